@@ -10,6 +10,7 @@
 
 #include "AdaptiveControllerLoader.h"
 #include "WaveVRPrivatePCH.h"
+#include "AdaptiveControllerMeshCache.h"
 #include "Runtime/ImageWrapper/Public/IImageWrapper.h"
 #include "Runtime/ImageWrapper/Public/IImageWrapperModule.h"
 #include "Runtime/Json/Public/Json.h"
@@ -105,6 +106,8 @@ bool UAdaptiveControllerLoader::doDeployControllerModel(EWVR_DeviceType type) {
 	else {
 		ret = true;
 		mRenderModelPath = FString(UTF8_TO_TCHAR(retStr.c_str()));
+		// Import the model before the actor is spawned.
+		FAdaptiveControllerMeshCache::Get().Prefetch(mRenderModelPath);
 	}
 	LOGI(LogAdapCtrLoader, "renderModelPath = %s", PLATFORM_CHAR(*mRenderModelPath));
 	delete[] deviceIndex;
@@ -0,0 +1,473 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "AdaptiveControllerMeshCache.h"
+#include "WaveVRPrivatePCH.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+DEFINE_LOG_CATEGORY_STATIC(AdapCtrMeshCache, Display, All);
+
+#define WVR_MODEL_CACHE_MAGIC 0x4d525657  // "WVRM"
+#define WVR_MODEL_CACHE_VERSION 1
+
+void FAdaptiveControllerMeshSet::Add(const FString& name, const FMatrix& transform)
+{
+	names.Add(name);
+	transforms.Add(transform);
+	vertices.AddDefaulted();
+	indices.AddDefaulted();
+	normals.AddDefaulted();
+	uvs.AddDefaulted();
+	tangents.AddDefaulted();
+	vertexColors.AddDefaulted();
+}
+
+FAdaptiveControllerMeshCache& FAdaptiveControllerMeshCache::Get()
+{
+	static FAdaptiveControllerMeshCache Instance;
+	return Instance;
+}
+
+bool FAdaptiveControllerMeshCache::IsNewDesign(const FString& renderModelPath)
+{
+	return !renderModelPath.Contains(FString(TEXT("Unreal")), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+}
+
+FString FAdaptiveControllerMeshCache::GetModelFile(const FString& renderModelPath)
+{
+	return renderModelPath + (IsNewDesign(renderModelPath) ? TEXT("controller00.fbx") : TEXT("Unreal.fbx"));
+}
+
+FString FAdaptiveControllerMeshCache::GetCachePath(const FString& renderModelPath)
+{
+	// The render model path ends with the model name, like ".../WVR_CONTROLLER_FINCH3DOF_2_0/".
+	FString name = FPaths::GetCleanFilename(renderModelPath.EndsWith(TEXT("/")) ? renderModelPath.LeftChop(1) : renderModelPath);
+	if (name.IsEmpty())
+		name = TEXT("Controller");
+	return FPaths::ProjectSavedDir() / TEXT("WaveVR") / TEXT("ModelCache") / (name + (IsNewDesign(renderModelPath) ? TEXT(".wvrmesh") : TEXT("_Unreal.wvrmesh")));
+}
+
+FAdaptiveControllerModelPtr FAdaptiveControllerMeshCache::Find(const FString& renderModelPath) const
+{
+	const FEntry* entry = Entries.Find(renderModelPath);
+	if (entry == nullptr)
+		return nullptr;
+	return entry->model;
+}
+
+bool FAdaptiveControllerMeshCache::Load(const FString& renderModelPath, FOnLoaded OnLoaded)
+{
+	check(IsInGameThread());
+	if (renderModelPath.IsEmpty()) {
+		if (OnLoaded)
+			OnLoaded(nullptr);
+		return false;
+	}
+
+	FEntry* entry = Entries.Find(renderModelPath);
+	if (entry != nullptr) {
+		if (entry->model.IsValid()) {
+			if (OnLoaded)
+				OnLoaded(entry->model);
+		} else if (OnLoaded) {
+			entry->waiters.Add(OnLoaded);  // Being loaded
+		}
+		return true;
+	}
+
+	entry = &Entries.Add(renderModelPath);
+	if (OnLoaded)
+		entry->waiters.Add(OnLoaded);
+
+	LOGD(AdapCtrMeshCache, "Start to load %s", PLATFORM_CHAR(*renderModelPath));
+	Async(EAsyncExecution::ThreadPool, [renderModelPath]() {
+		FAdaptiveControllerModelPtr model = LoadOrImport(renderModelPath);
+		AsyncTask(ENamedThreads::GameThread, [renderModelPath, model]() {
+			FAdaptiveControllerMeshCache::Get().OnLoadDone(renderModelPath, model);
+		});
+	});
+	return true;
+}
+
+FAdaptiveControllerModelPtr FAdaptiveControllerMeshCache::LoadNow(const FString& renderModelPath)
+{
+	check(IsInGameThread());
+	if (renderModelPath.IsEmpty())
+		return nullptr;
+
+	FEntry* entry = Entries.Find(renderModelPath);
+	if (entry != nullptr && entry->model.IsValid())
+		return entry->model;
+
+	LOGD(AdapCtrMeshCache, "Load %s in game thread", PLATFORM_CHAR(*renderModelPath));
+	FAdaptiveControllerModelPtr model = LoadOrImport(renderModelPath);
+	if (entry != nullptr) {
+		// A prefetch is still running.  Give its waiters this model now, and its result will be dropped.
+		OnLoadDone(renderModelPath, model);
+	} else if (model.IsValid()) {
+		Entries.Add(renderModelPath).model = model;
+	}
+	return model;
+}
+
+void FAdaptiveControllerMeshCache::Prefetch(const FString& renderModelPath)
+{
+	Load(renderModelPath, nullptr);
+}
+
+void FAdaptiveControllerMeshCache::OnLoadDone(const FString& renderModelPath, FAdaptiveControllerModelPtr model)
+{
+	check(IsInGameThread());
+	FEntry* entry = Entries.Find(renderModelPath);
+	if (entry == nullptr || entry->model.IsValid())
+		return;  // Loaded by LoadNow() already
+
+	TArray<FOnLoaded> waiters = MoveTemp(entry->waiters);
+	if (model.IsValid())
+		entry->model = model;
+	else
+		Entries.Remove(renderModelPath);  // Not to keep the failure.  Try again next time.
+
+	for (auto& waiter : waiters)
+		waiter(model);
+}
+
+FAdaptiveControllerModelPtr FAdaptiveControllerMeshCache::LoadOrImport(const FString& renderModelPath)
+{
+	const double start = FPlatformTime::Seconds();
+	const FString fbxPath = GetModelFile(renderModelPath);
+	const FString cachePath = GetCachePath(renderModelPath);
+
+	FMD5Hash hash = FMD5Hash::HashFile(*fbxPath);
+	if (!hash.IsValid()) {
+		LOGE(AdapCtrMeshCache, "Can not read %s", PLATFORM_CHAR(*fbxPath));
+		return nullptr;
+	}
+
+	TSharedPtr<FAdaptiveControllerModel, ESPMode::ThreadSafe> model = MakeShared<FAdaptiveControllerModel, ESPMode::ThreadSafe>();
+	if (ReadCache(cachePath, hash, *model)) {
+		LOGI(AdapCtrMeshCache, "Loaded %s from cache in %.2fms", PLATFORM_CHAR(*fbxPath), (FPlatformTime::Seconds() - start) * 1000.0);
+		return model;
+	}
+
+	*model = FAdaptiveControllerModel();
+	FString error;
+	if (!Import(fbxPath, IsNewDesign(renderModelPath), *model, error)) {
+		LOGE(AdapCtrMeshCache, "Import %s failed: %s", PLATFORM_CHAR(*fbxPath), PLATFORM_CHAR(*error));
+		return nullptr;
+	}
+	LOGI(AdapCtrMeshCache, "Imported %s in %.2fms", PLATFORM_CHAR(*fbxPath), (FPlatformTime::Seconds() - start) * 1000.0);
+
+	if (!WriteCache(cachePath, hash, *model))
+		LOGW(AdapCtrMeshCache, "Can not write cache %s", PLATFORM_CHAR(*cachePath));
+	return model;
+}
+
+//---------------------------------------------------
+// Assimp import
+//---------------------------------------------------
+
+#if WAVEVR_SUPPORTED_PLATFORMS
+static void ProcessMesh(const aiMesh* meshData, double unitSize, FAdaptiveControllerMeshSet& set)
+{
+	const int32 section = set.Num() - 1;
+	auto& vertices = set.vertices[section];
+	auto& normals = set.normals[section];
+	auto& uvs = set.uvs[section];
+	auto& tangents = set.tangents[section];
+	auto& indices = set.indices[section];
+
+	vertices.Reserve(meshData->mNumVertices);
+	normals.Reserve(meshData->mNumVertices);
+	uvs.Reserve(meshData->mNumVertices);
+	tangents.Reserve(meshData->mNumVertices);
+
+	for (uint32 i = 0; i < meshData->mNumVertices; i++) {
+		// Apply scale, unit of c4d is mm and Assimp is cm.
+		vertices.Add(FVector(meshData->mVertices[i].x, meshData->mVertices[i].y, meshData->mVertices[i].z) * (float)unitSize);
+		if (meshData->HasNormals())
+			normals.Add(FVector(meshData->mNormals[i].x, meshData->mNormals[i].y, meshData->mNormals[i].z) * (float)unitSize);
+		else
+			normals.Add(FVector::ZeroVector);
+
+		// if the mesh contains tex coords
+		if (meshData->mTextureCoords[0])
+			uvs.Add(FVector2D(meshData->mTextureCoords[0][i].x, meshData->mTextureCoords[0][i].y));
+		else
+			uvs.Add(FVector2D(0.f, 0.f));
+		tangents.Add(FProcMeshTangent(0, 1, 0));
+	}
+
+	indices.Reserve(meshData->mNumFaces * 3);
+	for (uint32 i = 0; i < meshData->mNumFaces; i++) {
+		const aiFace& face = meshData->mFaces[i];
+		indices.Add(face.mIndices[2]);
+		indices.Add(face.mIndices[1]);
+		indices.Add(face.mIndices[0]);
+	}
+}
+
+static void ProcessNode(const aiNode* node, const aiScene* scene, const aiMatrix4x4& accuTransform, double unitSize, FAdaptiveControllerMeshSet& set)
+{
+	const aiMatrix4x4 transform = node->mTransformation * accuTransform;
+	for (uint32 i = 0; i < node->mNumMeshes; i++) {
+		const aiMesh* AImesh = scene->mMeshes[node->mMeshes[i]];
+
+		aiMatrix4x4 transformMesh = transform;
+		transformMesh.a4 *= unitSize;
+		transformMesh.b4 *= unitSize;
+		transformMesh.c4 *= unitSize;
+
+		FMatrix NodeTransform(
+			FPlane(transformMesh.a1, transformMesh.b1, transformMesh.c1, transformMesh.d1),
+			FPlane(transformMesh.a2, transformMesh.b2, transformMesh.c2, transformMesh.d2),
+			FPlane(transformMesh.a3, transformMesh.b3, transformMesh.c3, transformMesh.d3),
+			FPlane(transformMesh.a4, transformMesh.b4, transformMesh.c4, transformMesh.d4));
+
+		set.Add(FString(AImesh->mName.C_Str()), NodeTransform);
+#if !UE_BUILD_SHIPPING //Do not log for performance purpose.
+		LOGD(AdapCtrMeshCache, "Mesh(%d) %s, vertices %u, faces %u", set.Num() - 1, AImesh->mName.C_Str(), AImesh->mNumVertices, AImesh->mNumFaces);
+#endif
+		ProcessMesh(AImesh, unitSize, set);
+	}
+
+	// do the same for all of its children
+	for (uint32 i = 0; i < node->mNumChildren; i++) {
+		ProcessNode(node->mChildren[i], scene, transform, unitSize, set);
+	}
+}
+
+static bool ImportScene(const std::string& filename, unsigned int flags, FAdaptiveControllerMeshSet& OutSet, FString& OutError)
+{
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(filename, flags);
+	if (!scene || !scene->mRootNode) {
+		OutError = importer.GetErrorString();
+		return false;
+	}
+
+	//Apply scale, unit of c4d is mm and Assimp is cm.
+	double unitSize = 1.0;
+	if (scene->mMetaData != nullptr)
+		scene->mMetaData->Get("UnitScaleFactor", unitSize);
+	LOGI(AdapCtrMeshCache, "UnitScaleFactor is (%lf)", unitSize);
+
+	ProcessNode(scene->mRootNode, scene, aiMatrix4x4(), unitSize, OutSet);
+	return true;
+}
+#endif
+
+bool FAdaptiveControllerMeshCache::Import(const FString& fbxPath, bool bWithOne, FAdaptiveControllerModel& OutModel, FString& OutError)
+{
+#if WAVEVR_SUPPORTED_PLATFORMS
+	std::string filename(TCHAR_TO_UTF8(*fbxPath));
+
+	if (!ImportScene(filename, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_ConvertToLeftHanded, OutModel.multi, OutError))
+		return false;
+
+	OutModel.bHasOne = bWithOne;
+	if (bWithOne && !ImportScene(filename, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_ConvertToLeftHanded | /*aiProcess_PreTransformVertices*/aiProcess_OptimizeGraph, OutModel.one, OutError))
+		return false;
+	return true;
+#else
+	OutError = TEXT("Assimp is not supported on this platform");
+	return false;
+#endif
+}
+
+//---------------------------------------------------
+// Binary cache
+//---------------------------------------------------
+
+// The streams are raw arrays, so the layout must be the same as the writer.
+struct FModelCacheHeader
+{
+	uint32 magic;
+	uint32 version;
+	uint32 layout;
+	uint8 hash[16];  // MD5 of the fbx
+	uint32 hasOne;
+};
+
+static uint32 GetCacheLayout()
+{
+	return (uint32)(sizeof(FVector) | sizeof(FVector2D) << 6 | sizeof(FProcMeshTangent) << 12 | sizeof(FLinearColor) << 18 | sizeof(FMatrix) << 24);
+}
+
+class FModelCacheWriter
+{
+public:
+	TArray<uint8> Data;
+
+	void Write(const void* src, int32 size) {
+		if (size > 0)
+			FMemory::Memcpy(&Data[Data.AddUninitialized(size)], src, size);
+	}
+
+	template<typename T>
+	void WriteStream(const TArray<T>& stream) {
+		const int32 num = stream.Num();
+		Write(&num, sizeof(num));
+		Write(stream.GetData(), num * sizeof(T));
+	}
+
+	void WriteSet(const FAdaptiveControllerMeshSet& set) {
+		const int32 num = set.Num();
+		Write(&num, sizeof(num));
+		for (int32 i = 0; i < num; i++) {
+			FTCHARToUTF8 name(*set.names[i]);
+			const int32 length = name.Length();
+			Write(&length, sizeof(length));
+			Write(name.Get(), length);
+			Write(&set.transforms[i], sizeof(FMatrix));
+			WriteStream(set.vertices[i]);
+			WriteStream(set.indices[i]);
+			WriteStream(set.normals[i]);
+			WriteStream(set.uvs[i]);
+			WriteStream(set.tangents[i]);
+			WriteStream(set.vertexColors[i]);
+		}
+	}
+};
+
+class FModelCacheReader
+{
+public:
+	FModelCacheReader(const uint8* data, int64 size) : Data(data), Size(size), Offset(0), bError(false) {}
+
+	bool IsError() const { return bError; }
+
+	bool Read(void* dst, int64 size) {
+		if (bError || size < 0 || Offset + size > Size) {
+			bError = true;
+			return false;
+		}
+		if (size > 0)
+			FMemory::Memcpy(dst, Data + Offset, size);
+		Offset += size;
+		return true;
+	}
+
+	template<typename T>
+	bool ReadStream(TArray<T>& stream) {
+		int32 num = 0;
+		if (!Read(&num, sizeof(num)) || num < 0 || (int64)num * sizeof(T) > Size - Offset) {
+			bError = true;
+			return false;
+		}
+		stream.SetNumUninitialized(num);
+		return Read(stream.GetData(), (int64)num * sizeof(T));
+	}
+
+	bool ReadSet(FAdaptiveControllerMeshSet& set) {
+		int32 num = 0;
+		if (!Read(&num, sizeof(num)) || num < 0 || num > 4096) {
+			bError = true;
+			return false;
+		}
+		for (int32 i = 0; i < num; i++) {
+			int32 length = 0;
+			if (!Read(&length, sizeof(length)) || length < 0 || length > Size - Offset) {
+				bError = true;
+				return false;
+			}
+			TArray<ANSICHAR> name;
+			name.SetNumZeroed(length + 1);
+			FMatrix transform;
+			if (!Read(name.GetData(), length) || !Read(&transform, sizeof(FMatrix)))
+				return false;
+			set.Add(FString(UTF8_TO_TCHAR(name.GetData())), transform);
+			if (!ReadStream(set.vertices[i]) || !ReadStream(set.indices[i]) || !ReadStream(set.normals[i]) ||
+				!ReadStream(set.uvs[i]) || !ReadStream(set.tangents[i]) || !ReadStream(set.vertexColors[i]))
+				return false;
+		}
+		return true;
+	}
+
+private:
+	const uint8* Data;
+	int64 Size;
+	int64 Offset;
+	bool bError;
+};
+
+static bool ReadModelCache(const uint8* data, int64 size, const FMD5Hash& hash, FAdaptiveControllerModel& OutModel)
+{
+	FModelCacheReader reader(data, size);
+	FModelCacheHeader header;
+	if (!reader.Read(&header, sizeof(header)))
+		return false;
+	if (header.magic != WVR_MODEL_CACHE_MAGIC || header.version != WVR_MODEL_CACHE_VERSION || header.layout != GetCacheLayout())
+		return false;
+	if (FMemory::Memcmp(header.hash, hash.GetBytes(), sizeof(header.hash)) != 0)
+		return false;  // The fbx was changed.
+
+	OutModel.bHasOne = header.hasOne != 0;
+	if (!reader.ReadSet(OutModel.multi))
+		return false;
+	if (OutModel.bHasOne && !reader.ReadSet(OutModel.one))
+		return false;
+	return !reader.IsError();
+}
+
+bool FAdaptiveControllerMeshCache::ReadCache(const FString& cachePath, const FMD5Hash& hash, FAdaptiveControllerModel& OutModel)
+{
+	// Map the file if the platform supports it.  Otherwise read it.
+	IMappedFileHandle* handle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*cachePath);
+	if (handle != nullptr) {
+		bool ret = false;
+		IMappedFileRegion* region = handle->MapRegion(0, handle->GetFileSize());
+		if (region != nullptr) {
+			ret = ReadModelCache(region->GetMappedPtr(), region->GetMappedSize(), hash, OutModel);
+			delete region;
+		}
+		delete handle;
+		return ret;
+	}
+
+	TArray<uint8> data;
+	if (!FFileHelper::LoadFileToArray(data, *cachePath, FILEREAD_Silent))
+		return false;
+	return ReadModelCache(data.GetData(), data.Num(), hash, OutModel);
+}
+
+bool FAdaptiveControllerMeshCache::WriteCache(const FString& cachePath, const FMD5Hash& hash, const FAdaptiveControllerModel& model)
+{
+	FModelCacheHeader header;
+	FMemory::Memzero(header);
+	header.magic = WVR_MODEL_CACHE_MAGIC;
+	header.version = WVR_MODEL_CACHE_VERSION;
+	header.layout = GetCacheLayout();
+	FMemory::Memcpy(header.hash, hash.GetBytes(), sizeof(header.hash));
+	header.hasOne = model.bHasOne ? 1 : 0;
+
+	FModelCacheWriter writer;
+	writer.Write(&header, sizeof(header));
+	writer.WriteSet(model.multi);
+	if (model.bHasOne)
+		writer.WriteSet(model.one);
+
+	// Write to a temp file and move, so a killed app never leaves a broken cache.  The temp file is
+	// per thread, because LoadNow() and a prefetch may write the same model at the same time.
+	const FString tempPath = cachePath + FString::Printf(TEXT(".%u.tmp"), FPlatformTLS::GetCurrentThreadId());
+	if (!FFileHelper::SaveArrayToFile(writer.Data, *tempPath))
+		return false;
+	return IFileManager::Get().Move(*cachePath, *tempPath, true, true);
+}
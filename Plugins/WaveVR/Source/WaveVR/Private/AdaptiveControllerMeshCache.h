@@ -0,0 +1,98 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+
+// Processed mesh streams of one scene.  Index is the mesh section.
+struct FAdaptiveControllerMeshSet
+{
+	TArray<FString> names;
+	TArray<FMatrix> transforms;
+	TArray<TArray<FVector>> vertices;
+	TArray<TArray<int32>> indices;
+	TArray<TArray<FVector>> normals;
+	TArray<TArray<FVector2D>> uvs;
+	TArray<TArray<FProcMeshTangent>> tangents;
+	TArray<TArray<FLinearColor>> vertexColors;
+
+	int32 Num() const { return names.Num(); }
+	void Add(const FString& name, const FMatrix& transform);
+};
+
+struct FAdaptiveControllerModel
+{
+	FAdaptiveControllerMeshSet multi;  // Every node as a mesh
+	FAdaptiveControllerMeshSet one;  // OptimizeGraph merged meshes.  Only for the new designed fbx.
+	bool bHasOne;
+
+	FAdaptiveControllerModel() : bHasOne(false) {}
+};
+
+typedef TSharedPtr<const FAdaptiveControllerModel, ESPMode::ThreadSafe> FAdaptiveControllerModelPtr;
+
+/**
+ * Load the controller model of a render model path.  Prefetch() loads without blocking the game
+ * thread, and LoadNow() blocks only if the model is not in memory yet.
+ *
+ * The fbx is imported by Assimp on a worker task, only once per path.  The processed streams are
+ * saved into a versioned binary under Saved/WaveVR/ModelCache, keyed by the model name and the
+ * MD5 of the fbx.  Later launches map the binary, and skip Assimp.  Loaded models are kept in
+ * memory, so a reconnected controller gets its model immediately.
+ *
+ * Load() and the callbacks are in game thread.
+ */
+class FAdaptiveControllerMeshCache
+{
+public:
+	typedef TFunction<void(FAdaptiveControllerModelPtr)> FOnLoaded;
+
+	static FAdaptiveControllerMeshCache& Get();
+
+	// The fbx file and its design are decided by the render model path.
+	static bool IsNewDesign(const FString& renderModelPath);
+	static FString GetModelFile(const FString& renderModelPath);
+
+	// Return the model if it is already in memory.
+	FAdaptiveControllerModelPtr Find(const FString& renderModelPath) const;
+
+	// Call OnLoaded with the model, or nullptr if failed.  It is called immediately if the model
+	// is in memory, otherwise later in game thread.  Return false if the load failed immediately.
+	bool Load(const FString& renderModelPath, FOnLoaded OnLoaded);
+
+	// Return the model, and load it in the calling game thread if it is not in memory.  A spawned
+	// controller needs its components before the spawn returns.  Return nullptr if failed.
+	FAdaptiveControllerModelPtr LoadNow(const FString& renderModelPath);
+
+	// Start loading early, for example when the render model was deployed.
+	void Prefetch(const FString& renderModelPath);
+
+private:
+	FAdaptiveControllerMeshCache() {}
+
+	void OnLoadDone(const FString& renderModelPath, FAdaptiveControllerModelPtr model);
+
+	// Worker
+	static FAdaptiveControllerModelPtr LoadOrImport(const FString& renderModelPath);
+	static bool Import(const FString& fbxPath, bool bWithOne, FAdaptiveControllerModel& OutModel, FString& OutError);
+	static bool ReadCache(const FString& cachePath, const FMD5Hash& hash, FAdaptiveControllerModel& OutModel);
+	static bool WriteCache(const FString& cachePath, const FMD5Hash& hash, const FAdaptiveControllerModel& model);
+	static FString GetCachePath(const FString& renderModelPath);
+
+	struct FEntry
+	{
+		FAdaptiveControllerModelPtr model;
+		TArray<FOnLoaded> waiters;
+	};
+
+	TMap<FString, FEntry> Entries;  // Key is render model path.  Only accessed in GT.
+};
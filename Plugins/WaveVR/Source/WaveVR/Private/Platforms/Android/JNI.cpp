@@ -12,6 +12,9 @@
 #include "RequestResultObject.h"
 #include "RequestUsbResultObject.h"
 #include "WaveVREventCommon.h"
+#include "WaveVROEMConfig.h"
+#include "WaveVRResourceStringCache.h"
+#include "WaveVRJavaBridgeAndroid.h"
 
 #include "Android/AndroidApplication.h"
 #include "Android/AndroidJNI.h"
@@ -19,26 +22,6 @@
 
 #undef LOG_TAG
 #define LOG_TAG "WaveHMD"
-JavaVM * mJavaVM;
-JNIEnv * JavaENV = NULL;
-jclass mPWclass;
-jobject mPWObj;
-
-jclass mRWClazz;
-jobject mRWObj;
-
-jclass mJclassCP;
-jobject mJobjectCP;
-
-jclass mFUClass;
-jobject mFUObject;
-
-jclass mSIPDClass;
-jobject mSIPDObject;
-
-jclass mOEMClass;
-jobject mOEMObject;
-
 TArray<FString> PermissionArr;
 TArray<bool> ResultArr;
 
@@ -46,24 +29,7 @@ TArray<bool> ResultArr;
 extern "C" void Java_com_htc_vr_unreal_PermissionWrapper_initNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Java_com_htc_vr_unreal_PermissionWrapper_initNative");
 
-	JavaENV = LocalJNIEnv;// FAndroidApplication::GetJavaEnv();
-
-	JavaENV->GetJavaVM(&mJavaVM);
-
-	if (mJavaVM == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "Java VM is null!!");
-		return;
-	}
-
-	mPWObj = JavaENV->NewGlobalRef(LocalThiz);
-
-	jclass localClass = JavaENV->FindClass("com/htc/vr/unreal/PermissionWrapper");
-	if (localClass == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "%s: Can't find Java Class - com/htc/vr/unreal/PermissionWrapper.", __func__);
-		return;
-	}
-
-	mPWclass = reinterpret_cast<jclass>(JavaENV->NewGlobalRef(localClass));
+	FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass::PermissionWrapper, LocalJNIEnv, LocalThiz);
 }
 
 extern "C" void Java_com_htc_vr_unreal_PermissionWrapper_requestCallbackNative(JNIEnv* LocalJNIEnv, jobject LocalThiz, jobjectArray PermissionArray, jbooleanArray resultArray) {
@@ -103,122 +69,46 @@ extern "C" void Java_com_htc_vr_unreal_PermissionWrapper_requestUsbCallbackNativ
 extern "C" void Java_com_htc_vr_unreal_ResourceWrapper_initNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Java_com_htc_vr_unreal_ResourceWrapper_initNative");
 
-	JavaENV = LocalJNIEnv;// FAndroidApplication::GetJavaEnv();
-
-	JavaENV->GetJavaVM(&mJavaVM);
-
-	if (mJavaVM == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "Java VM is null!!");
-		return;
-	}
-
-	mRWObj = JavaENV->NewGlobalRef(LocalThiz);
+	FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass::ResourceWrapper, LocalJNIEnv, LocalThiz);
+}
 
-	jclass localClass = JavaENV->FindClass("com/htc/vr/unreal/ResourceWrapper");
-	if (localClass == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "%s: Can't find Java Class - com/htc/vr/unreal/PermissionManager.", __func__);
-		return;
-	}
+extern "C" void Java_com_htc_vr_unreal_ResourceWrapper_localeChangedNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
+	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "localeChangedNative");
 
-	mRWClazz = reinterpret_cast<jclass>(JavaENV->NewGlobalRef(localClass));
+	FWaveVRResourceStringCache::Get().Invalidate();
 }
 
 extern "C" void Java_com_htc_vr_unreal_ContentProvider_initNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Java_com_htc_vr_unreal_ContentProvider_initNative");
 
-	JavaENV = LocalJNIEnv;// FAndroidApplication::GetJavaEnv();
-
-	JavaENV->GetJavaVM(&mJavaVM);
-
-	if (mJavaVM == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "Java VM is null!!");
-		return;
-	}
-
-	mJobjectCP = JavaENV->NewGlobalRef(LocalThiz);
-
-	jclass localClass = JavaENV->FindClass("com/htc/vr/unreal/ContentProvider");
-	if (localClass == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "%s: Can't find Java Class - com/htc/vr/unreal/ContentProvider.", __func__);
-		return;
-	}
-
-	mJclassCP = reinterpret_cast<jclass>(JavaENV->NewGlobalRef(localClass));
+	FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass::ContentProvider, LocalJNIEnv, LocalThiz);
 }
 
 extern "C" void Java_com_htc_vr_unreal_FileUtils_initNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Java_com_htc_vr_unreal_FileUtils_initNative");
 
-	JavaENV = LocalJNIEnv;// FAndroidApplication::GetJavaEnv();
-
-	JavaENV->GetJavaVM(&mJavaVM);
-
-	if (mJavaVM == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "Java VM is null!!");
-		return;
-	}
-
-	mFUObject = JavaENV->NewGlobalRef(LocalThiz);
-
-	jclass localClass = JavaENV->FindClass("com/htc/vr/unreal/FileUtils");
-	if (localClass == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "%s: Can't find Java Class - com/htc/vr/unreal/FileUtils.", __func__);
-		return;
-	}
-
-	mFUClass = reinterpret_cast<jclass>(JavaENV->NewGlobalRef(localClass));
+	FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass::FileUtils, LocalJNIEnv, LocalThiz);
 }
 
 extern "C" void Java_com_htc_vr_unreal_SoftwareIpd_initNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	//LOG_FUNC();
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Java_com_htc_vr_unreal_SoftwareIpd_initNative");
 
-	JavaENV = LocalJNIEnv;// FAndroidApplication::GetJavaEnv();
-
-	JavaENV->GetJavaVM(&mJavaVM);
-
-	if (mJavaVM == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "Java VM is null!!");
-		return;
-	}
-
-	mSIPDObject = JavaENV->NewGlobalRef(LocalThiz);
-
-	jclass localClass = JavaENV->FindClass("com/htc/vr/unreal/SoftwareIpd");
-	if (localClass == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "%s: Can't find Java Class - com/htc/vr/unreal/SoftwareIpd.", __func__);
-		return;
-	}
-
-	mSIPDClass =  reinterpret_cast<jclass>(JavaENV->NewGlobalRef(localClass));
+	FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass::SoftwareIpd, LocalJNIEnv, LocalThiz);
 }
 
 extern "C" void Java_com_htc_vr_unreal_OEMConfig_initNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Java_com_htc_vr_unreal_OEMConfig_initNative");
 
-	JavaENV = LocalJNIEnv;// FAndroidApplication::GetJavaEnv();
-
-	JavaENV->GetJavaVM(&mJavaVM);
-
-	if (mJavaVM == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "Java VM is null!!");
-		return;
-	}
-
-	mOEMObject = JavaENV->NewGlobalRef(LocalThiz);
-
-	jclass localClass = JavaENV->FindClass("com/htc/vr/unreal/OEMConfig");
-	if (localClass == nullptr) {
-		__android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "%s: Can't find Java Class - com/htc/vr/unreal/OEMConfig.", __func__);
-		return;
-	}
-
-	mOEMClass = reinterpret_cast<jclass>(JavaENV->NewGlobalRef(localClass));
+	FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass::OEMConfig, LocalJNIEnv, LocalThiz);
 }
 
 extern "C" void Java_com_htc_vr_unreal_OEMConfig_ConfigChangedNative(JNIEnv* LocalJNIEnv, jobject LocalThiz) {
 	__android_log_print(ANDROID_LOG_INFO, LOG_TAG, "ConfigChangedNative");
 
+	// The listeners read the new config.
+	WaveVROEMConfigImpl::getInstance()->Reload();
+
 	UWaveVREventCommon::OnOEMConfigChangeNative.Broadcast();
 }
 
@@ -0,0 +1,426 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#if PLATFORM_ANDROID
+#include "WaveVRJavaBridgeAndroid.h"
+#include "WaveVRPrivatePCH.h"
+#include "Misc/ScopeLock.h"
+#include <pthread.h>
+
+DEFINE_LOG_CATEGORY_STATIC(WVRJavaBridge, Log, All);
+
+static_assert(sizeof(TCHAR) == sizeof(jchar), "The strings are copied as UTF-16.");
+
+namespace {
+
+enum EMethod
+{
+	GetStringByName,
+	GetPreferredStringByName,
+	GetSystemLanguage,
+	GetSystemCountry,
+	GetStringsByName,
+	GetJsonRawDataByKey,
+	DoUnZIPAndDeploy,
+	RequestPermissions,
+	RequestUsbPermission,
+	IsPermissionGranted,
+	ShouldGrantPermission,
+	ShowDialogOnVRScene,
+	ReadIpd,
+	WriteIpd,
+	WriteControllerRoleValue,
+	MethodCount
+};
+
+struct FMethodInfo
+{
+	EWaveVRJavaClass javaClass;
+	const char* name;
+	const char* signature;
+};
+
+static const int32 kClassCount = (int32)EWaveVRJavaClass::Count;
+
+static const char* kClassNames[kClassCount] = {
+	"com/htc/vr/unreal/ResourceWrapper",
+	"com/htc/vr/unreal/OEMConfig",
+	"com/htc/vr/unreal/FileUtils",
+	"com/htc/vr/unreal/PermissionWrapper",
+	"com/htc/vr/unreal/SoftwareIpd",
+	"com/htc/vr/unreal/ContentProvider",
+};
+
+// Index is EMethod
+static const FMethodInfo kMethods[MethodCount] = {
+	{ EWaveVRJavaClass::ResourceWrapper, "getStringByName", "(Ljava/lang/String;)Ljava/lang/String;" },
+	{ EWaveVRJavaClass::ResourceWrapper, "getPreferredStringByName", "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;" },
+	{ EWaveVRJavaClass::ResourceWrapper, "getSystemLanguage", "()Ljava/lang/String;" },
+	{ EWaveVRJavaClass::ResourceWrapper, "getSystemCountry", "()Ljava/lang/String;" },
+	{ EWaveVRJavaClass::ResourceWrapper, "getStringsByName", "([Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)[Ljava/lang/String;" },
+	{ EWaveVRJavaClass::OEMConfig, "getJsonRawDataByKey", "(Ljava/lang/String;)Ljava/lang/String;" },
+	{ EWaveVRJavaClass::FileUtils, "doUnZIPAndDeploy", "(Ljava/lang/String;I)Ljava/lang/String;" },
+	{ EWaveVRJavaClass::PermissionWrapper, "requestPermissions", "([Ljava/lang/String;)Z" },
+	{ EWaveVRJavaClass::PermissionWrapper, "requestUsbPermission", "()Z" },
+	{ EWaveVRJavaClass::PermissionWrapper, "isPermissionGranted", "(Ljava/lang/String;)Z" },
+	{ EWaveVRJavaClass::PermissionWrapper, "shouldGrantPermission", "(Ljava/lang/String;)Z" },
+	{ EWaveVRJavaClass::PermissionWrapper, "showDialogOnVRScene", "()Z" },
+	{ EWaveVRJavaClass::SoftwareIpd, "read_ipd", "()[Ljava/lang/String;" },
+	{ EWaveVRJavaClass::SoftwareIpd, "write_ipd", "(Ljava/lang/String;Ljava/lang/String;)Z" },
+	{ EWaveVRJavaClass::ContentProvider, "writeControllerRoleValue", "(Ljava/lang/String;)V" },
+};
+
+// Written in Register(), under the lock.  A class is only read after it is ready.
+static FCriticalSection GRegisterLock;
+static JavaVM* GJavaVM = nullptr;
+static jclass GStringClass = nullptr;
+static jclass GClasses[kClassCount] = {};
+static jobject GObjects[kClassCount] = {};
+static jmethodID GMethodIds[MethodCount] = {};
+static int32 GReady[kClassCount] = {};
+
+static pthread_key_t GDetachKey;
+static pthread_once_t GDetachKeyOnce = PTHREAD_ONCE_INIT;
+
+static void DetachThread(void*)
+{
+	if (GJavaVM != nullptr)
+		GJavaVM->DetachCurrentThread();
+}
+
+static void CreateDetachKey()
+{
+	pthread_key_create(&GDetachKey, &DetachThread);
+}
+
+// Attach the thread at the first call, and keep it attached until the thread exits.
+static JNIEnv* GetThreadEnv()
+{
+	if (GJavaVM == nullptr)
+		return nullptr;
+
+	JNIEnv* env = nullptr;
+	const jint ret = GJavaVM->GetEnv((void**)&env, JNI_VERSION_1_6);
+	if (ret == JNI_OK)
+		return env;
+	if (ret != JNI_EDETACHED || GJavaVM->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+		LOGE(WVRJavaBridge, "Failed to attach the thread %u", FPlatformTLS::GetCurrentThreadId());
+		return nullptr;
+	}
+	pthread_once(&GDetachKeyOnce, &CreateDetachKey);
+	pthread_setspecific(GDetachKey, env);
+	LOGD(WVRJavaBridge, "Attached the thread %u", FPlatformTLS::GetCurrentThreadId());
+	return env;
+}
+
+static bool CheckException(JNIEnv* env)
+{
+	if (!env->ExceptionCheck())
+		return false;
+	env->ExceptionDescribe();
+	env->ExceptionClear();
+	return true;
+}
+
+static jstring ToJString(JNIEnv* env, const FString& str)
+{
+	return env->NewString((const jchar*)*str, str.Len());
+}
+
+static bool ToFString(JNIEnv* env, jstring str, FString& out)
+{
+	out.Empty();
+	if (str == nullptr)
+		return false;
+	const jsize length = env->GetStringLength(str);
+	if (length > 0) {
+		TArray<TCHAR>& chars = out.GetCharArray();
+		chars.SetNumUninitialized(length + 1);
+		env->GetStringRegion(str, 0, length, (jchar*)chars.GetData());
+		chars[length] = 0;
+	}
+	return true;
+}
+
+static jobjectArray ToJStringArray(JNIEnv* env, const TArray<FString>& strs)
+{
+	jobjectArray array = env->NewObjectArray(strs.Num(), GStringClass, nullptr);
+	if (array == nullptr)
+		return nullptr;
+	for (int32 i = 0; i < strs.Num(); i++) {
+		jstring str = ToJString(env, strs[i]);
+		env->SetObjectArrayElement(array, i, str);
+		env->DeleteLocalRef(str);
+	}
+	return array;
+}
+
+static bool ToFStringArray(JNIEnv* env, jobjectArray array, TArray<FString>& out)
+{
+	out.Reset();
+	if (array == nullptr)
+		return false;
+	const jsize length = env->GetArrayLength(array);
+	out.SetNum(length);
+	for (jsize i = 0; i < length; i++) {
+		jstring str = (jstring)env->GetObjectArrayElement(array, i);
+		ToFString(env, str, out[i]);
+		env->DeleteLocalRef(str);
+	}
+	return true;
+}
+
+// The env, object and method of a call, in a local reference frame.
+class FScopedCall
+{
+public:
+	explicit FScopedCall(EMethod method, jint localRefs = 8)
+		: env(GetThreadEnv())
+		, object(nullptr)
+		, id(nullptr)
+		, bFramePushed(false)
+	{
+		if (env == nullptr)
+			return;
+		const int32 javaClass = (int32)kMethods[method].javaClass;
+		if (FPlatformAtomics::AtomicRead(&GReady[javaClass]) == 0) {
+			LOGE(WVRJavaBridge, "%s is not registered for %s.", kClassNames[javaClass], kMethods[method].name);
+			return;
+		}
+		object = GObjects[javaClass];
+		id = GMethodIds[method];
+		if (id == nullptr)
+			return;
+		bFramePushed = env->PushLocalFrame(localRefs) == 0;
+	}
+
+	~FScopedCall()
+	{
+		if (bFramePushed)
+			env->PopLocalFrame(nullptr);
+	}
+
+	bool IsValid() const { return bFramePushed; }
+
+	JNIEnv* env;
+	jobject object;
+	jmethodID id;
+
+private:
+	bool bFramePushed;
+};
+
+static bool CallString(EMethod method, FString& out, const FString* arg0 = nullptr, const FString* arg1 = nullptr, const FString* arg2 = nullptr)
+{
+	FScopedCall call(method);
+	if (!call.IsValid())
+		return false;
+	JNIEnv* env = call.env;
+	jstring ret = nullptr;
+	if (arg2 != nullptr)
+		ret = (jstring)env->CallObjectMethod(call.object, call.id, ToJString(env, *arg0), ToJString(env, *arg1), ToJString(env, *arg2));
+	else if (arg0 != nullptr)
+		ret = (jstring)env->CallObjectMethod(call.object, call.id, ToJString(env, *arg0));
+	else
+		ret = (jstring)env->CallObjectMethod(call.object, call.id);
+	if (CheckException(env))
+		return false;
+	return ToFString(env, ret, out);
+}
+
+static bool CallBool(EMethod method, bool& outResult, const FString* arg0 = nullptr)
+{
+	FScopedCall call(method);
+	if (!call.IsValid())
+		return false;
+	JNIEnv* env = call.env;
+	jboolean ret = arg0 != nullptr ?
+		env->CallBooleanMethod(call.object, call.id, ToJString(env, *arg0)) :
+		env->CallBooleanMethod(call.object, call.id);
+	if (CheckException(env))
+		return false;
+	outResult = ret == JNI_TRUE;
+	return true;
+}
+
+}  // namespace
+
+void FWaveVRJavaBridgeAndroid::Register(EWaveVRJavaClass javaClass, JNIEnv* env, jobject thiz)
+{
+	const int32 index = (int32)javaClass;
+	FScopeLock lock(&GRegisterLock);
+
+	if (GJavaVM == nullptr)
+		env->GetJavaVM(&GJavaVM);
+	if (GJavaVM == nullptr) {
+		LOGE(WVRJavaBridge, "Java VM is null!!");
+		return;
+	}
+
+	if (GStringClass == nullptr) {
+		jclass localString = env->FindClass("java/lang/String");
+		if (localString != nullptr) {
+			GStringClass = (jclass)env->NewGlobalRef(localString);
+			env->DeleteLocalRef(localString);
+		}
+		CheckException(env);
+	}
+
+	// Registered again if the activity is recreated.  The old global references are kept,
+	// because another thread may be calling with them.
+	if (GClasses[index] == nullptr) {
+		jclass localClass = env->FindClass(kClassNames[index]);
+		if (localClass == nullptr) {
+			CheckException(env);
+			LOGE(WVRJavaBridge, "Can't find Java Class - %s.", kClassNames[index]);
+			return;
+		}
+		GClasses[index] = (jclass)env->NewGlobalRef(localClass);
+		env->DeleteLocalRef(localClass);
+
+		for (int32 m = 0; m < MethodCount; m++) {
+			if (kMethods[m].javaClass != javaClass)
+				continue;
+			GMethodIds[m] = env->GetMethodID(GClasses[index], kMethods[m].name, kMethods[m].signature);
+			if (GMethodIds[m] == nullptr) {
+				CheckException(env);
+				LOGE(WVRJavaBridge, "Can't find the method %s%s of %s.", kMethods[m].name, kMethods[m].signature, kClassNames[index]);
+			}
+		}
+	}
+	GObjects[index] = env->NewGlobalRef(thiz);
+	FPlatformAtomics::AtomicStore(&GReady[index], 1);
+	LOGI(WVRJavaBridge, "Registered %s", kClassNames[index]);
+}
+
+bool FWaveVRJavaBridgeAndroid::GetStringByName(const FString& name, FString& out)
+{
+	return CallString(EMethod::GetStringByName, out, &name);
+}
+
+bool FWaveVRJavaBridgeAndroid::GetPreferredStringByName(const FString& name, const FString& lang, const FString& country, FString& out)
+{
+	return CallString(EMethod::GetPreferredStringByName, out, &name, &lang, &country);
+}
+
+bool FWaveVRJavaBridgeAndroid::GetSystemLanguage(FString& out)
+{
+	return CallString(EMethod::GetSystemLanguage, out);
+}
+
+bool FWaveVRJavaBridgeAndroid::GetSystemCountry(FString& out)
+{
+	return CallString(EMethod::GetSystemCountry, out);
+}
+
+bool FWaveVRJavaBridgeAndroid::GetStringsByName(const TArray<FString>& names, const FString& lang, const FString& country, TArray<FString>& out)
+{
+	FScopedCall call(EMethod::GetStringsByName);
+	if (!call.IsValid() || GStringClass == nullptr)
+		return false;
+	JNIEnv* env = call.env;
+	jobjectArray array = ToJStringArray(env, names);
+	if (CheckException(env) || array == nullptr)
+		return false;
+	jobjectArray ret = (jobjectArray)env->CallObjectMethod(call.object, call.id, array, ToJString(env, lang), ToJString(env, country));
+	if (CheckException(env))
+		return false;
+	return ToFStringArray(env, ret, out);
+}
+
+bool FWaveVRJavaBridgeAndroid::GetJsonRawDataByKey(const FString& key, FString& out)
+{
+	return CallString(EMethod::GetJsonRawDataByKey, out, &key);
+}
+
+bool FWaveVRJavaBridgeAndroid::DoUnZIPAndDeploy(const FString& renderModelName, int32 deviceIndex, FString& outPath)
+{
+	FScopedCall call(EMethod::DoUnZIPAndDeploy);
+	if (!call.IsValid())
+		return false;
+	JNIEnv* env = call.env;
+	jstring ret = (jstring)env->CallObjectMethod(call.object, call.id, ToJString(env, renderModelName), (jint)deviceIndex);
+	if (CheckException(env))
+		return false;
+	return ToFString(env, ret, outPath);
+}
+
+bool FWaveVRJavaBridgeAndroid::RequestPermissions(const TArray<FString>& permissions, bool& outResult)
+{
+	FScopedCall call(EMethod::RequestPermissions);
+	if (!call.IsValid() || GStringClass == nullptr)
+		return false;
+	JNIEnv* env = call.env;
+	jobjectArray array = ToJStringArray(env, permissions);
+	if (CheckException(env) || array == nullptr)
+		return false;
+	jboolean ret = env->CallBooleanMethod(call.object, call.id, array);
+	if (CheckException(env))
+		return false;
+	outResult = ret == JNI_TRUE;
+	return true;
+}
+
+bool FWaveVRJavaBridgeAndroid::RequestUsbPermission(bool& outResult)
+{
+	return CallBool(EMethod::RequestUsbPermission, outResult);
+}
+
+bool FWaveVRJavaBridgeAndroid::IsPermissionGranted(const FString& permission, bool& outResult)
+{
+	return CallBool(EMethod::IsPermissionGranted, outResult, &permission);
+}
+
+bool FWaveVRJavaBridgeAndroid::ShouldGrantPermission(const FString& permission, bool& outResult)
+{
+	return CallBool(EMethod::ShouldGrantPermission, outResult, &permission);
+}
+
+bool FWaveVRJavaBridgeAndroid::ShowDialogOnVRScene(bool& outResult)
+{
+	return CallBool(EMethod::ShowDialogOnVRScene, outResult);
+}
+
+bool FWaveVRJavaBridgeAndroid::ReadIpd(TArray<FString>& outFields)
+{
+	FScopedCall call(EMethod::ReadIpd);
+	if (!call.IsValid())
+		return false;
+	JNIEnv* env = call.env;
+	jobjectArray data = (jobjectArray)env->CallObjectMethod(call.object, call.id);
+	if (CheckException(env))
+		return false;
+	return ToFStringArray(env, data, outFields);
+}
+
+bool FWaveVRJavaBridgeAndroid::WriteIpd(const FString& value, const FString& isEnable, bool& outResult)
+{
+	FScopedCall call(EMethod::WriteIpd);
+	if (!call.IsValid())
+		return false;
+	JNIEnv* env = call.env;
+	jboolean ret = env->CallBooleanMethod(call.object, call.id, ToJString(env, value), ToJString(env, isEnable));
+	if (CheckException(env))
+		return false;
+	outResult = ret == JNI_TRUE;
+	return true;
+}
+
+bool FWaveVRJavaBridgeAndroid::WriteControllerRoleValue(const FString& role)
+{
+	FScopedCall call(EMethod::WriteControllerRoleValue);
+	if (!call.IsValid())
+		return false;
+	JNIEnv* env = call.env;
+	env->CallVoidMethod(call.object, call.id, ToJString(env, role));
+	return !CheckException(env);
+}
+
+#endif  // PLATFORM_ANDROID
@@ -0,0 +1,73 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "Platforms/WaveVRJavaBridge.h"
+
+#if PLATFORM_ANDROID
+#include <jni.h>
+
+enum class EWaveVRJavaClass : uint8
+{
+	ResourceWrapper,
+	OEMConfig,
+	FileUtils,
+	PermissionWrapper,
+	SoftwareIpd,
+	ContentProvider,
+	Count
+};
+
+/**
+ * The Java bridge by JNI.
+ *
+ * The initNative of each Java helper calls Register() with its object.  The class and all its
+ * method ids are resolved there once, into a table indexed by the method.  A call gets the env
+ * of the calling thread from the VM.  A thread not attached yet is attached once, and detached
+ * by a pthread key destructor when it exits.  Each call runs in its own local reference frame,
+ * so the local references are released together.  The strings are copied between FString and
+ * jstring as UTF-16 directly.
+ */
+class FWaveVRJavaBridgeAndroid : public FWaveVRJavaBridge
+{
+public:
+	// Called by the initNative in the Java thread.
+	static void Register(EWaveVRJavaClass javaClass, JNIEnv* env, jobject thiz);
+
+	/* ResourceWrapper */
+	virtual bool GetStringByName(const FString& name, FString& out) override;
+	virtual bool GetPreferredStringByName(const FString& name, const FString& lang, const FString& country, FString& out) override;
+	virtual bool GetSystemLanguage(FString& out) override;
+	virtual bool GetSystemCountry(FString& out) override;
+	virtual bool GetStringsByName(const TArray<FString>& names, const FString& lang, const FString& country, TArray<FString>& out) override;
+
+	/* OEMConfig */
+	virtual bool GetJsonRawDataByKey(const FString& key, FString& out) override;
+
+	/* FileUtils */
+	virtual bool DoUnZIPAndDeploy(const FString& renderModelName, int32 deviceIndex, FString& outPath) override;
+
+	/* PermissionWrapper */
+	virtual bool RequestPermissions(const TArray<FString>& permissions, bool& outResult) override;
+	virtual bool RequestUsbPermission(bool& outResult) override;
+	virtual bool IsPermissionGranted(const FString& permission, bool& outResult) override;
+	virtual bool ShouldGrantPermission(const FString& permission, bool& outResult) override;
+	virtual bool ShowDialogOnVRScene(bool& outResult) override;
+
+	/* SoftwareIpd */
+	virtual bool ReadIpd(TArray<FString>& outFields) override;
+	virtual bool WriteIpd(const FString& value, const FString& isEnable, bool& outResult) override;
+
+	/* ContentProvider */
+	virtual bool WriteControllerRoleValue(const FString& role) override;
+};
+
+#endif  // PLATFORM_ANDROID
@@ -35,7 +35,8 @@
 #if WAVEVR_LOG_SHOW_ALL_ENTRY
 #define LOG_FUNC() LOGD(WVRHMD, "%s", WVR_FUNCTION_STRING);
 #else
-#define LOG_FUNC()
+// Recorded into the trace log if the level of WVRFunc is Verbose.
+#define LOG_FUNC() TLOG_FUNC()
 #endif
 
 #define LOG_FUNC_IF(expr) do { constexpr decltype(expr) var = (expr); if (var) { LOGD(WVRHMD, "%s", WVR_FUNCTION_STRING); } } while (0)
@@ -13,20 +13,10 @@
 #include <string>
 #include "../WaveVRAPIWrapper.h"
 #include "WaveVRLogAndroid.h"
+#include "Platforms/WaveVRJavaBridge.h"
 #include "Android/AndroidApplication.h"
 #include "Android/AndroidJNI.h"
 
-extern JavaVM* mJavaVM;
-extern JNIEnv* JavaENV;
-extern jclass mRWClazz;
-extern jobject mRWObj;
-extern jclass mOEMClass;
-extern jobject mOEMObject;
-extern jclass mFUClass;
-extern jobject mFUObject;
-extern jclass mPWclass;
-extern jobject mPWObj;
-
 extern FString GExternalFilePath;
 
 extern "C" void WVR_EXPORT WVR_PauseATW();   // New Api to replace SetATWActive(false)
@@ -87,6 +77,14 @@ WVR_Axis_t FWaveVRPlatformAndroid::GetInputAnalogAxis(WVR_DeviceType type, WVR_I
 	LOG_FUNC();
 	return WVR_GetInputAnalogAxis(type, id);
 }
+bool FWaveVRPlatformAndroid::GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount) {
+	LOG_FUNC();
+	return WVR_GetInputDeviceState(type, inputType, buttons, touches, analogArray, analogArrayCount);
+}
+int32_t FWaveVRPlatformAndroid::GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType) {
+	LOG_FUNC();
+	return WVR_GetInputTypeCount(type, inputType);
+}
 bool FWaveVRPlatformAndroid::IsDeviceConnected(WVR_DeviceType type) {
 	LOG_FUNC();
 	return WVR_IsDeviceConnected(type);
@@ -103,6 +101,10 @@ float FWaveVRPlatformAndroid::GetDeviceBatteryPercentage(WVR_DeviceType type) {
 	LOG_FUNC();
 	return WVR_GetDeviceBatteryPercentage(type);
 }
+WVR_BatteryTemperatureStatus FWaveVRPlatformAndroid::GetBatteryTemperatureStatus(WVR_DeviceType type) {
+	LOG_FUNC();
+	return WVR_GetBatteryTemperatureStatus(type);
+}
 bool FWaveVRPlatformAndroid::PollEventQueue(WVR_Event_t* event) {
 	LOG_FUNC();
 	return WVR_PollEventQueue(event);
@@ -373,233 +375,74 @@ WVR_DeviceType FWaveVRPlatformAndroid::GetFocusedController() {
 }
 
 std::string FWaveVRPlatformAndroid::GetStringBySystemLanguage(std::string stringName) {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
+	FString result;
+	if (!FWaveVRJavaBridge::GetInstance()->GetStringByName(UTF8_TO_TCHAR(stringName.c_str()), result)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getStringByName fails");
 		return stringName;
 	}
 
-	if ((mRWClazz == nullptr) || (mRWObj == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mRWClazz or mRWObj is nullptr");
-		JavaENVFinish();
-		return stringName;
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mRWClazz, "getStringByName", "(Ljava/lang/String;)Ljava/lang/String;");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getString Method cant be found T_T ");
-		JavaENVFinish();
-		return stringName;
-	}
-
-	jstring sn = JavaENV->NewStringUTF(stringName.c_str());
-	jstring retStr = (jstring)JavaENV->CallObjectMethod(mRWObj, methodid, sn);
-	JavaENV->DeleteLocalRef(sn);
-
-	const char *str;
-	str = JavaENV->GetStringUTFChars(retStr, 0);
-	std::string resString(str);
-
-	LOGI(FWaveVRPlatformAndroid, "GetStringBySystemLanguage, input = %s, result = %s", stringName.c_str(), str);
-
-	JavaENV->ReleaseStringUTFChars(retStr, str);
-	JavaENV->DeleteLocalRef(retStr);
-	JavaENVFinish();
-
+	std::string resString(TCHAR_TO_UTF8(*result));
+	TLOGI(FWaveVRPlatformAndroid, "GetStringBySystemLanguage, input = %s, result = %s", stringName.c_str(), resString.c_str());
 	return resString;
 }
 
 std::string FWaveVRPlatformAndroid::GetStringByLanguage(std::string stringName, std::string lang, std::string country) {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return stringName;
-	}
-
-	if ((mRWClazz == nullptr) || (mRWObj == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mRWClazz or mRWObj is nullptr");
-		JavaENVFinish();
-		return stringName;
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mRWClazz, "getPreferredStringByName", "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getPreferredStringByName Method cant be found T_T ");
-		JavaENVFinish();
+	FString result;
+	if (!FWaveVRJavaBridge::GetInstance()->GetPreferredStringByName(UTF8_TO_TCHAR(stringName.c_str()), UTF8_TO_TCHAR(lang.c_str()), UTF8_TO_TCHAR(country.c_str()), result)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getPreferredStringByName fails");
 		return stringName;
 	}
 
-	jstring sn1 = JavaENV->NewStringUTF(stringName.c_str());
-	jstring sn2 = JavaENV->NewStringUTF(lang.c_str());
-	jstring sn3 = JavaENV->NewStringUTF(country.c_str());
-	jstring retStr = (jstring)JavaENV->CallObjectMethod(mRWObj, methodid, sn1, sn2, sn3);
-	JavaENV->DeleteLocalRef(sn1);
-	JavaENV->DeleteLocalRef(sn2);
-	JavaENV->DeleteLocalRef(sn3);
-
-	const char *str;
-	str = JavaENV->GetStringUTFChars(retStr, 0);
-	std::string resString(str);
-
-	LOGI(FWaveVRPlatformAndroid, "getPreferredStringByName, input = %s, lang = %s, country = %s, result = %s", stringName.c_str(), lang.c_str(), country.c_str(), str);
-
-	JavaENV->ReleaseStringUTFChars(retStr, str);
-	JavaENV->DeleteLocalRef(retStr);
-	JavaENVFinish();
-
+	std::string resString(TCHAR_TO_UTF8(*result));
+	TLOGI(FWaveVRPlatformAndroid, "getPreferredStringByName, input = %s, lang = %s, country = %s, result = %s", stringName.c_str(), lang.c_str(), country.c_str(), resString.c_str());
 	return resString;
 }
 
 std::string FWaveVRPlatformAndroid::GetSystemLanguage() {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return std::string(" ");
-	}
-
-	if ((mRWClazz == nullptr) || (mRWObj == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mRWClazz or mRWObj is nullptr");
-		JavaENVFinish();
-		return std::string(" ");
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mRWClazz, "getSystemLanguage", "()Ljava/lang/String;");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getSystemLanguage Method cant be found T_T ");
-		JavaENVFinish();
+	FString result;
+	if (!FWaveVRJavaBridge::GetInstance()->GetSystemLanguage(result)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getSystemLanguage fails");
 		return std::string(" ");
 	}
 
-	jstring retStr = (jstring)JavaENV->CallObjectMethod(mRWObj, methodid);
-
-	const char *str;
-	str = JavaENV->GetStringUTFChars(retStr, 0);
-	std::string resString(str);
-
-	LOGI(FWaveVRPlatformAndroid, "getSystemLanguage, str = %s", str);
-
-	JavaENV->ReleaseStringUTFChars(retStr, str);
-	JavaENV->DeleteLocalRef(retStr);
-	JavaENVFinish();
-
+	std::string resString(TCHAR_TO_UTF8(*result));
+	LOGI(FWaveVRPlatformAndroid, "getSystemLanguage, str = %s", resString.c_str());
 	return resString;
 }
 
 std::string FWaveVRPlatformAndroid::GetSystemCountry() {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
+	FString result;
+	if (!FWaveVRJavaBridge::GetInstance()->GetSystemCountry(result)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getSystemCountry fails");
 		return std::string(" ");
 	}
 
-	if ((mRWClazz == nullptr) || (mRWObj == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mRWClazz or mRWObj is nullptr");
-		JavaENVFinish();
-		return std::string(" ");
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mRWClazz, "getSystemCountry", "()Ljava/lang/String;");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getSystemCountry Method cant be found T_T ");
-		JavaENVFinish();
-		return std::string(" ");
-	}
-
-	jstring retStr = (jstring)JavaENV->CallObjectMethod(mRWObj, methodid);
-
-	const char *str;
-	str = JavaENV->GetStringUTFChars(retStr, 0);
-	std::string resString(str);
-
-	LOGI(FWaveVRPlatformAndroid, "getSystemCountry, str = %s", str);
-
-	JavaENV->ReleaseStringUTFChars(retStr, str);
-	JavaENV->DeleteLocalRef(retStr);
-	JavaENVFinish();
-
+	std::string resString(TCHAR_TO_UTF8(*result));
+	LOGI(FWaveVRPlatformAndroid, "getSystemCountry, str = %s", resString.c_str());
 	return resString;
 }
 
 std::string FWaveVRPlatformAndroid::GetOEMConfigRawData(std::string key) {
-	std::string nullString("");
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return nullString;
-	}
-
-	if ((mOEMClass == nullptr) || (mOEMObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mOEMClass or mOEMObject is nullptr");
-		JavaENVFinish();
-		return nullString;
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mOEMClass, "getJsonRawDataByKey", "(Ljava/lang/String;)Ljava/lang/String;");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getString Method cant be found T_T ");
-		JavaENVFinish();
-		return nullString;
+	FString result;
+	if (!FWaveVRJavaBridge::GetInstance()->GetJsonRawDataByKey(UTF8_TO_TCHAR(key.c_str()), result)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: getJsonRawDataByKey fails");
+		return std::string("");
 	}
 
-	jstring sn = JavaENV->NewStringUTF(key.c_str());
-	jstring retStr = (jstring)JavaENV->CallObjectMethod(mOEMObject, methodid, sn);
-	JavaENV->DeleteLocalRef(sn);
-
-	const char *str;
-	str = JavaENV->GetStringUTFChars(retStr, 0);
-	std::string resString(str);
-
-	LOGI(FWaveVRPlatformAndroid, "GetOEMConfigRawData, key = %s, result = %s \n", key.c_str(), str);
-
-	JavaENV->ReleaseStringUTFChars(retStr, str);
-	JavaENV->DeleteLocalRef(retStr);
-	JavaENVFinish();
-
+	std::string resString(TCHAR_TO_UTF8(*result));
+	LOGI(FWaveVRPlatformAndroid, "GetOEMConfigRawData, key = %s, result = %s \n", key.c_str(), resString.c_str());
 	return resString;
 }
 
 std::string FWaveVRPlatformAndroid::DeployRenderModelAssets(int deviceIndex, std::string renderModelName) {
-	std::string nullString("");
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return nullString;
-	}
-
-	if ((mFUClass == nullptr) || (mFUObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mFUClass or mFUObject is nullptr");
-		JavaENVFinish();
-		return nullString;
+	FString result;
+	if (!FWaveVRJavaBridge::GetInstance()->DoUnZIPAndDeploy(UTF8_TO_TCHAR(renderModelName.c_str()), deviceIndex, result)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: doUnZIPAndDeploy fails");
+		return std::string("");
 	}
 
-	jmethodID methodid = JavaENV->GetMethodID(mFUClass, "doUnZIPAndDeploy", "(Ljava/lang/String;I)Ljava/lang/String;");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: doDeployControllerModel Method cant be found T_T ");
-		JavaENVFinish();
-		return nullString;
-	}
-
-	jstring jStr = JavaENV->NewStringUTF(renderModelName.c_str());
-	jstring retStr = (jstring)JavaENV->CallObjectMethod(mFUObject, methodid, jStr, deviceIndex);
-	JavaENV->DeleteLocalRef(jStr);
-
-	const char *str;
-	str = JavaENV->GetStringUTFChars(retStr, 0);
-	std::string resString(str);
-
-	LOGI(FWaveVRPlatformAndroid, "doDeployControllerModel, deploy path = %s", str);
-
-	JavaENV->ReleaseStringUTFChars(retStr, str);
-	JavaENV->DeleteLocalRef(retStr);
-
-	JavaENVFinish();
-
+	std::string resString(TCHAR_TO_UTF8(*result));
+	LOGI(FWaveVRPlatformAndroid, "doDeployControllerModel, deploy path = %s", resString.c_str());
 	return resString;
 }
 
@@ -618,197 +461,58 @@ std::string FWaveVRPlatformAndroid::GetRootRelativePath() {
 }
 
 bool FWaveVRPlatformAndroid::RequestPermissions(std::vector<std::string> permissions) {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
+	TArray<FString> permissionArray;
+	permissionArray.Reserve(permissions.size());
+	for (const std::string& permission : permissions)
+		permissionArray.Add(UTF8_TO_TCHAR(permission.c_str()));
+
+	bool ret = false;
+	if (!FWaveVRJavaBridge::GetInstance()->RequestPermissions(permissionArray, ret)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: requestPermissions fails");
 		return false;
 	}
-
-	if ((mPWclass == nullptr) || (mFUObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mPWclass or mPWObj is nullptr");
-		JavaENVFinish();
-		return false;
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mPWclass, "requestPermissions", "([Ljava/lang/String;)Z");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "ERROR: requestPermissions Method cant be found T_T ");
-		JavaENVFinish();
-		return false;
-	}
-	int len = permissions.size();
-	jstring str;
-	jobjectArray permissionArray = 0;
-	jclass strClass = JavaENV->FindClass("java/lang/String");
-	permissionArray = JavaENV->NewObjectArray(len, strClass, 0);
-
-	for (int i = 0; i < len; i++)
-	{
-		str = JavaENV->NewStringUTF(permissions[i].c_str());
-		JavaENV->SetObjectArrayElement(permissionArray, i, str);
-		JavaENV->DeleteLocalRef(str);
-	}
-	bool ret = JavaENV->CallBooleanMethod(mPWObj, methodid, permissionArray);
-
 	LOGI(FWaveVRPlatformAndroid, "requestPermissions, ret = %d", ret);
-
-	JavaENV->DeleteLocalRef(strClass);
-	JavaENV->DeleteLocalRef(permissionArray);
-
-	JavaENVFinish();
 	return ret;
 }
 
 bool FWaveVRPlatformAndroid::RequestUsbPermission() {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
+	bool ret = false;
+	if (!FWaveVRJavaBridge::GetInstance()->RequestUsbPermission(ret)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: requestUsbPermission fails");
 		return false;
 	}
-
-	if ((mPWclass == nullptr) || (mFUObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mPWclass or mPWObj is nullptr");
-		JavaENVFinish();
-		return false;
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mPWclass, "requestUsbPermission", "()Z");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "ERROR: requestUsbPermission Method cant be found T_T ");
-		JavaENVFinish();
-		return false;
-	}
-
-	bool ret = JavaENV->CallBooleanMethod(mPWObj, methodid);
 	LOGI(FWaveVRPlatformAndroid, "requestUsbPermission, ret = %d", ret);
-
-	JavaENVFinish();
 	return ret;
 }
 
 bool FWaveVRPlatformAndroid::IsPermissionGranted(std::string permission) {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return false;
-	}
-
-	if ((mPWclass == nullptr) || (mFUObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mPWclass or mPWObj is nullptr");
-		JavaENVFinish();
-		return false;
-	}
-	jmethodID methodid = JavaENV->GetMethodID(mPWclass, "isPermissionGranted", "(Ljava/lang/String;)Z");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "ERROR: isPermissionGranted Method cant be found T_T ");
-		JavaENVFinish();
+	bool ret = false;
+	if (!FWaveVRJavaBridge::GetInstance()->IsPermissionGranted(UTF8_TO_TCHAR(permission.c_str()), ret)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: isPermissionGranted fails");
 		return false;
 	}
-
-	jstring jStr = JavaENV->NewStringUTF(permission.c_str());
-
-	bool ret = JavaENV->CallBooleanMethod(mPWObj, methodid, jStr);
-
-	LOGE(FWaveVRPlatformAndroid, "isPermissionGranted, ret = %d", ret);
-	JavaENV->DeleteLocalRef(jStr);
-
-	JavaENVFinish();
-
+	LOGI(FWaveVRPlatformAndroid, "isPermissionGranted, ret = %d", ret);
 	return ret;
 }
 
 bool FWaveVRPlatformAndroid::ShouldPermissionGranted(std::string permission) {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return false;
-	}
-
-	if ((mPWclass == nullptr) || (mFUObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mPWclass or mPWObj is nullptr");
-		JavaENVFinish();
-		return false;
-	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mPWclass, "shouldGrantPermission", "(Ljava/lang/String;)Z");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "ERROR: shouldGrantPermission Method cant be found T_T ");
-		JavaENVFinish();
+	bool ret = false;
+	if (!FWaveVRJavaBridge::GetInstance()->ShouldGrantPermission(UTF8_TO_TCHAR(permission.c_str()), ret)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: shouldGrantPermission fails");
 		return false;
 	}
-	jstring jStr = JavaENV->NewStringUTF(permission.c_str());
-	bool ret = JavaENV->CallBooleanMethod(mPWObj, methodid, jStr);
-
-	LOGE(FWaveVRPlatformAndroid, "shouldGrantPermission, ret = %d", ret);
-	JavaENV->DeleteLocalRef(jStr);
-
-	JavaENVFinish();
-
+	LOGI(FWaveVRPlatformAndroid, "shouldGrantPermission, ret = %d", ret);
 	return ret;
 }
 
 bool FWaveVRPlatformAndroid::ShowDialogOnVRScene() {
-	if (!JavaENVCheck()) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: AndroidJavaENVCheck fails ");
-		return false;
-	}
-
-	if ((mPWclass == nullptr) || (mFUObject == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: mPWclass or mPWObj is nullptr");
-		JavaENVFinish();
+	bool ret = false;
+	if (!FWaveVRJavaBridge::GetInstance()->ShowDialogOnVRScene(ret)) {
+		LOGE(FWaveVRPlatformAndroid, "%s", "ERROR: showDialogOnVRScene fails");
 		return false;
 	}
-
-	jmethodID methodid = JavaENV->GetMethodID(mPWclass, "showDialogOnVRScene", "()Z");
-
-	if (!methodid)
-	{
-		LOGE(FWaveVRPlatformAndroid, "ERROR: showDialogOnVRScene Method cant be found T_T ");
-		JavaENVFinish();
-		return false;
-	}
-
-	bool ret = JavaENV->CallBooleanMethod(mPWObj, methodid);
-
-	LOGE(FWaveVRPlatformAndroid, "showDialogOnVRScene, ret = %d", ret);
-
-	JavaENVFinish();
-
+	LOGI(FWaveVRPlatformAndroid, "showDialogOnVRScene, ret = %d", ret);
 	return ret;
 }
 
-bool FWaveVRPlatformAndroid::JavaENVCheck() {
-	if ((JavaENV == nullptr) || (mJavaVM == nullptr)) {
-		LOGE(FWaveVRPlatformAndroid, "%s", "Cant find Java class/method.");
-		return false;
-	}
-
-	mJavaAttached = false;
-	switch (mJavaVM->GetEnv((void**)&JavaENV, JNI_VERSION_1_6)) {
-	case JNI_OK:
-		break;
-	case JNI_EDETACHED:
-		if (mJavaVM->AttachCurrentThread(&JavaENV, nullptr) != JNI_OK) {
-			LOGE(FWaveVRPlatformAndroid, "%s", "failed to attach current thread");
-			return false;
-		}
-		mJavaAttached = true;
-		break;
-	case JNI_EVERSION:
-		break;
-	}
-
-	return true;
-}
-
-void FWaveVRPlatformAndroid::JavaENVFinish() {
-	if (mJavaAttached) {
-		mJavaVM->DetachCurrentThread();
-	}
-}
-
 #endif //PLATFORM_ANDROID
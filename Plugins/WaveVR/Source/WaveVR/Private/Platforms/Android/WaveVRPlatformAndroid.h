@@ -27,10 +27,13 @@ public:
 	virtual bool GetInputButtonState(WVR_DeviceType type, WVR_InputId id) override;
 	virtual bool GetInputTouchState(WVR_DeviceType type, WVR_InputId id) override;
 	virtual WVR_Axis_t GetInputAnalogAxis(WVR_DeviceType type, WVR_InputId id) override;
+	virtual bool GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount) override;
+	virtual int32_t GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType) override;
 	virtual bool IsDeviceConnected(WVR_DeviceType type) override;
 	virtual uint32_t GetParameters(WVR_DeviceType type, const char* param, char* ret, uint32_t bufferSize) override;
 	virtual WVR_NumDoF GetDegreeOfFreedom(WVR_DeviceType type) override;
 	virtual float GetDeviceBatteryPercentage(WVR_DeviceType type) override;
+	virtual WVR_BatteryTemperatureStatus GetBatteryTemperatureStatus(WVR_DeviceType type) override;
 	virtual bool PollEventQueue(WVR_Event_t* event) override;
 
 	virtual bool GetRenderProps(WVR_RenderProps_t* props) override;
@@ -123,10 +126,5 @@ public:
 	virtual bool IsPermissionGranted(std::string permission) override;
 	virtual bool ShouldPermissionGranted(std::string permission) override;
 	virtual bool ShowDialogOnVRScene() override;
-
-private:
-	bool JavaENVCheck();
-	void JavaENVFinish();
-	bool mJavaAttached;
 #endif
 };
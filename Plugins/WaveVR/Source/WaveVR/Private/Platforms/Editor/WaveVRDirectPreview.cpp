@@ -13,8 +13,8 @@
 #include "Logging/LogMacros.h"
 #include "Platforms/DLLFunctionPointer.h"
 #include "WaveVRHMD.h"
-#include <chrono>
 #if WITH_EDITOR
+#include "Platforms/Editor/WaveVRDirectPreviewStream.h"
 #include "WaveVRDirectPreviewSettings.h"
 #include "Settings/LevelEditorPlaySettings.h"
 #endif
@@ -171,29 +171,30 @@ void WaveVRDirectPreview::ReportSimError(DP_InitError error)
 	}
 }
 
-uintptr_t latestNativeResource = 0;
-bool WaveVRDirectPreview::sendRTTexture(FRHICommandListImmediate& RHICmdList, void* NativeResource) {
+bool WaveVRDirectPreview::sendRTTexture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Texture) {
 	LOG_FUNC();
-	if (!mEnablePreviewImage) return false;
-	if (isInitialized) {
-		if (isTimeToUpdate()) {
-			void* rtPtr;
-			rtPtr = NativeResource;
-			if ((uintptr_t)NativeResource != latestNativeResource) {
-				UE_LOG(WVRDirectPreview, Display, TEXT(" Pointer has been changed, \"%" PRIxPTR "\""), NativeResource);
-				latestNativeResource = (uintptr_t)NativeResource;
-			}
-			static _WVR_SetRenderImageHandle funcPtr = nullptr;
-			if (mDllHandle != nullptr && funcPtr == nullptr)
-			{
-				FString procName = "WVR_SetRenderImageHandle";
-				funcPtr = (_WVR_SetRenderImageHandle)FPlatformProcess::GetDllExport(mDllHandle, *procName);
-			}
-			FUNC_CHECK();
-			FUNC_RUN_1(rtPtr);
-		}
+	if (!mEnablePreviewImage || !isInitialized || !mStream.IsValid())
+		return false;
+
+	void* rtPtr = mStream->Capture(RHICmdList, Texture);
+	if (rtPtr == nullptr)
+		return false;
+
+	static _WVR_SetRenderImageHandle funcPtr = nullptr;
+	if (mDllHandle != nullptr && funcPtr == nullptr)
+	{
+		FString procName = "WVR_SetRenderImageHandle";
+		funcPtr = (_WVR_SetRenderImageHandle)FPlatformProcess::GetDllExport(mDllHandle, *procName);
 	}
-	return false;
+	FUNC_CHECK();
+	if (funcPtr == nullptr)
+		return false;
+
+	// The DLL encodes and streams in this call.
+	const double start = FPlatformTime::Seconds();
+	bool ret = funcPtr(rtPtr);
+	mStream->OnSent(FPlatformTime::Seconds() - start);
+	return ret;
 }
 
 void WaveVRDirectPreview::ExportTexture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* TexRef2D)
@@ -429,21 +430,8 @@ void WaveVRDirectPreview::SetPrintCallback(PrintLog callback){
 
 void WaveVRDirectPreview::DllLog(const char* msg)
 {
-	FString str(msg);
-	LOGI(WVRDirectPreview, "%s", *str);
-}
-
-using namespace std::chrono;
-milliseconds latestUpdateTime;
-bool WaveVRDirectPreview::isTimeToUpdate() {
-	milliseconds ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-	if ((ms -latestUpdateTime) >= milliseconds(1000 / mFPS)) {
-		latestUpdateTime = ms;
-		return true;
-	}
-	else {
-		return false;
-	}
+	// Called by the DLL in every frame.  Keep it off the synchronous log.
+	TLOGI(WVRDirectPreview, "%s", msg);
 }
 
 DP_InitError WaveVRDirectPreview::ReadSettingsAndInit() {
@@ -494,6 +482,10 @@ DP_InitError WaveVRDirectPreview::ReadSettingsAndInit() {
 	LOGW(WVRDirectPreview, "readSettingsAndInit : ConntectType = %d , WifiIP = %s , EnablePreviewImage = %d , RegularlySaveImages = %d , FPS = %d",
 		 ConnectType, PLATFORM_CHAR(*DeviceWiFiIP), EnablePreviewImage, RegularlySaveImages , mFPS);
 
+	if (!mStream.IsValid())
+		mStream = MakeUnique<FWaveVRDirectPreviewStream>();
+	mStream->Reset(mFPS, (DP_ConnectType)ConnectType);
+
 #pragma warning(push)
 #pragma warning(disable: 4800)
 	error = SimulatorInit((DP_ConnectType)ConnectType, mWiFiIP, EnablePreviewImage, false, RegularlySaveImages);
@@ -17,6 +17,8 @@
 #include "DirectPreview/WaveVR_DirectPreview.h"
 #endif
 
+class FWaveVRDirectPreviewStream;
+
 class WAVEVR_API WaveVRDirectPreview : public FWaveVRAPIWrapper
 {
 public:
@@ -47,7 +49,8 @@ public:
 	static bool IsVRPreview();
 	static bool IsDirectPreview();
 	bool HookVRPreview();
-	bool sendRTTexture(FRHICommandListImmediate& RHICmdList, void* NativeResource);
+	// Render thread.  The texture is copied, and sent after the copy is done on GPU.
+	bool sendRTTexture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Texture);
 	void ExportTexture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* TexRef2D);
 
 #if WITH_EDITOR
@@ -55,10 +58,10 @@ private:
 	DP_InitError SimulatorInit(DP_ConnectType type, const char* IP, bool enablePreview, bool dllToFile, bool saveImage);
 	void SetPrintCallback(PrintLog callback);
 	void ReportSimError(DP_InitError error);
-	bool isTimeToUpdate();
 	DP_InitError ReadSettingsAndInit();
 	int mFPS = 60;
 	int mEnablePreviewImage = 0;
+	TUniquePtr<FWaveVRDirectPreviewStream> mStream;
 
 private:
 	static void DllLog(const char* msg);
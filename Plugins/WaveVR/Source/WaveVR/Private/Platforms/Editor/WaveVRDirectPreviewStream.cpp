@@ -0,0 +1,195 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "Platforms/Editor/WaveVRDirectPreviewStream.h"
+#include "WaveVRPrivatePCH.h"
+#include "RHICommandList.h"
+
+#if WITH_EDITOR
+
+DEFINE_LOG_CATEGORY_STATIC(WVRDirectPreviewStream, Log, All);
+
+static const double kStatsLogInterval = 5.0;
+static const double kEmaWeight = 0.1;
+
+FWaveVRDirectPreviewPacer::FWaveVRDirectPreviewPacer()
+	: MinInterval(1.0 / 60)
+	, MaxInterval(0.5)
+	, Interval(1.0 / 60)
+	, Headroom(1.2f)
+	, LastCaptureTime(0)
+	, SendCost(0)
+	, Age(0)
+	, Throughput(0)
+	, LastLogTime(0)
+	, SentCount(0)
+	, SkippedCount(0)
+{
+}
+
+void FWaveVRDirectPreviewPacer::Reset(int32 targetFps, DP_ConnectType type)
+{
+	MinInterval = 1.0 / FMath::Max(targetFps, 1);
+	Interval = MinInterval;
+	// WiFi has more jitter than USB.
+	switch (type)
+	{
+	case DP_ConnectType_USB:
+		Headroom = 1.2f;
+		break;
+	case DP_ConnectType_WiFi:
+		Headroom = 2.0f;
+		break;
+	default:
+		Headroom = 1.5f;
+		break;
+	}
+	LastCaptureTime = 0;
+	SendCost = Age = Throughput = 0;
+	LastLogTime = FPlatformTime::Seconds();
+	SentCount = SkippedCount = 0;
+}
+
+void FWaveVRDirectPreviewPacer::OnSent(double now, double sendSeconds, double age, uint64 bytes)
+{
+	SendCost = SendCost == 0 ? sendSeconds : FMath::Lerp(SendCost, sendSeconds, kEmaWeight);
+	Age = Age == 0 ? age : FMath::Lerp(Age, age, kEmaWeight);
+	if (sendSeconds > 0)
+		Throughput = FMath::Lerp(Throughput, bytes / sendSeconds, kEmaWeight);
+
+	// Additive decrease toward the link cost, multiplicative increase when frames get old.
+	const double target = FMath::Max(MinInterval, SendCost * Headroom);
+	if (Age > Interval * 2)
+		Interval = FMath::Min(Interval * 1.25, MaxInterval);
+	else
+		Interval = FMath::Max(target, Interval - MinInterval * 0.05);
+
+	SentCount++;
+	if (now - LastLogTime >= kStatsLogInterval)
+	{
+		const double elapsed = now - LastLogTime;
+		LOGD(WVRDirectPreviewStream, "Sent %.1f fps, skipped %u, interval %.1f ms, send %.2f ms, age %.2f ms, %.1f MB/s",
+			SentCount / elapsed, SkippedCount, Interval * 1000, SendCost * 1000, Age * 1000, Throughput / (1024 * 1024));
+		LastLogTime = now;
+		SentCount = SkippedCount = 0;
+	}
+}
+
+FWaveVRDirectPreviewStream::FWaveVRDirectPreviewStream()
+	: Size(0, 0)
+	, Format(PF_Unknown)
+	, Sending(INDEX_NONE)
+{
+	for (int32 i = 0; i < RingSize; i++)
+	{
+		Slots[i].State = ESlotState::Free;
+		Slots[i].CaptureTime = 0;
+	}
+}
+
+void FWaveVRDirectPreviewStream::Reset(int32 targetFps, DP_ConnectType type)
+{
+	LOGD(WVRDirectPreviewStream, "Reset() fps %d, connect type %d", targetFps, (int)type);
+	Pacer.Reset(targetFps, type);
+}
+
+bool FWaveVRDirectPreviewStream::EnsureSlots(FRHITexture2D* Source)
+{
+	const FIntPoint sourceSize(Source->GetSizeX(), Source->GetSizeY());
+	const EPixelFormat sourceFormat = Source->GetFormat();
+	if (sourceSize == Size && sourceFormat == Format && Slots[0].Texture.IsValid())
+		return true;
+
+	LOGD(WVRDirectPreviewStream, "EnsureSlots() %dx%d format %d", sourceSize.X, sourceSize.Y, (int)sourceFormat);
+	Size = sourceSize;
+	Format = sourceFormat;
+	Sending = INDEX_NONE;
+	for (int32 i = 0; i < RingSize; i++)
+	{
+		FRHIResourceCreateInfo CreateInfo;
+		FSlot& slot = Slots[i];
+		slot.Texture = RHICreateTexture2D(Size.X, Size.Y, Format, 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, CreateInfo);
+		if (!slot.Fence.IsValid())
+			slot.Fence = RHICreateGPUFence(TEXT("WaveVRDirectPreview"));
+		slot.Fence->Clear();
+		slot.State = ESlotState::Free;
+	}
+	return Slots[0].Texture.IsValid();
+}
+
+void* FWaveVRDirectPreviewStream::Capture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Source)
+{
+	check(IsInRenderingThread());
+	if (Source == nullptr || !EnsureSlots(Source))
+		return nullptr;
+
+	const double now = FPlatformTime::Seconds();
+
+	// Copy this frame into a free slot.
+	if (Pacer.IsTimeToCapture(now))
+	{
+		int32 free = INDEX_NONE;
+		for (int32 i = 0; i < RingSize && free == INDEX_NONE; i++)
+			if (Slots[i].State == ESlotState::Free)
+				free = i;
+
+		if (free != INDEX_NONE)
+		{
+			FSlot& slot = Slots[free];
+			RHICmdList.CopyTexture(Source, slot.Texture, FRHICopyTextureInfo());
+			slot.Fence->Clear();
+			RHICmdList.WriteGPUFence(slot.Fence);
+			slot.State = ESlotState::Copying;
+			slot.CaptureTime = now;
+			Pacer.OnCaptured(now);
+		}
+		else
+		{
+			Pacer.OnSkipped();
+		}
+	}
+
+	// Find the newest completed copy.  Older ones are outdated.
+	int32 newest = INDEX_NONE;
+	for (int32 i = 0; i < RingSize; i++)
+	{
+		FSlot& slot = Slots[i];
+		if (slot.State == ESlotState::Copying && slot.Fence->Poll())
+			slot.State = ESlotState::Ready;
+		if (slot.State == ESlotState::Ready && (newest == INDEX_NONE || slot.CaptureTime > Slots[newest].CaptureTime))
+			newest = i;
+	}
+	if (newest == INDEX_NONE)
+		return nullptr;
+
+	for (int32 i = 0; i < RingSize; i++)
+	{
+		if (i == newest)
+			continue;
+		if (Slots[i].State == ESlotState::Ready || Slots[i].State == ESlotState::Sent)
+			Slots[i].State = ESlotState::Free;
+	}
+
+	Slots[newest].State = ESlotState::Sent;
+	Sending = newest;
+	return Slots[newest].Texture->GetNativeResource();
+}
+
+void FWaveVRDirectPreviewStream::OnSent(double sendSeconds)
+{
+	if (Sending == INDEX_NONE)
+		return;
+	const double now = FPlatformTime::Seconds();
+	const uint64 bytes = (uint64)Size.X * Size.Y * GPixelFormats[Format].BlockBytes;
+	Pacer.OnSent(now, sendSeconds, now - Slots[Sending].CaptureTime, bytes);
+	Sending = INDEX_NONE;
+}
+
+#endif
@@ -0,0 +1,110 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHI.h"
+#include "RHIResources.h"
+
+#if WITH_EDITOR
+#include "DirectPreview/WaveVR_DirectPreview.h"
+
+/**
+ * Decide when DirectPreview captures the next frame.
+ *
+ * The DLL encodes and streams the image in WVR_SetRenderImageHandle, so the cost of that call
+ * is the cost of the link.  The interval follows the cost with a headroom of the connect type,
+ * and backs off when the frames get old before they are sent, which means the GPU or the link
+ * can not keep up.  It never goes below the interval of the UpdateFrequency setting.
+ */
+class FWaveVRDirectPreviewPacer
+{
+public:
+	FWaveVRDirectPreviewPacer();
+
+	void Reset(int32 targetFps, DP_ConnectType type);
+
+	bool IsTimeToCapture(double now) const { return now - LastCaptureTime >= Interval; }
+	void OnCaptured(double now) { LastCaptureTime = now; }
+	void OnSkipped() { SkippedCount++; }
+
+	// sendSeconds is the time of the DLL call, and age is from the capture to the send.
+	void OnSent(double now, double sendSeconds, double age, uint64 bytes);
+
+	double GetInterval() const { return Interval; }
+
+private:
+	double MinInterval;
+	double MaxInterval;
+	double Interval;
+	float Headroom;
+	double LastCaptureTime;
+
+	// Exponential moving averages
+	double SendCost;
+	double Age;
+	double Throughput;  // Bytes per second handed to the link
+
+	double LastLogTime;
+	uint32 SentCount;
+	uint32 SkippedCount;
+};
+
+/**
+ * Ring of copies of the render target for DirectPreview, in render thread.
+ *
+ * The frame is copied by the GPU into a free slot, and a fence is written after the copy.  A slot
+ * is only handed to the DLL after its fence passed, so the render thread never waits for the GPU.
+ * The slot last handed to the DLL is kept until another one is sent, because the DLL may still be
+ * reading it.  If no slot is free the frame is skipped.
+ */
+class FWaveVRDirectPreviewStream
+{
+public:
+	static const int32 RingSize = 3;
+
+	FWaveVRDirectPreviewStream();
+
+	void Reset(int32 targetFps, DP_ConnectType type);
+
+	// Return the native resource of the newest completed copy which was not sent, or nullptr.
+	void* Capture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Source);
+
+	// Report the result of sending the resource returned by Capture().
+	void OnSent(double sendSeconds);
+
+private:
+	enum class ESlotState : uint8
+	{
+		Free,
+		Copying,
+		Ready,
+		Sent,
+	};
+
+	struct FSlot
+	{
+		FTexture2DRHIRef Texture;
+		FGPUFenceRHIRef Fence;
+		ESlotState State;
+		double CaptureTime;
+	};
+
+	bool EnsureSlots(FRHITexture2D* Source);
+
+	FSlot Slots[RingSize];
+	FIntPoint Size;
+	EPixelFormat Format;
+	int32 Sending;  // Slot returned by Capture(), INDEX_NONE if none
+
+	FWaveVRDirectPreviewPacer Pacer;
+};
+#endif
@@ -0,0 +1,357 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "Platforms/Replay/WaveVRPlatformRecorder.h"
+#include "WaveVRPrivatePCH.h"
+#include "HAL/FileManager.h"
+#include "Misc/ScopeLock.h"
+#include "Platforms/WaveVRLogWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRRecorder, Log, All);
+
+// Flush to file when the buffer is larger than this.
+static const int32 RecorderFlushSize = 256 * 1024;
+
+FWaveVRPlatformRecorder::FWaveVRPlatformRecorder(FWaveVRAPIWrapper * inner, const FString& path)
+	: Inner(inner)
+	, File(nullptr)
+	, Path(path)
+	, StartTime(FPlatformTime::Seconds())
+	, StartFrame(GFrameNumber)
+	, RecordCount(0)
+{
+	LOG_FUNC();
+	check(Inner);
+
+	File = IFileManager::Get().CreateFileWriter(*Path);
+	if (File == nullptr) {
+		LOGE(WVRRecorder, "Fail to create trace file %s", PLATFORM_CHAR(*Path));
+		return;
+	}
+	LOGI(WVRRecorder, "Record runtime traffic to %s", PLATFORM_CHAR(*Path));
+
+	Buffer.Reserve(RecorderFlushSize + 4096);
+
+	// Runtime version is filled when Init().  The header will be rewritten then.
+	FWaveVRTraceFileHeader header = {};
+	header.magic = WVR_TRACE_MAGIC;
+	header.version = WVR_TRACE_VERSION;
+	header.headerSize = sizeof(FWaveVRTraceRecordHeader);
+	File->Serialize(&header, sizeof(header));
+}
+
+FWaveVRPlatformRecorder::~FWaveVRPlatformRecorder()
+{
+	LOG_FUNC();
+	Flush();
+	if (File) {
+		File->Close();
+		delete File;
+		File = nullptr;
+	}
+	delete Inner;
+	Inner = nullptr;
+}
+
+void FWaveVRPlatformRecorder::Flush()
+{
+	FScopeLock lock(&Lock);
+	FlushLocked();
+	if (File)
+		File->Flush();
+}
+
+void FWaveVRPlatformRecorder::FlushLocked()
+{
+	if (File && Buffer.Num() > 0)
+		File->Serialize(Buffer.GetData(), Buffer.Num());
+	Buffer.Reset();
+}
+
+void FWaveVRPlatformRecorder::Write(EWaveVRTraceRecord type, uint8 arg0, uint16 arg1, const void * payload, uint32 size)
+{
+	Write(type, arg0, arg1, payload, size, nullptr, 0);
+}
+
+void FWaveVRPlatformRecorder::Write(EWaveVRTraceRecord type, uint8 arg0, uint16 arg1, const void * payload0, uint32 size0, const void * payload1, uint32 size1, const void * payload2, uint32 size2)
+{
+	if (File == nullptr)
+		return;
+
+	FWaveVRTraceRecordHeader header;
+	header.type = (uint8)type;
+	header.arg0 = arg0;
+	header.arg1 = arg1;
+	header.size = size0 + size1 + size2;
+	header.timeNs = (int64)((FPlatformTime::Seconds() - StartTime) * 1e9);
+	header.frame = GFrameNumber - StartFrame;
+
+	FScopeLock lock(&Lock);
+	int32 offset = Buffer.AddUninitialized(sizeof(header) + header.size);
+	uint8 * dst = Buffer.GetData() + offset;
+	FMemory::Memcpy(dst, &header, sizeof(header));
+	dst += sizeof(header);
+	if (size0) { FMemory::Memcpy(dst, payload0, size0); dst += size0; }
+	if (size1) { FMemory::Memcpy(dst, payload1, size1); dst += size1; }
+	if (size2) { FMemory::Memcpy(dst, payload2, size2); }
+	RecordCount++;
+
+	if (Buffer.Num() > RecorderFlushSize)
+		FlushLocked();
+}
+
+void FWaveVRPlatformRecorder::WriteIfChanged(EWaveVRTraceRecord type, uint8 arg0, uint16 arg1, const void * payload, uint32 size)
+{
+	if (File == nullptr)
+		return;
+
+	const uint32 key = ((uint32)type << 24) | ((uint32)arg0 << 16) | arg1;
+	{
+		FScopeLock lock(&Lock);
+		TArray<uint8>& last = LastStates.FindOrAdd(key);
+		if (last.Num() == size && FMemory::Memcmp(last.GetData(), payload, size) == 0)
+			return;
+		last.SetNumUninitialized(size);
+		FMemory::Memcpy(last.GetData(), payload, size);
+	}
+	Write(type, arg0, arg1, payload, size);
+}
+
+/* Recorded */
+
+WVR_InitError FWaveVRPlatformRecorder::Init(WVR_AppType type) {
+	WVR_InitError ret = Inner->Init(type);
+
+	FScopeLock lock(&Lock);
+	if (File && ret == WVR_InitError_None) {
+		// Rewrite the header with the runtime version.
+		FWaveVRTraceFileHeader header = {};
+		header.magic = WVR_TRACE_MAGIC;
+		header.version = WVR_TRACE_VERSION;
+		header.headerSize = sizeof(FWaveVRTraceRecordHeader);
+		header.runtimeVersion = Inner->GetWaveRuntimeVersion();
+		FlushLocked();
+		int64 pos = File->Tell();
+		File->Seek(0);
+		File->Serialize(&header, sizeof(header));
+		File->Seek(pos);
+	}
+	return ret;
+}
+
+void FWaveVRPlatformRecorder::Quit() {
+	Inner->Quit();
+	Flush();
+	LOGI(WVRRecorder, "Recorded %u records", RecordCount);
+}
+
+void FWaveVRPlatformRecorder::GetSyncPose(WVR_PoseOriginModel originModel, WVR_DevicePosePair_t* retPose, uint32_t PoseCount) {
+	Inner->GetSyncPose(originModel, retPose, PoseCount);
+	if (retPose != nullptr && PoseCount > 0)
+		Write(EWaveVRTraceRecord::SyncPose, 0, (uint16)originModel, retPose, sizeof(WVR_DevicePosePair_t) * PoseCount);
+}
+
+void FWaveVRPlatformRecorder::GetPoseState(WVR_DeviceType type, WVR_PoseOriginModel originModel, uint32_t predictedMilliSec, WVR_PoseState_t *poseState) {
+	Inner->GetPoseState(type, originModel, predictedMilliSec, poseState);
+	if (poseState != nullptr)
+		Write(EWaveVRTraceRecord::PoseState, (uint8)type, (uint16)originModel, poseState, sizeof(WVR_PoseState_t));
+}
+
+bool FWaveVRPlatformRecorder::GetInputButtonState(WVR_DeviceType type, WVR_InputId id) {
+	bool ret = Inner->GetInputButtonState(type, id);
+	uint8 value = ret ? 1 : 0;
+	WriteIfChanged(EWaveVRTraceRecord::Button, (uint8)type, (uint16)id, &value, sizeof(value));
+	return ret;
+}
+
+bool FWaveVRPlatformRecorder::GetInputTouchState(WVR_DeviceType type, WVR_InputId id) {
+	bool ret = Inner->GetInputTouchState(type, id);
+	uint8 value = ret ? 1 : 0;
+	WriteIfChanged(EWaveVRTraceRecord::Touch, (uint8)type, (uint16)id, &value, sizeof(value));
+	return ret;
+}
+
+WVR_Axis_t FWaveVRPlatformRecorder::GetInputAnalogAxis(WVR_DeviceType type, WVR_InputId id) {
+	WVR_Axis_t ret = Inner->GetInputAnalogAxis(type, id);
+	WriteIfChanged(EWaveVRTraceRecord::Axis, (uint8)type, (uint16)id, &ret, sizeof(ret));
+	return ret;
+}
+
+bool FWaveVRPlatformRecorder::IsDeviceConnected(WVR_DeviceType type) {
+	bool ret = Inner->IsDeviceConnected(type);
+	uint8 value = ret ? 1 : 0;
+	WriteIfChanged(EWaveVRTraceRecord::DeviceConnected, (uint8)type, 0, &value, sizeof(value));
+	return ret;
+}
+
+bool FWaveVRPlatformRecorder::GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount) {
+	bool ret = Inner->GetInputDeviceState(type, inputType, buttons, touches, analogArray, analogArrayCount);
+	if (!ret)
+		return ret;
+
+	// Only the requested parts are valid.  The replay applies the parts in arg1.
+	uint32 recorded = inputType;
+	uint32 state[2] = { 0, 0 };
+	if ((inputType & WVR_InputType_Button) && buttons != nullptr)
+		state[0] = *buttons;
+	else
+		recorded &= ~WVR_InputType_Button;
+	if ((inputType & WVR_InputType_Touch) && touches != nullptr)
+		state[1] = *touches;
+	else
+		recorded &= ~WVR_InputType_Touch;
+	if (!(inputType & WVR_InputType_Analog) || analogArray == nullptr)
+		recorded &= ~WVR_InputType_Analog;
+	const uint32 analogSize = (recorded & WVR_InputType_Analog) ? analogArrayCount * sizeof(WVR_AnalogState_t) : 0;
+
+	TArray<uint8, TInlineAllocator<256>> payload;
+	payload.SetNumUninitialized(sizeof(state) + analogSize);
+	FMemory::Memcpy(payload.GetData(), state, sizeof(state));
+	if (analogSize)
+		FMemory::Memcpy(payload.GetData() + sizeof(state), analogArray, analogSize);
+	WriteIfChanged(EWaveVRTraceRecord::InputDeviceState, (uint8)type, (uint16)recorded, payload.GetData(), payload.Num());
+	return ret;
+}
+
+int32_t FWaveVRPlatformRecorder::GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType) {
+	int32_t ret = Inner->GetInputTypeCount(type, inputType);
+	int32 value = (int32)ret;
+	WriteIfChanged(EWaveVRTraceRecord::InputTypeCount, (uint8)type, (uint16)inputType, &value, sizeof(value));
+	return ret;
+}
+
+WVR_BatteryTemperatureStatus FWaveVRPlatformRecorder::GetBatteryTemperatureStatus(WVR_DeviceType type) {
+	WVR_BatteryTemperatureStatus ret = Inner->GetBatteryTemperatureStatus(type);
+	int32 value = (int32)ret;
+	WriteIfChanged(EWaveVRTraceRecord::BatteryTemperature, (uint8)type, 0, &value, sizeof(value));
+	return ret;
+}
+
+bool FWaveVRPlatformRecorder::PollEventQueue(WVR_Event_t* event) {
+	bool ret = Inner->PollEventQueue(event);
+	if (ret && event != nullptr)
+		Write(EWaveVRTraceRecord::Event, 0, 0, event, sizeof(WVR_Event_t));
+	return ret;
+}
+
+bool FWaveVRPlatformRecorder::IsInputFocusCapturedBySystem() {
+	bool ret = Inner->IsInputFocusCapturedBySystem();
+	uint8 value = ret ? 1 : 0;
+	WriteIfChanged(EWaveVRTraceRecord::InputFocus, 0, 0, &value, sizeof(value));
+	return ret;
+}
+
+WVR_Result FWaveVRPlatformRecorder::GetHandGestureData(WVR_HandGestureData *data) {
+	WVR_Result ret = Inner->GetHandGestureData(data);
+	int32 result = (int32)ret;
+	if (data != nullptr)
+		Write(EWaveVRTraceRecord::HandGesture, 0, 0, &result, sizeof(result), data, sizeof(WVR_HandGestureData_t));
+	return ret;
+}
+
+WVR_Result FWaveVRPlatformRecorder::GetHandTrackingData(WVR_HandSkeletonData_t *skeleton, WVR_HandPoseData_t* pose, WVR_PoseOriginModel type) {
+	WVR_Result ret = Inner->GetHandTrackingData(skeleton, pose, type);
+	int32 result = (int32)ret;
+	if (skeleton != nullptr)
+		Write(EWaveVRTraceRecord::HandTracking, pose != nullptr ? 1 : 0, (uint16)type,
+			&result, sizeof(result), skeleton, sizeof(WVR_HandSkeletonData_t),
+			pose, pose != nullptr ? sizeof(WVR_HandPoseData_t) : 0);
+	return ret;
+}
+
+/* Forward only */
+
+uint64_t FWaveVRPlatformRecorder::GetSupportedFeatures() { return Inner->GetSupportedFeatures(); }
+void FWaveVRPlatformRecorder::SetPosePredictEnabled(WVR_DeviceType type, bool enabled_position_predict, bool enabled_rotation_predict) { Inner->SetPosePredictEnabled(type, enabled_position_predict, enabled_rotation_predict); }
+uint32_t FWaveVRPlatformRecorder::GetParameters(WVR_DeviceType type, const char* param, char* ret, uint32_t bufferSize) { return Inner->GetParameters(type, param, ret, bufferSize); }
+WVR_NumDoF FWaveVRPlatformRecorder::GetDegreeOfFreedom(WVR_DeviceType type) { return Inner->GetDegreeOfFreedom(type); }
+float FWaveVRPlatformRecorder::GetDeviceBatteryPercentage(WVR_DeviceType type) { return Inner->GetDeviceBatteryPercentage(type); }
+bool FWaveVRPlatformRecorder::GetRenderProps(WVR_RenderProps_t* props) { return Inner->GetRenderProps(props); }
+bool FWaveVRPlatformRecorder::SetInputRequest(WVR_DeviceType type, const WVR_InputAttribute* request, uint32_t size) { return Inner->SetInputRequest(type, request, size); }
+bool FWaveVRPlatformRecorder::SetInteractionMode(WVR_InteractionMode mode) { return Inner->SetInteractionMode(mode); }
+WVR_InteractionMode FWaveVRPlatformRecorder::GetInteractionMode() { return Inner->GetInteractionMode(); }
+bool FWaveVRPlatformRecorder::SetGazeTriggerType(WVR_GazeTriggerType type) { return Inner->SetGazeTriggerType(type); }
+WVR_GazeTriggerType FWaveVRPlatformRecorder::GetGazeTriggerType() { return Inner->GetGazeTriggerType(); }
+void FWaveVRPlatformRecorder::SetNeckModelEnabled(bool enabled) { Inner->SetNeckModelEnabled(enabled); }
+WVR_DeviceType FWaveVRPlatformRecorder::GetDefaultControllerRole() { return Inner->GetDefaultControllerRole(); }
+void FWaveVRPlatformRecorder::SetArmSticky(bool stickyArm) { Inner->SetArmSticky(stickyArm); }
+void FWaveVRPlatformRecorder::SetArmModel(WVR_SimulationType type) { Inner->SetArmModel(type); }
+void FWaveVRPlatformRecorder::InAppRecenter(WVR_RecenterType recenterType) { Inner->InAppRecenter(recenterType); }
+void FWaveVRPlatformRecorder::SetArenaVisible(WVR_ArenaVisible config) { Inner->SetArenaVisible(config); }
+bool FWaveVRPlatformRecorder::StartCamera(WVR_CameraInfo_t *info) { return Inner->StartCamera(info); }
+void FWaveVRPlatformRecorder::StopCamera() { Inner->StopCamera(); }
+bool FWaveVRPlatformRecorder::GetCameraFrameBuffer(uint8_t *pframebuffer, uint32_t frameBufferSize) { return Inner->GetCameraFrameBuffer(pframebuffer, frameBufferSize); }
+bool FWaveVRPlatformRecorder::RequestScreenshot(uint32_t width, uint32_t height, WVR_ScreenshotMode mode, const char* filename) { return Inner->RequestScreenshot(width, height, mode, filename); }
+uint32_t FWaveVRPlatformRecorder::GetWaveRuntimeVersion() { return Inner->GetWaveRuntimeVersion(); }
+bool FWaveVRPlatformRecorder::GetInputMappingPair(WVR_DeviceType type, WVR_InputId destination, WVR_InputMappingPair* pair) { return Inner->GetInputMappingPair(type, destination, pair); }
+uint32_t FWaveVRPlatformRecorder::GetInputMappingTable(WVR_DeviceType type, WVR_InputMappingPair* table, uint32_t size) { return Inner->GetInputMappingTable(type, table, size); }
+void FWaveVRPlatformRecorder::TriggerVibration(WVR_DeviceType type, WVR_InputId id, uint32_t durationMicroSec, uint32_t frequency, WVR_Intensity intensity) { Inner->TriggerVibration(type, id, durationMicroSec, frequency, intensity); }
+void FWaveVRPlatformRecorder::SetParameters(WVR_DeviceType type, const char *pchValue) { Inner->SetParameters(type, pchValue); }
+
+WVR_Result FWaveVRPlatformRecorder::StartHandGesture() { return Inner->StartHandGesture(); }
+void FWaveVRPlatformRecorder::StopHandGesture() { Inner->StopHandGesture(); }
+WVR_Result FWaveVRPlatformRecorder::StartHandTracking() { return Inner->StartHandTracking(); }
+void FWaveVRPlatformRecorder::StopHandTracking() { Inner->StopHandTracking(); }
+
+WVR_RenderError FWaveVRPlatformRecorder::RenderInit(const WVR_RenderInitParams_t* param) { return Inner->RenderInit(param); }
+WVR_Matrix4f_t FWaveVRPlatformRecorder::GetTransformFromEyeToHead(WVR_Eye eye, WVR_NumDoF dof) { return Inner->GetTransformFromEyeToHead(eye, dof); }
+WVR_SubmitError FWaveVRPlatformRecorder::SubmitFrame(WVR_Eye eye, const WVR_TextureParams_t *param, const WVR_PoseState_t* pose, WVR_SubmitExtend extendMethod) { return Inner->SubmitFrame(eye, param, pose, extendMethod); }
+WVR_TextureQueueHandle_t FWaveVRPlatformRecorder::ObtainTextureQueue(WVR_TextureTarget target, WVR_TextureFormat format, WVR_TextureType type, uint32_t width, uint32_t height, int32_t level) { return Inner->ObtainTextureQueue(target, format, type, width, height, level); }
+uint32_t FWaveVRPlatformRecorder::GetTextureQueueLength(WVR_TextureQueueHandle_t handle) { return Inner->GetTextureQueueLength(handle); }
+int32_t FWaveVRPlatformRecorder::GetAvailableTextureIndex(WVR_TextureQueueHandle_t handle) { return Inner->GetAvailableTextureIndex(handle); }
+WVR_TextureParams_t FWaveVRPlatformRecorder::GetTexture(WVR_TextureQueueHandle_t handle, int32_t index) { return Inner->GetTexture(handle, index); }
+void FWaveVRPlatformRecorder::ReleaseTextureQueue(WVR_TextureQueueHandle_t handle) { Inner->ReleaseTextureQueue(handle); }
+bool FWaveVRPlatformRecorder::IsRenderFoveationSupport() { return Inner->IsRenderFoveationSupport(); }
+bool FWaveVRPlatformRecorder::IsRenderFoveationEnabled() { return Inner->IsRenderFoveationEnabled(); }
+WVR_Result FWaveVRPlatformRecorder::RenderFoveationMode(WVR_FoveationMode mode) { return Inner->RenderFoveationMode(mode); }
+WVR_Result FWaveVRPlatformRecorder::SetFoveationConfig(const WVR_Eye eye, const WVR_RenderFoveationParams_t *foveatedParam) { return Inner->SetFoveationConfig(eye, foveatedParam); }
+WVR_Result FWaveVRPlatformRecorder::GetFoveationDefaultConfig(const WVR_Eye eye, WVR_RenderFoveationParams_t *foveatedParam) { return Inner->GetFoveationDefaultConfig(eye, foveatedParam); }
+bool FWaveVRPlatformRecorder::IsAdaptiveQualityEnabled() { return Inner->IsAdaptiveQualityEnabled(); }
+bool FWaveVRPlatformRecorder::EnableAdaptiveQuality(bool enable, uint32_t strategyFlags) { return Inner->EnableAdaptiveQuality(enable, strategyFlags); }
+void FWaveVRPlatformRecorder::GetRenderTargetSize(uint32_t* width, uint32_t * height) { Inner->GetRenderTargetSize(width, height); }
+void FWaveVRPlatformRecorder::GetClippingPlaneBoundary(WVR_Eye eye, float * left, float * right, float * top, float * bottom) { Inner->GetClippingPlaneBoundary(eye, left, right, top, bottom); }
+void FWaveVRPlatformRecorder::PreRenderEye(WVR_Eye eye, const WVR_TextureParams_t *textureParam, const WVR_RenderFoveationParams_t* foveatedParam) { Inner->PreRenderEye(eye, textureParam, foveatedParam); }
+
+WVR_OverlayError FWaveVRPlatformRecorder::GenOverlay(int32_t *overlayId) { return Inner->GenOverlay(overlayId); }
+WVR_OverlayError FWaveVRPlatformRecorder::DelOverlay(int32_t overlayId) { return Inner->DelOverlay(overlayId); }
+WVR_OverlayError FWaveVRPlatformRecorder::SetOverlayTextureId(int32_t overlayId, const WVR_OverlayTexture_t *texture) { return Inner->SetOverlayTextureId(overlayId, texture); }
+WVR_OverlayError FWaveVRPlatformRecorder::SetOverlayFixedPosition(int32_t overlayId, const WVR_OverlayPosition_t *position) { return Inner->SetOverlayFixedPosition(overlayId, position); }
+WVR_OverlayError FWaveVRPlatformRecorder::ShowOverlay(int32_t overlayId) { return Inner->ShowOverlay(overlayId); }
+WVR_OverlayError FWaveVRPlatformRecorder::HideOverlay(int32_t overlayId) { return Inner->HideOverlay(overlayId); }
+bool FWaveVRPlatformRecorder::IsOverlayValid(int32_t overlayId) { return Inner->IsOverlayValid(overlayId); }
+
+bool FWaveVRPlatformRecorder::IsATWActive() { return Inner->IsATWActive(); }
+void FWaveVRPlatformRecorder::SetATWActive(bool isActive, void *anativeWindow) { Inner->SetATWActive(isActive, anativeWindow); }
+void FWaveVRPlatformRecorder::PauseATW() { Inner->PauseATW(); }
+void FWaveVRPlatformRecorder::ResumeATW() { Inner->ResumeATW(); }
+void FWaveVRPlatformRecorder::OnDisable() { Inner->OnDisable(); }
+void FWaveVRPlatformRecorder::OnApplicationQuit() { Inner->OnApplicationQuit(); Flush(); }
+void FWaveVRPlatformRecorder::SetRenderThreadId(int tid) { Inner->SetRenderThreadId(tid); }
+WVR_TextureQueueHandle_t FWaveVRPlatformRecorder::StoreRenderTextures(void ** texturesIDs, int size, bool eEye) { return Inner->StoreRenderTextures(texturesIDs, size, eEye); }
+void FWaveVRPlatformRecorder::GetStencilMesh(WVR_Eye eye, uint32_t* vertexCount, uint32_t* triangleCount, uint32_t floatArrayCount, float* vertexData, uint32_t intArrayCount, int* indexData) { Inner->GetStencilMesh(eye, vertexCount, triangleCount, floatArrayCount, vertexData, intArrayCount, indexData); }
+void FWaveVRPlatformRecorder::SetFocusedController(WVR_DeviceType focusedController) { Inner->SetFocusedController(focusedController); }
+WVR_DeviceType FWaveVRPlatformRecorder::GetFocusedController() { return Inner->GetFocusedController(); }
+
+std::string FWaveVRPlatformRecorder::GetStringBySystemLanguage(std::string str) { return Inner->GetStringBySystemLanguage(str); }
+std::string FWaveVRPlatformRecorder::GetStringByLanguage(std::string str, std::string lang, std::string country) { return Inner->GetStringByLanguage(str, lang, country); }
+std::string FWaveVRPlatformRecorder::GetSystemLanguage() { return Inner->GetSystemLanguage(); }
+std::string FWaveVRPlatformRecorder::GetSystemCountry() { return Inner->GetSystemCountry(); }
+std::string FWaveVRPlatformRecorder::GetOEMConfigRawData(std::string key) { return Inner->GetOEMConfigRawData(key); }
+std::string FWaveVRPlatformRecorder::DeployRenderModelAssets(int deviceIndex, std::string renderModelName) { return Inner->DeployRenderModelAssets(deviceIndex, renderModelName); }
+std::string FWaveVRPlatformRecorder::GetRootRelativePath() { return Inner->GetRootRelativePath(); }
+
+bool FWaveVRPlatformRecorder::RequestPermissions(std::vector<std::string> permissions) { return Inner->RequestPermissions(permissions); }
+bool FWaveVRPlatformRecorder::RequestUsbPermission() { return Inner->RequestUsbPermission(); }
+bool FWaveVRPlatformRecorder::IsPermissionGranted(std::string permission) { return Inner->IsPermissionGranted(permission); }
+bool FWaveVRPlatformRecorder::ShouldPermissionGranted(std::string permission) { return Inner->ShouldPermissionGranted(permission); }
+bool FWaveVRPlatformRecorder::ShowDialogOnVRScene() { return Inner->ShowDialogOnVRScene(); }
+
+bool FWaveVRPlatformRecorder::LoadLibraries() { return Inner->LoadLibraries(); }
+void FWaveVRPlatformRecorder::UnLoadLibraries() { Flush(); Inner->UnLoadLibraries(); }
@@ -0,0 +1,414 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "Platforms/Replay/WaveVRPlatformReplay.h"
+#include "WaveVRPrivatePCH.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Platforms/WaveVRLogWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRReplay, Log, All);
+
+FWaveVRPlatformReplay::FWaveVRPlatformReplay(const FString& path, EMode mode, bool loop, bool exitWhenFinished)
+	: Path(path)
+	, Mode(mode)
+	, bLoop(loop)
+	, bExitWhenFinished(exitWhenFinished)
+	, bLoaded(false)
+	, bFinished(false)
+	, NextRecord(0)
+	, LastGameFrame(0)
+	, ReplayFrame(0)
+	, ReplayStartTime(0)
+	, ReplayedFrames(0)
+	, FirstAdvanceTime(0)
+	, NextEvent(0)
+	, bInputFocusCaptured(false)
+	, GestureResult(WVR_Error_FeatureNotSupport)
+	, HandTrackingResult(WVR_Error_FeatureNotSupport)
+	, bHasHandPose(false)
+{
+	LOG_FUNC();
+	FMemory::Memzero(FileHeader);
+	FMemory::Memzero(Gesture);
+	FMemory::Memzero(HandSkeleton);
+	FMemory::Memzero(HandPose);
+	bLoaded = Load();
+}
+
+FWaveVRPlatformReplay::~FWaveVRPlatformReplay()
+{
+	LOG_FUNC();
+}
+
+bool FWaveVRPlatformReplay::Load()
+{
+	if (!FFileHelper::LoadFileToArray(Data, *Path)) {
+		LOGE(WVRReplay, "Fail to read trace %s", PLATFORM_CHAR(*Path));
+		return false;
+	}
+
+	if (Data.Num() < (int32)sizeof(FWaveVRTraceFileHeader)) {
+		LOGE(WVRReplay, "Trace is too small");
+		return false;
+	}
+	FMemory::Memcpy(&FileHeader, Data.GetData(), sizeof(FileHeader));
+	if (FileHeader.magic != WVR_TRACE_MAGIC || FileHeader.version != WVR_TRACE_VERSION || FileHeader.headerSize != sizeof(FWaveVRTraceRecordHeader)) {
+		LOGE(WVRReplay, "Trace format not match.  magic=%x version=%u", FileHeader.magic, FileHeader.version);
+		return false;
+	}
+
+	// Index the records.  A truncated tail is dropped.
+	int32 offset = sizeof(FWaveVRTraceFileHeader);
+	while (offset + (int32)sizeof(FWaveVRTraceRecordHeader) <= Data.Num()) {
+		FWaveVRTraceRecordHeader header;
+		FMemory::Memcpy(&header, Data.GetData() + offset, sizeof(header));
+		int32 next = offset + sizeof(header) + header.size;
+		if (next > Data.Num())
+			break;
+		RecordOffsets.Add(offset);
+		offset = next;
+	}
+
+	LOGI(WVRReplay, "Replay %s: %d records, runtime version %u, mode %s", PLATFORM_CHAR(*Path), RecordOffsets.Num(),
+		FileHeader.runtimeVersion, Mode == EMode::RealTime ? "RealTime" : "AsFastAsPossible");
+	return RecordOffsets.Num() > 0;
+}
+
+void FWaveVRPlatformReplay::Restart()
+{
+	NextRecord = 0;
+	ReplayFrame = 0;
+	ReplayStartTime = FPlatformTime::Seconds();
+}
+
+void FWaveVRPlatformReplay::Advance()
+{
+	if (!bLoaded || !IsInGameThread() || GFrameNumber == LastGameFrame)
+		return;
+
+	if (LastGameFrame == 0) {
+		Restart();
+		FirstAdvanceTime = ReplayStartTime;
+	} else {
+		ReplayFrame++;
+	}
+	LastGameFrame = GFrameNumber;
+	if (bFinished)
+		return;
+	ReplayedFrames++;
+
+	const int64 elapsedNs = (int64)((FPlatformTime::Seconds() - ReplayStartTime) * 1e9);
+
+	FScopeLock lock(&Lock);
+	while (NextRecord < RecordOffsets.Num()) {
+		const uint8 * record = Data.GetData() + RecordOffsets[NextRecord];
+		FWaveVRTraceRecordHeader header;
+		FMemory::Memcpy(&header, record, sizeof(header));
+
+		bool due = Mode == EMode::RealTime ? header.timeNs <= elapsedNs : header.frame <= ReplayFrame;
+		if (!due)
+			break;
+
+		ApplyRecord(header, record + sizeof(header));
+		NextRecord++;
+	}
+
+	if (NextRecord >= RecordOffsets.Num()) {
+		if (bLoop) {
+			Restart();
+		} else {
+			bFinished = true;
+			double elapsed = FPlatformTime::Seconds() - FirstAdvanceTime;
+			LOGI(WVRReplay, "Replay finished: %u frames in %.3fs, avg %.3fms per frame",
+				ReplayedFrames, elapsed, ReplayedFrames > 0 ? elapsed * 1000.0 / ReplayedFrames : 0.0);
+			if (bExitWhenFinished)
+				FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+// A payload size not matching its record type is from a truncated or broken trace.
+static bool IsPayloadSizeValid(const FWaveVRTraceRecordHeader& header)
+{
+	const uint32 handTrackingSize = sizeof(int32) + sizeof(WVR_HandSkeletonData_t);
+	switch ((EWaveVRTraceRecord)header.type) {
+	case EWaveVRTraceRecord::SyncPose:
+		return header.size % sizeof(WVR_DevicePosePair_t) == 0;
+	case EWaveVRTraceRecord::PoseState:
+		return header.size == sizeof(WVR_PoseState_t);
+	case EWaveVRTraceRecord::Event:
+		return header.size == sizeof(WVR_Event_t);
+	case EWaveVRTraceRecord::Button:
+	case EWaveVRTraceRecord::Touch:
+	case EWaveVRTraceRecord::DeviceConnected:
+	case EWaveVRTraceRecord::InputFocus:
+		return header.size == sizeof(uint8);
+	case EWaveVRTraceRecord::Axis:
+		return header.size == sizeof(WVR_Axis_t);
+	case EWaveVRTraceRecord::BatteryTemperature:
+		return header.size == sizeof(int32);
+	case EWaveVRTraceRecord::HandGesture:
+		return header.size == sizeof(int32) + sizeof(WVR_HandGestureData_t);
+	case EWaveVRTraceRecord::InputDeviceState:
+		return header.size >= 2 * sizeof(uint32) && (header.size - 2 * sizeof(uint32)) % sizeof(WVR_AnalogState_t) == 0;
+	case EWaveVRTraceRecord::InputTypeCount:
+		return header.size == sizeof(int32);
+	case EWaveVRTraceRecord::HandTracking:
+		return header.size == handTrackingSize || header.size == handTrackingSize + sizeof(WVR_HandPoseData_t);
+	default:
+		return true;  // Logged by ApplyRecord
+	}
+}
+
+void FWaveVRPlatformReplay::ApplyRecord(const FWaveVRTraceRecordHeader& header, const uint8 * payload)
+{
+	if (!IsPayloadSizeValid(header)) {
+		LOGW(WVRReplay, "Skip record type %u of bad size %u", header.type, header.size);
+		return;
+	}
+
+	const uint32 key = MakeKey(header.arg0, header.arg1);
+	switch ((EWaveVRTraceRecord)header.type) {
+	case EWaveVRTraceRecord::SyncPose:
+		{
+			auto& poses = SyncPoses.FindOrAdd(header.arg1);
+			poses.SetNumUninitialized(header.size / sizeof(WVR_DevicePosePair_t));
+			FMemory::Memcpy(poses.GetData(), payload, header.size);
+		}
+		break;
+	case EWaveVRTraceRecord::PoseState:
+		FMemory::Memcpy(&PoseStates.FindOrAdd(key), payload, sizeof(WVR_PoseState_t));
+		break;
+	case EWaveVRTraceRecord::Event:
+		{
+			// Drop the polled events before adding more.
+			if (NextEvent > 0 && NextEvent >= Events.Num()) {
+				Events.Reset();
+				NextEvent = 0;
+			}
+			WVR_Event_t event;
+			FMemory::Memcpy(&event, payload, sizeof(event));
+			Events.Add(event);
+		}
+		break;
+	case EWaveVRTraceRecord::Button:
+		Buttons.Add(key, payload[0] != 0);
+		break;
+	case EWaveVRTraceRecord::Touch:
+		Touches.Add(key, payload[0] != 0);
+		break;
+	case EWaveVRTraceRecord::Axis:
+		FMemory::Memcpy(&Axes.FindOrAdd(key), payload, sizeof(WVR_Axis_t));
+		break;
+	case EWaveVRTraceRecord::DeviceConnected:
+		Connections.Add(key, payload[0] != 0);
+		break;
+	case EWaveVRTraceRecord::BatteryTemperature:
+		{
+			int32 status;
+			FMemory::Memcpy(&status, payload, sizeof(status));
+			Temperatures.Add(key, (WVR_BatteryTemperatureStatus)status);
+		}
+		break;
+	case EWaveVRTraceRecord::InputDeviceState:
+		{
+			FInputDeviceState& state = InputDeviceStates.FindOrAdd(header.arg0);
+			if (header.arg1 & WVR_InputType_Button)
+				FMemory::Memcpy(&state.buttons, payload, sizeof(uint32));
+			if (header.arg1 & WVR_InputType_Touch)
+				FMemory::Memcpy(&state.touches, payload + sizeof(uint32), sizeof(uint32));
+			if (header.arg1 & WVR_InputType_Analog) {
+				state.analogs.SetNumUninitialized((header.size - 2 * sizeof(uint32)) / sizeof(WVR_AnalogState_t));
+				FMemory::Memcpy(state.analogs.GetData(), payload + 2 * sizeof(uint32), state.analogs.Num() * sizeof(WVR_AnalogState_t));
+			}
+			state.inputTypes |= header.arg1;
+		}
+		break;
+	case EWaveVRTraceRecord::InputTypeCount:
+		FMemory::Memcpy(&InputTypeCounts.FindOrAdd(key), payload, sizeof(int32));
+		break;
+	case EWaveVRTraceRecord::InputFocus:
+		bInputFocusCaptured = payload[0] != 0;
+		break;
+	case EWaveVRTraceRecord::HandGesture:
+		{
+			int32 result;
+			FMemory::Memcpy(&result, payload, sizeof(result));
+			GestureResult = (WVR_Result)result;
+			FMemory::Memcpy(&Gesture, payload + sizeof(result), sizeof(Gesture));
+		}
+		break;
+	case EWaveVRTraceRecord::HandTracking:
+		{
+			int32 result;
+			FMemory::Memcpy(&result, payload, sizeof(result));
+			HandTrackingResult = (WVR_Result)result;
+			FMemory::Memcpy(&HandSkeleton, payload + sizeof(result), sizeof(HandSkeleton));
+			bHasHandPose = header.arg0 != 0 && header.size == sizeof(int32) + sizeof(WVR_HandSkeletonData_t) + sizeof(WVR_HandPoseData_t);
+			if (bHasHandPose)
+				FMemory::Memcpy(&HandPose, payload + sizeof(result) + sizeof(HandSkeleton), sizeof(HandPose));
+		}
+		break;
+	default:
+		LOGW(WVRReplay, "Unknown record type %u", header.type);
+		break;
+	}
+}
+
+WVR_InitError FWaveVRPlatformReplay::Init(WVR_AppType type) {
+	LOG_FUNC();
+	return bLoaded ? WVR_InitError_None : WVR_InitError_NotInitialized;
+}
+
+void FWaveVRPlatformReplay::Quit() {
+	LOG_FUNC();
+}
+
+uint32_t FWaveVRPlatformReplay::GetWaveRuntimeVersion() {
+	return FileHeader.runtimeVersion;
+}
+
+void FWaveVRPlatformReplay::GetSyncPose(WVR_PoseOriginModel originModel, WVR_DevicePosePair_t* retPose, uint32_t PoseCount) {
+	Advance();
+	if (retPose == nullptr || PoseCount == 0)
+		return;
+
+	FScopeLock lock(&Lock);
+	const auto * poses = SyncPoses.Find((uint16)originModel);
+	if (poses == nullptr) {
+		FWaveVRAPIWrapper::GetSyncPose(originModel, retPose, PoseCount);
+		return;
+	}
+	uint32 count = FMath::Min<uint32>(PoseCount, poses->Num());
+	FMemory::Memcpy(retPose, poses->GetData(), count * sizeof(WVR_DevicePosePair_t));
+	for (uint32 i = count; i < PoseCount; i++) {
+		retPose[i].type = WVR_DeviceType_Invalid;
+		retPose[i].pose.isValidPose = false;
+	}
+}
+
+void FWaveVRPlatformReplay::GetPoseState(WVR_DeviceType type, WVR_PoseOriginModel originModel, uint32_t predictedMilliSec, WVR_PoseState_t *poseState) {
+	Advance();
+	if (poseState == nullptr)
+		return;
+
+	FScopeLock lock(&Lock);
+	const auto * pose = PoseStates.Find(MakeKey((uint8)type, (uint16)originModel));
+	if (pose != nullptr)
+		*poseState = *pose;
+	else
+		FWaveVRAPIWrapper::GetPoseState(type, originModel, predictedMilliSec, poseState);
+}
+
+bool FWaveVRPlatformReplay::GetInputButtonState(WVR_DeviceType type, WVR_InputId id) {
+	Advance();
+	FScopeLock lock(&Lock);
+	const bool * value = Buttons.Find(MakeKey((uint8)type, (uint16)id));
+	return value != nullptr && *value;
+}
+
+bool FWaveVRPlatformReplay::GetInputTouchState(WVR_DeviceType type, WVR_InputId id) {
+	Advance();
+	FScopeLock lock(&Lock);
+	const bool * value = Touches.Find(MakeKey((uint8)type, (uint16)id));
+	return value != nullptr && *value;
+}
+
+WVR_Axis_t FWaveVRPlatformReplay::GetInputAnalogAxis(WVR_DeviceType type, WVR_InputId id) {
+	Advance();
+	FScopeLock lock(&Lock);
+	const WVR_Axis_t * value = Axes.Find(MakeKey((uint8)type, (uint16)id));
+	return value != nullptr ? *value : WVR_Axis_t();
+}
+
+bool FWaveVRPlatformReplay::IsDeviceConnected(WVR_DeviceType type) {
+	Advance();
+	FScopeLock lock(&Lock);
+	const bool * value = Connections.Find(MakeKey((uint8)type, 0));
+	return value != nullptr && *value;
+}
+
+bool FWaveVRPlatformReplay::GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount) {
+	Advance();
+	{
+		FScopeLock lock(&Lock);
+		const FInputDeviceState * state = InputDeviceStates.Find((uint8)type);
+		if (state != nullptr && (state->inputTypes & inputType) == inputType) {
+			if ((inputType & WVR_InputType_Button) && buttons != nullptr)
+				*buttons = state->buttons;
+			if ((inputType & WVR_InputType_Touch) && touches != nullptr)
+				*touches = state->touches;
+			if ((inputType & WVR_InputType_Analog) && analogArray != nullptr) {
+				const uint32_t count = FMath::Min(analogArrayCount, (uint32_t)state->analogs.Num());
+				FMemory::Memcpy(analogArray, state->analogs.GetData(), count * sizeof(WVR_AnalogState_t));
+				if (count < analogArrayCount)
+					FMemory::Memzero(analogArray + count, (analogArrayCount - count) * sizeof(WVR_AnalogState_t));
+			}
+			return true;
+		}
+	}
+	// Recorded by the per id calls only.  Build it from them.
+	return FWaveVRAPIWrapper::GetInputDeviceState(type, inputType, buttons, touches, analogArray, analogArrayCount);
+}
+
+int32_t FWaveVRPlatformReplay::GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType) {
+	Advance();
+	{
+		FScopeLock lock(&Lock);
+		const int32 * value = InputTypeCounts.Find(MakeKey((uint8)type, (uint16)inputType));
+		if (value != nullptr)
+			return *value;
+	}
+	return FWaveVRAPIWrapper::GetInputTypeCount(type, inputType);
+}
+
+WVR_BatteryTemperatureStatus FWaveVRPlatformReplay::GetBatteryTemperatureStatus(WVR_DeviceType type) {
+	Advance();
+	FScopeLock lock(&Lock);
+	const WVR_BatteryTemperatureStatus * value = Temperatures.Find(MakeKey((uint8)type, 0));
+	return value != nullptr ? *value : WVR_BatteryTemperatureStatus_Normal;
+}
+
+bool FWaveVRPlatformReplay::PollEventQueue(WVR_Event_t* event) {
+	Advance();
+	if (event == nullptr)
+		return false;
+
+	FScopeLock lock(&Lock);
+	if (NextEvent >= Events.Num())
+		return false;
+	*event = Events[NextEvent++];
+	return true;
+}
+
+bool FWaveVRPlatformReplay::IsInputFocusCapturedBySystem() {
+	Advance();
+	FScopeLock lock(&Lock);
+	return bInputFocusCaptured;
+}
+
+WVR_Result FWaveVRPlatformReplay::GetHandGestureData(WVR_HandGestureData *data) {
+	Advance();
+	FScopeLock lock(&Lock);
+	if (data != nullptr)
+		*data = Gesture;
+	return GestureResult;
+}
+
+WVR_Result FWaveVRPlatformReplay::GetHandTrackingData(WVR_HandSkeletonData_t *skeleton, WVR_HandPoseData_t* pose, WVR_PoseOriginModel type) {
+	Advance();
+	FScopeLock lock(&Lock);
+	if (skeleton != nullptr)
+		*skeleton = HandSkeleton;
+	if (pose != nullptr && bHasHandPose)
+		*pose = HandPose;
+	return HandTrackingResult;
+}
@@ -0,0 +1,124 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "Platforms/WaveVRAPIWrapper.h"
+#include "Platforms/Replay/WaveVRTrace.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Feed a trace recorded by FWaveVRPlatformRecorder back as the runtime.  No headset is needed.
+ * Use -wvrreplay=<file> to enable it.  Only in the Android and Win64 game builds.  The editor
+ * builds use the direct preview instead, so the replay is compiled out there.
+ *
+ * The trace is advanced by the game thread when it sees a new GFrameNumber.
+ *   RealTime: Apply records whose recorded time has passed.  Follow the recorded pace.
+ *   AsFastAsPossible: Apply one recorded frame per game frame.  Same input in every run, whatever the frame rate is.
+ * Other calls, like render, fall back to the stub of FWaveVRAPIWrapper.
+ */
+class WAVEVR_API FWaveVRPlatformReplay : public FWaveVRAPIWrapper
+{
+public:
+	enum class EMode
+	{
+		RealTime,
+		AsFastAsPossible,
+	};
+
+public:
+	FWaveVRPlatformReplay(const FString& path, EMode mode, bool loop, bool exitWhenFinished);
+	virtual ~FWaveVRPlatformReplay();
+
+	inline bool IsLoaded() const { return bLoaded; }
+	inline bool IsFinished() const { return bFinished; }
+
+public:
+	virtual WVR_InitError Init(WVR_AppType type) override;
+	virtual void Quit() override;
+	virtual uint32_t GetWaveRuntimeVersion() override;
+	virtual void GetSyncPose(WVR_PoseOriginModel originModel, WVR_DevicePosePair_t* retPose, uint32_t PoseCount) override;
+	virtual void GetPoseState(WVR_DeviceType type, WVR_PoseOriginModel originModel, uint32_t predictedMilliSec, WVR_PoseState_t *poseState) override;
+	virtual bool GetInputButtonState(WVR_DeviceType type, WVR_InputId id) override;
+	virtual bool GetInputTouchState(WVR_DeviceType type, WVR_InputId id) override;
+	virtual WVR_Axis_t GetInputAnalogAxis(WVR_DeviceType type, WVR_InputId id) override;
+	virtual bool IsDeviceConnected(WVR_DeviceType type) override;
+	virtual bool GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount) override;
+	virtual int32_t GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType) override;
+	virtual WVR_BatteryTemperatureStatus GetBatteryTemperatureStatus(WVR_DeviceType type) override;
+	virtual bool PollEventQueue(WVR_Event_t* event) override;
+	virtual bool IsInputFocusCapturedBySystem() override;
+	virtual WVR_Result GetHandGestureData(WVR_HandGestureData *data) override;
+	virtual WVR_Result GetHandTrackingData(WVR_HandSkeletonData_t *skeleton, WVR_HandPoseData_t* pose = nullptr, WVR_PoseOriginModel type = WVR_PoseOriginModel_OriginOnHead) override;
+
+private:
+	bool Load();
+	// Only advance in game thread.  Other threads read the current state.
+	void Advance();
+	void ApplyRecord(const FWaveVRTraceRecordHeader& header, const uint8 * payload);
+	void Restart();
+
+	static inline uint32 MakeKey(uint8 arg0, uint16 arg1) { return ((uint32)arg0 << 16) | arg1; }
+
+private:
+	FWaveVRPlatformReplay(const FWaveVRPlatformReplay &) = delete;
+	FWaveVRPlatformReplay(FWaveVRPlatformReplay &&) = delete;
+	FWaveVRPlatformReplay &operator=(const FWaveVRPlatformReplay &) = delete;
+
+private:
+	FString Path;
+	EMode Mode;
+	bool bLoop;
+	bool bExitWhenFinished;
+	bool bLoaded;
+	bool bFinished;
+
+	TArray<uint8> Data;
+	TArray<int32> RecordOffsets;
+	FWaveVRTraceFileHeader FileHeader;
+
+	// Cursor, only accessed by GT
+	int32 NextRecord;
+	uint32 LastGameFrame;
+	uint32 ReplayFrame;
+	double ReplayStartTime;
+	uint32 ReplayedFrames;
+	double FirstAdvanceTime;
+
+	// Replayed state
+	FCriticalSection Lock;
+	TMap<uint16, TArray<WVR_DevicePosePair_t>> SyncPoses;  // Key is origin
+	TMap<uint32, WVR_PoseState_t> PoseStates;  // Key is device and origin
+	TMap<uint32, bool> Buttons;
+	TMap<uint32, bool> Touches;
+	TMap<uint32, WVR_Axis_t> Axes;
+	TMap<uint32, bool> Connections;
+	TMap<uint32, WVR_BatteryTemperatureStatus> Temperatures;
+	struct FInputDeviceState
+	{
+		uint32 inputTypes;  // The parts recorded
+		uint32 buttons;
+		uint32 touches;
+		TArray<WVR_AnalogState_t> analogs;
+
+		FInputDeviceState() : inputTypes(0), buttons(0), touches(0) {}
+	};
+	TMap<uint8, FInputDeviceState> InputDeviceStates;  // Key is device
+	TMap<uint32, int32> InputTypeCounts;  // Key is device and input type
+	TArray<WVR_Event_t> Events;
+	int32 NextEvent;
+	bool bInputFocusCaptured;
+	WVR_Result GestureResult;
+	WVR_HandGestureData_t Gesture;
+	WVR_Result HandTrackingResult;
+	WVR_HandSkeletonData_t HandSkeleton;
+	WVR_HandPoseData_t HandPose;
+	bool bHasHandPose;
+};
@@ -0,0 +1,68 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Platforms/WaveVRAPIWrapper.h"
+
+/**
+ * Binary trace of the runtime traffic, written by FWaveVRPlatformRecorder and read by FWaveVRPlatformReplay.
+ *
+ * File layout: FWaveVRTraceFileHeader, then records until the end of file.  Each record is a
+ * FWaveVRTraceRecordHeader followed by 'size' bytes of payload.  The payloads are the raw WVR
+ * structs, so a trace is only valid for the same SDK headers and the same endian.
+ *
+ * Button, touch, axis, connection, input focus, battery temperature, input device state and input
+ * type count are only written when changed.  The replay keeps the last value, so a key not in
+ * trace is false or zero.  A device state or type count not in trace falls back to the per id
+ * records.
+ */
+
+#define WVR_TRACE_MAGIC 0x54525657  // "WVRT"
+#define WVR_TRACE_VERSION 1
+
+enum class EWaveVRTraceRecord : uint8
+{
+	SyncPose = 1,		// arg1: origin.  payload: WVR_DevicePosePair_t[]
+	PoseState,			// arg0: device, arg1: origin.  payload: WVR_PoseState_t
+	Event,				// payload: WVR_Event_t
+	Button,				// arg0: device, arg1: input id.  payload: uint8
+	Touch,				// arg0: device, arg1: input id.  payload: uint8
+	Axis,				// arg0: device, arg1: input id.  payload: WVR_Axis_t
+	DeviceConnected,	// arg0: device.  payload: uint8
+	InputFocus,			// payload: uint8
+	HandGesture,		// payload: int32 WVR_Result, WVR_HandGestureData_t
+	HandTracking,		// arg0: has pose, arg1: origin.  payload: int32 WVR_Result, WVR_HandSkeletonData_t, [WVR_HandPoseData_t]
+	BatteryTemperature,	// arg0: device.  payload: int32 WVR_BatteryTemperatureStatus
+	InputDeviceState,	// arg0: device, arg1: WVR_InputType flags.  payload: uint32 buttons, uint32 touches, WVR_AnalogState_t[]
+	InputTypeCount,		// arg0: device, arg1: WVR_InputType.  payload: int32
+};
+
+#pragma pack(push, 1)
+struct FWaveVRTraceFileHeader
+{
+	uint32 magic;
+	uint16 version;
+	uint16 headerSize;  // sizeof(FWaveVRTraceRecordHeader), to reject a trace from other build.
+	uint32 runtimeVersion;  // GetWaveRuntimeVersion() of the recorded device
+	uint32 reserved;
+};
+
+struct FWaveVRTraceRecordHeader
+{
+	uint8 type;  // EWaveVRTraceRecord
+	uint8 arg0;
+	uint16 arg1;
+	uint32 size;  // Payload size
+	int64 timeNs;  // Since the recording started
+	uint32 frame;  // Game frame number since the recording started
+};
+#pragma pack(pop)
@@ -361,3 +361,37 @@ WVR_Result FWaveVRAPIWrapper::GetHandTrackingData(WVR_HandSkeletonData_t *skelet
 	pose->right.pinch.direction = OpenglCoordinate::GetVector3(PINCH_DIRECTION_R);
 	return WVR_Result::WVR_Success;
 }
+
+// The analog inputs known by the plugin, see TouchButton.
+static const uint32_t kAnalogIdCount = 3;
+static const WVR_InputId kAnalogIds[kAnalogIdCount] = { WVR_InputId_Alias1_Touchpad, WVR_InputId_Alias1_Trigger, WVR_InputId_Alias1_Thumbstick };
+
+bool FWaveVRAPIWrapper::GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount)
+{
+	// The last defined input id is the thumbstick.
+	if ((inputType & WVR_InputType_Button) && buttons != nullptr) {
+		*buttons = 0;
+		for (uint32_t id = 0; id <= WVR_InputId_Alias1_Thumbstick; id++)
+			if (GetInputButtonState(type, (WVR_InputId)id))
+				*buttons |= 1u << id;
+	}
+	if ((inputType & WVR_InputType_Touch) && touches != nullptr) {
+		*touches = 0;
+		for (uint32_t id = 0; id <= WVR_InputId_Alias1_Thumbstick; id++)
+			if (GetInputTouchState(type, (WVR_InputId)id))
+				*touches |= 1u << id;
+	}
+	if ((inputType & WVR_InputType_Analog) && analogArray != nullptr) {
+		for (uint32_t i = 0; i < analogArrayCount && i < kAnalogIdCount; i++) {
+			analogArray[i].id = kAnalogIds[i];
+			analogArray[i].type = kAnalogIds[i] == WVR_InputId_Alias1_Trigger ? WVR_AnalogType_1D : WVR_AnalogType_2D;
+			analogArray[i].axis = GetInputAnalogAxis(type, kAnalogIds[i]);
+		}
+	}
+	return true;
+}
+
+int32_t FWaveVRAPIWrapper::GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType)
+{
+	return inputType == WVR_InputType_Analog ? (int32_t)kAnalogIdCount : WVR_InputId_Alias1_Thumbstick + 1;
+}
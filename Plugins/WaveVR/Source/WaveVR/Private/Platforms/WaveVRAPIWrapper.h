@@ -85,10 +85,14 @@ public:
 	virtual bool GetInputButtonState(WVR_DeviceType type, WVR_InputId id) { return false; }
 	virtual bool GetInputTouchState(WVR_DeviceType type, WVR_InputId id) { return false; }
 	virtual WVR_Axis_t GetInputAnalogAxis(WVR_DeviceType type, WVR_InputId id) { return WVR_Axis_t(); }
+	// All inputs of a device in one call.  The default composes the single queries above.
+	virtual bool GetInputDeviceState(WVR_DeviceType type, uint32_t inputType, uint32_t* buttons, uint32_t* touches, WVR_AnalogState_t* analogArray, uint32_t analogArrayCount);
+	virtual int32_t GetInputTypeCount(WVR_DeviceType type, WVR_InputType inputType);
 	virtual bool IsDeviceConnected(WVR_DeviceType type) { return false; }
 	virtual uint32_t GetParameters(WVR_DeviceType type, const char* param, char* ret, uint32_t bufferSize) { return 0; }
 	virtual WVR_NumDoF GetDegreeOfFreedom(WVR_DeviceType type) { return WVR_NumDoF(0); }
 	virtual float GetDeviceBatteryPercentage(WVR_DeviceType type) { return -0.1f; }
+	virtual WVR_BatteryTemperatureStatus GetBatteryTemperatureStatus(WVR_DeviceType type) { return WVR_BatteryTemperatureStatus_Unknown; }
 	virtual bool PollEventQueue(WVR_Event_t* event) { return false; }
 	virtual bool GetRenderProps(WVR_RenderProps_t* props) { return false; }
 	virtual bool SetInputRequest(WVR_DeviceType type, const WVR_InputAttribute* request, uint32_t size) { return false; }
@@ -0,0 +1,42 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRJavaBridge.h"
+#include "WaveVRPrivatePCH.h"
+
+#if PLATFORM_ANDROID
+#include "Android/WaveVRJavaBridgeAndroid.h"
+#endif
+
+static FWaveVRJavaBridge* CreateDefault()
+{
+#if PLATFORM_ANDROID
+	return new FWaveVRJavaBridgeAndroid();
+#else
+	return new FWaveVRJavaBridge();
+#endif
+}
+
+static TUniquePtr<FWaveVRJavaBridge>& GetStorage()
+{
+	// Created at the first use, thread safe by the static initialization.
+	static TUniquePtr<FWaveVRJavaBridge> Instance(CreateDefault());
+	return Instance;
+}
+
+FWaveVRJavaBridge* FWaveVRJavaBridge::GetInstance()
+{
+	return GetStorage().Get();
+}
+
+void FWaveVRJavaBridge::SetInstance(FWaveVRJavaBridge* instance)
+{
+	GetStorage().Reset(instance != nullptr ? instance : CreateDefault());
+}
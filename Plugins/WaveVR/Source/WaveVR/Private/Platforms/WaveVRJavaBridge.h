@@ -0,0 +1,62 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Typed calls into the Java helpers of the plugin: ResourceWrapper, OEMConfig, FileUtils,
+ * PermissionWrapper, SoftwareIpd and ContentProvider.
+ *
+ * This default implementation has no Java, and every call fails.  The Android one resolves the
+ * classes and the method ids once, when the Java side registers, and keeps the calling threads
+ * attached to the VM until they exit.  A fake can be set by SetInstance(), for example to run
+ * the callers on Linux.
+ *
+ * The calls return false if the class is not registered, the method is missing, or Java throws.
+ */
+class WAVEVR_API FWaveVRJavaBridge
+{
+public:
+	static FWaveVRJavaBridge* GetInstance();
+	// Take the ownership.  nullptr restores the default of the platform.  Not thread safe.
+	static void SetInstance(FWaveVRJavaBridge* instance);
+
+	virtual ~FWaveVRJavaBridge() {}
+
+	/* ResourceWrapper */
+	virtual bool GetStringByName(const FString& name, FString& out) { return false; }
+	virtual bool GetPreferredStringByName(const FString& name, const FString& lang, const FString& country, FString& out) { return false; }
+	virtual bool GetSystemLanguage(FString& out) { return false; }
+	virtual bool GetSystemCountry(FString& out) { return false; }
+	// Empty lang and country for the system locale.  out has a string for each name.
+	virtual bool GetStringsByName(const TArray<FString>& names, const FString& lang, const FString& country, TArray<FString>& out) { return false; }
+
+	/* OEMConfig */
+	virtual bool GetJsonRawDataByKey(const FString& key, FString& out) { return false; }
+
+	/* FileUtils */
+	virtual bool DoUnZIPAndDeploy(const FString& renderModelName, int32 deviceIndex, FString& outPath) { return false; }
+
+	/* PermissionWrapper */
+	virtual bool RequestPermissions(const TArray<FString>& permissions, bool& outResult) { return false; }
+	virtual bool RequestUsbPermission(bool& outResult) { return false; }
+	virtual bool IsPermissionGranted(const FString& permission, bool& outResult) { return false; }
+	virtual bool ShouldGrantPermission(const FString& permission, bool& outResult) { return false; }
+	virtual bool ShowDialogOnVRScene(bool& outResult) { return false; }
+
+	/* SoftwareIpd */
+	virtual bool ReadIpd(TArray<FString>& outFields) { return false; }
+	virtual bool WriteIpd(const FString& value, const FString& isEnable, bool& outResult) { return false; }
+
+	/* ContentProvider */
+	virtual bool WriteControllerRoleValue(const FString& role) { return false; }
+};
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Logging/LogMacros.h"
+#include "Platforms/WaveVRTraceLog.h"
 
 #if WITH_EDITOR
 	#include "Editor/WaveVRLogEditor.h"
@@ -0,0 +1,759 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRTraceLog.h"
+#include "WaveVRPrivatePCH.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRTraceLog, Log, All);
+
+/**
+ * File layout: FFileHeader, then blocks until the end of file.  Each block starts with a uint8
+ * EBlock.
+ *   Site:    uint16 id, uint8 level, int32 line, then category, format, function and file as
+ *            uint16 length and UTF-8 bytes.  A site is written before any record of it.
+ *   Records: uint32 thread id, uint32 size, then 'size' bytes of records.  Each record is a
+ *            FRecordHeader followed by the arguments, see EWaveVRTraceArg.
+ *   Dropped: uint32 thread id, uint32 count of records dropped since the last block.
+ */
+
+#define WVR_TRACELOG_MAGIC 0x4C525657  // "WVRL"
+#define WVR_TRACELOG_VERSION 1
+
+namespace {
+
+enum class EBlock : uint8
+{
+	Site = 1,
+	Records,
+	Dropped,
+};
+
+#pragma pack(push, 1)
+struct FFileHeader
+{
+	uint32 magic;
+	uint16 version;
+	uint16 recordHeaderSize;
+	double secondsPerCycle;
+	uint64 startCycles;
+};
+
+struct FRecordHeader
+{
+	uint16 size;  // Include this header
+	uint16 site;
+	uint64 cycles;
+};
+#pragma pack(pop)
+
+static const uint32 kRingSize = 32 * 1024;  // Power of 2
+static const float kFlushIntervalSeconds = 0.1f;
+static const int32 kMaxSites = 65535;
+
+static const TCHAR* kLevelNames[] = { TEXT("Verbose"), TEXT("Debug"), TEXT("Info"), TEXT("Warning"), TEXT("Error"), TEXT("Off") };
+static const int32 kLevelCount = (int32)EWaveVRTraceLevel::Off + 1;
+
+// Single producer, the owner thread.  Single consumer, who holds the drain lock.
+struct FRing
+{
+	uint32 ThreadId;
+	int32 Head;  // Written bytes, wrapped
+	int32 Tail;  // Read bytes, wrapped
+	int32 Dropped;
+	int32 bReleased;  // The owner thread has exited.  Deleted once drained.
+	uint8 Data[kRingSize];
+
+	explicit FRing(uint32 threadId) : ThreadId(threadId), Head(0), Tail(0), Dropped(0), bReleased(0) {}
+
+	bool Push(const FRecordHeader& header, const uint8* args, uint32 argsSize) {
+		const uint32 head = (uint32)Head;
+		const uint32 tail = (uint32)FPlatformAtomics::AtomicRead(&Tail);
+		if (kRingSize - (head - tail) < header.size) {
+			FPlatformAtomics::InterlockedIncrement(&Dropped);
+			return false;
+		}
+		Copy(head, (const uint8*)&header, sizeof(header));
+		Copy(head + sizeof(header), args, argsSize);
+		FPlatformAtomics::AtomicStore(&Head, (int32)(head + header.size));
+		return true;
+	}
+
+	void Copy(uint32 pos, const uint8* src, uint32 size) {
+		const uint32 offset = pos & (kRingSize - 1);
+		const uint32 first = FMath::Min(size, kRingSize - offset);
+		FMemory::Memcpy(Data + offset, src, first);
+		if (first < size)
+			FMemory::Memcpy(Data, src + first, size - first);
+	}
+};
+
+// Release the ring of a thread when the thread exits.
+struct FRingHolder
+{
+	FRing* Ring;
+
+	FRingHolder() : Ring(nullptr) {}
+	~FRingHolder() {
+		if (Ring != nullptr)
+			FPlatformAtomics::AtomicStore(&Ring->bReleased, 1);
+	}
+};
+
+static thread_local FRingHolder tlsRing;
+
+static EWaveVRTraceLevel ParseLevel(const FString& str, EWaveVRTraceLevel defaultLevel)
+{
+	FString value = str.TrimStartAndEnd();
+	if (value.IsNumeric())
+		return (EWaveVRTraceLevel)FMath::Clamp(FCString::Atoi(*value), 0, kLevelCount - 1);
+	for (int32 i = 0; i < kLevelCount; i++) {
+		if (value.Equals(kLevelNames[i], ESearchCase::IgnoreCase))
+			return (EWaveVRTraceLevel)i;
+	}
+	return defaultLevel;
+}
+
+static void WriteString(FArchive& ar, const char* str)
+{
+	uint16 length = (uint16)FMath::Min<SIZE_T>(str != nullptr ? FCStringAnsi::Strlen(str) : 0, MAX_uint16);
+	ar << length;
+	if (length > 0)
+		ar.Serialize((void*)str, length);
+}
+
+class FTraceLogState : public FRunnable
+{
+public:
+	static FTraceLogState& Get() {
+		static FTraceLogState Instance;
+		return Instance;
+	}
+
+	FTraceLogState()
+		: bEnabled(false)
+		, DefaultLevel(EWaveVRTraceLevel::Debug)
+		, Thread(nullptr)
+		, wakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+		, File(nullptr)
+		, bOpenFailed(false)
+		, WrittenSites(0)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FTraceLogState() {
+		StopThread();
+		CloseFile();
+		// A thread still alive may release its ring later, so only the released rings are deleted.
+		for (FRing* ring : Rings) {
+			if (FPlatformAtomics::AtomicRead(&ring->bReleased))
+				delete ring;
+		}
+		Rings.Empty();
+		FPlatformProcess::ReturnSynchEventToPool(wakeEvent);
+		wakeEvent = nullptr;
+	}
+
+	FRing* GetRing() {
+		FRing* ring = tlsRing.Ring;
+		if (ring == nullptr) {
+			ring = new FRing(FPlatformTLS::GetCurrentThreadId());
+			tlsRing.Ring = ring;
+			FScopeLock lock(&SiteLock);
+			Rings.Add(ring);
+		}
+		return ring;
+	}
+
+	// Return the level and id under the lock.  The id is assigned at the first resolve.
+	bool Resolve(FWaveVRTraceSite& site, int32 generation) {
+		FScopeLock lock(&SiteLock);
+		if (site.Id == 0 && Sites.Num() < kMaxSites) {
+			Sites.Add(&site);
+			site.Id = Sites.Num();
+		}
+		EWaveVRTraceLevel level = DefaultLevel;
+		if (const EWaveVRTraceLevel* found = CategoryLevels.Find(ANSI_TO_TCHAR(site.Category)))
+			level = *found;
+		const bool enabled = bEnabled && site.Id != 0 && site.Level >= level;
+		FPlatformAtomics::AtomicStore(&site.bEnabled, enabled ? 1 : 0);
+		FPlatformAtomics::AtomicStore(&site.Generation, generation);
+		return enabled;
+	}
+
+	// Return true if the levels are changed.
+	bool ReadSettings() {
+		static const auto CVarEnable = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.TraceLog.enable"));
+		static const auto CVarLevel = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.TraceLog.Level"));
+		static const auto CVarCategories = IConsoleManager::Get().FindConsoleVariable(TEXT("wvr.TraceLog.Categories"));
+
+		const bool enabled = CVarEnable != nullptr && CVarEnable->GetValueOnAnyThread() != 0;
+		const EWaveVRTraceLevel defaultLevel = CVarLevel != nullptr ?
+			(EWaveVRTraceLevel)FMath::Clamp(CVarLevel->GetValueOnAnyThread(), 0, kLevelCount - 1) : EWaveVRTraceLevel::Debug;
+		const FString categories = CVarCategories != nullptr ? CVarCategories->GetString() : FString();
+
+		FScopeLock lock(&SiteLock);
+		if (enabled == bEnabled && defaultLevel == DefaultLevel && categories == CategoriesString)
+			return false;
+
+		bEnabled = enabled;
+		DefaultLevel = defaultLevel;
+		CategoriesString = categories;
+
+		// For example "WVRHMD=Info,WVRFunc=Verbose"
+		CategoryLevels.Empty();
+		TArray<FString> pairs;
+		categories.ParseIntoArray(pairs, TEXT(","));
+		for (const FString& pair : pairs) {
+			FString name, level;
+			if (pair.Split(TEXT("="), &name, &level))
+				CategoryLevels.Add(name.TrimStartAndEnd(), ParseLevel(level, defaultLevel));
+		}
+		LOGI(WVRTraceLog, "Settings: enable %d, level %d, categories \"%s\"", enabled, (int)defaultLevel, PLATFORM_CHAR(*categories));
+		return true;
+	}
+
+	void StartThread() {
+		if (Thread != nullptr)
+			return;
+		StopTaskCounter.Reset();
+		Thread = FRunnableThread::Create(this, TEXT("FWaveVRTraceLog"), 0, TPri_Lowest);
+	}
+
+	void StopThread() {
+		if (Thread == nullptr)
+			return;
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	// Begin FRunnable interface.
+	virtual uint32 Run() override {
+		while (StopTaskCounter.GetValue() == 0) {
+			wakeEvent->Wait(FTimespan::FromSeconds(kFlushIntervalSeconds));
+			Drain();
+		}
+		return 0;
+	}
+
+	virtual void Stop() override {
+		StopTaskCounter.Increment();
+		wakeEvent->Trigger();
+	}
+	// End FRunnable interface
+
+	void Drain() {
+		FScopeLock lock(&DrainLock);
+		// Before the new sites are collected, as a new file writes all sites again.
+		RotateFileIfFull();
+
+		TArray<FRing*> rings;
+		TArray<FWaveVRTraceSite*> newSites;
+		{
+			FScopeLock siteLock(&SiteLock);
+			rings = Rings;
+			for (int32 i = WrittenSites; i < Sites.Num(); i++)
+				newSites.Add(Sites[i]);
+		}
+
+		bool hasData = newSites.Num() > 0;
+		for (FRing* ring : rings)
+			hasData |= FPlatformAtomics::AtomicRead(&ring->Head) != ring->Tail || FPlatformAtomics::AtomicRead(&ring->Dropped) != 0;
+		if (!hasData) {
+			ReclaimRings(rings);
+			return;
+		}
+		if (!OpenFile())
+			return;
+
+		FArchive& ar = *File;
+		for (FWaveVRTraceSite* site : newSites) {
+			uint8 block = (uint8)EBlock::Site;
+			uint16 id = (uint16)site->Id;
+			uint8 level = (uint8)site->Level;
+			int32 line = site->Line;
+			ar << block << id << level << line;
+			WriteString(ar, site->Category);
+			WriteString(ar, site->Format);
+			WriteString(ar, site->Function);
+			WriteString(ar, site->File);
+		}
+		WrittenSites += newSites.Num();
+
+		for (FRing* ring : rings) {
+			const uint32 head = (uint32)FPlatformAtomics::AtomicRead(&ring->Head);
+			const uint32 tail = (uint32)ring->Tail;
+			if (head != tail) {
+				uint8 block = (uint8)EBlock::Records;
+				uint32 threadId = ring->ThreadId;
+				uint32 size = head - tail;
+				ar << block << threadId << size;
+				const uint32 offset = tail & (kRingSize - 1);
+				const uint32 first = FMath::Min(size, kRingSize - offset);
+				ar.Serialize(ring->Data + offset, first);
+				if (first < size)
+					ar.Serialize(ring->Data, size - first);
+				FPlatformAtomics::AtomicStore(&ring->Tail, (int32)head);
+			}
+
+			uint32 dropped = (uint32)FPlatformAtomics::InterlockedExchange(&ring->Dropped, 0);
+			if (dropped != 0) {
+				uint8 block = (uint8)EBlock::Dropped;
+				uint32 threadId = ring->ThreadId;
+				ar << block << threadId << dropped;
+			}
+		}
+		ar.Flush();
+		ReclaimRings(rings);
+	}
+
+	void CloseFile() {
+		FScopeLock lock(&DrainLock);
+		if (File == nullptr)
+			return;
+		File->Close();
+		delete File;
+		File = nullptr;
+	}
+
+	void WakeUp() { wakeEvent->Trigger(); }
+
+private:
+	// Delete the rings whose thread has exited, after they are drained.  Under the drain lock.
+	void ReclaimRings(const TArray<FRing*>& rings) {
+		for (FRing* ring : rings) {
+			if (!FPlatformAtomics::AtomicRead(&ring->bReleased) || FPlatformAtomics::AtomicRead(&ring->Head) != ring->Tail ||
+				FPlatformAtomics::AtomicRead(&ring->Dropped) != 0)
+				continue;
+			{
+				FScopeLock siteLock(&SiteLock);
+				Rings.Remove(ring);
+			}
+			delete ring;
+		}
+	}
+
+	// Under the drain lock.  The new file has the header and the sites again, so each file can be decoded alone.
+	void RotateFileIfFull() {
+		static const auto CVarMaxFileSize = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.TraceLog.MaxFileSizeMB"));
+		const int64 maxSize = CVarMaxFileSize != nullptr ? (int64)CVarMaxFileSize->GetValueOnAnyThread() * 1024 * 1024 : 0;
+		if (File == nullptr || maxSize <= 0 || File->Tell() < maxSize)
+			return;
+
+		File->Close();
+		delete File;
+		File = nullptr;
+
+		const FString rotatedPath = FPaths::ChangeExtension(FilePath, TEXT("1.wvrlog"));
+		IFileManager::Get().Move(*rotatedPath, *FilePath, true);
+		LOGI(WVRTraceLog, "Rotate the trace log to %s", PLATFORM_CHAR(*rotatedPath));
+
+		WrittenSites = 0;
+	}
+
+	bool OpenFile() {
+		if (File != nullptr)
+			return true;
+		if (bOpenFailed)
+			return false;
+
+		// The same path after a rotation, so only two files are kept.
+		if (FilePath.IsEmpty())
+			FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WaveVR"), TEXT("TraceLog"),
+				FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")) + TEXT(".wvrlog"));
+		File = IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead);
+		if (File == nullptr) {
+			bOpenFailed = true;
+			LOGW(WVRTraceLog, "Failed to create %s", PLATFORM_CHAR(*FilePath));
+			return false;
+		}
+		LOGI(WVRTraceLog, "Write trace log to %s", PLATFORM_CHAR(*FilePath));
+
+		FFileHeader header;
+		header.magic = WVR_TRACELOG_MAGIC;
+		header.version = WVR_TRACELOG_VERSION;
+		header.recordHeaderSize = sizeof(FRecordHeader);
+		header.secondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+		header.startCycles = StartCycles;
+		File->Serialize(&header, sizeof(header));
+		return true;
+	}
+
+	FCriticalSection SiteLock;  // Sites, Rings and the settings
+	TArray<FWaveVRTraceSite*> Sites;  // Index is id - 1
+	TArray<FRing*> Rings;  // A ring is kept after its thread exits, until its records are drained.
+	bool bEnabled;
+	EWaveVRTraceLevel DefaultLevel;
+	FString CategoriesString;
+	TMap<FString, EWaveVRTraceLevel> CategoryLevels;
+
+	FRunnableThread* Thread;
+	FThreadSafeCounter StopTaskCounter;
+	FEvent* wakeEvent;
+
+	FCriticalSection DrainLock;  // File and WrittenSites
+	FArchive* File;
+	FString FilePath;
+	bool bOpenFailed;
+	int32 WrittenSites;
+	const uint64 StartCycles;
+};
+
+static void OnTraceLogSettingsChanged()
+{
+	FWaveVRTraceLog::OnSettingsChanged();
+}
+
+static FAutoConsoleVariableSink CVarTraceLogSink(FConsoleCommandDelegate::CreateStatic(&OnTraceLogSettingsChanged));
+
+static FAutoConsoleCommand CCmdTraceLogFlush(
+	TEXT("wvr.TraceLog.Flush"),
+	TEXT("Write the trace log records to file now.\n"),
+	FConsoleCommandDelegate::CreateStatic(&FWaveVRTraceLog::Flush));
+
+static FAutoConsoleCommand CCmdTraceLogDecode(
+	TEXT("wvr.TraceLog.Decode"),
+	TEXT("wvr.TraceLog.Decode <file.wvrlog> [output.txt]\n")
+	TEXT("Format a trace log into text.  The output is <file>.txt by default.\n"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& args) {
+		if (args.Num() < 1) {
+			LOGW(WVRTraceLog, "Need the trace log path.");
+			return;
+		}
+		FString textPath = args.Num() > 1 ? args[1] : FPaths::ChangeExtension(args[0], TEXT("txt"));
+		FWaveVRTraceLog::Decode(args[0], textPath);
+	}));
+
+}  // namespace
+
+int32 FWaveVRTraceLog::Generation = 1;
+
+void FWaveVRTraceArgWriter::AddString(const char* value)
+{
+	if (value == nullptr)
+		value = "(null)";
+	uint16 length = (uint16)FMath::Min<SIZE_T>(FCStringAnsi::Strlen(value), MaxStringLength);
+	if (Size + 1 + sizeof(length) + length > MaxSize)
+		return;
+	Data[Size++] = (uint8)EWaveVRTraceArg::String;
+	FMemory::Memcpy(Data + Size, &length, sizeof(length));
+	Size += sizeof(length);
+	FMemory::Memcpy(Data + Size, value, length);
+	Size += length;
+}
+
+void FWaveVRTraceArgWriter::Add(const TCHAR* value)
+{
+	if (value == nullptr) {
+		AddString(nullptr);
+		return;
+	}
+	AddString(TCHAR_TO_UTF8(value));
+}
+
+void FWaveVRTraceLog::Start()
+{
+	FTraceLogState& state = FTraceLogState::Get();
+	if (state.ReadSettings())
+		FPlatformAtomics::InterlockedIncrement(&Generation);
+	state.StartThread();
+}
+
+void FWaveVRTraceLog::Stop()
+{
+	FTraceLogState& state = FTraceLogState::Get();
+	state.StopThread();
+	state.Drain();
+	state.CloseFile();
+}
+
+void FWaveVRTraceLog::Flush()
+{
+	FTraceLogState::Get().Drain();
+}
+
+void FWaveVRTraceLog::OnSettingsChanged()
+{
+	if (FTraceLogState::Get().ReadSettings())
+		FPlatformAtomics::InterlockedIncrement(&Generation);
+}
+
+bool FWaveVRTraceLog::Resolve(FWaveVRTraceSite& site)
+{
+	return FTraceLogState::Get().Resolve(site, FPlatformAtomics::AtomicRead(&Generation));
+}
+
+void FWaveVRTraceLog::Commit(const FWaveVRTraceSite& site, const FWaveVRTraceArgWriter& writer)
+{
+	FRecordHeader header;
+	header.size = (uint16)(sizeof(FRecordHeader) + writer.GetSize());
+	header.site = (uint16)site.Id;
+	header.cycles = FPlatformTime::Cycles64();
+	FTraceLogState& state = FTraceLogState::Get();
+	FRing* ring = state.GetRing();
+	// Do not wait for the interval if the ring is going to be full.
+	if (ring->Push(header, writer.GetData(), writer.GetSize()) &&
+		(uint32)(ring->Head - FPlatformAtomics::AtomicRead(&ring->Tail)) > kRingSize / 2)
+		state.WakeUp();
+}
+
+/**
+ * Decoder
+ */
+
+namespace {
+
+struct FDecodedSite
+{
+	EWaveVRTraceLevel level;
+	int32 line;
+	FString category;
+	FString format;
+	FString function;
+	FString file;
+	TArray<ANSICHAR> formatAnsi;
+};
+
+struct FDecodedLine
+{
+	uint64 cycles;
+	FString text;
+};
+
+static bool ReadString(FArchive& ar, FString& out)
+{
+	uint16 length = 0;
+	ar << length;
+	TArray<ANSICHAR> buffer;
+	buffer.SetNumZeroed(length + 1);
+	if (length > 0)
+		ar.Serialize(buffer.GetData(), length);
+	out = UTF8_TO_TCHAR(buffer.GetData());
+	return !ar.IsError();
+}
+
+// Read one argument of the expected class.  Return false if no argument left.
+static bool ReadArg(const uint8*& pos, const uint8* end, EWaveVRTraceArg& type, uint64& bits, double& real, FString& str)
+{
+	if (pos >= end)
+		return false;
+	type = (EWaveVRTraceArg)*pos++;
+	if (type == EWaveVRTraceArg::String) {
+		uint16 length = 0;
+		if (pos + sizeof(length) > end)
+			return false;
+		FMemory::Memcpy(&length, pos, sizeof(length));
+		pos += sizeof(length);
+		length = (uint16)FMath::Min<int64>(length, end - pos);
+		TArray<ANSICHAR> buffer;
+		buffer.SetNumZeroed(length + 1);
+		FMemory::Memcpy(buffer.GetData(), pos, length);
+		pos += length;
+		str = UTF8_TO_TCHAR(buffer.GetData());
+		return true;
+	}
+	if (pos + sizeof(uint64) > end)
+		return false;
+	FMemory::Memcpy(&bits, pos, sizeof(uint64));
+	pos += sizeof(uint64);
+	if (type == EWaveVRTraceArg::Double)
+		FMemory::Memcpy(&real, &bits, sizeof(real));
+	return true;
+}
+
+// printf the arguments by the format.  The length modifiers are replaced by the encoded type.
+static FString FormatRecord(const TArray<ANSICHAR>& format, const uint8* pos, const uint8* end)
+{
+	FString out;
+	const ANSICHAR* f = format.GetData();
+	while (*f) {
+		if (*f != '%') {
+			const ANSICHAR* start = f;
+			while (*f && *f != '%')
+				f++;
+			out += FString(f - start, start);
+			continue;
+		}
+		if (f[1] == '%') {
+			out += TEXT("%");
+			f += 2;
+			continue;
+		}
+
+		// %[flags][width][.precision][length]conversion
+		ANSICHAR spec[32];
+		int32 n = 0;
+		spec[n++] = *f++;
+		while (*f && FCStringAnsi::Strchr("-+ #0123456789.", *f) && n < 20)
+			spec[n++] = *f++;
+		while (*f && FCStringAnsi::Strchr("hlLqjzt", *f))
+			f++;
+		const ANSICHAR conversion = *f;
+		if (conversion == 0)
+			break;
+		f++;
+
+		EWaveVRTraceArg type;
+		uint64 bits = 0;
+		double real = 0;
+		FString str;
+		if (!ReadArg(pos, end, type, bits, real, str)) {
+			out += TEXT("<missing>");
+			continue;
+		}
+
+		ANSICHAR buffer[256];
+		buffer[0] = 0;
+		switch (conversion) {
+		case 'd': case 'i': case 'c':
+			if (conversion == 'c') {
+				spec[n++] = 'c'; spec[n] = 0;
+				FCStringAnsi::Snprintf(buffer, sizeof(buffer), spec, (int)bits);
+				break;
+			}
+			spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = 'd'; spec[n] = 0;
+			FCStringAnsi::Snprintf(buffer, sizeof(buffer), spec, type == EWaveVRTraceArg::Double ? (long long)real : (long long)bits);
+			break;
+		case 'u': case 'x': case 'X': case 'o':
+			spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conversion; spec[n] = 0;
+			FCStringAnsi::Snprintf(buffer, sizeof(buffer), spec, type == EWaveVRTraceArg::Double ? (unsigned long long)real : (unsigned long long)bits);
+			break;
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+			spec[n++] = conversion; spec[n] = 0;
+			FCStringAnsi::Snprintf(buffer, sizeof(buffer), spec, type == EWaveVRTraceArg::Double ? real : (double)(int64)bits);
+			break;
+		case 'p':
+			FCStringAnsi::Snprintf(buffer, sizeof(buffer), "0x%llx", (unsigned long long)bits);
+			break;
+		case 's':
+			if (type == EWaveVRTraceArg::String) {
+				out += str;
+				continue;
+			}
+			FCStringAnsi::Snprintf(buffer, sizeof(buffer), "%lld", (long long)bits);
+			break;
+		default:
+			FCStringAnsi::Snprintf(buffer, sizeof(buffer), "<%%%c>", conversion);
+			break;
+		}
+		out += UTF8_TO_TCHAR(buffer);
+	}
+	return out;
+}
+
+}  // namespace
+
+bool FWaveVRTraceLog::Decode(const FString& tracePath, const FString& textPath)
+{
+	TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*tracePath, FILEREAD_AllowWrite));
+	if (!reader) {
+		LOGW(WVRTraceLog, "Decode: failed to open %s", PLATFORM_CHAR(*tracePath));
+		return false;
+	}
+	FArchive& ar = *reader;
+
+	FFileHeader header;
+	ar.Serialize(&header, sizeof(header));
+	if (ar.IsError() || header.magic != WVR_TRACELOG_MAGIC || header.version != WVR_TRACELOG_VERSION ||
+		header.recordHeaderSize != sizeof(FRecordHeader)) {
+		LOGW(WVRTraceLog, "Decode: %s is not a trace log of this version.", PLATFORM_CHAR(*tracePath));
+		return false;
+	}
+
+	TMap<uint16, FDecodedSite> sites;
+	TArray<FDecodedLine> lines;
+	TArray<uint8> data;
+	while (!ar.AtEnd() && !ar.IsError()) {
+		uint8 block = 0;
+		ar << block;
+		if ((EBlock)block == EBlock::Site) {
+			uint16 id = 0;
+			uint8 level = 0;
+			FDecodedSite site;
+			ar << id << level << site.line;
+			site.level = (EWaveVRTraceLevel)FMath::Min<int32>(level, kLevelCount - 1);
+			ReadString(ar, site.category);
+			ReadString(ar, site.format);
+			ReadString(ar, site.function);
+			ReadString(ar, site.file);
+			FTCHARToUTF8 formatUtf8(*site.format);
+			site.formatAnsi.Append(formatUtf8.Get(), formatUtf8.Length());
+			site.formatAnsi.Add(0);
+			sites.Add(id, MoveTemp(site));
+		} else if ((EBlock)block == EBlock::Records) {
+			uint32 threadId = 0, size = 0;
+			ar << threadId << size;
+			if (ar.IsError() || (int64)size > ar.TotalSize() - ar.Tell())
+				break;  // Truncated
+			data.SetNumUninitialized(size);
+			ar.Serialize(data.GetData(), size);
+
+			const uint8* pos = data.GetData();
+			const uint8* end = pos + size;
+			while (pos + sizeof(FRecordHeader) <= end) {
+				FRecordHeader record;
+				FMemory::Memcpy(&record, pos, sizeof(record));
+				if (record.size < sizeof(FRecordHeader) || pos + record.size > end)
+					break;
+				const double ms = (double)(int64)(record.cycles - header.startCycles) * header.secondsPerCycle * 1000.0;
+				const FDecodedSite* site = sites.Find(record.site);
+				FDecodedLine line;
+				line.cycles = record.cycles;
+				if (site == nullptr) {
+					line.text = FString::Printf(TEXT("%12.3f %6u ? unknown site %u"), ms, threadId, record.site);
+				} else {
+					FString message = site->format.IsEmpty() ? site->function :
+						FormatRecord(site->formatAnsi, pos + sizeof(FRecordHeader), pos + record.size);
+					line.text = FString::Printf(TEXT("%12.3f %6u %c %s: %s"), ms, threadId,
+						kLevelNames[(int32)site->level][0], *site->category, *message);
+				}
+				lines.Add(MoveTemp(line));
+				pos += record.size;
+			}
+		} else if ((EBlock)block == EBlock::Dropped) {
+			uint32 threadId = 0, count = 0;
+			ar << threadId << count;
+			FDecodedLine line;
+			line.cycles = lines.Num() > 0 ? lines.Last().cycles : header.startCycles;
+			line.text = FString::Printf(TEXT("%12s %6u W WVRTraceLog: %u records dropped"), TEXT(""), threadId, count);
+			lines.Add(MoveTemp(line));
+		} else {
+			LOGW(WVRTraceLog, "Decode: unknown block %u, stop.", block);
+			break;
+		}
+	}
+
+	// The blocks of the threads are interleaved.
+	lines.StableSort([](const FDecodedLine& a, const FDecodedLine& b) { return a.cycles < b.cycles; });
+
+	FString text;
+	for (const FDecodedLine& line : lines) {
+		text += line.text;
+		text += LINE_TERMINATOR;
+	}
+	if (!FFileHelper::SaveStringToFile(text, *textPath, FFileHelper::EEncodingOptions::ForceUTF8)) {
+		LOGW(WVRTraceLog, "Decode: failed to write %s", PLATFORM_CHAR(*textPath));
+		return false;
+	}
+	LOGI(WVRTraceLog, "Decode: %d records of %d sites to %s", lines.Num(), sites.Num(), PLATFORM_CHAR(*textPath));
+	return true;
+}
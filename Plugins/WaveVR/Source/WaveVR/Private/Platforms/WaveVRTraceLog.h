@@ -0,0 +1,171 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+/**
+ * Binary trace log for the hot paths.
+ *
+ * A trace point records its call site id, the time and the arguments in binary into a lock free
+ * ring of the calling thread.  No formatting and no syscall in the caller.  A flusher thread
+ * drains the rings into Saved/WaveVR/TraceLog/<time>.wvrlog together with the call site table.
+ * It is disabled by default.  See wvr.TraceLog.enable, and wvr.TraceLog.MaxFileSizeMB for the
+ * file rotation.
+ * The file is formatted into text offline by FWaveVRTraceLog::Decode(), or the console command
+ * "wvr.TraceLog.Decode <file>".
+ *
+ * Each category has a runtime level, set by wvr.TraceLog.Level and wvr.TraceLog.Categories.  A
+ * call site caches whether it is enabled, and only checks again after the levels are changed.
+ * If the ring of a thread is full, the record is dropped and counted.
+ *
+ * Use TLOGV/TLOGD/TLOGI/TLOGW like LOGD.  The arguments can be integers, enums, floats, pointers
+ * and strings.  Strings are copied and truncated to MaxStringLength.
+ */
+
+enum class EWaveVRTraceLevel : uint8
+{
+	Verbose,
+	Debug,
+	Info,
+	Warning,
+	Error,
+	Off,
+};
+
+// A static of each trace point.  Zero initialized so it needs no guard.
+struct FWaveVRTraceSite
+{
+	const char* Category;
+	const char* Format;
+	const char* Function;
+	const char* File;
+	int32 Line;
+	EWaveVRTraceLevel Level;
+
+	// Filled by the trace log
+	int32 Id;
+	int32 Generation;
+	int32 bEnabled;
+};
+
+// Argument encoding of a record.  The decoder converts an argument by its format spec.
+enum class EWaveVRTraceArg : uint8
+{
+	Int,  // int64
+	UInt,  // uint64
+	Double,  // double
+	Pointer,  // uint64
+	String,  // uint16 length, then UTF-8 bytes without terminator
+};
+
+class WAVEVR_API FWaveVRTraceArgWriter
+{
+public:
+	enum
+	{
+		MaxSize = 256,
+		MaxStringLength = 96,
+	};
+
+	FWaveVRTraceArgWriter() : Size(0) {}
+
+	template <typename T>
+	void Add(T value) { AddNumber(value, typename std::is_floating_point<T>::type()); }
+	template <typename T>
+	void Add(T* value) { AddPointer(value); }
+	void Add(const char* value) { AddString(value); }
+	void Add(char* value) { AddString(value); }
+	void Add(const TCHAR* value);
+	void Add(TCHAR* value) { Add((const TCHAR*)value); }
+
+	const uint8* GetData() const { return Data; }
+	uint32 GetSize() const { return Size; }
+
+private:
+	template <typename T>
+	void AddNumber(T value, std::true_type) { Append(EWaveVRTraceArg::Double, (double)value); }
+	template <typename T>
+	void AddNumber(T value, std::false_type) {
+		if (std::is_unsigned<T>::value)
+			Append(EWaveVRTraceArg::UInt, (uint64)value);
+		else
+			Append(EWaveVRTraceArg::Int, (int64)value);
+	}
+	void AddPointer(const void* value) { Append(EWaveVRTraceArg::Pointer, (uint64)(UPTRINT)value); }
+	void AddString(const char* value);
+
+	template <typename T>
+	void Append(EWaveVRTraceArg type, T value) {
+		if (Size + 1 + sizeof(T) > MaxSize)
+			return;
+		Data[Size++] = (uint8)type;
+		FMemory::Memcpy(Data + Size, &value, sizeof(T));
+		Size += sizeof(T);
+	}
+
+	uint8 Data[MaxSize];
+	uint32 Size;
+};
+
+class WAVEVR_API FWaveVRTraceLog
+{
+public:
+	// Start the flusher.  The records before it are kept in the rings.
+	static void Start();
+	// Drain the rings, and stop the flusher.
+	static void Stop();
+	// Drain the rings now, in the caller thread.
+	static void Flush();
+
+	// Format a trace file into text.  Return false if the file is not a trace log.
+	static bool Decode(const FString& tracePath, const FString& textPath);
+
+	static FORCEINLINE bool IsEnabled(FWaveVRTraceSite& site) {
+		if (FPlatformAtomics::AtomicRead_Relaxed(&site.Generation) != FPlatformAtomics::AtomicRead_Relaxed(&Generation))
+			return Resolve(site);
+		return FPlatformAtomics::AtomicRead_Relaxed(&site.bEnabled) != 0;
+	}
+
+	template <typename... ArgTypes>
+	static void Write(const FWaveVRTraceSite& site, ArgTypes... args) {
+		FWaveVRTraceArgWriter writer;
+		int32 unused[] = { 0, (writer.Add(args), 0)... };
+		(void)unused;
+		Commit(site, writer);
+	}
+
+	// Called when the console variables are changed.
+	static void OnSettingsChanged();
+
+private:
+	static bool Resolve(FWaveVRTraceSite& site);
+	static void Commit(const FWaveVRTraceSite& site, const FWaveVRTraceArgWriter& writer);
+
+	// Increased when the levels are changed.  Start from 1, so a new site always resolves.
+	static int32 Generation;
+};
+
+#define TLOG_SITE(TAG, LEVEL, FMT, ...) \
+	do { \
+		static FWaveVRTraceSite WvrTraceSite = { #TAG, FMT, __FUNCTION__, __FILE__, __LINE__, EWaveVRTraceLevel::LEVEL, 0, 0, 0 }; \
+		if (FWaveVRTraceLog::IsEnabled(WvrTraceSite)) \
+			FWaveVRTraceLog::Write(WvrTraceSite, ##__VA_ARGS__); \
+	} while (0)
+
+#define TLOGV(TAG, fmt, ...) TLOG_SITE(TAG, Verbose, fmt, ##__VA_ARGS__)
+#define TLOGD(TAG, fmt, ...) TLOG_SITE(TAG, Debug, fmt, ##__VA_ARGS__)
+#define TLOGI(TAG, fmt, ...) TLOG_SITE(TAG, Info, fmt, ##__VA_ARGS__)
+#define TLOGW(TAG, fmt, ...) TLOG_SITE(TAG, Warning, fmt, ##__VA_ARGS__)
+
+// The function name is in the site, so an entry record has no argument.
+#define TLOG_FUNC() TLOGV(WVRFunc, "")
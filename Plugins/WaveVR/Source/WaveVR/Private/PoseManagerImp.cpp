@@ -10,6 +10,7 @@
 
 #include "PoseManagerImp.h"
 #include "WaveVRUtils.h"
+#include "WaveVRFrameTiming.h"
 #include "Platforms/WaveVRLogWrapper.h"
 
 DEFINE_LOG_CATEGORY_STATIC(PoseMgrImp, Log, All);
@@ -55,6 +56,7 @@ PoseManagerImp::PoseManagerImp()
 	controllerLeft = new Device(WVR_DeviceType_Controller_Left);
 	controllerRight = new Device(WVR_DeviceType_Controller_Right);
 	CheckSupportedNumOfDoF();
+	ResetPoseAgeStats();
 }
 
 PoseManagerImp::~PoseManagerImp()
@@ -256,6 +258,22 @@ bool PoseManagerImp::LateUpdate_RenderThread(FrameDataPtr frameData)
 	return posePairs[0].pose.isValidPose;
 }
 
+void PoseManagerImp::SyncPoses_RenderThread(FrameDataPtr frameData)
+{
+	LOG_FUNC();
+	SCOPED_NAMED_EVENT(SyncPoses, FColor::Magenta);
+	check(IsInRenderingThread());
+
+	WVR_DevicePosePair_t posePairs[WVR_DEVICE_COUNT_LEVEL_1];
+	WVR()->GetSyncPose(frameData->Origin, posePairs, WVR_DEVICE_COUNT_LEVEL_1);
+	SyncPoseMailbox.Publish(posePairs, frameData->Origin, frameData->frameNumber);
+}
+
+void PoseManagerImp::ResetPoseAgeStats()
+{
+	FMemory::Memzero(PoseAge);
+}
+
 /*Update all poses and return the assigned device position and Orientation*/
 void PoseManagerImp::UpdatePoses(FrameDataPtr frameData)
 {
@@ -276,17 +294,31 @@ void PoseManagerImp::UpdatePoses(FrameDataPtr frameData)
 			WVR()->GetPoseState(WVR_DeviceType_Controller_Left, Origin, predictMS, &(posePairs[1].pose));
 			posePairs[2].type = WVR_DeviceType_Controller_Right;
 			WVR()->GetPoseState(WVR_DeviceType_Controller_Right, Origin, predictMS, &(posePairs[2].pose));
+			FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::PoseSample, frameData->frameNumber);
 		}
 	} else {
-		SCOPED_NAMED_EVENT(GetSyncPose, FColor::Orange);
-		FRenderCommandFence Fence_Pose; //Avoid GetSyncPose twice in one submit.
-		Fence_Pose.BeginFence();
-		Fence_Pose.Wait();
-		WVR()->GetSyncPose(frameData->Origin, posePairs, WVR_DEVICE_COUNT_LEVEL_1);
+		// GetSyncPose should be called once in one submit, so RT do it.  Not to wait RT here.
+		SCOPED_NAMED_EVENT(ReadSyncPose, FColor::Orange);
+		FSyncPoseMailbox::FEntry entry;
+		if (SyncPoseMailbox.Read(entry) && entry.origin == frameData->Origin) {
+			FMemory::Memcpy(posePairs, entry.poses, sizeof(posePairs));
+
+			PoseAge.lastMs = (float)((FPlatformTime::Seconds() - entry.publishTime) * 1000.0);
+			PoseAge.lastFrames = frameData->frameNumber - entry.frameNumber;
+			PoseAge.maxMs = FMath::Max(PoseAge.maxMs, PoseAge.lastMs);
+			PoseAge.sumMs += PoseAge.lastMs;
+			PoseAge.count++;
+			// The poses were sampled when RT published them.
+			FWaveVRFrameTiming::GetInstance()->MarkAt(EWaveVRTimingStage::PoseSample, frameData->frameNumber, entry.publishTime);
+		} else {
+			// Keep the poses from previous frame.
+			PoseAge.missed++;
+		}
 	}
 
 	framePoses.ConvertWVRPosesToUnrealPoses(frameData->meterToWorldUnit);
 	UpdateDevice(frameData); //HMD , L-controller, R-controller
+	UpdatePoseHistory(frameData);
 
 #if DEBUG
 	PrintDeviceInfo(frameData);
@@ -320,3 +352,228 @@ void PoseManagerImp::PrintDeviceInfo(FrameDataPtr frameData) {
 		LOGD(PoseMgrImp, "Rotator_CompoundBase(Pitch,Roll,Yaw) is(%f, %f, %f)", dev->rotation_CompoundBase.Pitch, dev->rotation_CompoundBase.Roll, dev->rotation_CompoundBase.Yaw);
 	}
 }
+
+void PoseManagerImp::UpdatePoseHistory(FrameDataPtr frameData) {
+	auto& framePoses = frameData->poses;
+	for (int i = 0; i < WVR_DEVICE_COUNT_LEVEL_1; i++) {
+		int idx = framePoses.deviceIndexMap[i];
+		if (idx < 0 || idx >= WVR_DEVICE_COUNT_LEVEL_1 || !framePoses.wvrPoses[idx].pose.isValidPose)
+			continue;
+		PoseHistory[i].Push(framePoses.wvrPoses[idx].pose, framePoses.DeviceOrientation[i], framePoses.DevicePosition[i], frameData->meterToWorldUnit);
+	}
+}
+
+FPoseHistory* PoseManagerImp::GetPoseHistory(WVR_DeviceType Type) {
+	Device* device = GetDevice(Type);
+	if (device == nullptr)
+		return nullptr;
+	return &PoseHistory[device->index];
+}
+
+int64 PoseManagerImp::GetLatestPoseTimestamp(WVR_DeviceType Type) {
+	FPoseHistory* history = GetPoseHistory(Type);
+	FPoseHistory::FSample sample;
+	if (history == nullptr || !history->GetLatest(sample))
+		return 0;
+	return sample.timestamp;
+}
+
+bool PoseManagerImp::SamplePoseAt(WVR_DeviceType Type, int64 timestamp, FQuat& OutOrientation, FVector& OutPosition) {
+	FPoseHistory* history = GetPoseHistory(Type);
+	if (history == nullptr)
+		return false;
+	return history->SampleAt(timestamp, OutOrientation, OutPosition);
+}
+
+bool PoseManagerImp::SamplePoseAgo(WVR_DeviceType Type, float secondsAgo, FQuat& OutOrientation, FVector& OutPosition) {
+	int64 latest = GetLatestPoseTimestamp(Type);
+	if (latest == 0)
+		return false;
+	return SamplePoseAt(Type, latest - (int64)(secondsAgo * 1e9), OutOrientation, OutPosition);
+}
+
+bool PoseManagerImp::PredictPose(WVR_DeviceType Type, float predictSeconds, FQuat& OutOrientation, FVector& OutPosition) {
+	FPoseHistory* history = GetPoseHistory(Type);
+	if (history == nullptr)
+		return false;
+	return history->Predict(predictSeconds, OutOrientation, OutPosition);
+}
+
+/*
+ * FSyncPoseMailbox
+ */
+
+FSyncPoseMailbox::FSyncPoseMailbox()
+	: Sequence(0)
+	, PublishCount(0)
+{
+	FMemory::Memzero(Entry);
+}
+
+void FSyncPoseMailbox::Publish(const WVR_DevicePosePair_t * poses, WVR_PoseOriginModel origin, uint32 frameNumber) {
+	FPlatformAtomics::InterlockedIncrement(&Sequence);  // Odd, readers will retry.
+	FMemory::Memcpy(Entry.poses, poses, sizeof(Entry.poses));
+	Entry.origin = origin;
+	Entry.frameNumber = frameNumber;
+	Entry.publishTime = FPlatformTime::Seconds();
+	FPlatformAtomics::InterlockedIncrement(&Sequence);  // Even, done.
+	FPlatformAtomics::InterlockedIncrement(&PublishCount);
+}
+
+bool FSyncPoseMailbox::Read(FEntry& OutEntry) const {
+	if (FPlatformAtomics::AtomicRead(&PublishCount) == 0)
+		return false;
+
+	// The writer only publish once a frame.  A few retries are enough.
+	for (int i = 0; i < 4; i++) {
+		int32 before = FPlatformAtomics::AtomicRead(&Sequence);
+		if (before & 1) {
+			FPlatformProcess::Yield();
+			continue;
+		}
+		OutEntry = Entry;
+		FPlatformMisc::MemoryBarrier();
+		if (before == FPlatformAtomics::AtomicRead(&Sequence))
+			return true;
+	}
+	return false;
+}
+
+/*
+ * FPoseHistory
+ */
+
+FPoseHistory::FPoseHistory()
+	: Head(0)
+	, LastTimestamp(0)
+	, Clock(EClock::Unknown)
+{
+	for (int32 i = 0; i < Capacity; i++) {
+		Slots[i].sequence = 0;
+		Slots[i].index = -1;
+	}
+}
+
+void FPoseHistory::Clear() {
+	check(IsInGameThread());
+	// Readers will see the old samples as expired.
+	LastTimestamp = 0;
+	Clock = EClock::Unknown;
+	for (int32 i = 0; i < Capacity; i++) {
+		FPlatformAtomics::InterlockedIncrement(&Slots[i].sequence);
+		Slots[i].sample.timestamp = 0;
+		Slots[i].index = -1;
+		FPlatformAtomics::InterlockedIncrement(&Slots[i].sequence);
+	}
+	FPlatformAtomics::InterlockedExchange(&Head, 0);
+}
+
+void FPoseHistory::Push(const WVR_PoseState_t& pose, const FQuat& orientation, const FVector& position, float meterToWorldUnit) {
+	// Some runtime or simulator may not give the timestamp.  Then the local clock is used for the
+	// whole history, so two time bases are never mixed.
+	if (Clock == EClock::Unknown)
+		Clock = pose.timestamp != 0 ? EClock::Runtime : EClock::Local;
+
+	int64 timestamp;
+	if (Clock == EClock::Local) {
+		timestamp = (int64)(FPlatformTime::Seconds() * 1e9);
+	} else {
+		if (pose.timestamp == 0)
+			return;  // Can not be placed in the runtime time base.
+		timestamp = pose.timestamp;
+	}
+
+	// Poses copied from the last RT frame are not new.
+	if (timestamp <= LastTimestamp)
+		return;
+	LastTimestamp = timestamp;
+
+	const int32 head = FPlatformAtomics::AtomicRead(&Head);
+	FSlot& slot = Slots[head % Capacity];
+
+	FPlatformAtomics::InterlockedIncrement(&slot.sequence);  // Odd, readers will skip it.
+	slot.index = head;
+	slot.sample.timestamp = timestamp;
+	slot.sample.orientation = orientation;
+	slot.sample.position = position;
+	slot.sample.velocity = CoordinateUtil::GetVector3(pose.velocity, meterToWorldUnit);
+	// GL is right-handed, and Unreal is left-handed.  The rotation direction is reversed.
+	slot.sample.angularVelocity = FVector(pose.angularVelocity.v[2], -pose.angularVelocity.v[0], -pose.angularVelocity.v[1]);
+	slot.sample.pose = pose;
+	FPlatformAtomics::InterlockedIncrement(&slot.sequence);  // Even, done.
+
+	FPlatformAtomics::InterlockedIncrement(&Head);
+}
+
+bool FPoseHistory::ReadSlot(uint32 index, FSample& OutSample) const {
+	const FSlot& slot = Slots[index % Capacity];
+	int32 before = FPlatformAtomics::AtomicRead(&slot.sequence);
+	if (before & 1)
+		return false;
+	const int32 slotIndex = slot.index;
+	OutSample = slot.sample;
+	FPlatformMisc::MemoryBarrier();
+	int32 after = FPlatformAtomics::AtomicRead(&slot.sequence);
+	// If the writer has wrapped, the slot holds a newer sample than the wanted one.
+	return before == after && slotIndex == (int32)index && OutSample.timestamp != 0;
+}
+
+bool FPoseHistory::GetLatest(FSample& OutSample) const {
+	const int32 head = FPlatformAtomics::AtomicRead(&Head);
+	if (head <= 0)
+		return false;
+	return ReadSlot(head - 1, OutSample);
+}
+
+bool FPoseHistory::SampleAt(int64 timestamp, FQuat& OutOrientation, FVector& OutPosition) const {
+	const int32 head = FPlatformAtomics::AtomicRead(&Head);
+	const int32 tail = FMath::Max(0, head - Capacity);
+
+	FSample newer, older;
+	bool hasNewer = false;
+	int64 latestTimestamp = 0;
+	for (int32 i = head - 1; i >= tail; i--) {
+		if (!ReadSlot(i, older))
+			break;  // The writer has wrapped to here.  Rest are older.
+		if (!hasNewer)
+			latestTimestamp = older.timestamp;
+		else if (latestTimestamp - older.timestamp > DurationNs)
+			break;
+
+		if (older.timestamp <= timestamp) {
+			if (!hasNewer) {
+				// Later than the latest sample.
+				Extrapolate(older, (timestamp - older.timestamp) / 1e9f, OutOrientation, OutPosition);
+			} else {
+				float alpha = (float)(timestamp - older.timestamp) / (float)(newer.timestamp - older.timestamp);
+				OutOrientation = FQuat::Slerp(older.orientation, newer.orientation, alpha);
+				OutPosition = FMath::Lerp(older.position, newer.position, alpha);
+			}
+			return true;
+		}
+		newer = older;
+		hasNewer = true;
+	}
+	return false;
+}
+
+bool FPoseHistory::Predict(float predictSeconds, FQuat& OutOrientation, FVector& OutPosition) const {
+	FSample latest;
+	if (!GetLatest(latest))
+		return false;
+	Extrapolate(latest, predictSeconds, OutOrientation, OutPosition);
+	return true;
+}
+
+void FPoseHistory::Extrapolate(const FSample& sample, float seconds, FQuat& OutOrientation, FVector& OutPosition) {
+	OutPosition = sample.position + sample.velocity * seconds;
+
+	float speed = sample.angularVelocity.Size();
+	if (speed * FMath::Abs(seconds) > KINDA_SMALL_NUMBER) {
+		FQuat delta(sample.angularVelocity / speed, speed * seconds);
+		OutOrientation = delta * sample.orientation;
+		OutOrientation.Normalize();
+	} else {
+		OutOrientation = sample.orientation;
+	}
+}
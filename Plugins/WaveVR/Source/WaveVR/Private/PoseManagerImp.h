@@ -13,6 +13,99 @@
 #include "WaveVRHMD_FrameData.h"
 #include "HeadMountedDisplayTypes.h"
 
+/**
+ * Timestamped poses of one device in the last PoseHistory::Duration.
+ *
+ * Single writer (GT), many readers.  Each slot is guarded by its own sequence number, so a
+ * reader never blocks the writer, and a slot being rewritten is simply skipped.
+ * The position and orientation are in Unreal tracking space, and not include the game base.
+ */
+class FPoseHistory
+{
+public:
+	static const int32 Capacity = 64;  // 500ms in 120Hz
+	static const int64 DurationNs = 500 * 1000 * 1000;
+
+	struct FSample
+	{
+		int64 timestamp;  // Nanosecond, same time base of WVR_PoseState_t::timestamp, or FPlatformTime if the runtime gives none
+		FQuat orientation;
+		FVector position;
+		FVector velocity;  // Unreal units per second
+		FVector angularVelocity;  // Radians per second, Unreal axis
+		WVR_PoseState_t pose;
+	};
+
+public:
+	FPoseHistory();
+
+	// GT only
+	void Push(const WVR_PoseState_t& pose, const FQuat& orientation, const FVector& position, float meterToWorldUnit);
+	void Clear();
+
+	// Any thread
+	bool GetLatest(FSample& OutSample) const;
+	bool SampleAt(int64 timestamp, FQuat& OutOrientation, FVector& OutPosition) const;
+	bool Predict(float predictSeconds, FQuat& OutOrientation, FVector& OutPosition) const;
+
+	static void Extrapolate(const FSample& sample, float seconds, FQuat& OutOrientation, FVector& OutPosition);
+
+private:
+	bool ReadSlot(uint32 index, FSample& OutSample) const;
+
+	struct FSlot
+	{
+		volatile int32 sequence;  // Odd while writing
+		int32 index;  // The Head when it was pushed.  Tells a wrapped slot from the wanted one.
+		FSample sample;
+	};
+
+	// The time base is chosen by the first sample after Clear(), and kept for the whole history.
+	enum class EClock : uint8
+	{
+		Unknown,
+		Runtime,
+		Local,
+	};
+
+	FSlot Slots[Capacity];
+	volatile int32 Head;  // Number of samples ever pushed
+	int64 LastTimestamp;  // Only accessed by GT
+	EClock Clock;  // Only accessed by GT
+};
+
+/**
+ * Latest synced poses handed from render thread to game thread.
+ *
+ * The RT calls GetSyncPose once per submit and Publish() the result.  The GT Read() the most
+ * recent one without waiting the RT.  Single writer, guarded by a sequence number.
+ */
+class FSyncPoseMailbox
+{
+public:
+	struct FEntry
+	{
+		WVR_DevicePosePair_t poses[WVR_DEVICE_COUNT_LEVEL_1];
+		WVR_PoseOriginModel origin;
+		uint32 frameNumber;  // The game frame which the RT was consuming when published
+		double publishTime;  // FPlatformTime::Seconds()
+	};
+
+public:
+	FSyncPoseMailbox();
+
+	// RT only
+	void Publish(const WVR_DevicePosePair_t * poses, WVR_PoseOriginModel origin, uint32 frameNumber);
+
+	// Any thread.  Return false if nothing published yet, or the writer kept updating while reading.
+	bool Read(FEntry& OutEntry) const;
+
+private:
+	volatile int32 Sequence;  // Odd while writing
+	volatile int32 PublishCount;
+	FEntry Entry;
+};
+
 class PoseManagerImp
 {
 public:
@@ -51,6 +144,8 @@ public:
 	virtual ~PoseManagerImp();
 	void UpdatePoses(FrameDataPtr frameData); //Keep update per game frame
 	bool LateUpdate_RenderThread(FrameDataPtr frameData);
+	// Without late update, RT get the synced poses here and GT will use them in next frame.
+	void SyncPoses_RenderThread(FrameDataPtr frameData);
 
 public:
 	Device* GetDevice(WVR_DeviceType Type);
@@ -69,6 +164,27 @@ public:
 	EHMDTrackingOrigin::Type GetTrackingOriginPoses();
 	WVR_PoseOriginModel GetTrackingOriginModelInternal();
 
+public:
+	// Pose history.  Could be used in any thread.  Poses are in tracking space without the game base.
+	int64 GetLatestPoseTimestamp(WVR_DeviceType Type);
+	bool SamplePoseAt(WVR_DeviceType Type, int64 timestamp, FQuat& OutOrientation, FVector& OutPosition);
+	bool SamplePoseAgo(WVR_DeviceType Type, float secondsAgo, FQuat& OutOrientation, FVector& OutPosition);
+	bool PredictPose(WVR_DeviceType Type, float predictSeconds, FQuat& OutOrientation, FVector& OutPosition);
+
+public:
+	// How old the synced poses were when GT used them.  Only meaningful when late update is disabled.
+	struct FPoseAgeStats
+	{
+		float lastMs;
+		uint32 lastFrames;  // 1 means the poses were synced right after previous frame.
+		float maxMs;
+		float sumMs;
+		uint32 count;
+		uint32 missed;  // No synced poses available, and previous poses were reused.
+	};
+	FPoseAgeStats GetPoseAgeStats() const { return PoseAge; }
+	void ResetPoseAgeStats();
+
 public:
 	void UpdateDevice(FrameDataPtr frameData);
 
@@ -76,6 +192,8 @@ private:
 	PoseManagerImp(); //prevent new instance directly
 
 	void PrintDeviceInfo(FrameDataPtr frameData);
+	void UpdatePoseHistory(FrameDataPtr frameData);
+	FPoseHistory* GetPoseHistory(WVR_DeviceType Type);
 
 private:
 	Device* hmd = nullptr;
@@ -86,4 +204,9 @@ private:
 	EWVR_DOF ControllerSupportedDof = EWVR_DOF::DOF_3;
 	bool bIsHMDTrackingPosition = true;
 	bool bIsHMDTrackingRotation = true;
+
+	FPoseHistory PoseHistory[WVR_DEVICE_COUNT_LEVEL_1];  // Index is follow DeviceTypes.
+
+	FSyncPoseMailbox SyncPoseMailbox;
+	FPoseAgeStats PoseAge;  // Only accessed by GT
 };
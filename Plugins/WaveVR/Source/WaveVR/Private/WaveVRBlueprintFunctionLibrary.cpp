@@ -12,6 +12,7 @@
 #include "WaveVRPrivatePCH.h"
 #include "WaveVRHMD.h"
 #include "PoseManagerImp.h"
+#include "WaveVRFrameTiming.h"
 #include "WaveVRSplash.h"
 #include "Platforms/Editor/WaveVRDirectPreview.h"
 #include "Runtime/ImageWrapper/Public/IImageWrapper.h"
@@ -125,6 +126,40 @@ bool UWaveVRBlueprintFunctionLibrary::GetDevicePose(FVector& OutPosition, FRotat
 	return device->pose.pose.isValidPose;
 }
 
+static void ApplyGamePoseForDevice(const FQuat& orientation, const FVector& position, FRotator& OutOrientation, FVector& OutPosition)
+{
+	FWaveVRHMD* HMD = FWaveVRHMD::GetInstance();
+	FQuat gameOrientation = orientation;
+	// Same base as PoseManagerImp::UpdateDevice, from the frame data of this game frame.
+	if (HMD != nullptr && HMD->FrameData != nullptr)
+		WaveVRUtils::ApplyGamePose(orientation, position, HMD->FrameData->baseOrientation, HMD->FrameData->basePosition, gameOrientation, OutPosition);
+	else
+		OutPosition = position;
+	OutOrientation = gameOrientation.Rotator();
+}
+
+bool UWaveVRBlueprintFunctionLibrary::GetDevicePoseAgo(FVector& OutPosition, FRotator& OutOrientation, EWVR_DeviceType Type, float MilliSecondsAgo)
+{
+	PoseManagerImp* PoseMngr = PoseManagerImp::GetInstance();
+	FQuat orientation;
+	FVector position;
+	if (!PoseMngr->SamplePoseAgo(static_cast<WVR_DeviceType>(Type), MilliSecondsAgo / 1000.0f, orientation, position))
+		return false;
+	ApplyGamePoseForDevice(orientation, position, OutOrientation, OutPosition);
+	return true;
+}
+
+bool UWaveVRBlueprintFunctionLibrary::PredictDevicePose(FVector& OutPosition, FRotator& OutOrientation, EWVR_DeviceType Type, float MilliSeconds)
+{
+	PoseManagerImp* PoseMngr = PoseManagerImp::GetInstance();
+	FQuat orientation;
+	FVector position;
+	if (!PoseMngr->PredictPose(static_cast<WVR_DeviceType>(Type), MilliSeconds / 1000.0f, orientation, position))
+		return false;
+	ApplyGamePoseForDevice(orientation, position, OutOrientation, OutPosition);
+	return true;
+}
+
 void UWaveVRBlueprintFunctionLibrary::SetPosePredictEnabled(EWVR_DeviceType Type, bool enabled_position_predict, bool enabled_rotation_predict)
 {
 	FWaveVRAPIWrapper::GetInstance()->SetPosePredictEnabled(static_cast<WVR_DeviceType>(Type), enabled_position_predict, enabled_rotation_predict);
@@ -768,6 +803,16 @@ bool UWaveVRBlueprintFunctionLibrary::EnableAdaptiveQuality(bool enable, bool Se
 	return true;
 }
 
+void UWaveVRBlueprintFunctionLibrary::SetDynamicResolution(bool Enable, float MinDensity, float MaxDensity, float Headroom) {
+	FWaveVRDynamicResolution::Configure(Enable, MinDensity, MaxDensity, Headroom);
+}
+
+float UWaveVRBlueprintFunctionLibrary::GetPixelDensity() {
+	FWaveVRHMD* HMD = FWaveVRHMD::GetInstance();
+	if (HMD == nullptr) return 1.0f;
+	return HMD->GetPixelDenity();
+}
+
 void UWaveVRBlueprintFunctionLibrary::SetSplashParam(UTexture2D* InSplashTexture, FLinearColor BackGroundColor, float ScaleFactor, FVector2D Shift, bool EnableAutoLoading) {
 	FWaveVRHMD* HMD = FWaveVRHMD::GetInstance();
 	if (HMD == nullptr) return;
@@ -797,6 +842,22 @@ void UWaveVRBlueprintFunctionLibrary::HideSplashScreen() {
 	}
 }
 
+void UWaveVRBlueprintFunctionLibrary::SetSplashAnimation(const TArray<UTexture2D*>& Frames, float FramesPerSecond) {
+	FWaveVRHMD* HMD = FWaveVRHMD::GetInstance();
+	if (HMD == nullptr) return;
+	if (HMD->GetSplashScreen().IsValid()) {
+		HMD->GetSplashScreen()->SetSplashAnimation(Frames, FramesPerSecond);
+	}
+}
+
+void UWaveVRBlueprintFunctionLibrary::SetSplashProgress(float Progress) {
+	FWaveVRHMD* HMD = FWaveVRHMD::GetInstance();
+	if (HMD == nullptr) return;
+	if (HMD->GetSplashScreen().IsValid()) {
+		HMD->GetSplashScreen()->SetProgress(Progress);
+	}
+}
+
 int UWaveVRBlueprintFunctionLibrary::GetWaveVRRuntimeVersion() {
 	return FWaveVRAPIWrapper::GetInstance()->GetWaveRuntimeVersion();
 }
@@ -913,3 +974,27 @@ bool UWaveVRBlueprintFunctionLibrary::IsLateUpdateEnabled() {
 	FWaveVRHMD* HMD = FWaveVRHMD::GetInstance();
 	return HMD != nullptr && HMD->DoesSupportLateUpdate();
 }
+
+static void ToTimingPercentiles(const FWaveVRFrameTiming::FPercentiles& in, FWaveVRTimingPercentiles& out) {
+	out.P50 = in.p50;
+	out.P90 = in.p90;
+	out.P99 = in.p99;
+	out.Average = in.avg;
+	out.Max = in.max;
+}
+
+bool UWaveVRBlueprintFunctionLibrary::GetFrameTimingStats(FWaveVRFrameTimingStats& OutStats) {
+	OutStats = FWaveVRFrameTimingStats();
+	FWaveVRFrameTiming::FSummary summary;
+	if (!FWaveVRFrameTiming::GetInstance()->GetSummary(summary))
+		return false;
+
+	ToTimingPercentiles(summary.metrics[(int32)EWaveVRTimingMetric::GameThread], OutStats.GameThread);
+	ToTimingPercentiles(summary.metrics[(int32)EWaveVRTimingMetric::GameToRender], OutStats.GameToRender);
+	ToTimingPercentiles(summary.metrics[(int32)EWaveVRTimingMetric::PreRender], OutStats.PreRender);
+	ToTimingPercentiles(summary.metrics[(int32)EWaveVRTimingMetric::RenderThread], OutStats.RenderThread);
+	ToTimingPercentiles(summary.metrics[(int32)EWaveVRTimingMetric::PoseToSubmit], OutStats.PoseToSubmit);
+	ToTimingPercentiles(summary.metrics[(int32)EWaveVRTimingMetric::Total], OutStats.Total);
+	OutStats.Frames = summary.frames;
+	return true;
+}
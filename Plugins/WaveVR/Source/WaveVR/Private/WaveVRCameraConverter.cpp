@@ -0,0 +1,168 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRCameraConverter.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#define WVR_CAMERA_NEON 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define WVR_CAMERA_SSE2 1
+#endif
+
+// BT.601 limited range, scaled by 64.
+//   R = 1.164(Y-16) + 1.596(V-128)
+//   G = 1.164(Y-16) - 0.391(U-128) - 0.813(V-128)
+//   B = 1.164(Y-16) + 2.018(U-128)
+// 1.164 is rounded up to 75/64, so Y=235 reaches 255.  Only B may exceed int16.  The vector
+// paths saturate there, and it is clamped to 255 either way.
+#define CY 75
+#define CRV 102
+#define CGU 25
+#define CGV 52
+#define CBU 129
+
+void FWaveVRCameraConverter::NV21RowToRGBA_Scalar(const uint8* y, const uint8* vu, uint32 begin, uint32 end, uint8* dst)
+{
+	for (uint32 x = begin; x < end; x++) {
+		const int32 c = x & ~1u;
+		const int32 e = vu[c] - 128;
+		const int32 d = vu[c + 1] - 128;
+		const int32 luma = CY * (y[x] - 16) + 32;  // +32 to round
+		uint8* p = dst + x * 4;
+		p[0] = (uint8)FMath::Clamp((luma + CRV * e) >> 6, 0, 255);
+		p[1] = (uint8)FMath::Clamp((luma - (CGU * d + CGV * e)) >> 6, 0, 255);
+		p[2] = (uint8)FMath::Clamp((luma + CBU * d) >> 6, 0, 255);
+		p[3] = 255;
+	}
+}
+
+void FWaveVRCameraConverter::NV21ToRGBA_Scalar(const uint8* src, uint32 width, uint32 height, uint8* dst, uint32 dstPitch)
+{
+	const uint8* vuPlane = src + width * height;
+	for (uint32 row = 0; row < height; row++) {
+		NV21RowToRGBA_Scalar(src + row * width, vuPlane + (row / 2) * width, 0, width, dst + row * dstPitch);
+	}
+}
+
+void FWaveVRCameraConverter::NV21ToRGBA(const uint8* src, uint32 width, uint32 height, uint8* dst, uint32 dstPitch)
+{
+#if WVR_CAMERA_NEON
+	const int16x8_t k16 = vdupq_n_s16(16);
+	const int16x8_t k32 = vdupq_n_s16(32);
+	const int16x8_t k128 = vdupq_n_s16(128);
+	const uint8x16_t alpha = vdupq_n_u8(255);
+#elif WVR_CAMERA_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i k16 = _mm_set1_epi16(16);
+	const __m128i k32 = _mm_set1_epi16(32);
+	const __m128i k128 = _mm_set1_epi16(128);
+	const __m128i kY = _mm_set1_epi16(CY);
+	const __m128i kRV = _mm_set1_epi16(CRV);
+	const __m128i kGU = _mm_set1_epi16(CGU);
+	const __m128i kGV = _mm_set1_epi16(CGV);
+	const __m128i kBU = _mm_set1_epi16(CBU);
+	const __m128i lowByte = _mm_set1_epi16(0x00ff);
+	const __m128i alpha = _mm_set1_epi8((char)0xff);
+#endif
+
+	const uint8* vuPlane = src + width * height;
+	for (uint32 row = 0; row < height; row++) {
+		const uint8* y = src + row * width;
+		const uint8* vu = vuPlane + (row / 2) * width;
+		uint8* out = dst + row * dstPitch;
+		uint32 x = 0;
+
+#if WVR_CAMERA_NEON
+		// 16 pixels share 8 VU pairs.
+		for (; x + 16 <= width; x += 16) {
+			const uint8x16_t yv = vld1q_u8(y + x);
+			const uint8x8x2_t vu8 = vld2_u8(vu + x);
+			const int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vu8.val[0])), k128);
+			const int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vu8.val[1])), k128);
+
+			// Chroma of each pair is used by 2 pixels.
+			const int16x8_t rc = vmulq_n_s16(e, CRV);
+			const int16x8_t gc = vnegq_s16(vmlaq_n_s16(vmulq_n_s16(d, CGU), e, CGV));
+			const int16x8_t bc = vmulq_n_s16(d, CBU);
+			const int16x8x2_t r2 = vzipq_s16(rc, rc);
+			const int16x8x2_t g2 = vzipq_s16(gc, gc);
+			const int16x8x2_t b2 = vzipq_s16(bc, bc);
+
+			const int16x8_t ylo = vaddq_s16(vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(yv))), k16), CY), k32);
+			const int16x8_t yhi = vaddq_s16(vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(yv))), k16), CY), k32);
+
+			uint8x16x4_t rgba;
+			rgba.val[0] = vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(ylo, r2.val[0]), 6)), vqmovun_s16(vshrq_n_s16(vqaddq_s16(yhi, r2.val[1]), 6)));
+			rgba.val[1] = vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(ylo, g2.val[0]), 6)), vqmovun_s16(vshrq_n_s16(vqaddq_s16(yhi, g2.val[1]), 6)));
+			rgba.val[2] = vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(ylo, b2.val[0]), 6)), vqmovun_s16(vshrq_n_s16(vqaddq_s16(yhi, b2.val[1]), 6)));
+			rgba.val[3] = alpha;
+			vst4q_u8(out + x * 4, rgba);
+		}
+#elif WVR_CAMERA_SSE2
+		for (; x + 16 <= width; x += 16) {
+			const __m128i yv = _mm_loadu_si128((const __m128i*)(y + x));
+			const __m128i vu16 = _mm_loadu_si128((const __m128i*)(vu + x));  // Each lane is V | U << 8
+			const __m128i e = _mm_sub_epi16(_mm_and_si128(vu16, lowByte), k128);
+			const __m128i d = _mm_sub_epi16(_mm_srli_epi16(vu16, 8), k128);
+
+			const __m128i rc = _mm_mullo_epi16(e, kRV);
+			const __m128i gc = _mm_sub_epi16(zero, _mm_add_epi16(_mm_mullo_epi16(d, kGU), _mm_mullo_epi16(e, kGV)));
+			const __m128i bc = _mm_mullo_epi16(d, kBU);
+
+			const __m128i ylo = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(yv, zero), k16), kY), k32);
+			const __m128i yhi = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(yv, zero), k16), kY), k32);
+
+			const __m128i r = _mm_packus_epi16(
+				_mm_srai_epi16(_mm_adds_epi16(ylo, _mm_unpacklo_epi16(rc, rc)), 6),
+				_mm_srai_epi16(_mm_adds_epi16(yhi, _mm_unpackhi_epi16(rc, rc)), 6));
+			const __m128i g = _mm_packus_epi16(
+				_mm_srai_epi16(_mm_adds_epi16(ylo, _mm_unpacklo_epi16(gc, gc)), 6),
+				_mm_srai_epi16(_mm_adds_epi16(yhi, _mm_unpackhi_epi16(gc, gc)), 6));
+			const __m128i b = _mm_packus_epi16(
+				_mm_srai_epi16(_mm_adds_epi16(ylo, _mm_unpacklo_epi16(bc, bc)), 6),
+				_mm_srai_epi16(_mm_adds_epi16(yhi, _mm_unpackhi_epi16(bc, bc)), 6));
+
+			const __m128i rg0 = _mm_unpacklo_epi8(r, g);
+			const __m128i rg1 = _mm_unpackhi_epi8(r, g);
+			const __m128i ba0 = _mm_unpacklo_epi8(b, alpha);
+			const __m128i ba1 = _mm_unpackhi_epi8(b, alpha);
+			__m128i* o = (__m128i*)(out + x * 4);
+			_mm_storeu_si128(o + 0, _mm_unpacklo_epi16(rg0, ba0));
+			_mm_storeu_si128(o + 1, _mm_unpackhi_epi16(rg0, ba0));
+			_mm_storeu_si128(o + 2, _mm_unpacklo_epi16(rg1, ba1));
+			_mm_storeu_si128(o + 3, _mm_unpackhi_epi16(rg1, ba1));
+		}
+#endif
+
+		// The rest columns
+		NV21RowToRGBA_Scalar(y, vu, x, width, out);
+	}
+}
+
+void FWaveVRCameraConverter::GrayToRGBA(const uint8* src, uint32 width, uint32 height, uint8* dst, uint32 dstPitch)
+{
+	for (uint32 row = 0; row < height; row++) {
+		const uint8* y = src + row * width;
+		uint32* out = (uint32*)(dst + row * dstPitch);
+		for (uint32 x = 0; x < width; x++) {
+			const uint32 l = y[x];
+			// Little endian, bytes are R G B A.
+			out[x] = 0xff000000 | (l << 16) | (l << 8) | l;
+		}
+	}
+}
+
+#undef CY
+#undef CRV
+#undef CGU
+#undef CGV
+#undef CBU
@@ -0,0 +1,37 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Convert the camera image to the R8G8B8A8 texture data.
+ *
+ * NV21 is the Y plane followed by the interleaved V/U plane in half resolution.  It is converted
+ * by BT.601 limited range in 6 bits fixed point, so the intermediate fits in int16 lanes.  The NEON
+ * and SSE2 paths give the same result as the scalar path, bit by bit.  The scalar path is the
+ * reference, and also handles the columns not fitting the vector width.
+ */
+class FWaveVRCameraConverter
+{
+public:
+	// dstPitch is in bytes.  The width and height should be even.
+	static void NV21ToRGBA(const uint8* src, uint32 width, uint32 height, uint8* dst, uint32 dstPitch);
+	static void NV21ToRGBA_Scalar(const uint8* src, uint32 width, uint32 height, uint8* dst, uint32 dstPitch);
+
+	// Only use the Y plane.
+	static void GrayToRGBA(const uint8* src, uint32 width, uint32 height, uint8* dst, uint32 dstPitch);
+
+	static inline uint32 GetNV21Size(uint32 width, uint32 height) { return width * height + (width / 2) * (height / 2) * 2; }
+
+private:
+	static void NV21RowToRGBA_Scalar(const uint8* y, const uint8* vu, uint32 begin, uint32 end, uint8* dst);
+};
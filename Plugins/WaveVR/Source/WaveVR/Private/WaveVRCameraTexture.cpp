@@ -11,6 +11,7 @@
 #include "WaveVRCameraTexture.h"
 #include "WaveVRPrivatePCH.h"
 #include "Logging/LogMacros.h"
+#include "WaveVRCameraConverter.h"
 
 DEFINE_LOG_CATEGORY_STATIC(WVR_Camera, Display, All);
 
@@ -63,7 +64,6 @@ UTexture2D*  UWaveVRCameraTexture::getCameraTexture()
 				mSize = cameraInfo.size;
 				mWidth = cameraInfo.width;
 				mHeight = cameraInfo.height;
-				nativeRawData = (uint8_t *)malloc(mSize);
 				mImgType = (EWVR_CameraImageType)WVR_CameraImageType_SingleEye;
 				mImgFormat = (EWVR_CameraImageFormat)cameraInfo.imgFormat;
 			}
@@ -71,7 +71,6 @@ UTexture2D*  UWaveVRCameraTexture::getCameraTexture()
 				mSize = cameraInfo.size;
 				mWidth = cameraInfo.width;
 				mHeight = cameraInfo.height;
-				nativeRawData = (uint8_t *)malloc(mSize);
 				mImgType = (EWVR_CameraImageType)WVR_CameraImageType_DualEye;
 				mImgFormat = (EWVR_CameraImageFormat)cameraInfo.imgFormat;
 			}
@@ -88,11 +87,17 @@ UTexture2D*  UWaveVRCameraTexture::getCameraTexture()
 			mHeight = 480;
 		}
 
-		//create texture
-		CameraTexture = UTexture2D::CreateTransient(mWidth, mHeight, mPixelFormat);
-		echoUpdateTextureRegion = new FUpdateTextureRegion2D(0, 0, 0, 0, mWidth, mHeight);
-		CameraTexture->UpdateResource();
-		rawData.Init(FColor(0, 0, 0, 255), mWidth*mHeight);
+		// Allocate once.  They are reused by every frame.
+		mFrameBuffer.SetNumUninitialized(FMath::Max(mSize, mWidth * mHeight));
+		for (int32 i = 0; i < StagingCount; i++)
+			mStaging[i].SetNumUninitialized(mWidth * mHeight * 4);
+		mUpdateRegion = FUpdateTextureRegion2D(0, 0, 0, 0, mWidth, mHeight);
+
+		// The texture persists.  Only create it again if the size changed.
+		if (CameraTexture == nullptr || CameraTexture->GetSizeX() != mWidth || CameraTexture->GetSizeY() != mHeight) {
+			CameraTexture = UTexture2D::CreateTransient(mWidth, mHeight, mPixelFormat);
+			CameraTexture->UpdateResource();
+		}
 
 		PrimaryComponentTick.bCanEverTick = true;
 		PrimaryComponentTick.TickGroup = TG_PostPhysics;
@@ -100,6 +105,12 @@ UTexture2D*  UWaveVRCameraTexture::getCameraTexture()
 	return CameraTexture;
 }
 
+void UWaveVRCameraTexture::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	shutdownCamera();
+	Super::EndPlay(EndPlayReason);
+}
+
 void UWaveVRCameraTexture::shutdownCamera()
 {
 	if (bActive)
@@ -111,8 +122,11 @@ void UWaveVRCameraTexture::shutdownCamera()
 		mHeight = 0;
 	}
 
-	if (echoUpdateTextureRegion != nullptr) {
-		delete echoUpdateTextureRegion;
+	// RT may still read the staging.
+	waitStaging();
+	if (mSkippedFrames > 0) {
+		LOGD(WVR_Camera, "Skipped %u camera frames because the texture upload was not done", mSkippedFrames);
+		mSkippedFrames = 0;
 	}
 }
 
@@ -122,66 +136,15 @@ void UWaveVRCameraTexture::updateCamera(float delta)
 	if (timer >= (1.f / frameRate))
 	{
 		timer = 0;
-		if (CameraTexture && bActive)
+		if (CameraTexture && bActive && mFrameBuffer.Num() > 0)
 		{
-			bool ret = FWaveVRAPIWrapper::GetInstance()->GetCameraFrameBuffer(nativeRawData, mSize);
-			if (nativeRawData != nullptr) {
-				// updateTexture(nativeRawData);
-				//LOGE(WVR_Camera, "start SW codec");
-				updateTextureG(nativeRawData);
-				//LOGE(WVR_Camera, "end SW codec");
+			bool ret = FWaveVRAPIWrapper::GetInstance()->GetCameraFrameBuffer(mFrameBuffer.GetData(), mFrameBuffer.Num());
+			if (ret) {
+				updateTexture(mFrameBuffer.GetData());
 			}
 		}
 	}
 }
-/*
-void UWaveVRCameraTexture::updateTexture(uint8_t* data)
-{
-	if (data == NULL) return;
-
-#if WAVEVR_SUPPORTED_PLATFORMS
-	// fill my Texture Region data
-	FUpdateTextureRegionsData* RegionData = new FUpdateTextureRegionsData;
-	RegionData->Texture2DResource = (FTexture2DResource*)CameraTexture->Resource;
-	RegionData->MipIndex = 0;
-	RegionData->NumRegions = 1;
-	RegionData->Regions = echoUpdateTextureRegion;
-	RegionData->SrcPitch = (uint32)(4 * mWidth);
-	RegionData->SrcBpp = 4;
-
-	uint8_t* yarray = (uint8_t*)data;
-	uint8_t* uarray = yarray + (mWidth * mHeight);
-	uint8_t* varray = yarray + (mWidth * mHeight) + (mWidth * mHeight) / 4;
-	int ptr = 0;
-	uint8_t* rgb = new uint8_t[mWidth * mHeight * 4];
-
-	for (int y = 0; y < mHeight; y++) {
-		for (int x = 0; x < mWidth; x++) {
-			int yy = *(yarray + (y * mWidth) + x);
-			int uu = *(uarray + ((y / 2) * (mWidth / 2)) + (x / 2));
-			int vv = *(varray + ((y / 2) * (mWidth / 2)) + (x / 2));
-
-			int r = 1.164 * (yy - 16) + 1.596 * (vv - 128);
-			int g = 1.164 * (yy - 16) - 0.813 * (vv - 128) - 0.391 * (uu - 128);
-			int b = 1.164 * (yy - 16) + 2.018 * (uu - 128);
-			rgb[ptr++] = r > 255 ? 255 : r < 0 ? 0 : r;
-			rgb[ptr++] = g > 255 ? 255 : g < 0 ? 0 : g;
-			rgb[ptr++] = b > 255 ? 255 : b < 0 ? 0 : b;
-			rgb[ptr++] = 255;
-		}
-	}
-	RegionData->SrcData = (uint8*)rgb;
-
-	FTexture2DMipMap& Mip = CameraTexture->PlatformData->Mips[0];
-	void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
-	FMemory::Memcpy(Data, RegionData->SrcData, mWidth * mHeight * 4);
-	Mip.BulkData.Unlock();
-	CameraTexture->UpdateResource();
-	delete[] rgb;
-	delete RegionData;
-#endif
-}
-*/
 
 EWVR_CameraImageFormat UWaveVRCameraTexture::getCameraImageFormat() {
 	return (bActive ? mImgFormat : EWVR_CameraImageFormat::WVR_CameraImageFormat_Invalid);
@@ -209,77 +172,39 @@ void UWaveVRCameraTexture::reset() {
 	mHeight = 0;
 	mImgFormat = (EWVR_CameraImageFormat)WVR_CameraImageFormat_Invalid;
 	mImgType = (EWVR_CameraImageType)WVR_CameraImageType_Invalid;
-	if (nativeRawData != nullptr) {
-		delete nativeRawData;
-		nativeRawData = nullptr;
-	}
+	mStagingIndex = 0;
+	mSkippedFrames = 0;
+	mFrameBuffer.Empty();
 }
 
-void UWaveVRCameraTexture::updateTextureG(uint8_t* data)
+void UWaveVRCameraTexture::waitStaging()
 {
-	if (data == NULL) return;
-
-	// fill my Texture Region data
-	FUpdateTextureRegionsData* RegionData = new FUpdateTextureRegionsData;
-	RegionData->Texture2DResource = (FTexture2DResource*)CameraTexture->Resource;
-	RegionData->MipIndex = 0;
-	RegionData->NumRegions = 1;
-	RegionData->Regions = echoUpdateTextureRegion;
-	RegionData->SrcPitch = (uint32)(4 * mWidth);
-	RegionData->SrcBpp = 4;
-
-	char* yuv420sp = (char*)data;
-	int* rgb = new int[mWidth * mHeight];
-	if (!nativeRawData) return;
-
-	int size = mWidth*mHeight;
-	int offset = size;
-
-	int u, v, y1, y2, y3, y4;
-
-//    for (int i = 0, k = 0; i < size; i += 2, k += 2) {
-	for (int i = 0, k = 0; i < size; i += 2, k += 1) {
-		y1 = yuv420sp[i] & 0xff;
-		y2 = yuv420sp[i + 1] & 0xff;
-		y3 = yuv420sp[mWidth + i] & 0xff;
-		y4 = yuv420sp[mWidth + i + 1] & 0xff;
-
-	   // u = yuv420sp[offset + k] & 0xff;
-	   // v = yuv420sp[offset + (mWidth/2 * mHeight/2) + k] & 0xff;
-		u = 0;//u - 128;
-		v = 0;//v - 128;
+	for (int32 i = 0; i < StagingCount; i++)
+		mStagingFence[i].Wait();
+}
 
-		rgb[i] = YUVtoRGB(y1, u, v);
-		rgb[i + 1] = YUVtoRGB(y2, u, v);
-		rgb[mWidth + i] = YUVtoRGB(y3, u, v);
-		rgb[mWidth + i + 1] = YUVtoRGB(y4, u, v);
+void UWaveVRCameraTexture::updateTexture(const uint8* data)
+{
+	if (data == NULL) return;
 
-		if (i != 0 && (i + 2) % mWidth == 0)
-			i += mWidth;
+	// Not to stall the game thread.  Drop this frame if the RT has not uploaded this staging yet.
+	if (!mStagingFence[mStagingIndex].IsFenceComplete()) {
+		mSkippedFrames++;
+		return;
 	}
 
-	RegionData->SrcData = (uint8*)rgb;
+	TArray<uint8>& staging = mStaging[mStagingIndex];
+	const uint32 pitch = mWidth * 4;
+	if (mImgFormat == EWVR_CameraImageFormat::WVR_CameraImageFormat_YUV_420 && mSize >= FWaveVRCameraConverter::GetNV21Size(mWidth, mHeight)) {
+		FWaveVRCameraConverter::NV21ToRGBA(data, mWidth, mHeight, staging.GetData(), pitch);
+	} else {
+		FWaveVRCameraConverter::GrayToRGBA(data, mWidth, mHeight, staging.GetData(), pitch);
+	}
 
-	FTexture2DMipMap& Mip = CameraTexture->PlatformData->Mips[0];
-	void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
-	FMemory::Memcpy(Data, RegionData->SrcData, mWidth * mHeight * 4);
-	Mip.BulkData.Unlock();
-	CameraTexture->UpdateResource();
+	// Update the existing texture in RT.  The staging and region are owned by this component.
+	CameraTexture->UpdateTextureRegions(0, 1, &mUpdateRegion, pitch, 4, staging.GetData());
+	mStagingFence[mStagingIndex].BeginFence();
+	mStagingIndex = (mStagingIndex + 1) % StagingCount;
 
-	delete[] rgb;
-	delete RegionData;
 	bUpdated = true;
 }
-
-int UWaveVRCameraTexture::YUVtoRGB(int y, int u, int v)
-{
-	int r, g, b;
-	r = y + (int)1.402f*v;
-	g = y - (int)(0.344f*u + 0.714f*v);
-	b = y + (int)1.772f*u;
-	r = r>255 ? 255 : r<0 ? 0 : r;
-	g = g>255 ? 255 : g<0 ? 0 : g;
-	b = b>255 ? 255 : b<0 ? 0 : b;
-	//return 0x000000ff | (r << 24) | (g << 16) | (b << 8);
-	return 0xff000000 | (r << 16) | (g << 8) | b;
-}
@@ -39,6 +39,19 @@ static TAutoConsoleVariable<int32> CVarEyeTrackingEnable(
 	ECVF_RenderThreadSafe);
 
 
+/****************************************************
+ *
+ * Console Variable: Input
+ *
+ ****************************************************/
+
+static TAutoConsoleVariable<float> CVarHapticsMinInterval(
+	TEXT("wvr.Haptics.MinIntervalMs"),
+	/*default value*/ 50.0f,
+	TEXT("Min time in milliseconds between two vibration pulses of a controller, sent for the haptic effects.\n"),
+	ECVF_Default);
+
+
 /****************************************************
  *
  * Console Variable: Render
@@ -76,6 +89,58 @@ static TAutoConsoleVariable<int32> CVarFoveatedRenderingPeripheralQuality(
 	TEXT("  2: high quality (default)"),
 	ECVF_RenderThreadSafe);
 
+static TAutoConsoleVariable<int32> CVarFoveatedRenderingScheduler(
+	TEXT("wvr.FoveatedRendering.Scheduler"),
+	/*default value*/ 0,
+	TEXT("1. Move the foveation between presets by the frame time, and the quality and thermal events of the runtime.  The mode will be set to enable.\n")
+	TEXT("0. Disable it.  The foveation params are only set by code.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFoveatedRenderingBlendFrames(
+	TEXT("wvr.FoveatedRendering.BlendFrames"),
+	/*default value*/ 15,
+	TEXT("Number of frames the scheduler takes to blend from one foveation preset to another.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTextureQueueWaitBudget(
+	TEXT("wvr.TextureQueue.WaitBudgetMs"),
+	/*default value*/ 0.0f,
+	TEXT("Max time in milliseconds to wait for an available texture when the WVR texture queue is empty.  The render thread sleeps while waiting.\n")
+	TEXT("0. Not to wait.  Overwrite the earliest acquired texture directly.  Default.\n"),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarTextureQueueStarvationThreshold(
+	TEXT("wvr.TextureQueue.StarvationThreshold"),
+	/*default value*/ 3,
+	TEXT("Report the texture queue starvation when the queue has no available texture in this number of consecutive frames.\n"),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarDynamicResolutionEnable(
+	TEXT("wvr.DynamicResolution.enable"),
+	/*default value*/ 0,
+	TEXT("1. Adjust the pixel density by the GPU and render thread frame time.\n")
+	TEXT("0. Disable it.  The pixel density is only set by code.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDynamicResolutionMinDensity(
+	TEXT("wvr.DynamicResolution.MinDensity"),
+	/*default value*/ 0.5f,
+	TEXT("The lowest pixel density the dynamic resolution can use.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDynamicResolutionMaxDensity(
+	TEXT("wvr.DynamicResolution.MaxDensity"),
+	/*default value*/ 1.0f,
+	TEXT("The highest pixel density.  The eye textures are allocated in this density, larger than 1 is supersampling, e.g. 1.5.\n")
+	TEXT("It also limits the SetPixelDensity.  The eye textures are reallocated when changed.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDynamicResolutionHeadroom(
+	TEXT("wvr.DynamicResolution.Headroom"),
+	/*default value*/ 0.1f,
+	TEXT("Part of the frame time budget kept free.  0.1 means the frame should use at most 90% of the budget.\n"),
+	ECVF_Default);
+
 /****************************************************
  *
  * Console Variable: Direct Preview
@@ -146,3 +211,41 @@ static TAutoConsoleVariable<int32> CVarAdaptiveQualityAutoFoveation(
 	TEXT("0. Do not adjust foveation automatically.\n")
 	TEXT("1. Enable/ disable foveation or adjust PeripheralQuality automatically.\n"),
 	ECVF_SetByProjectSetting);
+
+/****************************************************
+ *
+ * Console Variable: Log
+ *
+ ****************************************************/
+
+static TAutoConsoleVariable<int32> CVarTraceLogEnable(
+	TEXT("wvr.TraceLog.enable"),
+	/*default value*/ 0,
+	TEXT("1. Record the trace log points into the binary trace log under Saved/WaveVR/TraceLog.\n")
+	TEXT("0. Disable all trace log points.  Default.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTraceLogMaxFileSize(
+	TEXT("wvr.TraceLog.MaxFileSizeMB"),
+	/*default value*/ 16,
+	TEXT("When the trace log reaches this size, it is renamed to <file>.1.wvrlog, replacing the previous one, and a new file is started.\n")
+	TEXT("So at most twice of this size is kept on the storage.  0 or less is unlimited.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTraceLogLevel(
+	TEXT("wvr.TraceLog.Level"),
+	/*default value*/ 1,
+	TEXT("The lowest level recorded, for the categories not in wvr.TraceLog.Categories.\n")
+	TEXT("  0: Verbose, include the function entries\n")
+	TEXT("  1: Debug (default)\n")
+	TEXT("  2: Info\n")
+	TEXT("  3: Warning\n")
+	TEXT("  4: Error\n")
+	TEXT("  5: Off"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarTraceLogCategories(
+	TEXT("wvr.TraceLog.Categories"),
+	/*default value*/ TEXT(""),
+	TEXT("Level of each category, for example \"WVRFunc=Verbose,LogWaveVRInput=Info\".  The level can be a name or a number of wvr.TraceLog.Level.\n"),
+	ECVF_Default);
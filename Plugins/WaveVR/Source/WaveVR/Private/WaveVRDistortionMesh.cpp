@@ -0,0 +1,310 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRDistortionMesh.h"
+#include "WaveVRPrivatePCH.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "RHICommandList.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRDistortion, Log, All);
+
+static const float kVignetteHardness = 25;
+// A point is solved if its green uv is this close to the grid point.
+static const float kEpsilon = 0.001f;
+static const int32 kMaxCachedMeshes = 8;
+
+FWaveVRDistortionCoefficients FWaveVRDistortionCoefficients::GetDefault(EStereoscopicPass eye)
+{
+	FWaveVRDistortionCoefficients c;
+	c.K1[0] = 0.21f; c.K2[0] = 0.21f;
+	c.K1[1] = 0.23f; c.K2[1] = 0.23f;
+	c.K1[2] = 0.25f; c.K2[2] = 0.25f;
+	return c;
+}
+
+static inline float GetVignette(float x, float y)
+{
+	return FMath::Clamp(x * kVignetteHardness, 0.0f, 1.0f)
+		* FMath::Clamp((1 - x) * kVignetteHardness, 0.0f, 1.0f)
+		* FMath::Clamp(y * kVignetteHardness, 0.0f, 1.0f)
+		* FMath::Clamp((1 - y) * kVignetteHardness, 0.0f, 1.0f);
+}
+
+/* Solver */
+
+void FWaveVRDistortionSolver::SolvePointReference(const FWaveVRDistortionCoefficients& c, const double target[2], double outPos[2], double outUV[3][2])
+{
+	double u[2] = { target[0], target[1] };
+	for (int32 i = 0; i < MaxIterations; i++) {
+		// Adjust [0, 1] to [-1, 1]
+		const double in[2] = { (u[0] - 0.5) * 2, (u[1] - 0.5) * 2 };
+		const double r2 = in[0] * in[0] + in[1] * in[1];
+		const double r4 = r2 * r2;
+		for (int32 ch = 0; ch < 3; ch++) {
+			const double scale = 1 + (double)c.K1[ch] * r2 + (double)c.K2[ch] * r4;
+			outUV[ch][0] = in[0] * scale / 2 + 0.5;
+			outUV[ch][1] = in[1] * scale / 2 + 0.5;
+		}
+
+		const double delta[2] = { target[0] - outUV[1][0], target[1] - outUV[1][1] };
+		if (FMath::Sqrt(delta[0] * delta[0] + delta[1] * delta[1]) < kEpsilon)
+			break;
+		if (i != MaxIterations - 1) {
+			u[0] += delta[0] * 0.5;
+			u[1] += delta[1] * 0.5;
+		}
+	}
+	outPos[0] = u[0];
+	outPos[1] = u[1];
+}
+
+void FWaveVRDistortionSolver::SolveRow(const FWaveVRDistortionCoefficients& c, uint32 y, uint32 pointsX, uint32 pointsY, FDistortionVertex* outRow)
+{
+	const VectorRegister Half = VectorSetFloat1(0.5f);
+	const VectorRegister Two = VectorSetFloat1(2.0f);
+	const VectorRegister One = VectorOne();
+	const VectorRegister Epsilon2 = VectorSetFloat1(kEpsilon * kEpsilon);
+	const VectorRegister AllLanes = VectorCompareEQ(One, One);
+	VectorRegister K1[3], K2[3];
+	for (int32 ch = 0; ch < 3; ch++) {
+		K1[ch] = VectorSetFloat1(c.K1[ch]);
+		K2[ch] = VectorSetFloat1(c.K2[ch]);
+	}
+
+	const float targetY = float(y) / float(pointsY - 1);
+	const VectorRegister TY = VectorSetFloat1(targetY);
+
+	for (uint32 x0 = 0; x0 < pointsX; x0 += 4) {
+		const uint32 lanes = FMath::Min(pointsX - x0, 4u);
+
+		// The lanes out of the row repeat the last point.
+		float targetX[4];
+		for (uint32 lane = 0; lane < 4; lane++)
+			targetX[lane] = float(FMath::Min(x0 + lane, pointsX - 1)) / float(pointsX - 1);
+		const VectorRegister TX = VectorLoad(targetX);
+
+		VectorRegister UX = TX, UY = TY;
+		VectorRegister DX[3], DY[3];
+		VectorRegister Active = AllLanes;
+		for (int32 i = 0; i < MaxIterations; i++) {
+			const VectorRegister InX = VectorMultiply(VectorSubtract(UX, Half), Two);
+			const VectorRegister InY = VectorMultiply(VectorSubtract(UY, Half), Two);
+			const VectorRegister R2 = VectorMultiplyAdd(InX, InX, VectorMultiply(InY, InY));
+			const VectorRegister R4 = VectorMultiply(R2, R2);
+			for (int32 ch = 0; ch < 3; ch++) {
+				const VectorRegister Scale = VectorMultiply(VectorMultiplyAdd(K2[ch], R4, VectorMultiplyAdd(K1[ch], R2, One)), Half);
+				DX[ch] = VectorMultiplyAdd(InX, Scale, Half);
+				DY[ch] = VectorMultiplyAdd(InY, Scale, Half);
+			}
+
+			const VectorRegister DeltaX = VectorSubtract(TX, DX[1]);
+			const VectorRegister DeltaY = VectorSubtract(TY, DY[1]);
+			const VectorRegister Length2 = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+			Active = VectorBitwiseAnd(Active, VectorCompareGE(Length2, Epsilon2));
+			if (VectorMaskBits(Active) == 0)
+				break;
+			if (i != MaxIterations - 1) {
+				UX = VectorSelect(Active, VectorMultiplyAdd(DeltaX, Half, UX), UX);
+				UY = VectorSelect(Active, VectorMultiplyAdd(DeltaY, Half, UY), UY);
+			}
+		}
+
+		// The uvs are of the final positions, because a converged lane doesn't move.
+		float ux[4], uy[4], dx[3][4], dy[3][4];
+		VectorStore(UX, ux);
+		VectorStore(UY, uy);
+		for (int32 ch = 0; ch < 3; ch++) {
+			VectorStore(DX[ch], dx[ch]);
+			VectorStore(DY[ch], dy[ch]);
+		}
+
+		for (uint32 lane = 0; lane < lanes; lane++) {
+			FDistortionVertex& v = outRow[x0 + lane];
+			// The screen y is down.
+			v.Position = FVector2D(ux[lane] * 2.0f - 1.0f, -(uy[lane] * 2.0f - 1.0f));
+			v.TexR = FVector2D(dx[0][lane], dy[0][lane]);
+			v.TexG = FVector2D(dx[1][lane], dy[1][lane]);
+			v.TexB = FVector2D(dx[2][lane], dy[2][lane]);
+			v.VignetteFactor = GetVignette(targetX[lane], targetY);
+			v.TimewarpFactor = 0.0f;
+		}
+	}
+}
+
+void FWaveVRDistortionSolver::SolveGrid(const FWaveVRDistortionCoefficients& c, uint32 pointsX, uint32 pointsY, FDistortionVertex* outVerts)
+{
+	ParallelFor(pointsY, [&](int32 y) {
+		SolveRow(c, y, pointsX, pointsY, outVerts + y * pointsX);
+	});
+}
+
+void FWaveVRDistortionSolver::BuildIndices(uint32 pointsX, uint32 pointsY, uint16* outIndices)
+{
+	uint32 InsertIndex = 0;
+	for (uint32 y = 0; y < pointsY - 1; ++y)
+	{
+		for (uint32 x = 0; x < pointsX - 1; ++x)
+		{
+			// Calculate indices for the triangle
+			const uint16 BottomLeft = (y * pointsX) + x + 0;
+			const uint16 BottomRight = (y * pointsX) + x + 1;
+			const uint16 TopLeft = (y * pointsX) + x + 0 + pointsX;
+			const uint16 TopRight = (y * pointsX) + x + 1 + pointsX;
+
+			// Insert indices
+			outIndices[InsertIndex + 0] = BottomLeft;
+			outIndices[InsertIndex + 1] = BottomRight;
+			outIndices[InsertIndex + 2] = TopRight;
+			outIndices[InsertIndex + 3] = BottomLeft;
+			outIndices[InsertIndex + 4] = TopRight;
+			outIndices[InsertIndex + 5] = TopLeft;
+			InsertIndex += 6;
+		}
+	}
+}
+
+float FWaveVRDistortionSolver::Validate(const FWaveVRDistortionCoefficients& c, uint32 pointsX, uint32 pointsY)
+{
+	TArray<FDistortionVertex> verts;
+	verts.SetNumUninitialized(pointsX * pointsY);
+	SolveGrid(c, pointsX, pointsY, verts.GetData());
+
+	double maxError = 0;
+	for (uint32 y = 0; y < pointsY; y++) {
+		for (uint32 x = 0; x < pointsX; x++) {
+			const double target[2] = { double(x) / double(pointsX - 1), double(y) / double(pointsY - 1) };
+			double pos[2], uv[3][2];
+			SolvePointReference(c, target, pos, uv);
+
+			const FDistortionVertex& v = verts[y * pointsX + x];
+			const FVector2D* texs[3] = { &v.TexR, &v.TexG, &v.TexB };
+			maxError = FMath::Max(maxError, FMath::Abs((pos[0] * 2 - 1) - v.Position.X));
+			maxError = FMath::Max(maxError, FMath::Abs(-(pos[1] * 2 - 1) - v.Position.Y));
+			for (int32 ch = 0; ch < 3; ch++) {
+				maxError = FMath::Max(maxError, FMath::Abs(uv[ch][0] - texs[ch]->X));
+				maxError = FMath::Max(maxError, FMath::Abs(uv[ch][1] - texs[ch]->Y));
+			}
+		}
+	}
+	return (float)maxError;
+}
+
+static FAutoConsoleCommand CValidateCommand(
+	TEXT("wvr.Distortion.Validate"),
+	TEXT("Compare the distortion mesh solver with the double precision reference.  Args: [PointsX] [PointsY]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		const uint32 pointsX = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 2, 200) : 40;
+		const uint32 pointsY = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 2, 200) : pointsX;
+		const FWaveVRDistortionCoefficients c = FWaveVRDistortionCoefficients::GetDefault(eSSP_LEFT_EYE);
+
+		const double start = FPlatformTime::Seconds();
+		TArray<FDistortionVertex> verts;
+		verts.SetNumUninitialized(pointsX * pointsY);
+		FWaveVRDistortionSolver::SolveGrid(c, pointsX, pointsY, verts.GetData());
+		const double elapsed = FPlatformTime::Seconds() - start;
+
+		LOGI(WVRDistortion, "Validate %ux%u, max error %f, solved in %.3fms", pointsX, pointsY, FWaveVRDistortionSolver::Validate(c, pointsX, pointsY), elapsed * 1000);
+	}));
+
+/* Mesh */
+
+void FWaveVRDistortionMesh::Draw_RenderThread(FRHICommandList& RHICmdList)
+{
+	check(IsInRenderingThread());
+
+	if (!VertexBufferRHI.IsValid()) {
+		const uint32 size = Vertices.Num() * sizeof(FDistortionVertex);
+		FRHIResourceCreateInfo CreateInfo;
+		VertexBufferRHI = RHICreateVertexBuffer(size, BUF_Static, CreateInfo);
+		void* VoidPtr = RHILockVertexBuffer(VertexBufferRHI, 0, size, RLM_WriteOnly);
+		FPlatformMemory::Memcpy(VoidPtr, Vertices.GetData(), size);
+		RHIUnlockVertexBuffer(VertexBufferRHI);
+	}
+
+	FWaveVRDistortionIndices& indices = *Indices;
+	if (!indices.IndexBufferRHI.IsValid()) {
+		const uint32 size = indices.Indices.Num() * sizeof(uint16);
+		FRHIResourceCreateInfo CreateInfo;
+		indices.IndexBufferRHI = RHICreateIndexBuffer(sizeof(uint16), size, BUF_Static, CreateInfo);
+		void* VoidPtr = RHILockIndexBuffer(indices.IndexBufferRHI, 0, size, RLM_WriteOnly);
+		FPlatformMemory::Memcpy(VoidPtr, indices.Indices.GetData(), size);
+		RHIUnlockIndexBuffer(indices.IndexBufferRHI);
+	}
+
+	RHICmdList.SetStreamSource(0, VertexBufferRHI, 0);
+	RHICmdList.DrawIndexedPrimitive(indices.IndexBufferRHI, 0, 0, Vertices.Num(), 0, NumTris, 1);
+}
+
+/* Cache */
+
+FWaveVRDistortionMeshCache& FWaveVRDistortionMeshCache::Get()
+{
+	static FWaveVRDistortionMeshCache Instance;
+	return Instance;
+}
+
+FWaveVRDistortionMeshPtr FWaveVRDistortionMeshCache::GetMesh(const FWaveVRDistortionCoefficients& c, uint32 pointsX, uint32 pointsY, EStereoscopicPass eye)
+{
+	check(IsInGameThread());
+	check(pointsX >= 2 && pointsY >= 2 && pointsX * pointsY <= MAX_uint16 + 1);
+
+	FKey key = { c, pointsX, pointsY, (int32)eye };
+	RecentKeys.Remove(key);
+	RecentKeys.Add(key);
+
+	if (FWaveVRDistortionMeshPtr* found = Meshes.Find(key))
+		return *found;
+
+	const uint32 gridKey = pointsX << 16 | pointsY;
+	TSharedPtr<FWaveVRDistortionIndices, ESPMode::ThreadSafe>& indices = Indices.FindOrAdd(gridKey);
+	if (!indices.IsValid()) {
+		indices = MakeShareable(new FWaveVRDistortionIndices());
+		indices->Indices.SetNumUninitialized((pointsX - 1) * (pointsY - 1) * 6);
+		FWaveVRDistortionSolver::BuildIndices(pointsX, pointsY, indices->Indices.GetData());
+	}
+
+	FWaveVRDistortionMeshPtr mesh = MakeShareable(new FWaveVRDistortionMesh());
+	mesh->PointsX = pointsX;
+	mesh->PointsY = pointsY;
+	mesh->NumTris = (pointsX - 1) * (pointsY - 1) * 2;
+	mesh->Indices = indices;
+
+	// The other eye of the same lens has the same vertices.
+	FKey otherKey = key;
+	otherKey.Eye = (int32)(eye == eSSP_LEFT_EYE ? eSSP_RIGHT_EYE : eSSP_LEFT_EYE);
+	if (FWaveVRDistortionMeshPtr* other = Meshes.Find(otherKey)) {
+		mesh->Vertices = (*other)->Vertices;
+	} else {
+		const double start = FPlatformTime::Seconds();
+		mesh->Vertices.SetNumUninitialized(pointsX * pointsY);
+		FWaveVRDistortionSolver::SolveGrid(c, pointsX, pointsY, mesh->Vertices.GetData());
+		LOGD(WVRDistortion, "Solved %ux%u in %.3fms", pointsX, pointsY, (FPlatformTime::Seconds() - start) * 1000);
+	}
+	Meshes.Add(key, mesh);
+
+	// Drop the least recent meshes.  The one still drawn is kept alive by its owner.
+	while (RecentKeys.Num() > kMaxCachedMeshes) {
+		Meshes.Remove(RecentKeys[0]);
+		RecentKeys.RemoveAt(0);
+	}
+	for (auto it = Indices.CreateIterator(); it; ++it) {
+		if (it.Value().IsUnique())
+			it.RemoveCurrent();
+	}
+	return mesh;
+}
+
+void FWaveVRDistortionMeshCache::Empty()
+{
+	Meshes.Empty();
+	RecentKeys.Empty();
+	Indices.Empty();
+}
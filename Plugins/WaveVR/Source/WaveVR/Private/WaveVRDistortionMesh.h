@@ -0,0 +1,108 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HeadMountedDisplayTypes.h"
+#include "StereoRendering.h"
+#include "RHI.h"
+
+// The radial distortion of each color, out = in * (1 + K1 * r^2 + K2 * r^4).
+struct FWaveVRDistortionCoefficients
+{
+	float K1[3];  // Index is R, G, B
+	float K2[3];
+
+	// The same lens for both eyes for now.
+	static FWaveVRDistortionCoefficients GetDefault(EStereoscopicPass eye);
+
+	bool operator==(const FWaveVRDistortionCoefficients& other) const { return FMemory::Memcmp(this, &other, sizeof(*this)) == 0; }
+	friend uint32 GetTypeHash(const FWaveVRDistortionCoefficients& c) { return FCrc::MemCrc32(&c, sizeof(c)); }
+};
+
+/**
+ * Solve the inverse distortion of a grid.  Each screen position is found by the fixed point
+ * iteration, so its green uv lands on the grid point.
+ *
+ * The float solver runs 4 points at a time by VectorRegister, and a lane stops moving once it
+ * converged.  The double one solves a point at a time, as the reference of the float one.  All
+ * are pure functions without the engine state, for the tests and the benchmarks.
+ */
+struct FWaveVRDistortionSolver
+{
+	enum { MaxIterations = 10 };
+
+	// target is in [0, 1].  outUV is the R, G and B uv of outPos.
+	static void SolvePointReference(const FWaveVRDistortionCoefficients& c, const double target[2], double outPos[2], double outUV[3][2]);
+
+	static void SolveRow(const FWaveVRDistortionCoefficients& c, uint32 y, uint32 pointsX, uint32 pointsY, FDistortionVertex* outRow);
+	// The rows are solved in parallel.
+	static void SolveGrid(const FWaveVRDistortionCoefficients& c, uint32 pointsX, uint32 pointsY, FDistortionVertex* outVerts);
+	static void BuildIndices(uint32 pointsX, uint32 pointsY, uint16* outIndices);
+
+	// The max error of the screen position and the uvs against the reference.
+	static float Validate(const FWaveVRDistortionCoefficients& c, uint32 pointsX, uint32 pointsY);
+};
+
+struct FWaveVRDistortionIndices
+{
+	TArray<uint16> Indices;
+	FIndexBufferRHIRef IndexBufferRHI;
+};
+
+/**
+ * The distortion mesh of an eye.  The vertices are built once in game thread.  The static RHI
+ * buffers are created at the first draw in render thread, and reused by the later frames.
+ */
+struct FWaveVRDistortionMesh
+{
+	uint32 PointsX;
+	uint32 PointsY;
+	uint32 NumTris;
+	TArray<FDistortionVertex> Vertices;
+	TSharedPtr<FWaveVRDistortionIndices, ESPMode::ThreadSafe> Indices;  // Shared by the meshes of a grid size
+	FVertexBufferRHIRef VertexBufferRHI;
+
+	void Draw_RenderThread(FRHICommandList& RHICmdList);
+};
+
+typedef TSharedPtr<FWaveVRDistortionMesh, ESPMode::ThreadSafe> FWaveVRDistortionMeshPtr;
+
+/**
+ * The meshes keyed by the coefficients, the grid size and the eye.  A grid size used before is
+ * not solved again.  Only the recent meshes are kept.  Accessed in game thread.
+ */
+class FWaveVRDistortionMeshCache
+{
+public:
+	static FWaveVRDistortionMeshCache& Get();
+
+	FWaveVRDistortionMeshPtr GetMesh(const FWaveVRDistortionCoefficients& c, uint32 pointsX, uint32 pointsY, EStereoscopicPass eye);
+	void Empty();
+
+private:
+	FWaveVRDistortionMeshCache() {}
+
+	struct FKey
+	{
+		FWaveVRDistortionCoefficients Coefficients;
+		uint32 PointsX;
+		uint32 PointsY;
+		int32 Eye;
+
+		bool operator==(const FKey& other) const { return Coefficients == other.Coefficients && PointsX == other.PointsX && PointsY == other.PointsY && Eye == other.Eye; }
+		friend uint32 GetTypeHash(const FKey& key) { return HashCombine(GetTypeHash(key.Coefficients), HashCombine(key.PointsX << 16 | key.PointsY, (uint32)key.Eye)); }
+	};
+
+	TMap<FKey, FWaveVRDistortionMeshPtr> Meshes;
+	TArray<FKey> RecentKeys;  // The last is the most recent.
+	TMap<uint32, TSharedPtr<FWaveVRDistortionIndices, ESPMode::ThreadSafe>> Indices;  // Key is PointsX << 16 | PointsY
+};
@@ -0,0 +1,168 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRDynamicResolution.h"
+#include "WaveVRPrivatePCH.h"
+#include "HAL/IConsoleManager.h"
+#include "RHI.h"
+#include "RenderCore.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRDynRes, Log, All);
+
+static const float kDensityLimitMin = 0.1f;
+static const float kDensityLimitMax = 2.0f;
+static const double kLogInterval = 5.0;
+
+FWaveVRDynamicResolutionPolicy::FWaveVRDynamicResolutionPolicy()
+	: Density(1.0f)
+	, OverFrames(0)
+	, UnderFrames(0)
+{
+}
+
+void FWaveVRDynamicResolutionPolicy::Reset(const FWaveVRDynamicResolutionConfig& InConfig, float InDensity)
+{
+	SetConfig(InConfig);
+	Density = FMath::Clamp(InDensity, Config.MinDensity, Config.MaxDensity);
+	OverFrames = UnderFrames = 0;
+}
+
+void FWaveVRDynamicResolutionPolicy::SetConfig(const FWaveVRDynamicResolutionConfig& InConfig)
+{
+	Config = InConfig;
+	Config.MaxDensity = FMath::Clamp(Config.MaxDensity, kDensityLimitMin, kDensityLimitMax);
+	Config.MinDensity = FMath::Clamp(Config.MinDensity, kDensityLimitMin, Config.MaxDensity);
+	Config.Headroom = FMath::Clamp(Config.Headroom, 0.0f, 0.5f);
+	Config.Step = FMath::Max(Config.Step, 0.01f);
+	Density = FMath::Clamp(Density, Config.MinDensity, Config.MaxDensity);
+}
+
+float FWaveVRDynamicResolutionPolicy::Update(float frameBudgetMs, float gpuMs, float renderThreadMs)
+{
+	// The render thread time does not shrink with the pixels, so it can not drive the density.
+	if (frameBudgetMs <= 0 || gpuMs <= 0)
+	{
+		OverFrames = UnderFrames = 0;
+		return Density;
+	}
+	const float pixelCost = gpuMs;
+
+	const float target = frameBudgetMs * (1 - Config.Headroom);
+	const float lowerBand = target * (1 - Config.Headroom);
+
+	if (pixelCost > target)
+	{
+		UnderFrames = 0;
+		if (++OverFrames >= Config.DownFrames)
+		{
+			const float fit = Density * FMath::Sqrt(target / pixelCost);
+			Density = FMath::Max(FMath::Min(fit, Density - Config.Step), Config.MinDensity);
+			OverFrames = 0;
+		}
+	}
+	else if (pixelCost < lowerBand && renderThreadMs < target)
+	{
+		OverFrames = 0;
+		if (++UnderFrames >= Config.UpFrames)
+		{
+			const float next = FMath::Min(Density + Config.Step, Config.MaxDensity);
+			const float predicted = pixelCost * FMath::Square(next / Density);
+			if (predicted < target)
+				Density = next;
+			UnderFrames = 0;
+		}
+	}
+	else
+	{
+		OverFrames = UnderFrames = 0;
+	}
+	return Density;
+}
+
+FWaveVRDynamicResolution::FWaveVRDynamicResolution()
+	: RefreshRate(60)
+	, bWasEnabled(false)
+	, bNoGpuTimeLogged(false)
+	, LastLogTime(0)
+{
+}
+
+bool FWaveVRDynamicResolution::IsEnabled()
+{
+	static const auto CVarEnable = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.DynamicResolution.enable"));
+	return CVarEnable && CVarEnable->GetValueOnGameThread() != 0;
+}
+
+float FWaveVRDynamicResolution::GetMaxDensity()
+{
+	static const auto CVarMaxDensity = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("wvr.DynamicResolution.MaxDensity"));
+	return CVarMaxDensity ? FMath::Clamp(CVarMaxDensity->GetValueOnAnyThread(), 1.0f, kDensityLimitMax) : 1.0f;
+}
+
+static void SetConsoleVariable(const TCHAR* name, float value)
+{
+	IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(name);
+	if (CVar)
+		CVar->Set(value, ECVF_SetByCode);
+}
+
+void FWaveVRDynamicResolution::Configure(bool enable, float minDensity, float maxDensity, float headroom)
+{
+	LOGI(WVRDynRes, "Configure(%d, %.2f, %.2f, %.2f)", enable, minDensity, maxDensity, headroom);
+	SetConsoleVariable(TEXT("wvr.DynamicResolution.enable"), enable ? 1 : 0);
+	SetConsoleVariable(TEXT("wvr.DynamicResolution.MinDensity"), minDensity);
+	SetConsoleVariable(TEXT("wvr.DynamicResolution.MaxDensity"), maxDensity);
+	SetConsoleVariable(TEXT("wvr.DynamicResolution.Headroom"), headroom);
+}
+
+bool FWaveVRDynamicResolution::Tick(float& InOutDensity)
+{
+	check(IsInGameThread());
+	if (!IsEnabled()) {
+		bWasEnabled = false;
+		return false;
+	}
+
+	static const auto CVarMinDensity = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("wvr.DynamicResolution.MinDensity"));
+	static const auto CVarHeadroom = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("wvr.DynamicResolution.Headroom"));
+	FWaveVRDynamicResolutionConfig config;
+	if (CVarMinDensity)
+		config.MinDensity = CVarMinDensity->GetValueOnGameThread();
+	config.MaxDensity = GetMaxDensity();
+	if (CVarHeadroom)
+		config.Headroom = CVarHeadroom->GetValueOnGameThread();
+	if (!bWasEnabled) {
+		Policy.Reset(config, InOutDensity);
+		bWasEnabled = true;
+	} else {
+		Policy.SetConfig(config);
+	}
+
+	// The engine times are of the previous frames.
+	const float gpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+	const float renderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	const float budgetMs = RefreshRate > 0 ? 1000.0f / RefreshRate : 0;
+	const float density = Policy.Update(budgetMs, gpuMs, renderThreadMs);
+	if (gpuMs <= 0 && !bNoGpuTimeLogged) {
+		LOGW(WVRDynRes, "No GPU frame time from the RHI.  The density is held at %.2f.", density);
+		bNoGpuTimeLogged = true;
+	}
+
+	const double now = FPlatformTime::Seconds();
+	if (now - LastLogTime >= kLogInterval) {
+		LOGD(WVRDynRes, "density %.2f, budget %.2fms, gpu %.2fms, rt %.2fms", density, budgetMs, gpuMs, renderThreadMs);
+		LastLogTime = now;
+	}
+
+	if (density == InOutDensity)
+		return false;
+	InOutDensity = density;
+	return true;
+}
@@ -0,0 +1,86 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FWaveVRDynamicResolutionConfig
+{
+	float MinDensity;
+	float MaxDensity;  // The eye textures are allocated in this density.
+	float Headroom;  // Part of the frame budget kept free, 0.1 means 10%.
+	float Step;  // Density step to increase.
+	int32 DownFrames;  // Over budget in these consecutive frames to decrease.
+	int32 UpFrames;  // Under the lower band in these consecutive frames to increase.
+
+	FWaveVRDynamicResolutionConfig()
+		: MinDensity(0.5f), MaxDensity(1.0f), Headroom(0.1f), Step(0.05f), DownFrames(3), UpFrames(60) {}
+};
+
+/**
+ * Pure policy of the dynamic resolution.  No engine state is read here, so it can be driven by
+ * recorded frame times.
+ *
+ * The GPU cost is treated as proportional to the pixels, that is the square of the density.  Over
+ * the budget, the density drops at once to the predicted fit.  Increase is one step at a time,
+ * only after a long run under a lower band, and only if the predicted cost still fits.  Between
+ * the band and the budget nothing changes.  The render thread time is not scaled by the density,
+ * so it only holds an increase.  Without a GPU time the density is held.
+ */
+class FWaveVRDynamicResolutionPolicy
+{
+public:
+	FWaveVRDynamicResolutionPolicy();
+
+	void Reset(const FWaveVRDynamicResolutionConfig& InConfig, float InDensity);
+	void SetConfig(const FWaveVRDynamicResolutionConfig& InConfig);
+
+	// Return the density for the next frame.  The gpuMs is 0 if not available, for example on
+	// GLES, and then the density is not changed.
+	float Update(float frameBudgetMs, float gpuMs, float renderThreadMs);
+
+	float GetDensity() const { return Density; }
+	const FWaveVRDynamicResolutionConfig& GetConfig() const { return Config; }
+
+private:
+	FWaveVRDynamicResolutionConfig Config;
+	float Density;
+	int32 OverFrames;
+	int32 UnderFrames;
+};
+
+/**
+ * Game thread driver of the policy.  It reads the wvr.DynamicResolution cvars and the engine GPU
+ * and render thread frame times every frame.
+ */
+class FWaveVRDynamicResolution
+{
+public:
+	FWaveVRDynamicResolution();
+
+	static bool IsEnabled();
+	// The density which the eye textures should be allocated in.
+	static float GetMaxDensity();
+	// Set the cvars by code, for Blueprint.
+	static void Configure(bool enable, float minDensity, float maxDensity, float headroom);
+
+	void SetRefreshRate(float fps) { RefreshRate = fps; }
+
+	// Return true if the density is changed.
+	bool Tick(float& InOutDensity);
+
+private:
+	FWaveVRDynamicResolutionPolicy Policy;
+	float RefreshRate;
+	bool bWasEnabled;
+	bool bNoGpuTimeLogged;
+	double LastLogTime;
+};
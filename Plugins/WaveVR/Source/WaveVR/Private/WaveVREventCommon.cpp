@@ -12,6 +12,7 @@
 #include "WaveVRPrivatePCH.h"
 #include "WaveVRHMD.h"
 #include "WaveVRController.h"
+#include "WaveVRInputSnapshot.h"
 
 bool UWaveVREventCommon::bInitialized(false);
 
@@ -49,13 +50,13 @@ FAllEventTouchNative UWaveVREventCommon::OnAllEventTouchNative_HMD;
 FAllEventTouchNative UWaveVREventCommon::OnAllEventTouchNative_Right;
 FAllEventTouchNative UWaveVREventCommon::OnAllEventTouchNative_Left;
 
-bool UWaveVREventCommon::btnPress_HMD[EventCommonButtonCount] = { false };
-bool UWaveVREventCommon::btnPress_right[EventCommonButtonCount] = { false };
-bool UWaveVREventCommon::btnPress_left[EventCommonButtonCount] = { false };
+uint32 UWaveVREventCommon::btnPress_HMD = 0;
+uint32 UWaveVREventCommon::btnPress_right = 0;
+uint32 UWaveVREventCommon::btnPress_left = 0;
 
-bool UWaveVREventCommon::btnTouch_HMD[EventCommonButtonCount] = { false };
-bool UWaveVREventCommon::btnTouch_right[EventCommonButtonCount] = { false };
-bool UWaveVREventCommon::btnTouch_left[EventCommonButtonCount] = { false };
+uint32 UWaveVREventCommon::btnTouch_HMD = 0;
+uint32 UWaveVREventCommon::btnTouch_right = 0;
+uint32 UWaveVREventCommon::btnTouch_left = 0;
 
 FHandChanging UWaveVREventCommon::OnHandChangingNative;
 
@@ -247,40 +248,48 @@ void UWaveVREventCommon::OnAllButtonPressHandling_Left(uint8 button, bool down)
 void UWaveVREventCommon::OnAllEventPressHandling_HMD(uint8 button, bool down)
 {
 	LOGD(LogWaveVREventCommon, "OnAllEventPressHandling_HMD() button: %d, down: %d, left-handed? %d", button, (uint8)down, (uint8)bIsLeftHanded);
-	btnPress_HMD[button] = down;
+	SetButtonBit(btnPress_HMD, button, down);
 	OnAllEventPressBp_HMD.Broadcast(button, down);
 }
 
 void UWaveVREventCommon::OnAllEventPressHandling_Right(uint8 button, bool down)
 {
 	LOGD(LogWaveVREventCommon, "OnAllEventPressHandling_Right() button: %d, down: %d, left-handed? %d", button, (uint8)down, (uint8)bIsLeftHanded);
-	btnPress_right[button] = down;
+	SetButtonBit(btnPress_right, button, down);
 	OnAllEventPressBp_Right.Broadcast(button, down);
 }
 
 void UWaveVREventCommon::OnAllEventPressHandling_Left(uint8 button, bool down)
 {
 	LOGD(LogWaveVREventCommon, "OnAllEventPressHandling_Left() button: %d, down: %d, left-handed? %d", button, (uint8)down, (uint8)bIsLeftHanded);
-	btnPress_left[button] = down;
+	SetButtonBit(btnPress_left, button, down);
 	OnAllEventPressBp_Left.Broadcast(button, down);
 }
 
 void UWaveVREventCommon::OnAllEventTouchHandling_HMD(uint8 button, bool down)
 {
 	LOGD(LogWaveVREventCommon, "OnAllEventTouchHandling_HMD() button: %d, down: %d, left-handed? %d", button, (uint8)down, (uint8)bIsLeftHanded);
-	btnTouch_HMD[button] = down;
+	SetButtonBit(btnTouch_HMD, button, down);
 }
 
 void UWaveVREventCommon::OnAllEventTouchHandling_Right(uint8 button, bool down)
 {
 	LOGD(LogWaveVREventCommon, "OnAllEventTouchHandling_Right() button: %d, down: %d, left-handed? %d", button, (uint8)down, (uint8)bIsLeftHanded);
-	btnTouch_right[button] = down;
+	SetButtonBit(btnTouch_right, button, down);
 }
 
 void UWaveVREventCommon::OnAllEventTouchHandling_Left(uint8 button, bool down)
 {
 	LOGD(LogWaveVREventCommon, "OnAllEventTouchHandling_Left() button: %d, down: %d, left-handed? %d", button, (uint8)down, (uint8)bIsLeftHanded);
-	btnTouch_left[button] = down;
+	SetButtonBit(btnTouch_left, button, down);
+}
+
+void UWaveVREventCommon::SetButtonBit(uint32& mask, uint8 button, bool down)
+{
+	if (down)
+		mask |= FWaveVRInputSnapshot::GetBit(button);
+	else
+		mask &= ~FWaveVRInputSnapshot::GetBit(button);
 }
 #pragma endregion Handler of Button Event Native
 
@@ -305,17 +314,17 @@ bool UWaveVREventCommon::IsControllerButtonPressed(EWVR_DeviceType device, EWVR_
 
 bool UWaveVREventCommon::isBtnPress_HMD(EWVR_InputId button)
 {
-	return btnPress_HMD[(uint8)button];
+	return (btnPress_HMD & FWaveVRInputSnapshot::GetBit((uint8)button)) != 0;
 }
 
 bool UWaveVREventCommon::isBtnPress_right(EWVR_InputId button)
 {
-	return btnPress_right[(uint8)button];
+	return (btnPress_right & FWaveVRInputSnapshot::GetBit((uint8)button)) != 0;
 }
 
 bool UWaveVREventCommon::isBtnPress_left(EWVR_InputId button)
 {
-	return btnPress_left[(uint8)button];
+	return (btnPress_left & FWaveVRInputSnapshot::GetBit((uint8)button)) != 0;
 }
 
 bool UWaveVREventCommon::IsControllerButtonTouched(EWVR_DeviceType device, EWVR_TouchId button_id)
@@ -338,17 +347,57 @@ bool UWaveVREventCommon::IsControllerButtonTouched(EWVR_DeviceType device, EWVR_
 
 bool UWaveVREventCommon::isBtnTouch_HMD(EWVR_TouchId button)
 {
-	return btnTouch_HMD[(uint8)button];
+	return (btnTouch_HMD & FWaveVRInputSnapshot::GetBit((uint8)button)) != 0;
 }
 
 bool UWaveVREventCommon::isBtnTouch_right(EWVR_TouchId button)
 {
-	return btnTouch_right[(uint8)button];
+	return (btnTouch_right & FWaveVRInputSnapshot::GetBit((uint8)button)) != 0;
 }
 
 bool UWaveVREventCommon::isBtnTouch_left(EWVR_TouchId button)
 {
-	return btnTouch_left[(uint8)button];
+	return (btnTouch_left & FWaveVRInputSnapshot::GetBit((uint8)button)) != 0;
+}
+
+uint32 UWaveVREventCommon::GetButtonPressMask(EWVR_DeviceType device)
+{
+	switch (device)
+	{
+	case EWVR_DeviceType::DeviceType_HMD:
+		return btnPress_HMD;
+	case EWVR_DeviceType::DeviceType_Controller_Right:
+		return btnPress_right;
+	case EWVR_DeviceType::DeviceType_Controller_Left:
+		return btnPress_left;
+	default:
+		return 0;
+	}
+}
+
+uint32 UWaveVREventCommon::GetButtonTouchMask(EWVR_DeviceType device)
+{
+	switch (device)
+	{
+	case EWVR_DeviceType::DeviceType_HMD:
+		return btnTouch_HMD;
+	case EWVR_DeviceType::DeviceType_Controller_Right:
+		return btnTouch_right;
+	case EWVR_DeviceType::DeviceType_Controller_Left:
+		return btnTouch_left;
+	default:
+		return 0;
+	}
+}
+
+void UWaveVREventCommon::QueryButtonStates(EWVR_DeviceType device, uint32& press, uint32& touch)
+{
+	FWaveVRInputSnapshot snapshot;
+	// Not connected is all released.
+	snapshot.Query(device, WVR_InputType_Button | WVR_InputType_Touch);
+	press = snapshot.Pressed;
+	touch = snapshot.Touched;
+	LOGD(LogWaveVREventCommon, "QueryButtonStates() device %d pressed 0x%08X touched 0x%08X", (uint8)device, press, touch);
 }
 #pragma endregion Get Button States
 
@@ -421,7 +470,7 @@ void UWaveVREventCommon::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 		isFocusCapturedBySystem = _focusCapturedBySystem;
 		if (!isFocusCapturedBySystem)
 		{
-			LOGD(LogWaveVREventCommon, "TickComponent() get system focus.");
+			TLOGD(LogWaveVREventCommon, "TickComponent() get system focus.");
 			bResetAllButtonStates = true;
 		}
 	}
@@ -434,77 +483,43 @@ void UWaveVREventCommon::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 			bIsLeftHanded = hand_mode;
 			OnControllerRoleChangeBp.Broadcast();
 		}
-		LOGD(LogWaveVREventCommon, "TickComponent() bIsLeftHanded: %d", bIsLeftHanded);
+		TLOGD(LogWaveVREventCommon, "TickComponent() bIsLeftHanded: %d", bIsLeftHanded);
 		bCheckLeftHanded = false;
 	}
 
 	if (bResetAllButtonStates)
 	{
-		LOGD(LogWaveVREventCommon, "TickComponent() reset button states.");
+		TLOGD(LogWaveVREventCommon, "TickComponent() reset button states.");
 		UWaveVRController::ResetButtonStates(EWVR_DeviceType::DeviceType_Controller_Right);
 		UWaveVRController::ResetButtonStates(EWVR_DeviceType::DeviceType_Controller_Left);
 
-		for (int i = 0; i < InputButtonCount; i++)
-		{
-			int _btn = (int)InputButton[i];
-			btnPress_HMD[_btn] = UWaveVRBlueprintFunctionLibrary::GetInputButtonState(EWVR_DeviceType::DeviceType_HMD, InputButton[i]);
-			btnPress_right[_btn] = UWaveVRBlueprintFunctionLibrary::GetInputButtonState(EWVR_DeviceType::DeviceType_Controller_Right, InputButton[i]);
-			btnPress_left[_btn] = UWaveVRBlueprintFunctionLibrary::GetInputButtonState(EWVR_DeviceType::DeviceType_Controller_Left, InputButton[i]);
-			btnTouch_HMD[_btn] = UWaveVRBlueprintFunctionLibrary::GetInputTouchState(EWVR_DeviceType::DeviceType_HMD, InputButton[i]);
-			btnTouch_right[_btn] = UWaveVRBlueprintFunctionLibrary::GetInputTouchState(EWVR_DeviceType::DeviceType_Controller_Right, InputButton[i]);
-			btnTouch_left[_btn] = UWaveVRBlueprintFunctionLibrary::GetInputTouchState(EWVR_DeviceType::DeviceType_Controller_Left, InputButton[i]);
-			LOGD(LogWaveVREventCommon, "TickComponent() HMD button %d pressed? %d", _btn, (int)btnPress_HMD[_btn]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Right button %d pressed? %d", _btn, (int)btnPress_right[_btn]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Left button %d pressed? %d", _btn, (int)btnPress_left[_btn]);
-			LOGD(LogWaveVREventCommon, "TickComponent() HMD button %d touched? %d", _btn, (int)btnTouch_HMD[_btn]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Right button %d touched? %d", _btn, (int)btnTouch_right[_btn]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Left button %d touched? %d", _btn, (int)btnTouch_left[_btn]);
-		}
+		QueryButtonStates(EWVR_DeviceType::DeviceType_HMD, btnPress_HMD, btnTouch_HMD);
+		QueryButtonStates(EWVR_DeviceType::DeviceType_Controller_Right, btnPress_right, btnTouch_right);
+		QueryButtonStates(EWVR_DeviceType::DeviceType_Controller_Left, btnPress_left, btnTouch_left);
 		bResetAllButtonStates = false;
 	}
 
 	if (bResetHmdButtonStates)
 	{
-		LOGD(LogWaveVREventCommon, "TickComponent() reset HMD button states.");
-		for (int i = 0; i < InputButtonCount; i++)
-		{
-			int btn_index = (int)InputButton[i];
-			btnPress_HMD[btn_index] = UWaveVRBlueprintFunctionLibrary::GetInputButtonState(EWVR_DeviceType::DeviceType_HMD, InputButton[i]);
-			btnTouch_HMD[btn_index] = UWaveVRBlueprintFunctionLibrary::GetInputTouchState(EWVR_DeviceType::DeviceType_HMD, InputButton[i]);
-			LOGD(LogWaveVREventCommon, "TickComponent() HMD button %d pressed? %d", btn_index, (int)btnPress_HMD[btn_index]);
-			LOGD(LogWaveVREventCommon, "TickComponent() HMD button %d touched? %d", btn_index, (int)btnTouch_HMD[btn_index]);
-		}
+		TLOGD(LogWaveVREventCommon, "TickComponent() reset HMD button states.");
+		QueryButtonStates(EWVR_DeviceType::DeviceType_HMD, btnPress_HMD, btnTouch_HMD);
 		bResetHmdButtonStates = false;
 	}
 
 	if (bResetRightButtonStates)
 	{
-		LOGD(LogWaveVREventCommon, "TickComponent() reset Right button states.");
+		TLOGD(LogWaveVREventCommon, "TickComponent() reset Right button states.");
 		UWaveVRController::ResetButtonStates(EWVR_DeviceType::DeviceType_Controller_Right);
-		for (int i = 0; i < InputButtonCount; i++)
-		{
-			int btn_index = (int)InputButton[i];
-			btnPress_right[btn_index] = UWaveVRBlueprintFunctionLibrary::GetInputButtonState(EWVR_DeviceType::DeviceType_Controller_Right, InputButton[i]);
-			btnTouch_right[btn_index] = UWaveVRBlueprintFunctionLibrary::GetInputTouchState(EWVR_DeviceType::DeviceType_Controller_Right, InputButton[i]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Right button %d pressed? %d", btn_index, (int)btnPress_right[btn_index]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Right button %d touched? %d", btn_index, (int)btnTouch_right[btn_index]);
-		}
+		QueryButtonStates(EWVR_DeviceType::DeviceType_Controller_Right, btnPress_right, btnTouch_right);
 		bResetRightButtonStates = false;
 	}
 
 	if (bResetLeftButtonStates)
 	{
-		LOGD(LogWaveVREventCommon, "TickComponent() reset Right button states.");
+		TLOGD(LogWaveVREventCommon, "TickComponent() reset Right button states.");
 		UWaveVRController::ResetButtonStates(EWVR_DeviceType::DeviceType_Controller_Left);
 
-		for (int i = 0; i < InputButtonCount; i++)
-		{
-			int btn_index = (int)InputButton[i];
-			btnPress_left[btn_index] = UWaveVRBlueprintFunctionLibrary::GetInputButtonState(EWVR_DeviceType::DeviceType_Controller_Left, InputButton[i]);
-			btnTouch_left[btn_index] = UWaveVRBlueprintFunctionLibrary::GetInputTouchState(EWVR_DeviceType::DeviceType_Controller_Left, InputButton[i]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Left button %d pressed? %d", btn_index, (int)btnPress_left[btn_index]);
-			LOGD(LogWaveVREventCommon, "TickComponent() Left button %d touched? %d", btn_index, (int)btnTouch_left[btn_index]);
-		}
+		QueryButtonStates(EWVR_DeviceType::DeviceType_Controller_Left, btnPress_left, btnTouch_left);
 		bResetLeftButtonStates = false;
 	}
 
@@ -512,7 +527,7 @@ void UWaveVREventCommon::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 	{
 		// 0: DOF 3, 1: DOF 6, 2: DOF SYSTEM
 		currentDoF = UWaveVRBlueprintFunctionLibrary::IsTrackingHMDPosition() ? EWVR_DOF::DOF_6 : EWVR_DOF::DOF_3;
-		LOGD(LogWaveVREventCommon, "TickComponent() currentDoF: %d", (uint8)currentDoF);
+		TLOGD(LogWaveVREventCommon, "TickComponent() currentDoF: %d", (uint8)currentDoF);
 		OnTrackingModeChangeBp.Broadcast();
 		bCheckTrackingMode = false;
 	}
@@ -0,0 +1,150 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVREyeGeometry.h"
+#include "WaveVRPrivatePCH.h"
+#include "Platforms/WaveVRAPIWrapper.h"
+#include "WaveVRUtils.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVREyeGeometry, Log, All);
+
+static FMatrix MakeProjection(float Left, float Right, float Top, float Bottom, float ZNear, float ZFar = 0) {
+	LOGI(WVREyeGeometry, "MakeProjection (%f, %f, %f, %f, %f, %f)", Left, Right, Top, Bottom, ZNear, ZFar);
+
+	float SumRL = (Right + Left);
+	float SumTB = (Top + Bottom);
+	float SubRL = Right - Left;
+	float SubTB = Top - Bottom;
+
+	if (ZFar > 0 && ZNear > 0 && ZFar > ZNear) {
+		// Reversed Z [1, 0].  Use this function if ZFar is finite.
+		return FMatrix(
+			FPlane(2.0f / SubRL, 0.0f, 0.0f, 0.0f),
+			FPlane(0.0f, 2.0f / SubTB, 0.0f, 0.0f),
+			FPlane(SumRL / -SubRL, SumTB / -SubTB, ZNear / (ZNear - ZFar), 1.0f),
+			FPlane(0.0f, 0.0f, ZFar * ZNear / (ZFar - ZNear), 0.0f)
+		);
+	}
+	else
+	{
+		// Reversed Z [1, 0].  Use this function if ZFar is infinite.
+		return FMatrix(
+			FPlane(2.0f / SubRL, 0.0f, 0.0f, 0.0f),
+			FPlane(0.0f, 2.0f / SubTB, 0.0f, 0.0f),
+			FPlane(SumRL / -SubRL, SumTB / -SubTB, 0.0f, 1.0f),
+			FPlane(0.0f, 0.0f, ZNear, 0.0f)
+		);
+	}
+}
+
+FWaveVREyeGeometry::FWaveVREyeGeometry()
+	: Generation(0)
+	, DoF(WVR_NumDoF_6DoF)
+	, NearPlane(10.0f)
+	, FarPlane(0.0f)
+	, WorldToMeters(100.0f)
+{
+	for (int32 i = 0; i < 2; i++) {
+		EyeOrientation[i] = FQuat::Identity;
+		EyePosition[i] = FVector::ZeroVector;
+	}
+	for (int32 i = 0; i < 3; i++) {
+		Boundaries[i][0] = Boundaries[i][3] = -1;
+		Boundaries[i][1] = Boundaries[i][2] = 1;
+		Projections[i] = FMatrix::Identity;
+	}
+}
+
+FWaveVREyeGeometryCache::FWaveVREyeGeometryCache()
+	: Current(MakeShareable(new FWaveVREyeGeometry()))
+	, bDirty(true)
+{
+}
+
+void FWaveVREyeGeometryCache::Invalidate(const TCHAR* reason)
+{
+	LOGD(WVREyeGeometry, "Invalidate by %s", PLATFORM_CHAR(reason));
+	bDirty = true;
+}
+
+bool FWaveVREyeGeometryCache::Update(const FParams& params)
+{
+	check(IsInGameThread());
+	// Only GT writes the Current, so no lock to read it here.
+	const FWaveVREyeGeometry* current = Current.Get();
+	// The eye to head transforms are of the DoF.
+	if (current->DoF != params.DoF)
+		bDirty = true;
+	if (!bDirty && current->NearPlane == params.NearPlane &&
+		current->FarPlane == params.FarPlane && current->WorldToMeters == params.WorldToMeters)
+		return false;
+
+	FWaveVREyeGeometry* geometry = new FWaveVREyeGeometry();
+	if (bDirty) {
+		Build(params, current->Generation + 1, *geometry);
+	} else {
+		// Only the planes or the scale are changed.  The eyes are still the same.
+		*geometry = *current;
+		geometry->Generation = current->Generation + 1;
+		geometry->WorldToMeters = params.WorldToMeters;
+		if (current->NearPlane != params.NearPlane || current->FarPlane != params.FarPlane) {
+			geometry->NearPlane = params.NearPlane;
+			geometry->FarPlane = params.FarPlane;
+			for (int32 i = 0; i < 3; i++) {
+				const float* b = geometry->Boundaries[i];
+				geometry->Projections[i] = MakeProjection(b[0], b[1], b[2], b[3], params.NearPlane, params.FarPlane);
+			}
+		}
+	}
+	bDirty = false;
+
+	{
+		// The replaced snapshot is deleted when its last reader releases it.
+		FWriteScopeLock lock(CurrentLock);
+		Current = MakeShareable(geometry);
+	}
+
+	LOGI(WVREyeGeometry, "Generation %u: DoF %d, near %f, far %f, worldToMeters %f", geometry->Generation,
+		(int)geometry->DoF, geometry->NearPlane, geometry->FarPlane, geometry->WorldToMeters);
+	return true;
+}
+
+void FWaveVREyeGeometryCache::Build(const FParams& params, uint32 generation, FWaveVREyeGeometry& geometry)
+{
+	LOG_FUNC();
+	geometry.Generation = generation;
+	geometry.DoF = params.DoF;
+	geometry.NearPlane = params.NearPlane;
+	geometry.FarPlane = params.FarPlane;
+	geometry.WorldToMeters = params.WorldToMeters;
+
+	for (int32 i = 0; i < 2; i++) {
+		WVR_Matrix4f_t headFromEye = WVR()->GetTransformFromEyeToHead(i == 0 ? WVR_Eye_Left : WVR_Eye_Right, params.DoF);
+
+		geometry.EyePosition[i] = FVector(-headFromEye.m[2][3], headFromEye.m[0][3], headFromEye.m[1][3]);
+
+		FQuat Orientation(wvr::utils::ToFMatrix(headFromEye));
+		geometry.EyeOrientation[i].X = -Orientation.Z;
+		geometry.EyeOrientation[i].Y = Orientation.X;
+		geometry.EyeOrientation[i].Z = Orientation.Y;
+		geometry.EyeOrientation[i].W = -Orientation.W;
+	}
+
+	float (&b)[3][4] = geometry.Boundaries;
+	WVR()->GetClippingPlaneBoundary(WVR_Eye_Left, &(b[0][0]), &(b[0][1]), &(b[0][2]), &(b[0][3]));
+	WVR()->GetClippingPlaneBoundary(WVR_Eye_Right, &(b[1][0]), &(b[1][1]), &(b[1][2]), &(b[1][3]));
+	b[2][0] = FMath::Min(b[0][0], b[1][0]);
+	b[2][1] = FMath::Max(b[0][1], b[1][1]);
+	b[2][2] = FMath::Max(b[0][2], b[1][2]);
+	b[2][3] = FMath::Min(b[0][3], b[1][3]);
+
+	for (int32 i = 0; i < 3; i++)
+		geometry.Projections[i] = MakeProjection(b[i][0], b[i][1], b[i][2], b[i][3], params.NearPlane, params.FarPlane);
+}
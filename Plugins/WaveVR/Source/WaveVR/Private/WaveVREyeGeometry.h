@@ -0,0 +1,84 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "wvr_types.h"
+
+/**
+ * Immutable snapshot of the eye geometry.  Index 0 is the left eye, 1 the right eye, and 2 the
+ * center view of both eyes.
+ */
+struct FWaveVREyeGeometry
+{
+	uint32 Generation;
+	WVR_NumDoF DoF;
+	float NearPlane;
+	float FarPlane;
+	float WorldToMeters;  // For example, 1 meter multiply 100 to convert to world units.
+
+	// Head from eye in Unreal coordinate.  The position is in meters.
+	FQuat EyeOrientation[2];
+	FVector EyePosition[2];
+
+	float Boundaries[3][4];  // Left, right, top, bottom at distance 1
+	FMatrix Projections[3];
+
+	FWaveVREyeGeometry();
+};
+
+typedef TSharedPtr<const FWaveVREyeGeometry, ESPMode::ThreadSafe> FWaveVREyeGeometryPtr;
+
+/**
+ * The eye to head transforms, clipping boundaries, projections and the world to meters scale.
+ *
+ * They change perhaps once per session, but are read several times per frame in both game and
+ * render thread.  The runtime is only queried when the geometry is invalidated, by the IPD or DoF
+ * change, or when the near plane, far plane or world to meters scale is different from the
+ * current snapshot.
+ *
+ * Update() builds a new snapshot in game thread, and publishes it under a lock.  Get() can be
+ * called in any thread, and the reader shares the snapshot, so it stays valid as long as the
+ * reader holds it, even if a newer one is published.
+ */
+class FWaveVREyeGeometryCache
+{
+public:
+	struct FParams
+	{
+		WVR_NumDoF DoF;
+		float NearPlane;
+		float FarPlane;
+		float WorldToMeters;
+	};
+
+	FWaveVREyeGeometryCache();
+
+	// Game thread.  The next Update() queries the runtime again.
+	void Invalidate(const TCHAR* reason);
+
+	// Game thread.  Return true if a new snapshot is published.
+	bool Update(const FParams& params);
+
+	// Any thread.  Never null.
+	inline FWaveVREyeGeometryPtr Get() const {
+		FReadScopeLock lock(CurrentLock);
+		return Current;
+	}
+
+private:
+	static void Build(const FParams& params, uint32 generation, FWaveVREyeGeometry& geometry);
+
+	mutable FRWLock CurrentLock;
+	FWaveVREyeGeometryPtr Current;  // Only written in GT
+	bool bDirty;
+};
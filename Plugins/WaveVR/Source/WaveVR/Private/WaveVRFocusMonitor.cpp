@@ -0,0 +1,101 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRFocusMonitor.h"
+#include "WaveVRPrivatePCH.h"
+#include "HAL/RunnableThread.h"
+#include "Platforms/WaveVRAPIWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRFocus, Log, All);
+
+FWaveVRFocusMonitor::FWaveVRFocusMonitor()
+	: Thread(nullptr)
+	, wakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bCaptured(0)
+	, bChangePending(0)
+	, ChangeCycles(0)
+{
+}
+
+FWaveVRFocusMonitor::~FWaveVRFocusMonitor()
+{
+	Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(wakeEvent);
+	wakeEvent = nullptr;
+}
+
+void FWaveVRFocusMonitor::Startup()
+{
+	if (Thread != nullptr)
+		return;
+	LOGD(WVRFocus, "Startup()");
+	StopTaskCounter.Reset();
+	Thread = FRunnableThread::Create(this, TEXT("FWaveVRFocusMonitor"), 0, TPri_BelowNormal);
+}
+
+void FWaveVRFocusMonitor::Shutdown()
+{
+	if (Thread == nullptr)
+		return;
+	LOGD(WVRFocus, "Shutdown()");
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+}
+
+void FWaveVRFocusMonitor::Stop()
+{
+	StopTaskCounter.Increment();
+	wakeEvent->Trigger();
+}
+
+void FWaveVRFocusMonitor::RequestRefresh()
+{
+	wakeEvent->Trigger();
+}
+
+uint32 FWaveVRFocusMonitor::Run()
+{
+	while (StopTaskCounter.GetValue() == 0)
+	{
+		Publish(WVR()->IsInputFocusCapturedBySystem());
+
+		// Sleep until the next poll, a refresh request or Stop().
+		if (StopTaskCounter.GetValue() == 0)
+			wakeEvent->Wait(PollIntervalMs);
+	}
+	return 0;
+}
+
+void FWaveVRFocusMonitor::Publish(bool captured)
+{
+	const int32 value = captured ? 1 : 0;
+	if (FPlatformAtomics::InterlockedExchange(&bCaptured, value) == value)
+		return;
+	FPlatformAtomics::InterlockedExchange(&ChangeCycles, (int64)FPlatformTime::Cycles64());
+	FPlatformAtomics::InterlockedExchange(&bChangePending, 1);
+}
+
+double FWaveVRFocusMonitor::GetLastChangeTime() const
+{
+	const int64 cycles = FPlatformAtomics::AtomicRead(&ChangeCycles);
+	return cycles == 0 ? 0 : FPlatformTime::ToSeconds64((uint64)cycles);
+}
+
+void FWaveVRFocusMonitor::Tick()
+{
+	if (FPlatformAtomics::InterlockedExchange(&bChangePending, 0) == 0)
+		return;
+
+	const bool captured = IsCaptured();
+	LOGD(WVRFocus, "Tick() focus is %s by system, %.1f ms ago.", captured ? "captured" : "released", (float)((FPlatformTime::Seconds() - GetLastChangeTime()) * 1000.0));
+	OnChanged.Broadcast(captured);
+}
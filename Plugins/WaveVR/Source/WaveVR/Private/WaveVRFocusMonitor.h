@@ -0,0 +1,66 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/Event.h"
+#include "HAL/ThreadSafeCounter.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSystemFocusChanged, bool /* captured */);
+
+/**
+ * Whether the input focus is captured by the system, without calling the runtime in the game thread.
+ *
+ * IsInputFocusCapturedBySystem may block, so it is only called by a worker.  The worker polls at a
+ * low rate, and immediately when RequestRefresh() is called for an event which may move the focus,
+ * e.g. resume or a system overlay.  The state and the time of its last change are published by
+ * atomics, and can be read from any thread.  OnChanged is broadcasted by Tick() in game thread.
+ */
+class FWaveVRFocusMonitor : public FRunnable
+{
+public:
+	FWaveVRFocusMonitor();
+	virtual ~FWaveVRFocusMonitor();
+
+	void Startup();
+	void Shutdown();
+
+	// Ask the worker to query now.
+	void RequestRefresh();
+
+	// Game thread.  Broadcast OnChanged if the state was changed since the last tick.
+	void Tick();
+
+	bool IsCaptured() const { return FPlatformAtomics::AtomicRead(&bCaptured) != 0; }
+	// FPlatformTime::Seconds() of the last change, 0 if never changed.
+	double GetLastChangeTime() const;
+
+	FOnSystemFocusChanged OnChanged;
+
+	// Begin FRunnable interface.
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+	void Publish(bool captured);
+
+	static const uint32 PollIntervalMs = 500;
+
+	FRunnableThread* Thread;
+	FThreadSafeCounter StopTaskCounter;
+	FEvent* wakeEvent;
+
+	volatile int32 bCaptured;
+	volatile int32 bChangePending;
+	volatile int64 ChangeCycles;
+};
@@ -0,0 +1,244 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRFoveationScheduler.h"
+#include "WaveVRPrivatePCH.h"
+#include "WaveVRRender.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRFoveation, Log, All);
+
+// From the best quality to the most saving.  The focal point is not used.
+static const WVR_RenderFoveationParams_t kPresets[FWaveVRFoveationScheduler::LevelCount] = {
+	{ 0, 0, 90, WVR_PeripheralQuality_High },
+	{ 0, 0, 57, WVR_PeripheralQuality_High },
+	{ 0, 0, 45, WVR_PeripheralQuality_Medium },
+	{ 0, 0, 33, WVR_PeripheralQuality_Low },
+};
+
+static const float kOverBudgetRatio = 0.95f;
+static const float kUnderBudgetRatio = 0.75f;
+static const int32 kDownFrames = 5;
+static const int32 kUpFrames = 120;
+
+/* Default policy */
+
+FWaveVRFoveationDefaultPolicy::FWaveVRFoveationDefaultPolicy()
+	: OverFrames(0)
+	, UnderFrames(0)
+{
+}
+
+void FWaveVRFoveationDefaultPolicy::Reset()
+{
+	OverFrames = UnderFrames = 0;
+}
+
+bool FWaveVRFoveationDefaultPolicy::Decide(const FWaveVRFoveationSignals& signals, FWaveVRFoveationDecision& InOutDecision)
+{
+	const int32 maxLevel = signals.levelCount - 1;
+	int32 minLevel = 0;
+	if (signals.thermal == WVR_BatteryTemperatureStatus_UltraOverheat)
+		minLevel = maxLevel;
+	else if (signals.thermal == WVR_BatteryTemperatureStatus_Overheat)
+		minLevel = FMath::Min(2, maxLevel);
+
+	const int32 current = InOutDecision.level[0];
+	const float ratio = signals.budgetMs > 0 ? signals.frameMs / signals.budgetMs : 0;
+	int32 target = current;
+	const TCHAR* reason = nullptr;
+
+	if (ratio > kOverBudgetRatio) {
+		UnderFrames = 0;
+		OverFrames++;
+	} else if (ratio > 0 && ratio < kUnderBudgetRatio) {
+		OverFrames = 0;
+		UnderFrames++;
+	} else {
+		OverFrames = UnderFrames = 0;
+	}
+
+	if (signals.qualityHint < 0) {
+		target = current + 1;
+		reason = TEXT("runtime recommends lower quality");
+	} else if (OverFrames >= kDownFrames) {
+		target = current + 1;
+		reason = TEXT("frame time over budget");
+	} else if (signals.qualityHint > 0) {
+		target = current - 1;
+		reason = TEXT("runtime recommends higher quality");
+	} else if (UnderFrames >= kUpFrames) {
+		target = current - 1;
+		reason = TEXT("frame time under budget");
+	}
+
+	if (target < minLevel) {
+		target = minLevel;
+		reason = TEXT("battery overheat");
+	}
+	target = FMath::Clamp(target, 0, maxLevel);
+
+	if (reason != nullptr)
+		OverFrames = UnderFrames = 0;
+	if (target == current)
+		return false;
+
+	InOutDecision.level[0] = InOutDecision.level[1] = target;
+	InOutDecision.reason = reason;
+	return true;
+}
+
+/* Scheduler */
+
+FWaveVRFoveationScheduler::FWaveVRFoveationScheduler(FWaveVRRender* InRender)
+	: mRender(InRender)
+	, Policy(MakeShareable(new FWaveVRFoveationDefaultPolicy()))
+	, bRunning(false)
+	, SavedMode(WVR_FoveationMode_Default)
+	, PendingQualityHint(0)
+	, Thermal(WVR_BatteryTemperatureStatus_Normal)
+	, BlendFrame(0)
+	, BlendFrames(0)
+{
+	for (int32 i = 0; i < 2; i++) {
+		Decision.level[i] = 0;
+		FromFov[i] = CurrentFov[i] = kPresets[0].fovealFov;
+		FromQuality[i] = CurrentQuality[i] = kPresets[0].periQuality;
+		SavedFov[i] = kPresets[0].fovealFov;
+		SavedQuality[i] = kPresets[0].periQuality;
+	}
+	Decision.reason = nullptr;
+}
+
+bool FWaveVRFoveationScheduler::IsEnabled()
+{
+	static const auto CVarScheduler = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.FoveatedRendering.Scheduler"));
+	return CVarScheduler && CVarScheduler->GetValueOnGameThread() != 0;
+}
+
+const WVR_RenderFoveationParams_t& FWaveVRFoveationScheduler::GetPreset(int32 level)
+{
+	return kPresets[FMath::Clamp<int32>(level, 0, LevelCount - 1)];
+}
+
+void FWaveVRFoveationScheduler::SetPolicy(TSharedPtr<IWaveVRFoveationPolicy> InPolicy)
+{
+	Policy = InPolicy.IsValid() ? InPolicy : MakeShareable(new FWaveVRFoveationDefaultPolicy());
+	Policy->Reset();
+	LOGI(WVRFoveation, "SetPolicy(%s)", PLATFORM_CHAR(Policy->GetName()));
+}
+
+void FWaveVRFoveationScheduler::OnRecommendedQuality(bool bHigher)
+{
+	// A lower hint wins over a higher one in the same frame.
+	if (!bHigher)
+		PendingQualityHint = -1;
+	else if (PendingQualityHint == 0)
+		PendingQualityHint = 1;
+}
+
+void FWaveVRFoveationScheduler::OnThermalStatus(WVR_BatteryTemperatureStatus status)
+{
+	if (Thermal != status)
+		LOGI(WVRFoveation, "Thermal status %d -> %d", (int)Thermal, (int)status);
+	Thermal = status;
+}
+
+void FWaveVRFoveationScheduler::Start()
+{
+	LOGI(WVRFoveation, "Start with policy %s", PLATFORM_CHAR(Policy->GetName()));
+	bRunning = true;
+	SavedMode = mRender->GetFoveationMode();
+	mRender->GetFoveationQuality(SavedFov, SavedQuality);
+
+	// The foveation params are only used in enable mode.
+	if (!mRender->IsRenderFoveationEnabled())
+		mRender->SetFoveationMode(WVR_FoveationMode_Enable);
+
+	Policy->Reset();
+	PendingQualityHint = 0;
+	for (int32 i = 0; i < 2; i++) {
+		Decision.level[i] = 0;
+		CurrentFov[i] = kPresets[0].fovealFov;
+		CurrentQuality[i] = kPresets[0].periQuality;
+	}
+	BlendFrame = BlendFrames = 0;
+	Apply();
+}
+
+void FWaveVRFoveationScheduler::Stop()
+{
+	LOGI(WVRFoveation, "Stop at level L%d R%d, restore mode %d", Decision.level[0], Decision.level[1], (int)SavedMode);
+	bRunning = false;
+
+	// Put back what the app had.  The params first, so the mode is not restored with the scheduler's params.
+	// The mode is compared in render thread, where it is applied.
+	mRender->SetFoveationQuality(SavedFov, SavedQuality);
+	mRender->SetFoveationMode(SavedMode);
+}
+
+void FWaveVRFoveationScheduler::BeginBlend()
+{
+	static const auto CVarBlendFrames = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.FoveatedRendering.BlendFrames"));
+	for (int32 i = 0; i < 2; i++) {
+		FromFov[i] = CurrentFov[i];
+		FromQuality[i] = CurrentQuality[i];
+	}
+	BlendFrame = 0;
+	BlendFrames = CVarBlendFrames ? FMath::Max(CVarBlendFrames->GetValueOnGameThread(), 1) : 1;
+}
+
+void FWaveVRFoveationScheduler::Apply()
+{
+	mRender->SetFoveationQuality(CurrentFov, CurrentQuality);
+}
+
+void FWaveVRFoveationScheduler::Tick(float frameMs, float budgetMs)
+{
+	check(IsInGameThread());
+	if (!IsEnabled() || !mRender->IsRenderFoveationSupport()) {
+		if (bRunning)
+			Stop();
+		return;
+	}
+	if (!bRunning)
+		Start();
+
+	FWaveVRFoveationSignals signals;
+	signals.frameMs = frameMs;
+	signals.budgetMs = budgetMs;
+	signals.qualityHint = PendingQualityHint;
+	signals.thermal = Thermal;
+	signals.levelCount = LevelCount;
+	PendingQualityHint = 0;
+
+	const FWaveVRFoveationDecision previous = Decision;
+	if (Policy->Decide(signals, Decision)) {
+		for (int32 i = 0; i < 2; i++)
+			Decision.level[i] = FMath::Clamp<int32>(Decision.level[i], 0, LevelCount - 1);
+		LOGI(WVRFoveation, "%s: level L%d R%d -> L%d R%d, %s (frame %.2fms of %.2fms, hint %d, thermal %d)",
+			PLATFORM_CHAR(Policy->GetName()), previous.level[0], previous.level[1], Decision.level[0], Decision.level[1],
+			PLATFORM_CHAR(Decision.reason ? Decision.reason : TEXT("no reason")), frameMs, budgetMs, signals.qualityHint, (int)Thermal);
+		BeginBlend();
+	}
+
+	if (BlendFrame >= BlendFrames)
+		return;
+
+	// The fov moves smoothly.  The quality has only a few steps, and switches in the middle.
+	BlendFrame++;
+	const float alpha = (float)BlendFrame / BlendFrames;
+	for (int32 i = 0; i < 2; i++) {
+		const WVR_RenderFoveationParams_t& target = GetPreset(Decision.level[i]);
+		CurrentFov[i] = FMath::Lerp(FromFov[i], target.fovealFov, alpha);
+		CurrentQuality[i] = alpha >= 0.5f ? target.periQuality : FromQuality[i];
+	}
+	Apply();
+}
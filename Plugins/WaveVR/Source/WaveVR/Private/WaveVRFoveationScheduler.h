@@ -0,0 +1,129 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "wvr_render.h"
+#include "wvr_device.h"
+
+class FWaveVRRender;
+
+// What the foveation policy decides on.
+struct FWaveVRFoveationSignals
+{
+	float frameMs;  // Measured frame time, the slower of GPU and render thread.
+	float budgetMs;  // From the display refresh rate.
+	int32 qualityHint;  // -1 or +1 if the runtime recommended a lower or higher quality since the last decision, else 0.
+	WVR_BatteryTemperatureStatus thermal;
+	int32 levelCount;  // Number of presets.  Level 0 has the best quality.
+};
+
+struct FWaveVRFoveationDecision
+{
+	int32 level[2];  // Index is the WVR_Eye
+	const TCHAR* reason;  // Logged with the decision
+};
+
+/**
+ * Decide the foveation preset levels from the signals.  Only pure logic here, no runtime call, so
+ * it can be exercised with recorded or mocked signals.
+ */
+class IWaveVRFoveationPolicy
+{
+public:
+	virtual ~IWaveVRFoveationPolicy() {}
+
+	virtual const TCHAR* GetName() const = 0;
+	virtual void Reset() = 0;
+	// Called once per game frame.  InOutDecision holds the current levels.  Return true if changed.
+	virtual bool Decide(const FWaveVRFoveationSignals& signals, FWaveVRFoveationDecision& InOutDecision) = 0;
+};
+
+/**
+ * Default policy.  Both eyes use the same level.
+ *
+ * Go one level down after some frames over the budget, or at once by a lower quality hint.  Go one
+ * level up after a long run well under the budget, or by a higher quality hint.  An overheated
+ * battery sets a minimum level.
+ */
+class FWaveVRFoveationDefaultPolicy : public IWaveVRFoveationPolicy
+{
+public:
+	FWaveVRFoveationDefaultPolicy();
+
+	virtual const TCHAR* GetName() const override { return TEXT("Default"); }
+	virtual void Reset() override;
+	virtual bool Decide(const FWaveVRFoveationSignals& signals, FWaveVRFoveationDecision& InOutDecision) override;
+
+private:
+	int32 OverFrames;
+	int32 UnderFrames;
+};
+
+/**
+ * Move the foveation of each eye between presets by a policy, closing the loop on the measured
+ * frame time and the runtime quality and thermal events.
+ *
+ * A new level is not applied at once.  The foveal fov is blended over some frames, and the
+ * peripheral quality is switched in the middle, so the change is not visible as a pop.  The focal
+ * point set by the app is kept.  Every decision is logged.
+ *
+ * Game thread only.  The params are sent to the render thread by FWaveVRRender.
+ */
+class FWaveVRFoveationScheduler
+{
+public:
+	enum { LevelCount = 4 };
+
+	FWaveVRFoveationScheduler(FWaveVRRender* InRender);
+
+	static bool IsEnabled();
+
+	// Replace the policy, for example by a mock.  nullptr to use the default policy.
+	void SetPolicy(TSharedPtr<IWaveVRFoveationPolicy> InPolicy);
+
+	// From the runtime events
+	void OnRecommendedQuality(bool bHigher);
+	void OnThermalStatus(WVR_BatteryTemperatureStatus status);
+
+	void Tick(float frameMs, float budgetMs);
+
+	int32 GetLevel(WVR_Eye eye) const { return Decision.level[eye == WVR_Eye_Right ? 1 : 0]; }
+	// Only the foveal fov and the peripheral quality of a preset are used.
+	static const WVR_RenderFoveationParams_t& GetPreset(int32 level);
+
+private:
+	void Start();
+	void Stop();
+	void BeginBlend();
+	void Apply();
+
+	FWaveVRRender* mRender;
+	TSharedPtr<IWaveVRFoveationPolicy> Policy;
+	bool bRunning;
+
+	// What the app had before Start(), put back by Stop().  Index is the WVR_Eye.
+	WVR_FoveationMode SavedMode;
+	float SavedFov[2];
+	WVR_PeripheralQuality SavedQuality[2];
+
+	FWaveVRFoveationDecision Decision;
+	int32 PendingQualityHint;
+	WVR_BatteryTemperatureStatus Thermal;
+
+	// Blend.  Index is the WVR_Eye.
+	float FromFov[2];
+	WVR_PeripheralQuality FromQuality[2];
+	float CurrentFov[2];
+	WVR_PeripheralQuality CurrentQuality[2];
+	int32 BlendFrame;
+	int32 BlendFrames;
+};
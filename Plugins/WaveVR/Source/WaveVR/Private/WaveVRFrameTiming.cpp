@@ -0,0 +1,306 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRFrameTiming.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Stats/Stats.h"
+#include "Platforms/WaveVRLogWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRTiming, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("WaveVR"), STATGROUP_WaveVR, STATCAT_Advanced);
+
+#define WVR_DECLARE_TIMING_STATS(name) \
+	DECLARE_FLOAT_COUNTER_STAT(TEXT(#name) TEXT(" p50 (ms)"), STAT_WaveVR_##name##_P50, STATGROUP_WaveVR); \
+	DECLARE_FLOAT_COUNTER_STAT(TEXT(#name) TEXT(" p90 (ms)"), STAT_WaveVR_##name##_P90, STATGROUP_WaveVR); \
+	DECLARE_FLOAT_COUNTER_STAT(TEXT(#name) TEXT(" p99 (ms)"), STAT_WaveVR_##name##_P99, STATGROUP_WaveVR);
+
+WVR_DECLARE_TIMING_STATS(GameThread)
+WVR_DECLARE_TIMING_STATS(GameToRender)
+WVR_DECLARE_TIMING_STATS(PreRender)
+WVR_DECLARE_TIMING_STATS(RenderThread)
+WVR_DECLARE_TIMING_STATS(PoseToSubmit)
+WVR_DECLARE_TIMING_STATS(Total)
+
+static_assert((FWaveVRFrameTiming::Capacity & (FWaveVRFrameTiming::Capacity - 1)) == 0, "Capacity must be power of 2");
+static_assert(FWaveVRFrameTiming::Window < FWaveVRFrameTiming::Capacity, "Window must be smaller than Capacity");
+
+static inline int64 SecondsToUs(double seconds) { return (int64)(seconds * 1e6); }
+
+FWaveVRFrameTiming* FWaveVRFrameTiming::GetInstance()
+{
+	static FWaveVRFrameTiming* mInst = new FWaveVRFrameTiming();
+	return mInst;
+}
+
+FWaveVRFrameTiming::FWaveVRFrameTiming()
+	: LatestSubmitted(0)
+{
+	FMemory::Memzero(Slots);
+}
+
+const TCHAR * FWaveVRFrameTiming::GetStageName(EWaveVRTimingStage stage)
+{
+	switch (stage) {
+	case EWaveVRTimingStage::GameFrameStart: return TEXT("GameFrameStart");
+	case EWaveVRTimingStage::PoseSample: return TEXT("PoseSample");
+	case EWaveVRTimingStage::GameFrameEnd: return TEXT("GameFrameEnd");
+	case EWaveVRTimingStage::LateUpdate: return TEXT("LateUpdate");
+	case EWaveVRTimingStage::BeginRendering: return TEXT("BeginRendering");
+	case EWaveVRTimingStage::PreRenderEye: return TEXT("PreRenderEye");
+	case EWaveVRTimingStage::Submit: return TEXT("Submit");
+	default: return TEXT("Unknown");
+	}
+}
+
+const TCHAR * FWaveVRFrameTiming::GetMetricName(EWaveVRTimingMetric metric)
+{
+	switch (metric) {
+	case EWaveVRTimingMetric::GameThread: return TEXT("GameThread");
+	case EWaveVRTimingMetric::GameToRender: return TEXT("GameToRender");
+	case EWaveVRTimingMetric::PreRender: return TEXT("PreRender");
+	case EWaveVRTimingMetric::RenderThread: return TEXT("RenderThread");
+	case EWaveVRTimingMetric::PoseToSubmit: return TEXT("PoseToSubmit");
+	case EWaveVRTimingMetric::Total: return TEXT("Total");
+	default: return TEXT("Unknown");
+	}
+}
+
+void FWaveVRFrameTiming::Mark(EWaveVRTimingStage stage, uint32 frameNumber)
+{
+	MarkAt(stage, frameNumber, FPlatformTime::Seconds());
+}
+
+void FWaveVRFrameTiming::MarkAt(EWaveVRTimingStage stage, uint32 frameNumber, double seconds)
+{
+	if (frameNumber == 0)  // FrameData before the first game frame.
+		return;
+
+	const int64 timeUs = FMath::Max<int64>(SecondsToUs(seconds), 1);  // 0 is for not marked
+	if (stage == EWaveVRTimingStage::GameFrameStart) {
+		BeginFrame(frameNumber, timeUs);
+		return;
+	}
+
+	FSlot& slot = Slots[frameNumber & (Capacity - 1)];
+	if ((uint32)FPlatformAtomics::AtomicRead(&slot.frame) != frameNumber)
+		return;  // Not begun, or recycled.
+	// First mark wins.  For example, the splash may submit again with the same FrameDataRT.
+	FPlatformAtomics::InterlockedCompareExchange(&slot.timeUs[(int32)stage], timeUs, (int64)0);
+
+	if (stage == EWaveVRTimingStage::Submit && (int32)(frameNumber - (uint32)FPlatformAtomics::AtomicRead(&LatestSubmitted)) > 0)
+		FPlatformAtomics::InterlockedExchange(&LatestSubmitted, (int32)frameNumber);
+}
+
+void FWaveVRFrameTiming::BeginFrame(uint32 frameNumber, int64 timeUs)
+{
+	FSlot& slot = Slots[frameNumber & (Capacity - 1)];
+	if ((uint32)FPlatformAtomics::AtomicRead(&slot.frame) == frameNumber)
+		return;  // Keep the first.  OnStartGameFrame may be called twice in the same frame in editor.
+
+	// Readers and late writers see the frame 0 and skip it while resetting.
+	FPlatformAtomics::InterlockedExchange(&slot.frame, 0);
+	for (int32 i = 0; i < (int32)EWaveVRTimingStage::Count; i++)
+		FPlatformAtomics::InterlockedExchange(&slot.timeUs[i], (int64)0);
+	slot.timeUs[(int32)EWaveVRTimingStage::GameFrameStart] = timeUs;
+	FPlatformAtomics::InterlockedExchange(&slot.frame, (int32)frameNumber);
+}
+
+bool FWaveVRFrameTiming::ReadRecord(uint32 frameNumber, FRecord& OutRecord) const
+{
+	const FSlot& slot = Slots[frameNumber & (Capacity - 1)];
+	if ((uint32)FPlatformAtomics::AtomicRead(&slot.frame) != frameNumber)
+		return false;
+	OutRecord.frame = frameNumber;
+	for (int32 i = 0; i < (int32)EWaveVRTimingStage::Count; i++)
+		OutRecord.timeUs[i] = FPlatformAtomics::AtomicRead(&slot.timeUs[i]);
+	FPlatformMisc::MemoryBarrier();
+	// Recycled while reading
+	return (uint32)FPlatformAtomics::AtomicRead(&slot.frame) == frameNumber;
+}
+
+bool FWaveVRFrameTiming::GetMetric(const FRecord& record, EWaveVRTimingMetric metric, float& OutMs)
+{
+	EWaveVRTimingStage from, to;
+	switch (metric) {
+	case EWaveVRTimingMetric::GameThread: from = EWaveVRTimingStage::GameFrameStart; to = EWaveVRTimingStage::GameFrameEnd; break;
+	case EWaveVRTimingMetric::GameToRender: from = EWaveVRTimingStage::GameFrameEnd; to = EWaveVRTimingStage::BeginRendering; break;
+	case EWaveVRTimingMetric::PreRender: from = EWaveVRTimingStage::BeginRendering; to = EWaveVRTimingStage::PreRenderEye; break;
+	case EWaveVRTimingMetric::RenderThread: from = EWaveVRTimingStage::BeginRendering; to = EWaveVRTimingStage::Submit; break;
+	case EWaveVRTimingMetric::PoseToSubmit:
+		from = record.timeUs[(int32)EWaveVRTimingStage::LateUpdate] != 0 ? EWaveVRTimingStage::LateUpdate : EWaveVRTimingStage::PoseSample;
+		to = EWaveVRTimingStage::Submit;
+		break;
+	case EWaveVRTimingMetric::Total: from = EWaveVRTimingStage::GameFrameStart; to = EWaveVRTimingStage::Submit; break;
+	default: return false;
+	}
+
+	const int64 begin = record.timeUs[(int32)from];
+	const int64 end = record.timeUs[(int32)to];
+	if (begin == 0 || end == 0 || end < begin)
+		return false;
+	OutMs = (end - begin) / 1000.0f;
+	return true;
+}
+
+bool FWaveVRFrameTiming::GetSummary(FSummary& OutSummary) const
+{
+	FMemory::Memzero(OutSummary);
+	const uint32 latest = (uint32)FPlatformAtomics::AtomicRead(&LatestSubmitted);
+	if (latest == 0)
+		return false;
+	OutSummary.latestFrame = latest;
+
+	TArray<float, TInlineAllocator<Window>> values[(int32)EWaveVRTimingMetric::Count];
+	FRecord record;
+	for (uint32 frame = latest; frame != 0 && latest - frame < (uint32)Window; frame--) {
+		if (!ReadRecord(frame, record) || record.timeUs[(int32)EWaveVRTimingStage::Submit] == 0)
+			continue;
+		OutSummary.frames++;
+		for (int32 m = 0; m < (int32)EWaveVRTimingMetric::Count; m++) {
+			float ms;
+			if (GetMetric(record, (EWaveVRTimingMetric)m, ms))
+				values[m].Add(ms);
+		}
+	}
+
+	for (int32 m = 0; m < (int32)EWaveVRTimingMetric::Count; m++) {
+		auto& v = values[m];
+		if (v.Num() == 0)
+			continue;
+		v.Sort();
+		float sum = 0;
+		for (float ms : v)
+			sum += ms;
+		FPercentiles& p = OutSummary.metrics[m];
+		const int32 last = v.Num() - 1;
+		p.p50 = v[FMath::RoundToInt(last * 0.50f)];
+		p.p90 = v[FMath::RoundToInt(last * 0.90f)];
+		p.p99 = v[FMath::RoundToInt(last * 0.99f)];
+		p.avg = sum / v.Num();
+		p.max = v[last];
+	}
+	return OutSummary.frames > 0;
+}
+
+bool FWaveVRFrameTiming::DumpCSV(const FString& path) const
+{
+	const uint32 latest = (uint32)FPlatformAtomics::AtomicRead(&LatestSubmitted);
+	if (latest == 0)
+		return false;
+
+	// Stages are in ms since GameFrameStart.  Empty if not marked.
+	FString csv(TEXT("Frame"));
+	for (int32 s = 1; s < (int32)EWaveVRTimingStage::Count; s++)
+		csv += FString::Printf(TEXT(",%s"), GetStageName((EWaveVRTimingStage)s));
+	for (int32 m = 0; m < (int32)EWaveVRTimingMetric::Count; m++)
+		csv += FString::Printf(TEXT(",%sMs"), GetMetricName((EWaveVRTimingMetric)m));
+	csv += LINE_TERMINATOR;
+
+	// From old to new.  All the submitted frames still in the ring.
+	FRecord record;
+	const uint32 first = latest > (uint32)Capacity ? latest - Capacity + 1 : 1;
+	for (uint32 frame = first; frame != latest + 1; frame++) {
+		if (!ReadRecord(frame, record) || record.timeUs[(int32)EWaveVRTimingStage::Submit] == 0)
+			continue;
+		const int64 start = record.timeUs[(int32)EWaveVRTimingStage::GameFrameStart];
+		csv += FString::Printf(TEXT("%u"), frame);
+		for (int32 s = 1; s < (int32)EWaveVRTimingStage::Count; s++) {
+			const int64 t = record.timeUs[s];
+			csv += t != 0 ? FString::Printf(TEXT(",%.3f"), (t - start) / 1000.0) : FString(TEXT(","));
+		}
+		for (int32 m = 0; m < (int32)EWaveVRTimingMetric::Count; m++) {
+			float ms;
+			csv += GetMetric(record, (EWaveVRTimingMetric)m, ms) ? FString::Printf(TEXT(",%.3f"), ms) : FString(TEXT(","));
+		}
+		csv += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(csv, *path);
+}
+
+void FWaveVRFrameTiming::Reset()
+{
+	FPlatformAtomics::InterlockedExchange(&LatestSubmitted, 0);
+	for (int32 i = 0; i < Capacity; i++)
+		FPlatformAtomics::InterlockedExchange(&Slots[i].frame, 0);
+}
+
+void FWaveVRFrameTiming::UpdateStats()
+{
+#if STATS
+	if (!FThreadStats::IsCollectingData())
+		return;
+
+	FSummary summary;
+	if (!GetSummary(summary))
+		return;
+
+#define WVR_SET_TIMING_STATS(name) \
+	SET_FLOAT_STAT(STAT_WaveVR_##name##_P50, summary.metrics[(int32)EWaveVRTimingMetric::name].p50); \
+	SET_FLOAT_STAT(STAT_WaveVR_##name##_P90, summary.metrics[(int32)EWaveVRTimingMetric::name].p90); \
+	SET_FLOAT_STAT(STAT_WaveVR_##name##_P99, summary.metrics[(int32)EWaveVRTimingMetric::name].p99);
+
+	WVR_SET_TIMING_STATS(GameThread)
+	WVR_SET_TIMING_STATS(GameToRender)
+	WVR_SET_TIMING_STATS(PreRender)
+	WVR_SET_TIMING_STATS(RenderThread)
+	WVR_SET_TIMING_STATS(PoseToSubmit)
+	WVR_SET_TIMING_STATS(Total)
+
+#undef WVR_SET_TIMING_STATS
+#endif
+}
+
+//---------------------------------------------------
+// Console commands
+//---------------------------------------------------
+
+static void PrintFrameTiming()
+{
+	FWaveVRFrameTiming::FSummary summary;
+	if (!FWaveVRFrameTiming::GetInstance()->GetSummary(summary)) {
+		LOGI(WVRTiming, "No submitted frame yet.");
+		return;
+	}
+
+	LOGI(WVRTiming, "Last %u submitted frames until frame %u (ms):", summary.frames, summary.latestFrame);
+	for (int32 m = 0; m < (int32)EWaveVRTimingMetric::Count; m++) {
+		const FWaveVRFrameTiming::FPercentiles& p = summary.metrics[m];
+		FString name(FWaveVRFrameTiming::GetMetricName((EWaveVRTimingMetric)m));
+		LOGI(WVRTiming, "  %-12s p50 %6.2f  p90 %6.2f  p99 %6.2f  avg %6.2f  max %6.2f",
+			PLATFORM_CHAR(*name), p.p50, p.p90, p.p99, p.avg, p.max);
+	}
+}
+
+static void DumpFrameTiming(const TArray<FString>& Args)
+{
+	FString path = Args.Num() > 0 ? Args[0] :
+		FPaths::ProfilingDir() / TEXT("WaveVR") / FString::Printf(TEXT("FrameTiming-%s.csv"), *FDateTime::Now().ToString());
+
+	if (FWaveVRFrameTiming::GetInstance()->DumpCSV(path)) {
+		LOGI(WVRTiming, "Frame timing is dumped to %s", PLATFORM_CHAR(*path));
+	} else {
+		LOGW(WVRTiming, "Failed to dump frame timing to %s", PLATFORM_CHAR(*path));
+	}
+}
+
+static FAutoConsoleCommand CWaveVRTimingPrint(
+	TEXT("wvr.Timing.Print"),
+	TEXT("Log the rolling percentiles of the WaveVR frame timing."),
+	FConsoleCommandDelegate::CreateStatic(&PrintFrameTiming));
+
+static FAutoConsoleCommand CWaveVRTimingDumpCSV(
+	TEXT("wvr.Timing.DumpCSV"),
+	TEXT("Dump the WaveVR frame timing still in the ring to a csv file.\n")
+	TEXT("wvr.Timing.DumpCSV [path], default to Saved/Profiling/WaveVR/FrameTiming-<time>.csv"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DumpFrameTiming));
@@ -0,0 +1,111 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The stages are marked with the frameNumber of the FFrameData they are working on.
+enum class EWaveVRTimingStage : uint8
+{
+	GameFrameStart = 0,	// OnStartGameFrame.  Begin the record of the frame.
+	PoseSample,			// When the poses used by the GT were sampled.  Marked in UpdatePoses.
+	GameFrameEnd,		// OnEndGameFrame
+	LateUpdate,			// GetCurrentPose in RT
+	BeginRendering,		// OnBeginRendering_RenderThread
+	PreRenderEye,		// After PreRenderEye
+	Submit,				// SubmitFrame_RenderThread
+	Count
+};
+
+// Durations calculated from the stages.
+enum class EWaveVRTimingMetric : uint8
+{
+	GameThread = 0,		// GameFrameStart to GameFrameEnd
+	GameToRender,		// GameFrameEnd to BeginRendering
+	PreRender,			// BeginRendering to PreRenderEye
+	RenderThread,		// BeginRendering to Submit
+	PoseToSubmit,		// LateUpdate, or PoseSample if no late update, to Submit.  Motion to photon without the runtime part.
+	Total,				// GameFrameStart to Submit
+	Count
+};
+
+/**
+ * Per frame timestamps of the GT and RT stages, and the rolling percentiles of them.
+ *
+ * The records are kept in a ring indexed by the frame number.  GameFrameStart claims the slot,
+ * other stages CAS their timestamp in, and the first mark of a stage wins.  A stage of a frame
+ * which was not begun, or was already recycled, is dropped.  Nothing is locked or allocated
+ * when marking, so it can be called in GT and RT every frame.
+ *
+ * Only the submitted frames are summarized.  Use 'stat WaveVR', wvr.Timing.Print or
+ * wvr.Timing.DumpCSV to see them.
+ */
+class FWaveVRFrameTiming
+{
+public:
+	static const int32 Capacity = 128;  // Must be power of 2
+	static const int32 Window = 90;  // Frames in the rolling percentiles.  Keep a margin to the frames being written.
+
+	struct FPercentiles
+	{
+		float p50;
+		float p90;
+		float p99;
+		float avg;
+		float max;
+	};
+
+	struct FSummary
+	{
+		FPercentiles metrics[(int32)EWaveVRTimingMetric::Count];  // Milliseconds
+		uint32 frames;  // Submitted frames in the window
+		uint32 latestFrame;
+	};
+
+public:
+	static FWaveVRFrameTiming* GetInstance();
+
+	// Any thread
+	void Mark(EWaveVRTimingStage stage, uint32 frameNumber);
+	void MarkAt(EWaveVRTimingStage stage, uint32 frameNumber, double seconds);  // seconds is from FPlatformTime::Seconds()
+
+	bool GetSummary(FSummary& OutSummary) const;
+	bool DumpCSV(const FString& path) const;
+	void Reset();
+
+	// GT.  Update the 'stat WaveVR' counters if the stats are being collected.
+	void UpdateStats();
+
+	static const TCHAR * GetStageName(EWaveVRTimingStage stage);
+	static const TCHAR * GetMetricName(EWaveVRTimingMetric metric);
+
+private:
+	FWaveVRFrameTiming();
+
+	struct FRecord
+	{
+		uint32 frame;
+		int64 timeUs[(int32)EWaveVRTimingStage::Count];  // 0 if not marked
+	};
+
+	void BeginFrame(uint32 frameNumber, int64 timeUs);
+	bool ReadRecord(uint32 frameNumber, FRecord& OutRecord) const;
+	static bool GetMetric(const FRecord& record, EWaveVRTimingMetric metric, float& OutMs);
+
+	struct FSlot
+	{
+		volatile int32 frame;  // 0 while the slot is being reset
+		volatile int64 timeUs[(int32)EWaveVRTimingStage::Count];
+	};
+
+	FSlot Slots[Capacity];
+	volatile int32 LatestSubmitted;
+};
@@ -33,8 +33,11 @@
 #include "Platforms/Windows/WaveVRPlatformWindows.h"
 #include "Platforms/Android/WaveVRPlatformAndroid.h"
 #include "Platforms/Editor/WaveVRDirectPreview.h"
+#include "Platforms/Replay/WaveVRPlatformRecorder.h"
+#include "Platforms/Replay/WaveVRPlatformReplay.h"
 #include "IWaveVRPlugin.h"
 #include "PoseManagerImp.h"
+#include "WaveVRFrameTiming.h"
 #include "WaveVRGestureEnums.h"
 #include "WaveVRUtils.h"
 
@@ -82,20 +85,44 @@ public:
 		return true;
 	}
 
+	// Replay a recorded trace instead of a real runtime.  Not need a headset.  Not in the editor
+	// builds, where the direct preview is the runtime.
+	FWaveVRAPIWrapper * CreateReplayInstance()
+	{
+#if !WITH_EDITOR
+		FString tracePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("wvrreplay="), tracePath)) {
+			auto mode = FParse::Param(FCommandLine::Get(), TEXT("wvrreplayfast")) ?
+				FWaveVRPlatformReplay::EMode::AsFastAsPossible : FWaveVRPlatformReplay::EMode::RealTime;
+			return new FWaveVRPlatformReplay(tracePath, mode,
+				FParse::Param(FCommandLine::Get(), TEXT("wvrreplayloop")),
+				FParse::Param(FCommandLine::Get(), TEXT("wvrreplayexit")));
+		}
+#endif
+		return nullptr;
+	}
+
 	// This code should be here.  The FWaveVRPlugin must be the one who decide the platform, not decide in the wrapper.
 	FWaveVRAPIWrapper * CreateWaveVRInstance()
 	{
 		LOGI(WVRHMD, "CreateWaveVRInstance()");
-		FWaveVRAPIWrapper * instance = nullptr;
+		FWaveVRAPIWrapper * instance = CreateReplayInstance();
+		if (instance == nullptr) {
 #if PLATFORM_ANDROID
-		instance = new FWaveVRPlatformAndroid();
+			instance = new FWaveVRPlatformAndroid();
 #elif WITH_EDITOR
-		instance = FWaveVRHMD::DirectPreview = new WaveVRDirectPreview();
+			instance = FWaveVRHMD::DirectPreview = new WaveVRDirectPreview();
 #elif PLATFORM_WINDOWS
-		instance = new FWaveVRPlatformWindows();
+			instance = new FWaveVRPlatformWindows();
 #endif
+		}
 		if (instance == nullptr)
 			instance = new FWaveVRAPIWrapper();
+
+		// Record the runtime traffic for replay.
+		FString tracePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("wvrrecord="), tracePath))
+			instance = new FWaveVRPlatformRecorder(instance, tracePath);
 		FWaveVRAPIWrapper::SetInstance(instance);
 
 		return instance;
@@ -105,6 +132,7 @@ public:
 	{
 		LOGI(WVRHMD, "StartupModule()+");
 
+		FWaveVRTraceLog::Start();
 		IHeadMountedDisplayModule::StartupModule();
 		// If use DirectPreview
 
@@ -133,6 +161,7 @@ public:
 		if (PlatFormContext != nullptr) {
 			PlatFormContext->UnLoadLibraries();
 		}
+		FWaveVRTraceLog::Stop();
 	}
 };
 
@@ -282,6 +311,7 @@ bool FWaveVRHMD::GetCurrentPose(int32 DeviceId, FQuat& OutOrientation, FVector&
 		if (FrameDataRT->bSupportLateUpdate && FrameDataRT->bNeedLateUpdateInRT) {
 			FrameDataRT->bNeedLateUpdateInRT = false;
 			PoseMngr->LateUpdate_RenderThread(FrameDataRT);
+			FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::LateUpdate, FrameDataRT->frameNumber);
 		}
 		OutOrientation = FrameDataRT->gameOrientation;
 		OutPosition = FrameDataRT->gamePosition;
@@ -300,16 +330,10 @@ bool FWaveVRHMD::GetRelativeEyePose(int32 DeviceId, EStereoscopicPass Eye, FQuat
 	//	return true;
 
 	if (DeviceId == IXRTrackingSystem::HMDDeviceId && (Eye == eSSP_LEFT_EYE || Eye == eSSP_RIGHT_EYE)) {
-		WVR_Eye hmdEye = (Eye == eSSP_LEFT_EYE) ? WVR_Eye_Left : WVR_Eye_Right;
-		WVR_Matrix4f_t headFromEye = WVR()->GetTransformFromEyeToHead(hmdEye/*, WVR_NumDoF_6DoF*/);  // TODO need input DoF
-
-		OutPosition = FVector(-headFromEye.m[2][3], headFromEye.m[0][3], headFromEye.m[1][3]) * GetWorldToMetersScale();
-
-		FQuat Orientation(wvr::utils::ToFMatrix(headFromEye));
-		OutOrientation.X = -Orientation.Z;
-		OutOrientation.Y = Orientation.X;
-		OutOrientation.Z = Orientation.Y;
-		OutOrientation.W = -Orientation.W;
+		FWaveVREyeGeometryPtr geometry = EyeGeometry.Get();
+		const int32 index = (Eye == eSSP_LEFT_EYE) ? 0 : 1;
+		OutPosition = geometry->EyePosition[index] * geometry->WorldToMeters;
+		OutOrientation = geometry->EyeOrientation[index];
 		//LOGI(WVRHMD, "GetRelativeEyePose(%d, %d, Quat(%f, %f, %f, %f), Pos(%f, %f, %f))", DeviceId, Eye, OutOrientation.X, OutOrientation.Y, OutOrientation.Z, OutOrientation.W, OutPosition.X, OutPosition.Y, OutPosition.Z);
 		return true;
 	} else {
@@ -338,11 +362,28 @@ bool FWaveVRHMD::GetHMDDistortionEnabled(EShadingPath ShadingPath) const {
 
 void FWaveVRHMD::SetPixelDensity(const float NewDensity) {
 	LOG_FUNC();
-	/* TODO Handle it when density larger than one. */
-	if (NewDensity < 0.1f || NewDensity > 1.0f)
-		PixelDensity = FMath::Clamp(NewDensity, 0.1f, 1.0f);
-	else
-		PixelDensity = NewDensity;
+	// Larger than one is supersampling, limited by the allocated density.  See wvr.DynamicResolution.MaxDensity.
+	PixelDensity = FMath::Clamp(NewDensity, 0.1f, AllocatedDensity);
+}
+
+void FWaveVRHMD::SetRenderTargetSize(uint32 width, uint32 height) {
+	LOG_FUNC();
+	RecommendedWidth = width;
+	RecommendedHeight = height;
+	AllocatedDensity = FWaveVRDynamicResolution::GetMaxDensity();
+	PixelDensity = FMath::Min(PixelDensity, AllocatedDensity);
+	mRender.SetSingleEyePixelSize(FMath::CeilToInt(width * AllocatedDensity), FMath::CeilToInt(height * AllocatedDensity));
+}
+
+void FWaveVRHMD::UpdatePixelDensity() {
+	// The eye textures are reallocated if the max density is changed.
+	if (RecommendedWidth != 0 && FWaveVRDynamicResolution::GetMaxDensity() != AllocatedDensity) {
+		SetRenderTargetSize(RecommendedWidth, RecommendedHeight);
+		mRender.Apply();
+	}
+
+	if (DynamicResolution.Tick(PixelDensity))
+		LOGD(WVRHMD, "Dynamic resolution density %.2f", PixelDensity);
 }
 
 FIntPoint FWaveVRHMD::GetIdealRenderTargetSize() const {
@@ -378,11 +419,12 @@ void FWaveVRHMD::OnBeginPlay(FWorldContext& InWorldContext)
 		if (DirectPreview != nullptr && DirectPreview->HookVRPreview()) {
 			LOGD(WVRHMD, "DirectPreview device is hooked.");
 			bSIM_Available = true;
-			ResetProjectionMats();
+			EyeGeometry.Invalidate(TEXT("DirectPreview"));
+			UpdateEyeGeometry();
 
 			uint32 width = 1024, height = 1024;
 			WVR()->GetRenderTargetSize(&width, &height);
-			mRender.SetSingleEyePixelSize(width, height);
+			SetRenderTargetSize(width, height);
 			mRender.SetTextureFormat(PF_R8G8B8A8);
 			mRender.Apply();
 
@@ -398,6 +440,38 @@ void FWaveVRHMD::OnEndPlay(FWorldContext& InWorldContext)
 {
 	LOG_FUNC();
 	EnableStereo(false);
+
+	FFrameDataRing::FStats stats = FrameDataRing.GetStats();
+	LOGI(WVRHMD, "FrameData published %u, consumed %u, overwritten %u, repeated %u",
+		stats.published, stats.consumed, stats.overwritten, stats.repeated);
+	FrameDataRing.ResetStats();
+
+	PoseManagerImp::FPoseAgeStats poseAge = PoseMngr->GetPoseAgeStats();
+	if (poseAge.count > 0) {
+		LOGI(WVRHMD, "PoseAge avg %.2fms, max %.2fms, last %.2fms (%u frames), missed %u",
+			poseAge.sumMs / poseAge.count, poseAge.maxMs, poseAge.lastMs, poseAge.lastFrames, poseAge.missed);
+	}
+	PoseMngr->ResetPoseAgeStats();
+
+	const FWaveVRTextureQueueStats& queue = mRender.GetTextureManager()->GetQueueStats();
+	if (queue.acquired > 0) {
+		const uint32 * h = queue.depthHistogram;
+		LOGI(WVRHMD, "TextureQueue acquired %u, misses %u (max consecutive %u), starvations %u, waited %.2fms, in flight avg %.2fms max %.2fms, depth [%u %u %u %u %u %u %u %u+]",
+			queue.acquired, queue.misses, queue.maxConsecutiveMisses, queue.starvations, queue.waitMs,
+			queue.inFlightCount > 0 ? queue.sumInFlightMs / queue.inFlightCount : 0.0f, queue.maxInFlightMs,
+			h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+	}
+	mRender.GetTextureManager()->ResetQueueStats();
+
+	FWaveVRFrameTiming::FSummary timing;
+	if (FWaveVRFrameTiming::GetInstance()->GetSummary(timing)) {
+		const auto& pose = timing.metrics[(int32)EWaveVRTimingMetric::PoseToSubmit];
+		const auto& total = timing.metrics[(int32)EWaveVRTimingMetric::Total];
+		LOGI(WVRHMD, "FrameTiming last %u frames, PoseToSubmit p50 %.2fms p99 %.2fms, Total p50 %.2fms p99 %.2fms",
+			timing.frames, pose.p50, pose.p99, total.p50, total.p99);
+	}
+	FWaveVRFrameTiming::GetInstance()->Reset();
+
 	if (WaveVRDirectPreview::IsVRPreview())
 	{
 		// Close it if available
@@ -409,18 +483,16 @@ void FWaveVRHMD::OnEndPlay(FWorldContext& InWorldContext)
 }
 
 void FWaveVRHMD::NextFrameData() {
-	// swap data
-	OldFrameData = FrameData;
-	FrameData = FFrameData::NewInstance();
-
 	// If position is invalidate, we need the old pose.  Use latest pose in RT.
-	FFrameData::Copy(OldFrameDataRT, FrameData);
+	// The retired slot holds the frame which RT finished last time.
+	*FrameData = *FrameDataRing.GetRetired();
 
 	FrameData->bSupportLateUpdate = FrameData->bNeedLateUpdateInRT = lateUpdateConfig.bEnabled;
 	FrameData->bDoUpdateInGT = lateUpdateConfig.bDoUpdateInGT;
 	FrameData->predictTimeInGT = lateUpdateConfig.predictTimeInGT;
 	FrameData->frameNumber = GFrameNumber;
 	FrameData->meterToWorldUnit = GetWorldToMetersScale();  // For example, 1 meter multiply 100 to convert to world units.
+	FrameData->viewportScale = GetViewportScale();
 	FrameData->baseOrientation = BaseOrientation;
 	FrameData->basePosition = CompensationOffset;
 	FrameData->Origin = PoseMngr->GetTrackingOriginModelInternal();
@@ -430,6 +502,7 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 {
 	LOG_FUNC();
 	WVR_SCOPED_NAMED_EVENT(OnStartGameFrame, FColor::Purple);
+	FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::GameFrameStart, GFrameNumber);
 
 #if WITH_EDITOR
 #ifdef DP_DEBUG
@@ -438,6 +511,13 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 	FlushRenderingCommands();
 #endif
 
+	// The eye geometry is rebuilt only if any of these is changed.
+	UWorld* World = WorldContext.World();
+	if (World != nullptr && World->GetWorldSettings() != nullptr)
+		WorldToMeters = World->GetWorldSettings()->WorldToMeters;
+	NearClippingPlane = GNearClippingPlane;
+	UpdateEyeGeometry();
+
 #if WITH_EDITOR
 	if (WorldContext.WorldType == EWorldType::PIE && (WaveVRDirectPreview::IsVRPreview() && IsDirectPreview())) {
 #ifdef DP_DEBUG
@@ -446,6 +526,10 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 #else
 	if (mRender.IsInitialized()) {
 #endif
+		UpdatePixelDensity();
+		// The engine times are of the previous frames.
+		mRender.GetFoveationScheduler()->Tick(
+			FPlatformTime::ToMilliseconds(FMath::Max(RHIGetGPUFrameCycles(), GRenderThreadTime)), 1000.0f / RefreshRate);
 		NextFrameData();
 		PoseMngr->UpdatePoses(FrameData);
 	}
@@ -458,14 +542,7 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 
 	RefreshTrackingToWorldTransform(WorldContext);
 	pollEvent();
-	checkSystemFocus();
-
-	if (GNearClippingPlane != NearClippingPlane) {
-		bNeedResetProjectionMatrix = true;
-		NearClippingPlane = GNearClippingPlane;
-	}
-	if (bNeedResetProjectionMatrix)
-		ResetProjectionMats();
+	FocusMonitor.Tick();
 
 	SceneStatusInfo(FirstGameFrame);
 	FirstGameFrame = false;
@@ -478,6 +555,8 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 	WVR()->Tick();
 #endif
 
+	FWaveVRFrameTiming::GetInstance()->UpdateStats();
+
 #if (UE_BUILD_DEVELOPMENT || UE_BUILD_DEBUG)
 	if (SimulatedLoadingGameThread > 0 && SimulatedLoadingGameThread <= 100000)
 	{
@@ -495,15 +574,27 @@ bool FWaveVRHMD::OnEndGameFrame(FWorldContext& WorldContext)
 
 	LOG_FUNC();
 	//LOGD(WVRHMD, "OnEndGameFrame");
+	FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::GameFrameEnd, FrameData->frameNumber);
 
-	FrameDataPtr FrameDataCopy = FFrameData::NewInstance();
-	FFrameData::Copy(FrameData, FrameDataCopy);
+	// Send a copy of FrameData to render thread.  The ring is preallocated, no allocation here.
+	*FrameDataRing.AcquireForWrite() = *FrameData;
+	const uint32 frameSequence = FrameDataRing.Publish();
 
-	// Send a copy of FrameData to render thread.
-	ExecuteOnRenderThread_DoNotWait([this, FrameDataCopy](FRHICommandListImmediate& RHICmdList)
+	// Same condition as the UpdatePoses in OnStartGameFrame.
+#if WITH_EDITOR
+	bool bSyncPoses = WaveVRDirectPreview::IsVRPreview() && IsDirectPreview();
+#else
+	bool bSyncPoses = mRender.IsInitialized();
+#endif
+	bSyncPoses = bSyncPoses && !FrameData->bSupportLateUpdate;
+
+	ExecuteOnRenderThread_DoNotWait([this, bSyncPoses, frameSequence](FRHICommandListImmediate& RHICmdList)
 	{
-		OldFrameDataRT = FrameDataRT;
-		FrameDataRT = FrameDataCopy;
+		// Exactly the frame this command was enqueued for, even if GT has published newer ones.
+		FrameDataRT = FrameDataRing.Consume(frameSequence);
+		// Previous frame was submitted.  Sync poses for the GT's next frame.
+		if (bSyncPoses)
+			PoseMngr->SyncPoses_RenderThread(FrameDataRT);
 	}
 	);
 
@@ -519,6 +610,8 @@ void FWaveVRHMD::OnBeginRendering_RenderThread(FRHICommandListImmediate& RHICmdL
 	// TODO We should let simulator run the mRender to test windows path.
 	if (GIsEditor) return;
 
+	FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::BeginRendering, FrameDataRT->frameNumber);
+
 #if (UE_BUILD_DEVELOPMENT || UE_BUILD_DEBUG)
 	if (SimulatedLoadingRenderThread > 0 && SimulatedLoadingRenderThread <= 100000)
 	{
@@ -598,6 +691,7 @@ void FWaveVRHMD::processVREvent(WVR_Event_t vrEvent)
 		LOGD(WVRHMD, "processVREvent() WVR_EventType_DeviceConnected device %d", (uint8)_dt);
 		if (_dt == WVR_DeviceType::WVR_DeviceType_HMD) {
 			bIsHmdConnected = true;
+			UpdateInputMappingTable(_dt);
 		}
 		if (_dt == WVR_DeviceType::WVR_DeviceType_Controller_Right) {
 			if (!bIsRightDeviceConnected)
@@ -628,10 +722,33 @@ void FWaveVRHMD::processVREvent(WVR_Event_t vrEvent)
 		}
 		UWaveVREventCommon::OnConnectionChangeNative.Broadcast((uint8)_dt, false);
 		break;
+	case WVR_EventType_DeviceSuspend:
+	case WVR_EventType_DeviceResume:
+	case WVR_EventType_SystemInteractionModeChanged:
+	case WVR_EventType_PassthroughOverlayShownBySystem:
+	case WVR_EventType_PassthroughOverlayHiddenBySystem:
+		// The system may take or give back the input focus.
+		LOGD(WVRHMD, "processVREvent() event %d, refresh the system focus.", (int)vrEvent.common.type);
+		FocusMonitor.RequestRefresh();
+		break;
+	case WVR_EventType_DeviceStatusUpdate:
+		// The configuration of the device has changed, and may change its mapping.
+		LOGD(WVRHMD, "processVREvent() WVR_EventType_DeviceStatusUpdate device %d", (uint8)_dt);
+		UpdateInputMappingTable(_dt);
+		break;
 	case WVR_EventType_BatteryStatusUpdate:
 		LOGD(WVRHMD, "WVR_EventType: WVR_EventType battery status updated");
 		UBatteryStatusEvent::onBatteryStatusUpdateNative.Broadcast();
 		break;
+	case WVR_EventType_BatteryTemperatureStatusUpdate:
+		if (_dt == WVR_DeviceType::WVR_DeviceType_HMD)
+			mRender.GetFoveationScheduler()->OnThermalStatus(WVR()->GetBatteryTemperatureStatus(_dt));
+		break;
+	case WVR_EventType_RecommendedQuality_Lower:
+	case WVR_EventType_RecommendedQuality_Higher:
+		LOGD(WVRHMD, "processVREvent() recommended quality %s", vrEvent.common.type == WVR_EventType_RecommendedQuality_Higher ? "higher" : "lower");
+		mRender.GetFoveationScheduler()->OnRecommendedQuality(vrEvent.common.type == WVR_EventType_RecommendedQuality_Higher);
+		break;
 	case WVR_EventType_IpdChanged:
 		WVR_RenderProps props;
 		if (WVR()->GetRenderProps(&props)) {
@@ -642,7 +759,8 @@ void FWaveVRHMD::processVREvent(WVR_Event_t vrEvent)
 		else {
 			LOGD(WVRHMD, "Get render properties error! Not success!");
 		}
-		ResetProjectionMats();
+		EyeGeometry.Invalidate(TEXT("IpdChanged"));
+		UpdateEyeGeometry();
 		UIpdUpdateEvent::onIpdUpdateNative.Broadcast();
 		break;
 	case WVR_EventType_LeftToRightSwipe:
@@ -671,6 +789,10 @@ void FWaveVRHMD::processVREvent(WVR_Event_t vrEvent)
 	case WVR_EventType_DeviceRoleChanged:
 		LOGD(WVRHMD, "WaveVR processVREvent() WVR_EventType_DeviceRoleChanged");
 		SetInputRequestAll();	// For Focus role change.
+		FocusMonitor.RequestRefresh();
+		// The roles are switched, so are the mappings of the controllers.
+		UpdateInputMappingTable(WVR_DeviceType::WVR_DeviceType_Controller_Right);
+		UpdateInputMappingTable(WVR_DeviceType::WVR_DeviceType_Controller_Left);
 		UWaveVREventCommon::OnControllerRoleChangeNative.Broadcast();
 		bIsHmdConnected = PoseMngr->IsDeviceConnected(WVR_DeviceType::WVR_DeviceType_HMD);
 		UWaveVREventCommon::OnConnectionChangeNative.Broadcast((uint8)WVR_DeviceType::WVR_DeviceType_HMD, bIsHmdConnected);
@@ -681,6 +803,8 @@ void FWaveVRHMD::processVREvent(WVR_Event_t vrEvent)
 		break;
 	case WVR_EventType_TrackingModeChanged:
 		LOGD(WVRHMD, "WVR_EventType: WVR_EventType_TrackingModeChanged");
+		HmdDoF = WVR()->GetDegreeOfFreedom(WVR_DeviceType_HMD);
+		UpdateEyeGeometry();
 		UWaveVREventCommon::OnTrackingModeChangeNative.Broadcast();
 		break;
 		/* ------------------- Button State begin ---------------- */
@@ -859,82 +983,16 @@ FVector FWaveVRHMD::GetCompensationOffset() const {
 	return CompensationOffset;
 }
 
-void FWaveVRHMD::checkSystemFocus() {
-	// TODO IsInputFocusCapuredBySystem() will block!
-	bFocusCapturedBySystem = WVR()->IsInputFocusCapturedBySystem();
-}
-
 #pragma region
 bool FWaveVRHMD::IsButtonAvailable(WVR_DeviceType device, WVR_InputId button)
 {
-	if (device == WVR_DeviceType_HMD)
-		return usableButtons_hmd[(uint8)button];
-	if (device == WVR_DeviceType_Controller_Right)
-		return usableButtons_right[(uint8)button];
-	if (device == WVR_DeviceType_Controller_Left)
-		return usableButtons_left[(uint8)button];
-
-	return false;
+	return InputMapping.IsAvailable(device, button);
 }
 
 void FWaveVRHMD::UpdateInputMappingTable(WVR_DeviceType device)
 {
-	switch (device)
-	{
-	case WVR_DeviceType::WVR_DeviceType_HMD:
-		inputTableHMDSize = WVR()->GetInputMappingTable(device, inputTableHMD, (uint32_t)WVR_InputId_Max);
-		LOGD(WVRHMD, "UpdateInputMappingTable() HMD size: %d", inputTableHMDSize);
-		for (int _i = 0; _i < (int)inputTableHMDSize; _i++)
-		{
-			if (inputTableHMD[_i].source.capability != 0)
-			{
-				usableButtons_hmd[(uint8)inputTableHMD[_i].destination.id] = true;
-				LOGD(WVRHMD, "UpdateInputMappingTable() HMD button %d (capability: %d) is mapping to input ID %d.",
-					(uint8)inputTableHMD[_i].source.id, (uint8)inputTableHMD[_i].source.capability, (uint8)inputTableHMD[_i].destination.id);
-			}
-			else
-			{
-				LOGD(WVRHMD, "UpdateInputMappingTable() HMD source button %d has invalid capability.", (uint8)inputTableHMD[_i].source.id);
-			}
-		}
-		break;
-	case WVR_DeviceType::WVR_DeviceType_Controller_Right:
-		inputTableRightSize = WVR()->GetInputMappingTable(device, inputTableRight, (uint32_t)WVR_InputId_Max);
-		LOGD(WVRHMD, "UpdateInputMappingTable() Right size: %d", inputTableRightSize);
-		for (int _i = 0; _i < (int)inputTableRightSize; _i++)
-		{
-			if (inputTableRight[_i].source.capability != 0)
-			{
-				usableButtons_right[(uint8)inputTableRight[_i].destination.id] = true;
-				LOGD(WVRHMD, "UpdateInputMappingTable() Right button %d (capability: %d) is mapping to input ID %d.",
-					(uint8)inputTableRight[_i].source.id, (uint8)inputTableRight[_i].source.capability, (uint8)inputTableRight[_i].destination.id);
-			}
-			else
-			{
-				LOGD(WVRHMD, "UpdateInputMappingTable() Right source button %d has invalid capability.", (uint8)inputTableRight[_i].source.id);
-			}
-		}
-		break;
-	case WVR_DeviceType::WVR_DeviceType_Controller_Left:
-		inputTableLeftSize = WVR()->GetInputMappingTable(device, inputTableLeft, (uint32_t)WVR_InputId_Max);
-		LOGD(WVRHMD, "UpdateInputMappingTable() Left size: %d", inputTableLeftSize);
-		for (int _i = 0; _i < (int)inputTableLeftSize; _i++)
-		{
-			if (inputTableLeft[_i].source.capability != 0)
-			{
-				usableButtons_left[(uint8)inputTableLeft[_i].destination.id] = true;
-				LOGD(WVRHMD, "UpdateInputMappingTable() Left button %d (capability: %d) is mapping to input ID %d.",
-					(uint8)inputTableLeft[_i].source.id, (uint8)inputTableLeft[_i].source.capability, (uint8)inputTableLeft[_i].destination.id);
-			}
-			else
-			{
-				LOGD(WVRHMD, "UpdateInputMappingTable() Left source button %d has invalid capability.", (uint8)inputTableLeft[_i].source.id);
-			}
-		}
-		break;
-	default:
-		break;
-	}
+	LOGD(WVRHMD, "UpdateInputMappingTable() device %d", (uint8)device);
+	InputMapping.Rebuild(device);
 }
 
 void FWaveVRHMD::SetInputRequest(WVR_DeviceType device, const WVR_InputAttribute_t* inputAttributes, uint32_t size) {
@@ -952,17 +1010,17 @@ void FWaveVRHMD::SetInputRequest(WVR_DeviceType device, const WVR_InputAttribute
 void FWaveVRHMD::SetInputRequestAll()
 {
 	// TODO Correct it.  This may be needed in windows
-	if (inputTableHMDSize == 0)
+	if (InputMapping.IsEmpty(WVR_DeviceType::WVR_DeviceType_HMD))
 	{
 		LOGD(WVRHMD, "SetInputRequestAll() SetInputRequest HMD.");
 		SetInputRequest(WVR_DeviceType::WVR_DeviceType_HMD, InputAttributes_HMD, InputAttributes_HMD_Count);
 	}
-	if (inputTableRightSize == 0)
+	if (InputMapping.IsEmpty(WVR_DeviceType::WVR_DeviceType_Controller_Right))
 	{
 		LOGD(WVRHMD, "SetInputRequestAll() SetInputRequest Right.");
 		SetInputRequest(WVR_DeviceType::WVR_DeviceType_Controller_Right, InputAttributes_Controller, InputAttributes_Controller_Count);
 	}
-	if (inputTableLeftSize == 0)
+	if (InputMapping.IsEmpty(WVR_DeviceType::WVR_DeviceType_Controller_Left))
 	{
 		LOGD(WVRHMD, "SetInputRequestAll() SetInputRequest Left.");
 		SetInputRequest(WVR_DeviceType::WVR_DeviceType_Controller_Left, InputAttributes_Controller, InputAttributes_Controller_Count);
@@ -971,61 +1029,13 @@ void FWaveVRHMD::SetInputRequestAll()
 
 bool FWaveVRHMD::GetInputMappingPair(WVR_DeviceType device, WVR_InputId &destination)
 {
-	// Default true in editor mode, destination will be equivallent to source.
-	bool result = false;
-	int index = 0;
-
-	switch (device)
-	{
-	case WVR_DeviceType::WVR_DeviceType_HMD:
-		if (inputTableHMDSize > 0)
-		{
-			for (index = 0; index < (int)inputTableHMDSize; index++)
-			{
-				if (inputTableHMD[index].destination.id == destination)
-				{
-					destination = inputTableHMD[index].source.id;
-					result = true;
-				}
-			}
-		}
-		break;
-	case WVR_DeviceType::WVR_DeviceType_Controller_Right:
-		if (inputTableRightSize > 0)
-		{
-			for (index = 0; index < (int)inputTableRightSize; index++)
-			{
-				if (inputTableRight[index].destination.id == destination)
-				{
-					destination = inputTableRight[index].source.id;
-					result = true;
-				}
-			}
-		}
-		break;
-	case WVR_DeviceType::WVR_DeviceType_Controller_Left:
-		if (inputTableLeftSize > 0)
-		{
-			for (index = 0; index < (int)inputTableLeftSize; index++)
-			{
-				if (inputTableLeft[index].destination.id == destination)
-				{
-					destination = inputTableLeft[index].source.id;
-					result = true;
-				}
-			}
-		}
-		break;
-	default:
-		break;
-	}
-
-	return result;
+	// The destination is replaced by its source if mapped.
+	return InputMapping.GetSource(device, destination, destination);
 }
 #pragma endregion Key Mapping
 
 bool FWaveVRHMD::IsFocusCapturedBySystem() const {
-	return bFocusCapturedBySystem;
+	return FocusMonitor.IsCaptured();
 }
 
 bool FWaveVRHMD::IsDeviceConnected(WVR_DeviceType device) const {
@@ -1057,14 +1067,8 @@ bool FWaveVRHMD::IsStereoEnabled() const
 float FWaveVRHMD::GetWorldToMetersScale() const
 {
 	LOG_FUNC();
-	if (IsInGameThread() && GWorld != nullptr)
-	{
-		// For example, One world unit need multiply 100 to become 1 meter.
-		float wtm = GWorld->GetWorldSettings()->WorldToMeters;
-		//LOGI(WVRHMD, "GWorld->GetWorldSettings()->WorldToMeters = %f", wtm);
-		return wtm;
-	}
-	return 100.0f;
+	// For example, One world unit need multiply 100 to become 1 meter.  Same value in both GT and RT.
+	return EyeGeometry.Get()->WorldToMeters;
 }
 
 bool FWaveVRHMD::EnableStereo(bool bStereo)
@@ -1086,8 +1090,10 @@ void FWaveVRHMD::AdjustViewRect(EStereoscopicPass StereoPass, int32& X, int32& Y
 		SizeX = SizeX / 2;
 		SizeY = SizeY;
 
-		uint32 newWidth = FMath::CeilToInt(SizeX * PixelDensity);
-		uint32 newHeight = FMath::CeilToInt(SizeY * PixelDensity);
+		// No supersampling in editor.
+		const float density = FMath::Min(PixelDensity, 1.0f);
+		uint32 newWidth = FMath::CeilToInt(SizeX * density);
+		uint32 newHeight = FMath::CeilToInt(SizeY * density);
 
 		// Put in center
 		X = FMath::CeilToInt((SizeX - newWidth) / 2) + (StereoPass == eSSP_RIGHT_EYE ? SizeX : 0);
@@ -1105,10 +1111,12 @@ void FWaveVRHMD::AdjustViewRect(EStereoscopicPass StereoPass, int32& X, int32& Y
 		return;
 	}
 
+	// The eye texture is in the allocated density.  Render the center part in the current density.
 	uint32 width = mRender.GetSingleEyePixelWidth(), height = mRender.GetSingleEyePixelHeight();
+	const float scale = GetViewportScale();
 
-	uint32 newWidth = FMath::CeilToInt(width * PixelDensity);
-	uint32 newHeight = FMath::CeilToInt(height * PixelDensity);
+	uint32 newWidth = FMath::Min<uint32>(FMath::CeilToInt(width * scale), width);
+	uint32 newHeight = FMath::Min<uint32>(FMath::CeilToInt(height * scale), height);
 
 	if (false/*GSupportsMobileMultiView*/) {
 		SizeX = newWidth;
@@ -1147,12 +1155,13 @@ FMatrix FWaveVRHMD::GetStereoProjectionMatrix(const enum EStereoscopicPass Stere
 	if (!IsStereoEnabledInternal())
 		return FMatrix::Identity;
 
+	FWaveVREyeGeometryPtr geometry = EyeGeometry.Get();
 	if (StereoPassType == eSSP_LEFT_EYE) {
-		return LeftProjection;
+		return geometry->Projections[0];
 	} else if (StereoPassType == eSSP_RIGHT_EYE) {
-		return RightProjection;
+		return geometry->Projections[1];
 	} else if (StereoPassType == eSSP_FULL) {
-		return CenterProjection;
+		return geometry->Projections[2];
 	}
 
 	return FMatrix::Identity;
@@ -1169,9 +1178,6 @@ FWaveVRHMD::FWaveVRHMD(const FAutoRegister& AutoRegister)
 	, FSceneViewExtensionBase(AutoRegister)
 	, bUseUnrealDistortion(GIsEditor)
 
-	, inputTableHMDSize(0)
-	, inputTableRightSize(0)
-	, inputTableLeftSize(0)
 
 	, gestureEventCurr(WVR_EventType::WVR_EventType_HandGesture_Changed)
 	, handGestureEnabled(false)
@@ -1182,12 +1188,6 @@ FWaveVRHMD::FWaveVRHMD(const FAutoRegister& AutoRegister)
 
 	, DistortionPointsX(40)
 	, DistortionPointsY(40)
-	, NumVerts(0)
-	, NumTris(0)
-	, NumIndices(0)
-	, DistortionMeshIndices(nullptr)
-	, DistortionMeshVerticesLeftEye(nullptr)
-	, DistortionMeshVerticesRightEye(nullptr)
 
 	, bIsHmdConnected(false)
 	, bIsRightDeviceConnected(false)
@@ -1198,7 +1198,8 @@ FWaveVRHMD::FWaveVRHMD(const FAutoRegister& AutoRegister)
 
 	, NearClippingPlane(10.0f)
 	, FarClippingPlane(0.0f)
-	, bNeedResetProjectionMatrix(true)
+	, WorldToMeters(100.0f)
+	, HmdDoF(WVR_NumDoF_6DoF)
 
 	, mRender(this)
 	, PoseMngr(PoseManagerImp::GetInstance())
@@ -1212,7 +1213,10 @@ FWaveVRHMD::FWaveVRHMD(const FAutoRegister& AutoRegister)
 	, Current_Yaw(0.f)
 
 	, PixelDensity(1.f)
-	, bFocusCapturedBySystem(false)
+	, AllocatedDensity(1.f)
+	, RecommendedWidth(0)
+	, RecommendedHeight(0)
+	, RefreshRate(60)
 	, bIsInAppRecenter(false)
 	, bSIM_Available(false)
 	, FirstGameFrame(true)
@@ -1297,6 +1301,9 @@ void FWaveVRHMD::setDeviceSupportedMaxFPS()
 	if (WVR()->GetRenderProps(&props)) {
 		float fps = props.refreshRate;
 		LOGI(WVRHMD, "Set FreshRate as %f", fps);
+		if (fps > 0)
+			RefreshRate = fps;
+		DynamicResolution.SetRefreshRate(fps);
 		GEngine->SetMaxFPS(fps);  // If set to 500, the tick frequency will become 500 if possible.
 		//IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("t.MaxFPS"));
 		//CVar->Set(fps);
@@ -1311,10 +1318,8 @@ bool FWaveVRHMD::Startup()
 {
 	LOG_FUNC();
 
-	FrameData = FFrameData::NewInstance();
-	FrameDataRT = FFrameData::NewInstance();
-	OldFrameData = FFrameData::NewInstance();
-	OldFrameDataRT = FFrameData::NewInstance();
+	FrameData = &GameFrameData;
+	FrameDataRT = FrameDataRing.GetConsumed();
 
 	// load WaveVR project settings from ini
 	ApplyCVarSettingsFromIni(TEXT("/Script/WaveVREditor.WaveVRSettings"), *GEngineIni, ECVF_SetByProjectSetting);
@@ -1343,6 +1348,7 @@ bool FWaveVRHMD::Startup()
 	supportedFeatures = WVR()->GetSupportedFeatures();
 	LOGI(WVRHMD, "Startup() supportedFeatures: %d", (int)supportedFeatures);
 	pollEvent(); //get device connect info.
+	FocusMonitor.Startup();
 #if WITH_EDITOR
 	if (!GIsEditor)
 #endif
@@ -1368,7 +1374,8 @@ bool FWaveVRHMD::Startup()
 	}
 
 	NearClippingPlane = GNearClippingPlane;
-	ResetProjectionMats();
+	HmdDoF = WVR()->GetDegreeOfFreedom(WVR_DeviceType_HMD);
+	UpdateEyeGeometry();
 
 	if (bUseUnrealDistortion)
 		SetNumOfDistortionPoints(40, 40);
@@ -1385,7 +1392,7 @@ bool FWaveVRHMD::Startup()
 
 	uint32 width = 1024, height = 1024;
 	WVR()->GetRenderTargetSize(&width, &height);
-	mRender.SetSingleEyePixelSize(width, height);
+	SetRenderTargetSize(width, height);
 	mRender.SetTextureFormat(PF_R8G8B8A8);
 	mRender.Apply();
 
@@ -1417,6 +1424,7 @@ void FWaveVRHMD::OnResume()
 	if (bResumed)
 		return;
 	bResumed = true;
+	FocusMonitor.RequestRefresh();
 	UWaveVREventCommon::OnResumeNative.Broadcast();
 
 	bIsHmdConnected = PoseMngr->IsDeviceConnected(WVR_DeviceType::WVR_DeviceType_HMD);
@@ -1480,6 +1488,8 @@ void FWaveVRHMD::OnPostLoadMap(UWorld*)
 void FWaveVRHMD::Shutdown()
 {
 	LOG_FUNC_IF(WAVEVR_LOG_ENTRY_LIFECYCLE);
+	// The monitor calls the runtime.
+	FocusMonitor.Shutdown();
 	if (!GIsEditor)
 	{
 		LOGI(WVRHMD, "Stop Hand Gesture before WVR_Quit.");
@@ -1489,18 +1499,15 @@ void FWaveVRHMD::Shutdown()
 		mRender.Shutdown();
 		WVR()->Quit();
 	} else {
-
-		if (DistortionMeshVerticesLeftEye != nullptr)
-			delete[] DistortionMeshVerticesLeftEye;
-		DistortionMeshVerticesLeftEye = nullptr;
-
-		if (DistortionMeshVerticesRightEye != nullptr)
-			delete[] DistortionMeshVerticesRightEye;
-		DistortionMeshVerticesRightEye = nullptr;
-
-		if (DistortionMeshIndices != nullptr)
-			delete[] DistortionMeshIndices;
-		DistortionMeshIndices = nullptr;
+		FWaveVRHMD* hmd = this;
+		ENQUEUE_RENDER_COMMAND(ReleaseDistortionMeshes) (
+			[hmd](FRHICommandListImmediate& RHICmdList)
+			{
+				hmd->DistortionMeshes_RenderThread[0].Reset();
+				hmd->DistortionMeshes_RenderThread[1].Reset();
+			});
+		FlushRenderingCommands();
+		FWaveVRDistortionMeshCache::Get().Empty();
 
 		if (bSIM_Available)
 			WVR()->Quit();
@@ -1509,51 +1516,14 @@ void FWaveVRHMD::Shutdown()
 	Instance = nullptr;
 }
 
-static FMatrix MakeProjection(float Left, float Right, float Top, float Bottom, float ZNear, float ZFar = 0) {
-	LOGI(WVRHMD, "MakeProjection (%f, %f, %f, %f, %f, %f)", Left, Right, Top, Bottom, ZNear, ZFar);
-
-	float SumRL = (Right + Left);
-	float SumTB = (Top + Bottom);
-	float SubRL = Right - Left;
-	float SubTB = Top - Bottom;
-
-	if (ZFar > 0 && ZNear > 0 && ZFar > ZNear) {
-		// Reversed Z [1, 0].  Use this function if ZFar is finite.
-		return FMatrix(
-			FPlane(2.0f / SubRL, 0.0f, 0.0f, 0.0f),
-			FPlane(0.0f, 2.0f / SubTB, 0.0f, 0.0f),
-			FPlane(SumRL / -SubRL, SumTB / -SubTB, ZNear / (ZNear - ZFar), 1.0f),
-			FPlane(0.0f, 0.0f, ZFar * ZNear / (ZFar - ZNear), 0.0f)
-		);
-	}
-	else
-	{
-		// Reversed Z [1, 0].  Use this function if ZFar is infinite.
-		return FMatrix(
-			FPlane(2.0f / SubRL, 0.0f, 0.0f, 0.0f),
-			FPlane(0.0f, 2.0f / SubTB, 0.0f, 0.0f),
-			FPlane(SumRL / -SubRL, SumTB / -SubTB, 0.0f, 1.0f),
-			FPlane(0.0f, 0.0f, ZNear, 0.0f)
-		);
-	}
-}
-
-void FWaveVRHMD::ResetProjectionMats()
+void FWaveVRHMD::UpdateEyeGeometry()
 {
-	LOG_FUNC();
-	bNeedResetProjectionMatrix = false;
-
-	float boundaries[3][4];
-	WVR()->GetClippingPlaneBoundary(WVR_Eye_Left, &(boundaries[0][0]), &(boundaries[0][1]), &(boundaries[0][2]), &(boundaries[0][3]));
-	WVR()->GetClippingPlaneBoundary(WVR_Eye_Right, &(boundaries[1][0]), &(boundaries[1][1]), &(boundaries[1][2]), &(boundaries[1][3]));
-	boundaries[2][0] = FMath::Min(boundaries[0][0], boundaries[1][0]);
-	boundaries[2][1] = FMath::Max(boundaries[0][1], boundaries[1][1]);
-	boundaries[2][2] = FMath::Max(boundaries[0][2], boundaries[1][2]);
-	boundaries[2][3] = FMath::Min(boundaries[0][3], boundaries[1][3]);
-
-	LeftProjection = MakeProjection(boundaries[0][0], boundaries[0][1], boundaries[0][2], boundaries[0][3], NearClippingPlane, FarClippingPlane);
-	RightProjection = MakeProjection(boundaries[1][0], boundaries[1][1], boundaries[1][2], boundaries[1][3], NearClippingPlane, FarClippingPlane);
-	CenterProjection = MakeProjection(boundaries[2][0], boundaries[2][1], boundaries[2][2], boundaries[2][3], NearClippingPlane, FarClippingPlane);
+	FWaveVREyeGeometryCache::FParams params;
+	params.DoF = HmdDoF;
+	params.NearPlane = NearClippingPlane;
+	params.FarPlane = FarClippingPlane;
+	params.WorldToMeters = WorldToMeters;
+	EyeGeometry.Update(params);
 }
 
 void FWaveVRHMD::SetClippingPlanes(float NCP, float FCP) {
@@ -1563,10 +1533,8 @@ void FWaveVRHMD::SetClippingPlanes(float NCP, float FCP) {
 
 	GNearClippingPlane = NearClippingPlane;
 
-	bNeedResetProjectionMatrix = true;
-
-	// Do we need reset it immediatly?
-	ResetProjectionMats();
+	// Only the projections are rebuilt.
+	UpdateEyeGeometry();
 }
 
 void FWaveVRHMD::SetInAppRecenter(bool enabled) {
@@ -1629,11 +1597,9 @@ void FWaveVRHMD::PostRenderViewFamily_RenderThread(FRHICommandListImmediate& RHI
 #ifdef DP_DEBUG
 		LOGW(WVRHMD, "PostRenderViewFamily_RenderThread %d", x2++);
 #endif
+		// No lock here.  The preview copies the texture on GPU, and sends it when the copy is done.
 		FRHITexture2D* TexRef2D = InViewFamily.RenderTarget->GetRenderTargetTexture()->GetTexture2D();
-		uint32 LolStride = 0;
-		char* TextureDataPtr = (char*)RHICmdList.LockTexture2D(TexRef2D, 0, EResourceLockMode::RLM_ReadOnly, LolStride, false);
-		DirectPreview->sendRTTexture(RHICmdList, TexRef2D->GetNativeResource());
-		RHICmdList.UnlockTexture2D(TexRef2D, 0, false);
+		DirectPreview->sendRTTexture(RHICmdList, TexRef2D);
 	}
 #endif
 }
@@ -22,6 +22,11 @@
 #include "WaveVRRender.h"
 #include "WaveVRHMD_FrameData.h"
 #include "WaveVRDirectPreviewSettings.h"
+#include "WaveVRInputMapping.h"
+#include "WaveVRFocusMonitor.h"
+#include "WaveVRDynamicResolution.h"
+#include "WaveVREyeGeometry.h"
+#include "WaveVRDistortionMesh.h"
 
 #include "ARSystem.h"
 #include "ARLightEstimate.h"
@@ -260,13 +265,20 @@ protected:
 	virtual void AddReferencedObjects(FReferenceCollector& Collector) /*override*/;
 
 public:
-	FrameDataPtr FrameData;
-	FrameDataPtr FrameDataRT;
-	FrameDataPtr OldFrameData;
-	FrameDataPtr OldFrameDataRT;
+	FrameDataPtr FrameData;  // Only used in GT
+	FrameDataPtr FrameDataRT;  // Only used in RT.  Borrowed from FrameDataRing.
+
+	FFrameDataRing::FStats GetFrameDataStats() const { return FrameDataRing.GetStats(); }
 
 private:
 	void NextFrameData();
+	// Allocate the eye textures of the recommended size in the max density of the dynamic resolution.
+	void SetRenderTargetSize(uint32 width, uint32 height);
+	void UpdatePixelDensity();
+	float GetViewportScale() const { return PixelDensity / AllocatedDensity; }
+
+	FFrameData GameFrameData;
+	FFrameDataRing FrameDataRing;
 
 public:
 	static void SetARSystem(TSharedPtr<IARSystemSupport, ESPMode::ThreadSafe> InArSystem) { ArSystem = InArSystem; }
@@ -279,6 +291,7 @@ public:
 	bool IsStereoEnabledInternal() const;
 	FVector GetCompensationOffset() const;
 	bool IsFocusCapturedBySystem() const;
+	FOnSystemFocusChanged& OnSystemFocusChanged() { return FocusMonitor.OnChanged; }
 	bool IsDeviceConnected(WVR_DeviceType device) const;
 	void SetInAppRecenter(bool enabled = false);
 	bool IsInAppRecenter();
@@ -301,6 +314,8 @@ public:
 
 public:
 	bool IsRenderInitialized();
+	// The current snapshot.  See FWaveVREyeGeometryCache.
+	FWaveVREyeGeometryPtr GetEyeGeometry() const { return EyeGeometry.Get(); }
 	void SimulateCPULoading(unsigned int gameThreadLoading, unsigned int renderThreadLoading);
 
 private:
@@ -310,9 +325,6 @@ private:
 		{WVR_InputId_Alias1_Back, WVR_InputType_Button, WVR_AnalogType_None},
 		{WVR_InputId_Alias1_Enter, WVR_InputType_Button, WVR_AnalogType_None},
 	};
-	bool usableButtons_hmd[(int)WVR_InputId_Max] = { false };
-	WVR_InputMappingPair_t inputTableHMD[(int)WVR_InputId_Max];
-	uint32_t inputTableHMDSize;
 
 
 	// ---------------------------------- Controller ----------------------------------
@@ -333,12 +345,8 @@ private:
 
 		{WVR_InputId_Alias1_Trigger, WVR_InputType_Button | WVR_InputType_Touch | WVR_InputType_Analog, WVR_AnalogType_1D},
 	};
-	bool usableButtons_right[(int)WVR_InputId_Max] = { false };
-	bool usableButtons_left[(int)WVR_InputId_Max] = { false };
-	WVR_InputMappingPair_t inputTableRight[(int)WVR_InputId_Max];
-	WVR_InputMappingPair_t inputTableLeft[(int)WVR_InputId_Max];
-	uint32_t inputTableRightSize;
-	uint32_t inputTableLeftSize;
+
+	FWaveVRInputMapping InputMapping;
 
 public:	// Gesture
 	WVR_EventType GetGestureEvent() { return gestureEventCurr; }
@@ -377,10 +385,6 @@ private:
 
 	// DistortionCorrection
 private:
-	/** Helper method to generate index buffer for manual distortion rendering */
-	void GenerateDistortionCorrectionIndexBuffer();
-	/** Helper method to generate vertex buffer for manual distortion rendering */
-	void GenerateDistortionCorrectionVertexBuffer(EStereoscopicPass Eye);
 	/** Generates Distortion Correction Points*/
 	void SetNumOfDistortionPoints(int32 XPoints, int32 YPoints);
 
@@ -405,15 +409,10 @@ public:
 	// distortion mesh
 	uint32 DistortionPointsX;
 	uint32 DistortionPointsY;
-	uint32 NumVerts;
-	uint32 NumTris;
-	uint32 NumIndices;
 	FHMDViewMesh HiddenAreaMeshes[2];
 	FHMDViewMesh VisibleAreaMeshes[2];
 
-	uint16* DistortionMeshIndices;
-	FDistortionVertex* DistortionMeshVerticesLeftEye;
-	FDistortionVertex* DistortionMeshVerticesRightEye;
+	FWaveVRDistortionMeshPtr DistortionMeshes_RenderThread[2];  // Index is left and right
 	//WaveVRDistortion* mWaveVRDistort;
 	FSceneViewFamily* mViewFamily;
 	uint64_t GetSupportedFeatures() { return supportedFeatures; }
@@ -428,8 +427,8 @@ private:
 
 	void pollEvent();
 	void processVREvent(WVR_Event_t vrEvent);
-	void ResetProjectionMats();
-	void checkSystemFocus();
+	// Rebuild the eye geometry if it is invalidated, or any of its parameters is changed.
+	void UpdateEyeGeometry();
 
 private:
 	bool bIsHmdConnected;
@@ -441,7 +440,9 @@ private:
 	float CurrentIPD;
 	float NearClippingPlane;
 	float FarClippingPlane;
-	bool bNeedResetProjectionMatrix;
+	float WorldToMeters;  // Of the current world, refreshed in OnStartGameFrame.
+	WVR_NumDoF HmdDoF;
+	FWaveVREyeGeometryCache EyeGeometry;
 
 	FWaveVRRender mRender;
 	PoseManagerImp* PoseMngr;
@@ -451,17 +452,18 @@ private:
 	FRotator	DeltaControlRotation;    // same as DeltaControlOrientation but as rotator
 	FQuat	DeltaControlOrientation; // same as DeltaControlRotation but as quat
 
-	FMatrix LeftProjection;
-	FMatrix RightProjection;
-	FMatrix CenterProjection;
-
 	// Game Position / Teleport
 	FQuat BaseOrientation;
 	FVector CompensationOffset;
 	float Current_Yaw;
 
-	float PixelDensity;
-	bool bFocusCapturedBySystem;
+	float PixelDensity;  // Relative to the recommended eye size.
+	float AllocatedDensity;  // The eye textures are allocated in this density.
+	uint32 RecommendedWidth;
+	uint32 RecommendedHeight;
+	float RefreshRate;
+	FWaveVRDynamicResolution DynamicResolution;
+	FWaveVRFocusMonitor FocusMonitor;
 	bool bIsInAppRecenter;
 	bool bSIM_Available;
 	bool FirstGameFrame;
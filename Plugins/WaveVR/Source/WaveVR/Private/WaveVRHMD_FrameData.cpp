@@ -75,6 +75,7 @@ FFrameData::FFrameData()
 	, gameOrientation(EForceInit::ForceInit)
 	, gamePosition()
 	, meterToWorldUnit(100)
+	, viewportScale(1)
 	, bSupportLateUpdate(true)
 	, bNeedLateUpdateInRT(true)
 	, bDoUpdateInGT(false)
@@ -88,11 +89,7 @@ void FFrameData::ApplyGamePoseForHMD() {
 	WaveVRUtils::ApplyGamePose(orientation, position, baseOrientation, basePosition, gameOrientation, gamePosition);
 }
 
-FrameDataPtr FFrameData::NewInstance() {
-	return MakeShareable(new FFrameData());
-}
-
-void FFrameData::DebugLogFrameData(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& frameData, const char* name) {
+void FFrameData::DebugLogFrameData(const FFrameData* frameData, const char* name) {
 	LOGD(WVRFrameData,
 		"FrameData: %s\n"
 		"frameNumber=%d, bNeedLateUpdateInRT=%d, meterToWorldUnit=%f, Origin=%d\n"
@@ -110,6 +107,56 @@ void FFrameData::DebugLogFrameData(const TSharedPtr<FFrameData, ESPMode::ThreadS
 	);
 }
 
-void FFrameData::Copy(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& from, TSharedPtr<FFrameData, ESPMode::ThreadSafe>& to) {
-	*to = *from;
+FFrameDataRing::FFrameDataRing()
+	: WriteSequence(1)
+	, ReadIndex(0)
+	, ConsumedSequence(0)
+	, RetiredIndex(Capacity - 1)
+{
+	// The RT holds the slot of sequence 0 before the first frame.  The others are never published.
+	for (int32 i = 0; i < Capacity; i++)
+		Sequences[i] = i == 0 ? 0 : -1;
+}
+
+uint32 FFrameDataRing::Publish() {
+	const uint32 sequence = WriteSequence++;
+	const int32 index = sequence % Capacity;
+	// The slot was published Capacity frames ago.  If RT has not reached it, it will be lost.
+	const int32 previous = FPlatformAtomics::AtomicRead(&Sequences[index]);
+	if (previous >= 0 && previous > FPlatformAtomics::AtomicRead(&ConsumedSequence))
+		OverwrittenCount.Increment();
+	FPlatformAtomics::InterlockedExchange(&Sequences[index], (int32)sequence);
+	PublishedCount.Increment();
+	return sequence;
+}
+
+FFrameData* FFrameDataRing::Consume(uint32 sequence) {
+	const int32 index = sequence % Capacity;
+	if (FPlatformAtomics::AtomicRead(&Sequences[index]) != (int32)sequence) {
+		RepeatedCount.Increment();
+		return &Slots[ReadIndex];
+	}
+
+	if (index != ReadIndex)
+		FPlatformAtomics::InterlockedExchange(&RetiredIndex, ReadIndex);
+	FPlatformAtomics::InterlockedExchange(&ConsumedSequence, (int32)sequence);
+	ReadIndex = index;
+	ConsumedCount.Increment();
+	return &Slots[ReadIndex];
+}
+
+FFrameDataRing::FStats FFrameDataRing::GetStats() const {
+	FStats stats;
+	stats.published = PublishedCount.GetValue();
+	stats.consumed = ConsumedCount.GetValue();
+	stats.overwritten = OverwrittenCount.GetValue();
+	stats.repeated = RepeatedCount.GetValue();
+	return stats;
+}
+
+void FFrameDataRing::ResetStats() {
+	PublishedCount.Reset();
+	ConsumedCount.Reset();
+	OverwrittenCount.Reset();
+	RepeatedCount.Reset();
 }
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Platforms/WaveVRAPIWrapper.h"
 
 class FFramePoses
@@ -29,7 +30,7 @@ public:
 	FQuat DeviceOrientation[WVR_DEVICE_COUNT_LEVEL_1];  // In Unreal world space.  Index is follow PoseManagerImp::DeviceTypes.
 };
 
-class FFrameData : public TSharedFromThis<FFrameData, ESPMode::ThreadSafe>
+class FFrameData
 {
 public:
 	uint32 frameNumber;  // copy from GFrameNumber
@@ -44,6 +45,7 @@ public:
 	FVector gamePosition;  // HMD Game World
 
 	float meterToWorldUnit;  // Game World
+	float viewportScale;  // Size of the rendered viewport over the allocated eye texture, from the pixel density.
 
 	bool bSupportLateUpdate;
 	bool bNeedLateUpdateInRT;
@@ -60,10 +62,65 @@ public:
 public:
 	void ApplyGamePoseForHMD();
 
-	static void DebugLogFrameData(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& frameData, const char* name);
-	static TSharedPtr<FFrameData, ESPMode::ThreadSafe> NewInstance();
-	static void Copy(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& from, TSharedPtr<FFrameData, ESPMode::ThreadSafe>& to);
+	static void DebugLogFrameData(const FFrameData* frameData, const char* name);
 };
 
-typedef TSharedPtr<FFrameData, ESPMode::ThreadSafe> FrameDataPtr;
+// Frame data is owned by the FWaveVRHMD or by the FFrameDataRing.  Users only borrow it.
+typedef FFrameData* FrameDataPtr;
+
+/**
+ * Preallocated ring which hands the FFrameData from game thread to render thread.
+ *
+ * The game thread fills the slot from AcquireForWrite() and Publish() it, which returns the
+ * sequence of the frame.  The sequence is captured by the render command of that frame, and the
+ * render thread Consume() exactly that slot, and keeps it until its next Consume().  So a frame is
+ * always rendered with its own poses and viewport scale, even if the game thread runs ahead.
+ * No slot is allocated or refcounted after construction.
+ *
+ * The game thread starts a frame from GetRetired(), the slot the render thread had finished with
+ * last, which still holds the late updated poses.  The game thread can only be a frame or two
+ * ahead, so a slot is not written again before it is consumed.  If it is, the render thread sees
+ * the sequence mismatch, keeps its previous frame, and the frame is counted as overwritten.
+ */
+class FFrameDataRing
+{
+public:
+	static const int32 Capacity = 4;
+
+	struct FStats
+	{
+		uint32 published;
+		uint32 consumed;
+		uint32 overwritten;  // Published by GT but written again before RT consumed it.
+		uint32 repeated;  // RT had no valid frame, and reused its previous one.
+	};
 
+public:
+	FFrameDataRing();
+
+	// Game thread
+	FFrameData* AcquireForWrite() { return &Slots[WriteSequence % Capacity]; }
+	uint32 Publish();
+	const FFrameData* GetRetired() const { return &Slots[FPlatformAtomics::AtomicRead(&RetiredIndex)]; }
+
+	// Render thread
+	FFrameData* Consume(uint32 sequence);
+	FFrameData* GetConsumed() { return &Slots[ReadIndex]; }
+
+	// Any thread
+	FStats GetStats() const;
+	void ResetStats();
+
+private:
+	FFrameData Slots[Capacity];
+	volatile int32 Sequences[Capacity];  // Sequence of the frame in each slot.  Written by GT, read by RT.
+	uint32 WriteSequence;  // Only accessed by GT
+	int32 ReadIndex;  // Only accessed by RT
+	volatile int32 ConsumedSequence;  // Written by RT
+	volatile int32 RetiredIndex;  // Written by RT
+
+	FThreadSafeCounter PublishedCount;
+	FThreadSafeCounter ConsumedCount;
+	FThreadSafeCounter OverwrittenCount;
+	FThreadSafeCounter RepeatedCount;
+};
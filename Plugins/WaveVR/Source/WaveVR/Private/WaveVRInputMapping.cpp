@@ -0,0 +1,106 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRInputMapping.h"
+#include "WaveVRPrivatePCH.h"
+#include "Platforms/WaveVRAPIWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRInputMapping, Log, All);
+
+void FWaveVRInputMapping::FDeviceTable::Reset()
+{
+	for (int32 i = 0; i < WVR_InputId_Max; i++)
+		sourceOf[i] = INDEX_NONE;
+	available = 0;
+	size = 0;
+}
+
+FWaveVRInputMapping::FWaveVRInputMapping()
+{
+	for (int32 i = 0; i < DeviceCount; i++)
+		Tables[i].Reset();
+}
+
+int32 FWaveVRInputMapping::GetDeviceIndex(WVR_DeviceType device)
+{
+	switch (device)
+	{
+	case WVR_DeviceType::WVR_DeviceType_HMD:
+		return 0;
+	case WVR_DeviceType::WVR_DeviceType_Controller_Right:
+		return 1;
+	case WVR_DeviceType::WVR_DeviceType_Controller_Left:
+		return 2;
+	default:
+		return INDEX_NONE;
+	}
+}
+
+void FWaveVRInputMapping::Rebuild(WVR_DeviceType device)
+{
+	int32 index = GetDeviceIndex(device);
+	if (index == INDEX_NONE)
+		return;
+
+	WVR_InputMappingPair_t pairs[WVR_InputId_Max];
+	uint32_t size = FMath::Min<uint32_t>(WVR()->GetInputMappingTable(device, pairs, (uint32_t)WVR_InputId_Max), (uint32_t)WVR_InputId_Max);
+
+	FDeviceTable& table = Tables[index];
+	table.Reset();
+	table.size = size;
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const int32 dst = (int32)pairs[i].destination.id;
+		const int32 src = (int32)pairs[i].source.id;
+		if (!IsValidId(dst) || !IsValidId(src))
+			continue;
+
+		// The last pair of a destination wins, as the old linear scan.
+		table.sourceOf[dst] = (int8)src;
+		if (pairs[i].source.capability != 0)
+		{
+			table.available |= 1u << dst;
+			LOGD(WVRInputMapping, "Rebuild() device %d button %d (capability: %d) is mapping to input ID %d.", (uint8)device, src, (uint8)pairs[i].source.capability, dst);
+		}
+		else
+		{
+			LOGD(WVRInputMapping, "Rebuild() device %d source button %d has invalid capability.", (uint8)device, src);
+		}
+	}
+
+	LOGD(WVRInputMapping, "Rebuild() device %d size %u, available 0x%08X", (uint8)device, size, table.available);
+}
+
+bool FWaveVRInputMapping::IsEmpty(WVR_DeviceType device) const
+{
+	int32 index = GetDeviceIndex(device);
+	return index == INDEX_NONE || Tables[index].size == 0;
+}
+
+bool FWaveVRInputMapping::GetSource(WVR_DeviceType device, WVR_InputId destination, WVR_InputId& OutSource) const
+{
+	int32 index = GetDeviceIndex(device);
+	if (index == INDEX_NONE || !IsValidId(destination))
+		return false;
+
+	int8 source = Tables[index].sourceOf[destination];
+	if (source == INDEX_NONE)
+		return false;
+	OutSource = (WVR_InputId)source;
+	return true;
+}
+
+bool FWaveVRInputMapping::IsAvailable(WVR_DeviceType device, WVR_InputId destination) const
+{
+	int32 index = GetDeviceIndex(device);
+	if (index == INDEX_NONE || !IsValidId(destination))
+		return false;
+	return (Tables[index].available & (1u << destination)) != 0;
+}
@@ -0,0 +1,55 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "wvr_device.h"
+
+/**
+ * Input mapping tables of the HMD and both controllers.
+ *
+ * The ids are less than WVR_InputId_Max, so each device keeps an array indexed by destination
+ * instead of the table from the runtime.  A lookup is a single read.  A device is rebuilt only
+ * when its input request or connection changes.
+ */
+class FWaveVRInputMapping
+{
+public:
+	FWaveVRInputMapping();
+
+	// Read the table of the device from the runtime.
+	void Rebuild(WVR_DeviceType device);
+
+	// The runtime returned no pair of the device, e.g. the input request is not set yet.
+	bool IsEmpty(WVR_DeviceType device) const;
+
+	// The destination is the id the app sees, and the source is the key on the device.
+	bool GetSource(WVR_DeviceType device, WVR_InputId destination, WVR_InputId& OutSource) const;
+
+	// The destination is mapped to a source which has any capability.
+	bool IsAvailable(WVR_DeviceType device, WVR_InputId destination) const;
+
+private:
+	struct FDeviceTable
+	{
+		int8 sourceOf[WVR_InputId_Max];  // Index is destination.  INDEX_NONE if not mapped.
+		uint32 available;  // Bits of the destinations
+		uint32 size;
+
+		void Reset();
+	};
+
+	static int32 GetDeviceIndex(WVR_DeviceType device);
+	static inline bool IsValidId(int32 id) { return id >= 0 && id < WVR_InputId_Max; }
+
+	static const int32 DeviceCount = 3;  // HMD, Right, Left
+	FDeviceTable Tables[DeviceCount];
+};
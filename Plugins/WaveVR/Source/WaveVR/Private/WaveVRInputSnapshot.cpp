@@ -0,0 +1,77 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRInputSnapshot.h"
+#include "WaveVRPrivatePCH.h"
+#include "WaveVRHMD.h"
+#include "Platforms/WaveVRAPIWrapper.h"
+#include "Platforms/Editor/WaveVRDirectPreview.h"
+
+// The runtime may report more analog inputs than the plugin uses.
+static const int32 kMaxAnalogCount = 32;
+
+void FWaveVRInputSnapshot::Reset()
+{
+	Pressed = 0;
+	Touched = 0;
+	for (int32 i = 0; i < TouchButtonCount; i++)
+		Axis[i] = FVector2D::ZeroVector;
+}
+
+int32 FWaveVRInputSnapshot::GetTouchIndex(uint8 id)
+{
+	for (int32 i = 0; i < TouchButtonCount; i++)
+		if ((uint8)TouchButton[i] == id)
+			return i;
+	return INDEX_NONE;
+}
+
+bool FWaveVRInputSnapshot::Query(EWVR_DeviceType device, uint32 inputTypes)
+{
+	if (GIsEditor && !WaveVRDirectPreview::IsDirectPreview())
+		return false;
+
+	FWaveVRHMD* hmd = FWaveVRHMD::GetInstance();
+	if (hmd == nullptr || !hmd->IsDeviceConnected((WVR_DeviceType)device))
+		return false;
+
+	FWaveVRAPIWrapper* wvr = FWaveVRAPIWrapper::GetInstance();
+
+	WVR_AnalogState_t analogs[kMaxAnalogCount];
+	uint32_t analogCount = 0;
+	if (inputTypes & WVR_InputType_Analog)
+	{
+		int32_t count = wvr->GetInputTypeCount((WVR_DeviceType)device, WVR_InputType_Analog);
+		analogCount = (uint32_t)FMath::Clamp(count, 0, kMaxAnalogCount);
+		if (analogCount == 0)
+			inputTypes &= ~WVR_InputType_Analog;
+	}
+
+	uint32_t buttons = 0, touches = 0;
+	if (!wvr->GetInputDeviceState((WVR_DeviceType)device, inputTypes, &buttons, &touches, analogCount > 0 ? analogs : nullptr, analogCount))
+		return false;
+
+	if (inputTypes & WVR_InputType_Button)
+		Pressed = buttons;
+	if (inputTypes & WVR_InputType_Touch)
+		Touched = touches;
+	if (inputTypes & WVR_InputType_Analog)
+	{
+		for (int32 i = 0; i < TouchButtonCount; i++)
+			Axis[i] = FVector2D::ZeroVector;
+		for (uint32_t i = 0; i < analogCount; i++)
+		{
+			int32 index = GetTouchIndex((uint8)analogs[i].id);
+			if (index != INDEX_NONE)
+				Axis[index].Set(analogs[i].axis.x, analogs[i].axis.y);
+		}
+	}
+	return true;
+}
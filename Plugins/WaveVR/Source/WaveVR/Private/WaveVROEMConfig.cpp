@@ -20,225 +20,229 @@ DEFINE_LOG_CATEGORY(LogOEMConfig);
 #define BATTERY_INDICATOR_KEY "battery_indicator"
 #define SINGLE_BEAM_KEY "controller_singleBeam"
 
-WaveVROEMConfigImpl* WaveVROEMConfigImpl::mInstance = nullptr;
+// Retry the first load if the Java side was not ready.
+static const double kLoadRetryInterval = 1.0;
 
-WaveVROEMConfigImpl::WaveVROEMConfigImpl() {
-	jsonString = FString(TEXT(""));
-	jsonUpdate = false;
+WaveVROEMConfigImpl* WaveVROEMConfigImpl::mInstance = nullptr;
 
-	updateJsonStr();
+static FString GetRawData(const char* key) {
+	std::string JsonRawData = FWaveVRAPIWrapper::GetInstance()->GetOEMConfigRawData(key);
+	return FString(UTF8_TO_TCHAR(JsonRawData.c_str()));
 }
 
-WaveVROEMConfigImpl* WaveVROEMConfigImpl::getInstance() {
-	if (mInstance == nullptr) {
-		mInstance = new WaveVROEMConfigImpl();
-	}
-	return mInstance;
-}
-
-FString WaveVROEMConfigImpl::GetConfig(FString category, FString key) {
-	FString ret = FString(TEXT(""));
-	if (category == "" || key == "") {
-		return ret;
+static void ParseValue(const TSharedPtr<FJsonValue>& json, FWaveVROEMConfigValue& value) {
+	if (!json.IsValid() || json->IsNull()) {
+		value.bIsNull = true;
+		return;
 	}
 
-	if (!jsonUpdate) {
-		LOGE(LogOEMConfig, "JSON string didn't update");
-		updateJsonStr();
+	if (json->Type == EJson::Number) {
+		value.Number = (float)json->AsNumber();
+		value.bHasNumber = true;
+		json->TryGetString(value.String);
+		return;
 	}
 
-
-	if (JsonParsed.IsValid()) {
-		//category field
-		bool tmpCat = JsonParsed->HasField(category);
-		if (tmpCat == false) {
-			LOGE(LogOEMConfig, "Category %s not found.", PLATFORM_CHAR(*category));
-			return ret;
-		}
-		TSharedPtr<FJsonObject> categoryObject = JsonParsed->GetObjectField(category);
-		//key field
-		bool tmpKey = categoryObject->HasField(key);
-		if (tmpKey == false) {
-			LOGE(LogOEMConfig, "Key %s not found.", PLATFORM_CHAR(*key));
-			return ret;
+	if (json->Type == EJson::String) {
+		value.String = json->AsString();
+		if (value.String.IsNumeric()) {
+			value.Number = FCString::Atof(*value.String);
+			value.bHasNumber = true;
 		}
-		TSharedPtr<FJsonValue> tmp = categoryObject->TryGetField(key);
-		if (tmp->IsNull())
-			return ret;
-		else
-			ret = categoryObject->GetStringField(key);
-	}
-	else {
-		LOGE(LogOEMConfig, "JSON Parse is not valid.");
+		return;
 	}
-	LOGI(LogOEMConfig, "GetConfig, category = %s, key = %s, value = %s", PLATFORM_CHAR(*category), PLATFORM_CHAR(*key), PLATFORM_CHAR(*ret));
-
-	return ret;
-}
 
-bool WaveVROEMConfigImpl::GetVector(FString category, FString key, FVector& vec) {
-	if (category == "" || key == "") {
-		return false;
-	}
-	vec = FVector(0.0, 0.0, 0.0);
-	if (!jsonUpdate) {
-		LOGE(LogOEMConfig, "JSON string didn't update");
-		updateJsonStr();
+	// Keep the text the string getter gave for a boolean key.
+	if (json->Type == EJson::Boolean) {
+		value.String = json->AsBool() ? TEXT("true") : TEXT("false");
+		return;
 	}
 
-	if (JsonParsed.IsValid()) {
-		//category field
-		bool tmpCat = JsonParsed->HasField(category);
-		if (tmpCat == false) {
-			LOGE(LogOEMConfig, "Category %s not found.", PLATFORM_CHAR(*category));
-			return false;
+	const TArray<TSharedPtr<FJsonValue>>* array = nullptr;
+	if (json->TryGetArray(array)) {
+		float elements[4] = { 0, 0, 0, 0 };
+		const int32 num = FMath::Min(array->Num(), 4);
+		for (int32 i = 0; i < num; i++) {
+			FString element;
+			if (!(*array)[i].IsValid() || !(*array)[i]->TryGetString(element))
+				return;
+			elements[i] = FCString::Atof(*element);
 		}
-		TSharedPtr<FJsonObject> categoryObject = JsonParsed->GetObjectField(category);
-		//key field
-		bool tmpKey = categoryObject->HasField(key);
-		if (tmpKey == false) {
-			LOGE(LogOEMConfig, "Key %s not found.", PLATFORM_CHAR(*key));
-			return false;
+		if (num >= 3) {
+			value.Vector = FVector(elements[0], elements[1], elements[2]);
+			value.bHasVector = true;
 		}
-		TArray<FString> ArrayJson;
-		categoryObject->TryGetStringArrayField(key, ArrayJson);
-		if (categoryObject->TryGetStringArrayField(key, ArrayJson) != false) {
-			FVector tVector = FVector(
-				FCString::Atof(*ArrayJson[0]),
-				FCString::Atof(*ArrayJson[1]),
-				FCString::Atof(*ArrayJson[2])
-			);
-			vec = tVector;
-			LOGI(LogOEMConfig, "GetVector, category = %s, key = %s, value = %f %f %f", PLATFORM_CHAR(*category), PLATFORM_CHAR(*key), vec.X, vec.Y, vec.Z);
-			return true;
+		if (num >= 4) {
+			value.Vector4 = FVector4(elements[0], elements[1], elements[2], elements[3]);
+			value.bHasVector4 = true;
 		}
-		else {
-			LOGE(LogOEMConfig, "Value format is wrong.");
-			return false;
-		}
-	}
-	else {
-		LOGE(LogOEMConfig, "JSON Parse is not valid.");
 	}
+}
 
-	return false;
+const FWaveVROEMConfigValue* FWaveVROEMConfigStore::Find(const FString& category, const FString& key) const {
+	// A name not in the name table can't be a key of the store.
+	const FName categoryName(*category, FNAME_Find);
+	const FName keyName(*key, FNAME_Find);
+	if (categoryName == NAME_None || keyName == NAME_None)
+		return nullptr;
+	return Find(categoryName, keyName);
 }
 
-bool WaveVROEMConfigImpl::GetVector4(FString category, FString key, FVector4& vec4) {
-	if (category == "" || key == "") {
-		return false;
-	}
+WaveVROEMConfigImpl::WaveVROEMConfigImpl()
+	: Store(MakeShareable(new FWaveVROEMConfigStore()))
+	, Generation(0)
+	, LastLoadTime(0) {
+	Reload();
+}
 
-	vec4 = FVector4(0.0, 0.0, 0.0, 0.0);
-	if (!jsonUpdate) {
-		LOGD(LogOEMConfig, "JSON string didn't update");
-		updateJsonStr();
+WaveVROEMConfigImpl* WaveVROEMConfigImpl::getInstance() {
+	if (mInstance == nullptr) {
+		mInstance = new WaveVROEMConfigImpl();
 	}
+	return mInstance;
+}
 
-	if (JsonParsed.IsValid()) {
-		//category field
-		bool tmpCat = JsonParsed->HasField(category);
-		if (tmpCat == false) {
-			LOGE(LogOEMConfig, "Category %s not found.", PLATFORM_CHAR(*category));
-			return false;
-		}
-		TSharedPtr<FJsonObject> categoryObject = JsonParsed->GetObjectField(category);
-		//key field
-		bool tmpKey = categoryObject->HasField(key);
-		if (tmpKey == false) {
-			LOGE(LogOEMConfig, "Key %s not found.", PLATFORM_CHAR(*key));
-			return false;
-		}
-		TArray<FString> ArrayJson;
-		categoryObject->TryGetStringArrayField(key, ArrayJson);
-		if (categoryObject->TryGetStringArrayField(key, ArrayJson) != false) {
-			FVector4 Vector = FVector4(
-				FCString::Atof(*ArrayJson[0]),
-				FCString::Atof(*ArrayJson[1]),
-				FCString::Atof(*ArrayJson[2]),
-				FCString::Atof(*ArrayJson[3])
-			);
-			vec4 = Vector;
-			LOGI(LogOEMConfig, "GetVector4, category = %s, key = %s, value = %f %f %f %f", PLATFORM_CHAR(*category), PLATFORM_CHAR(*key), vec4.X, vec4.Y, vec4.Z, vec4.W);
-			return true;
+FWaveVROEMConfigStore* WaveVROEMConfigImpl::Load() {
+	FWaveVROEMConfigStore* store = new FWaveVROEMConfigStore();
+
+	FString jsonString = GetRawData(CONTROLLER_PROPERTY_KEY);
+	if (jsonString != "") {
+		TSharedPtr<FJsonObject> JsonParsed;
+		TSharedRef< TJsonReader<TCHAR> > Reader = TJsonReaderFactory<TCHAR>::Create(jsonString);
+
+		if (FJsonSerializer::Deserialize(Reader, JsonParsed) && JsonParsed.IsValid()) {
+			for (const auto& category : JsonParsed->Values) {
+				const TSharedPtr<FJsonObject>* categoryObject = nullptr;
+				if (!category.Value.IsValid() || !category.Value->TryGetObject(categoryObject))
+					continue;
+				const FName categoryName(*category.Key);
+				for (const auto& key : (*categoryObject)->Values) {
+					FWaveVROEMConfigValue& value = store->Values.Add(FWaveVROEMConfigStore::FKey(categoryName, FName(*key.Key)));
+					ParseValue(key.Value, value);
+				}
+			}
+			store->bLoaded = true;
+			LOGI(LogOEMConfig, "JSON Parse success, %d values.", store->Values.Num());
 		}
 		else {
-			LOGE(LogOEMConfig, "Value format is wrong.");
-			return false;
+			LOGE(LogOEMConfig, "JSON Parse failed.");
 		}
 	}
 	else {
-		LOGE(LogOEMConfig, "JSON Parse is not valid.");
+		LOGE(LogOEMConfig, "GetOEMConfigRawData is empty string.");
 	}
-	return false;
-}
-
-bool WaveVROEMConfigImpl::IsEnableSingleBeam() {
-	bool ret = true;
-	std::string JsonRawData = FWaveVRAPIWrapper::GetInstance()->GetOEMConfigRawData(SINGLE_BEAM_KEY);
 
-	if (JsonRawData != "") {
+	FString singleBeamString = GetRawData(SINGLE_BEAM_KEY);
+	if (singleBeamString != "") {
 		FOEnableSingleBeam JsonData;
-		FString CurrJsonString = FString(UTF8_TO_TCHAR(JsonRawData.c_str()));
-		bool parsed = FJsonObjectConverter::JsonObjectStringToUStruct<FOEnableSingleBeam>(
-			CurrJsonString,
-			&JsonData,
-			0, 0);
-
-		if (parsed) {
-			FString enable = JsonData.enable;
-			ret = (enable.TrimStartAndEnd().Equals(TEXT("true"), ESearchCase::IgnoreCase)) ? true : false;
-		}
+		if (FJsonObjectConverter::JsonObjectStringToUStruct<FOEnableSingleBeam>(singleBeamString, &JsonData, 0, 0))
+			store->bEnableSingleBeam = JsonData.enable.TrimStartAndEnd().Equals(TEXT("true"), ESearchCase::IgnoreCase);
 	}
 
-	LOGI(LogOEMConfig, "IsEnableSingleBeam = %d", ret);
+	FString batteryString = GetRawData(BATTERY_INDICATOR_KEY);
+	if (batteryString != "") {
+		FOBatterySetting JsonData;
+		if (FJsonObjectConverter::JsonObjectStringToUStruct<FOBatterySetting>(batteryString, &JsonData, 0, 0))
+			store->bBatteryInfo = JsonData.show == 2;
+	}
 
-	return ret;
+	LOGI(LogOEMConfig, "IsEnableSingleBeam = %d, IsBatteryInfo = %d", store->bEnableSingleBeam, store->bBatteryInfo);
+	return store;
 }
 
-bool WaveVROEMConfigImpl::IsBatteryInfo() {
-	bool ret = false;
-	std::string JsonRawData = FWaveVRAPIWrapper::GetInstance()->GetOEMConfigRawData(BATTERY_INDICATOR_KEY);
+void WaveVROEMConfigImpl::Reload() {
+	{
+		FScopeLock lock(&StoreLock);
+		LastLoadTime = FPlatformTime::Seconds();
+	}
 
-	if (JsonRawData != "") {
-		FOBatterySetting JsonData;
-		FString CurrJsonString = FString(UTF8_TO_TCHAR(JsonRawData.c_str()));
-		bool parsed = FJsonObjectConverter::JsonObjectStringToUStruct<FOBatterySetting>(
-			CurrJsonString,
-			&JsonData,
-			0, 0);
+	// Number the load before it starts, so a slower load of an older config cannot replace a newer one.
+	const uint32 generation = (uint32)FPlatformAtomics::InterlockedIncrement(&Generation);
 
-		if (parsed) {
-			int show = JsonData.show;
+	// The Java calls are out of the lock.  Readers keep using the old store until the swap.
+	FWaveVROEMConfigStore* store = Load();
+	store->Generation = generation;
 
-			ret = (show == 2) ? true : false;
+	FScopeLock lock(&StoreLock);
+	if (Store.IsValid() && Store->Generation > generation) {
+		LOGI(LogOEMConfig, "Reload, drop generation %u, generation %u is installed", generation, Store->Generation);
+		delete store;
+		return;
+	}
+	Store = MakeShareable(store);
+	LOGI(LogOEMConfig, "Reload, generation %u", generation);
+}
+
+FWaveVROEMConfigStorePtr WaveVROEMConfigImpl::GetStore() {
+	bool bRetry = false;
+	{
+		FScopeLock lock(&StoreLock);
+		if (!Store->bLoaded && FPlatformTime::Seconds() - LastLoadTime > kLoadRetryInterval) {
+			LastLoadTime = FPlatformTime::Seconds();
+			bRetry = true;
 		}
 	}
-	LOGI(LogOEMConfig, "IsBatteryInfo = %d", ret);
+	if (bRetry) {
+		LOGW(LogOEMConfig, "JSON string didn't update");
+		Reload();
+	}
 
-	return ret;
+	FScopeLock lock(&StoreLock);
+	return Store;
 }
 
-void WaveVROEMConfigImpl::updateJsonStr() {
-	jsonUpdate = false;
-	std::string JsonRawData = FWaveVRAPIWrapper::GetInstance()->GetOEMConfigRawData(CONTROLLER_PROPERTY_KEY);
+FString WaveVROEMConfigImpl::GetConfig(FString category, FString key) {
+	if (category == "" || key == "") {
+		return FString(TEXT(""));
+	}
 
-	if (JsonRawData != "") {
-		jsonString = UTF8_TO_TCHAR(JsonRawData.c_str());
-		TSharedRef< TJsonReader<TCHAR> > Reader = TJsonReaderFactory<TCHAR>::Create(jsonString);;
+	FWaveVROEMConfigStorePtr store = GetStore();
+	const FWaveVROEMConfigValue* value = store->Find(category, key);
+	if (value == nullptr) {
+		TLOGD(LogOEMConfig, "GetConfig, %s %s not found.", PLATFORM_CHAR(*category), PLATFORM_CHAR(*key));
+		return FString(TEXT(""));
+	}
+	return value->String;
+}
 
-		if (FJsonSerializer::Deserialize(Reader, JsonParsed))
-		{
-			jsonUpdate = true;
-			LOGI(LogOEMConfig, "JSON Parse success.");
-		}
-		else {
-			LOGE(LogOEMConfig, "JSON Parse failed.");
-		}
+bool WaveVROEMConfigImpl::GetVector(FString category, FString key, FVector& vec) {
+	if (category == "" || key == "") {
+		return false;
 	}
-	else {
-		LOGE(LogOEMConfig, "GetOEMConfigRawData is empty string.");
+	vec = FVector(0.0, 0.0, 0.0);
+
+	FWaveVROEMConfigStorePtr store = GetStore();
+	const FWaveVROEMConfigValue* value = store->Find(category, key);
+	if (value == nullptr || !value->bHasVector) {
+		TLOGD(LogOEMConfig, "GetVector, %s %s not found.", PLATFORM_CHAR(*category), PLATFORM_CHAR(*key));
+		return false;
+	}
+	vec = value->Vector;
+	return true;
+}
+
+bool WaveVROEMConfigImpl::GetVector4(FString category, FString key, FVector4& vec4) {
+	if (category == "" || key == "") {
+		return false;
+	}
+	vec4 = FVector4(0.0, 0.0, 0.0, 0.0);
+
+	FWaveVROEMConfigStorePtr store = GetStore();
+	const FWaveVROEMConfigValue* value = store->Find(category, key);
+	if (value == nullptr || !value->bHasVector4) {
+		TLOGD(LogOEMConfig, "GetVector4, %s %s not found.", PLATFORM_CHAR(*category), PLATFORM_CHAR(*key));
+		return false;
 	}
+	vec4 = value->Vector4;
+	return true;
+}
+
+bool WaveVROEMConfigImpl::IsEnableSingleBeam() {
+	return GetStore()->bEnableSingleBeam;
+}
+
+bool WaveVROEMConfigImpl::IsBatteryInfo() {
+	return GetStore()->bBatteryInfo;
 }
 
 //---------------------------------------------------------------------------
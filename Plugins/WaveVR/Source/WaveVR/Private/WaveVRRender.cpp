@@ -13,6 +13,7 @@
 #include "Logging/LogMacros.h"
 
 #include "WaveVRHMD.h"
+#include "WaveVRFrameTiming.h"
 #include "RHIUtilities.h"
 #include "OpenGLResources.h"
 #include "XRThreadUtils.h"
@@ -149,6 +150,12 @@ public:
 	uint32 FindIndexByResource(void * resource) const;
 	uint32 FindIndexByTexture(void * textureBaseRHI) const;
 
+private:
+	// Add the texture at index to the reverse maps.
+	void UpdateIndex(uint32 index);
+	// Linear search.  Only used when the maps missed.
+	int32 SearchIndexByGLId(GLuint id) const;
+
 public:
 	// Get
 	inline const FWaveVRRenderTextureInfo GetInfo() const { return textureInfo; }
@@ -166,6 +173,11 @@ private:
 	FTextureRHIRef * texturePoolRHIRefs;
 
 	FWaveVRRenderTextureInfo textureInfo;
+
+	// Reverse maps to the index of texturePoolRHIRefs.  The GL id could be changed by MakeAlias().
+	mutable TMap<GLuint, uint32> glIdToIndex;
+	TMap<void *, uint32> resourceToIndex;
+	TMap<void *, uint32> textureToIndex;
 };
 
 FWaveVRTexturePool::FWaveVRTexturePool(const FWaveVRRenderTextureInfo& info) :
@@ -275,6 +287,7 @@ void FWaveVRTexturePool::CreateTextureInPool(uint32 index)
 		LOGI(WVRRender, "WVR_TextureParams_t[%d]=%p", index, params.id);
 
 		texturePoolRHIRefs[index] = CreateTexture2D(info, (GLuint)PTR_TO_INT(params.id));
+		UpdateIndex(index);
 	} else if (!textureInfo.useUnrealTextureQueue && textureInfo.createFromResource) {
 		// Use textures in wvrTextureQueue and use a base texture to alias.
 		check(textureInfo.wvrTextureQueue);
@@ -286,6 +299,7 @@ void FWaveVRTexturePool::CreateTextureInPool(uint32 index)
 			LOGI(WVRRender, "WVR_TextureParams_t[%d]=%p", info.capacity - 1 - i, params.id);
 
 			texturePoolRHIRefs[i] = CreateTexture2D(info, (GLuint)PTR_TO_INT(params.id));
+			UpdateIndex(i);
 		}
 	} else if (!textureInfo.useUnrealTextureQueue && !textureInfo.createFromResource) {
 		// As the old way
@@ -295,6 +309,7 @@ void FWaveVRTexturePool::CreateTextureInPool(uint32 index)
 
 		for (int i = 0; i < info.capacity; i++) {
 			texturePoolRHIRefs[i] = CreateTexture2D(info);
+			UpdateIndex(i);
 			MakeAlias(i);
 		}
 		//void ** textures = new void *[info.capacity];
@@ -307,6 +322,7 @@ void FWaveVRTexturePool::CreateTextureInPool(uint32 index)
 	} else if (textureInfo.useUnrealTextureQueue && !textureInfo.createFromResource) {
 		// Create texture in unreal and not use a base texture to alias.
 		texturePoolRHIRefs[index] = CreateTexture2D(info);
+		UpdateIndex(index);
 	} else {
 		// Impossible
 		check(false);
@@ -334,6 +350,10 @@ void FWaveVRTexturePool::MakeAlias(int idx, GLuint resource)
 			// For using unreal texture queue, the resource not match the wvr queue's idx.
 			if (base->Resource != resource) {
 				//LOGV(WVRRender, "MakeAlias(%d, %u) -> originalResource %u -> %u", idx, resource, base->Resource, resource);
+				if (base == target) {
+					glIdToIndex.Remove(base->Resource);
+					glIdToIndex.Add(resource, idx);
+				}
 				base->Resource = resource;
 			} else {
 				//LOGV(WVRRender, "MakeAlias(%d, %u) noop", idx, resource);
@@ -346,16 +366,45 @@ void FWaveVRTexturePool::MakeAlias(int idx, GLuint resource)
 	}
 }
 
+void FWaveVRTexturePool::UpdateIndex(uint32 index)
+{
+	check(index < textureInfo.capacity);
+	check(texturePoolRHIRefs[index]);
+
+	auto base = (FOpenGLTextureBase*)texturePoolRHIRefs[index]->GetTextureBaseRHI();
+	glIdToIndex.Add(base->Resource, index);
+	resourceToIndex.Add(texturePoolRHIRefs[index]->GetNativeResource(), index);
+	textureToIndex.Add(texturePoolRHIRefs[index]->GetTextureBaseRHI(), index);
+}
+
+int32 FWaveVRTexturePool::SearchIndexByGLId(GLuint id) const
+{
+	for (int i = 0; i < textureInfo.capacity; i++) {
+		if (!texturePoolRHIRefs[i])
+			continue;
+		auto base = (FOpenGLTextureBase*)texturePoolRHIRefs[i]->GetTextureBaseRHI();
+		if (base->Resource == id)
+			return i;
+	}
+	return -1;
+}
+
 uint32 FWaveVRTexturePool::FindIndexByGLId(GLuint id) const
 {
 	check(id);
 
 	// Find the index
-	for (int i = 0; i < textureInfo.capacity; i++) {
-		auto base = (FOpenGLTextureBase*) texturePoolRHIRefs[i]->GetTextureBaseRHI();
-		if (base->Resource == id) {
-			return i;
-		}
+	const uint32 * found = glIdToIndex.Find(id);
+	if (found && texturePoolRHIRefs[*found] &&
+		((FOpenGLTextureBase*)texturePoolRHIRefs[*found]->GetTextureBaseRHI())->Resource == id) {
+		return *found;
+	}
+
+	// The map is out of date.  Learn it.
+	int32 idx = SearchIndexByGLId(id);
+	if (idx >= 0) {
+		glIdToIndex.Add(id, idx);
+		return idx;
 	}
 
 	// Imposible
@@ -373,11 +422,10 @@ uint32 FWaveVRTexturePool::FindIndexByResource(void * nativeResource) const
 	check(nativeResource);
 
 	// Find the index
-	for (int i = 0; i < textureInfo.capacity; i++) {
-		check(texturePoolRHIRefs[i]);
-		if (texturePoolRHIRefs[i]->GetNativeResource() == nativeResource) {
-			return i;
-		}
+	const uint32 * found = resourceToIndex.Find(nativeResource);
+	if (found) {
+		check(texturePoolRHIRefs[*found]);
+		return *found;
 	}
 	// Imposible
 	check(false);
@@ -389,11 +437,10 @@ uint32 FWaveVRTexturePool::FindIndexByTexture(void * textureBaseRHI) const
 	check(textureBaseRHI);
 
 	// Find the index
-	for (int i = 0; i < textureInfo.capacity; i++) {
-		check(texturePoolRHIRefs[i]);
-		if (texturePoolRHIRefs[i]->GetTextureBaseRHI() == textureBaseRHI) {
-			return i;
-		}
+	const uint32 * found = textureToIndex.Find(textureBaseRHI);
+	if (found) {
+		check(texturePoolRHIRefs[*found]);
+		return *found;
 	}
 	// Imposible
 	check(false);
@@ -438,6 +485,9 @@ void FWaveVRTexturePool::ReleaseTextures()
 		delete[] texturePoolRHIRefs;
 		texturePoolRHIRefs = nullptr;
 	}
+	glIdToIndex.Empty();
+	resourceToIndex.Empty();
+	textureToIndex.Empty();
 
 	if (mBaseTexture) {
 		LOGD(WVRRender, "TexturePool: Release Base texture");
@@ -467,10 +517,12 @@ FWaveVRTextureManager::FWaveVRTextureManager(FWaveVRRender * render, FWaveVRHMD
 	mCurrentResource(0),
 	mCurrentResourceRT(0),
 	mCurrentWVRTextureQueueIndex(0),
+	mAcquireSerialCounter(0),
 	mRender(render),
 	mHMD(hmd)
 {
 	LOG_FUNC();
+	ResetQueueStats();
 }
 
 FWaveVRTextureManager::~FWaveVRTextureManager()
@@ -514,6 +566,9 @@ bool FWaveVRTextureManager::CreateColorTexturePool(const FWaveVRRenderTextureInf
 	// Create pool
 	mColorTexturePool = new FWaveVRTexturePool(infoCopy);
 
+	mAcquireTime.Init(0, infoCopy.capacity);
+	mAcquireSerial.Init(0, infoCopy.capacity);
+
 	if (!infoCopy.useUnrealTextureQueue) {
 		if (infoCopy.createFromResource) {
 			mColorTexturePool->CreateBaseTexture();
@@ -665,15 +720,19 @@ void FWaveVRTextureManager::Next(const FViewport& Viewport)
 		} else {
 			idx = WVR()->GetAvailableTextureIndex(info.wvrTextureQueue);
 			//LOGV(WVRRender, "next texture index = %d", idx);
+			if (idx < 0)
+				idx = WaitAvailableTextureIndex(info.wvrTextureQueue);
 
 			// No available texture!
-			if (idx < 0) {
-				LOGE(WVRRender, "No available texture %d.  Should fix it.", idx);
-				mCurrentWVRTextureQueueIndex = ++mCurrentWVRTextureQueueIndex % info.capacity;
-				idx = mCurrentWVRTextureQueueIndex;
-			} else {
-				mCurrentWVRTextureQueueIndex = idx;
+			bool available = idx >= 0;
+			if (!available) {
+				OnTextureMissed(info.capacity);
+				// Use the one which was acquired earliest.  It is the most possible one which is done.
+				idx = PickStarvedTextureIndex(info.capacity);
+				LOGE(WVRRender, "No available texture.  Use %d.  Consecutive misses %u", idx, mQueueStats.consecutiveMisses);
 			}
+			OnTextureAcquired(idx, available);
+			mCurrentWVRTextureQueueIndex = idx;
 			checkf(idx >= 0 && idx < info.capacity, TEXT("RenderTexture=%d is out of range."), idx);
 
 			WVR_TextureParams_t params = WVR()->GetTexture(info.wvrTextureQueue, idx);
@@ -703,6 +762,83 @@ void FWaveVRTextureManager::Next(const FViewport& Viewport)
 	}
 }
 
+// Wait a while for the runtime to release a texture.  Budget is set by wvr.TextureQueue.WaitBudgetMs.
+int32 FWaveVRTextureManager::WaitAvailableTextureIndex(WVR_TextureQueueHandle_t queue)
+{
+	WVR_SCOPED_NAMED_EVENT(WaitAvailableTexture, FColor::Red);
+	static const auto CVarWaitBudget = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("wvr.TextureQueue.WaitBudgetMs"));
+	float budgetMs = CVarWaitBudget ? CVarWaitBudget->GetValueOnAnyThread() : 0;
+	if (budgetMs <= 0)
+		return -1;
+
+	int32 idx = -1;
+	double start = FPlatformTime::Seconds();
+	double end = start + budgetMs / 1000.0;
+	while (idx < 0 && FPlatformTime::Seconds() < end) {
+		FPlatformProcess::SleepNoStats(0.0002f);
+		idx = WVR()->GetAvailableTextureIndex(queue);
+	}
+	mQueueStats.waitMs += (float)((FPlatformTime::Seconds() - start) * 1000.0);
+	return idx;
+}
+
+uint32 FWaveVRTextureManager::PickStarvedTextureIndex(uint32 capacity) const
+{
+	uint32 oldest = (mCurrentWVRTextureQueueIndex + 1) % capacity;
+	for (uint32 i = 0; i < capacity && i < (uint32)mAcquireSerial.Num(); i++) {
+		if (mAcquireSerial[i] < mAcquireSerial[oldest])
+			oldest = i;
+	}
+	return oldest;
+}
+
+void FWaveVRTextureManager::OnTextureAcquired(uint32 idx, bool available)
+{
+	if (idx >= (uint32)mAcquireSerial.Num())
+		return;
+
+	double now = FPlatformTime::Seconds();
+	if (available && mAcquireSerial[idx] != 0) {
+		float inFlightMs = (float)((now - mAcquireTime[idx]) * 1000.0);
+		mQueueStats.lastInFlightMs = inFlightMs;
+		mQueueStats.maxInFlightMs = FMath::Max(mQueueStats.maxInFlightMs, inFlightMs);
+		mQueueStats.sumInFlightMs += inFlightMs;
+		mQueueStats.inFlightCount++;
+
+		uint32 depth = mAcquireSerialCounter - mAcquireSerial[idx];
+		mQueueStats.depthHistogram[FMath::Min<uint32>(depth, FWaveVRTextureQueueStats::DepthHistogramSize - 1)]++;
+	}
+
+	mAcquireSerial[idx] = ++mAcquireSerialCounter;
+	mAcquireTime[idx] = now;
+	if (available) {
+		mQueueStats.acquired++;
+		mQueueStats.consecutiveMisses = 0;
+	}
+}
+
+void FWaveVRTextureManager::OnTextureMissed(uint32 capacity)
+{
+	static const auto CVarThreshold = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.TextureQueue.StarvationThreshold"));
+	uint32 threshold = CVarThreshold ? FMath::Max(1, CVarThreshold->GetValueOnAnyThread()) : 3;
+
+	mQueueStats.misses++;
+	mQueueStats.consecutiveMisses++;
+	mQueueStats.maxConsecutiveMisses = FMath::Max(mQueueStats.maxConsecutiveMisses, mQueueStats.consecutiveMisses);
+
+	// Only report once when reach the threshold, and again if it keeps going.
+	if (mQueueStats.consecutiveMisses % threshold == 0) {
+		mQueueStats.starvations++;
+		LOGW(WVRRender, "Texture queue is starving.  %u consecutive misses with capacity %u", mQueueStats.consecutiveMisses, capacity);
+		OnTextureQueueStarvation.Broadcast(mQueueStats.consecutiveMisses, capacity);
+	}
+}
+
+void FWaveVRTextureManager::ResetQueueStats()
+{
+	FMemory::Memzero(mQueueStats);
+}
+
 void* FWaveVRTextureManager::GetCurrentTextureResource()
 {
 	LOG_FUNC();
@@ -731,8 +867,8 @@ WVR_TextureParams_t FWaveVRTextureManager::GetSubmitParams(WVR_Eye eye) {
 	if (!mColorTexturePool) return params;
 	auto info = mColorTexturePool->GetInfo();
 
-	float pixelDensity = mHMD->GetPixelDenity();
-	float margin = (1.0f - pixelDensity) / 2; // TODO How to handle pixelDensity larger than 1?
+	// The eye texture is allocated in the max density, and the viewport is in its center.
+	float margin = (1.0f - mHMD->FrameDataRT->viewportScale) / 2;
 
 	// Submit
 	params.id = mCurrentResourceRT;
@@ -765,6 +901,8 @@ void FWaveVRTextureManager::CleanTextures()
 		delete mColorTexturePool;
 	}
 	mColorTexturePool = nullptr;
+	mAcquireTime.Empty();
+	mAcquireSerial.Empty();
 }
 
 
@@ -780,6 +918,7 @@ FWaveVRRender::FWaveVRRender(FWaveVRHMD * hmd) :
 	mCustomPresent(nullptr),
 	mTextureManager(this, hmd),
 	mHMD(hmd),
+	mFoveationScheduler(this),
 
 	// WaveVR State
 	bInitialized(false),
@@ -1284,6 +1423,32 @@ void FWaveVRRender::SetFoveationParams(EStereoscopicPass Eye, const WVR_RenderFo
 		foveationParams.fovealFov, foveationParams.periQuality);
 }
 
+void FWaveVRRender::SetFoveationQuality(const float fovealFov[2], const WVR_PeripheralQuality periQuality[2])
+{
+	LOG_FUNC();
+	for (int32 i = 0; i < 2; i++) {
+		EnableModeFoveationParams[i].fovealFov = fovealFov[i];
+		EnableModeFoveationParams[i].periQuality = periQuality[i];
+	}
+
+	// Copy, not to read the params which the game thread may be changing.
+	const WVR_RenderFoveationParams_t paramsL = EnableModeFoveationParams[0];
+	const WVR_RenderFoveationParams_t paramsR = EnableModeFoveationParams[1];
+	ENQUEUE_RENDER_COMMAND(SetFoveationQuality) (
+		[paramsL, paramsR](FRHICommandListImmediate& RHICmdList)
+		{
+			WVR()->SetFoveationConfig(WVR_Eye::WVR_Eye_Left, &paramsL);
+			WVR()->SetFoveationConfig(WVR_Eye::WVR_Eye_Right, &paramsR);
+		});
+}
+
+void FWaveVRRender::GetFoveationQuality(float fovealFov[2], WVR_PeripheralQuality periQuality[2]) const
+{
+	for (int32 i = 0; i < 2; i++) {
+		fovealFov[i] = EnableModeFoveationParams[i].fovealFov;
+		periQuality[i] = EnableModeFoveationParams[i].periQuality;
+	}
+}
 
 void FWaveVRRender::SetSubmitWithPose(bool enable, const WVR_PoseState_t * pose) {
 	if (enable) {
@@ -1388,6 +1553,7 @@ void FWaveVRRender::OnBeginRendering_RenderThread(FRHICommandListImmediate& RHIC
 		WVR_TextureParams_t paramsR = mTextureManager.GetSubmitParams(WVR_Eye_Right);
 		WVR()->PreRenderEye(WVR_Eye_Right, &paramsR);
 	}
+	FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::PreRenderEye, mHMD->FrameDataRT->frameNumber);
 }
 
 // Present
@@ -1407,6 +1573,7 @@ void FWaveVRRender::OnFinishRendering_RenderThread()
 void FWaveVRRender::SubmitFrame_RenderThread() {
 	LOG_FUNC();
 	WVR_SCOPED_NAMED_EVENT(SubmitFrame_RenderThread, FColor::Orange);
+	FWaveVRFrameTiming::GetInstance()->Mark(EWaveVRTimingStage::Submit, mHMD->FrameDataRT->frameNumber);
 	// Submit
 
 	//LOGV(WVRRender, "WVR_SubmitFrame(param.id=%p .target=%d)", params.id, params.target);
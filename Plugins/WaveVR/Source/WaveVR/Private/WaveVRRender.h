@@ -15,6 +15,7 @@
 
 #include "OpenGLDrv.h"
 #include "XRRenderBridge.h"
+#include "WaveVRFoveationScheduler.h"
 
 class FWaveVRHMD;
 class FWaveVRRender;
@@ -68,6 +69,30 @@ struct FWaveVRRenderTextureInfo
 	WVR_TextureQueueHandle_t wvrTextureQueue;  // Created by TextureManager
 };
 
+// Telemetry of the WVR texture queue.  Updated when getting next texture.
+struct FWaveVRTextureQueueStats
+{
+	static const int32 DepthHistogramSize = 8;
+
+	uint32 acquired;
+	uint32 misses;  // GetAvailableTextureIndex() had no texture, even after waiting.
+	uint32 consecutiveMisses;
+	uint32 maxConsecutiveMisses;
+	uint32 starvations;  // Times the consecutive misses reached wvr.TextureQueue.StarvationThreshold
+	float waitMs;  // Total time waited for an available texture
+
+	// In flight means from a texture is acquired until it is available again.
+	float lastInFlightMs;
+	float maxInFlightMs;
+	float sumInFlightMs;
+	uint32 inFlightCount;
+	// Index is how many other textures were acquired while a texture was in flight.  The last one also counts the deeper.
+	uint32 depthHistogram[DepthHistogramSize];
+};
+
+// Params: consecutive misses, queue capacity
+DECLARE_MULTICAST_DELEGATE_TwoParams(FWaveVRTextureQueueStarvationDelegate, uint32, uint32);
+
 // Manager queue and submit
 class FWaveVRTextureManager
 {
@@ -96,6 +121,14 @@ public:
 	WVR_TextureQueueHandle_t GetWVRTextureQueue();
 	WVR_TextureParams_t GetSubmitParams(WVR_Eye eye);
 
+	// Not thread safe.  Read it in the thread which call Next(), or when the values are not important.
+	const FWaveVRTextureQueueStats& GetQueueStats() const { return mQueueStats; }
+	void ResetQueueStats();
+
+	// Broadcast in the thread which call Next() when the queue keep starving.  The WVR texture
+	// queue's length is decided by runtime, so the listener should lower the loading instead.
+	FWaveVRTextureQueueStarvationDelegate OnTextureQueueStarvation;
+
 //private:
 //	inline FWaveVRTexturePool * GetColorTextureQueue() const { return mColorTexturePool; }
 //	inline FWaveVRTexturePool * GetDepthTextureQueue() const { return mDepthTextureQueue; }
@@ -114,6 +147,17 @@ private:
 
 	WVR_TextureTarget wvrTextureTarget;
 
+private:
+	int32 WaitAvailableTextureIndex(WVR_TextureQueueHandle_t queue);
+	uint32 PickStarvedTextureIndex(uint32 capacity) const;
+	void OnTextureAcquired(uint32 idx, bool available);
+	void OnTextureMissed(uint32 capacity);
+
+	FWaveVRTextureQueueStats mQueueStats;
+	TArray<double> mAcquireTime;  // Index is the texture index in queue.
+	TArray<uint32> mAcquireSerial;  // Index is the texture index in queue.  0 if never acquired.
+	uint32 mAcquireSerialCounter;
+
 protected:
 	FWaveVRRender * mRender;
 	FWaveVRHMD * mHMD;
@@ -133,6 +177,7 @@ private:
 
 public:
 	inline FWaveVRTextureManager * GetTextureManager() { return &mTextureManager; }
+	inline FWaveVRFoveationScheduler * GetFoveationScheduler() { return &mFoveationScheduler; }
 	inline bool IsInitialized() const { return bInitialized; }
 	inline bool IsCustomPresentSet() const { return bAlreadySetCustomPresent; }
 
@@ -144,6 +189,8 @@ public:
 	void SetSingleEyePixelSize(uint32 w, uint32 h);
 	void SetTextureFormat(EPixelFormat format);
 	void SetFoveationParams(EStereoscopicPass Eye, const WVR_RenderFoveationParams_t& FoveatParams);
+	// Set the foveal fov and peripheral quality of both eyes, and keep the focal points.  Used by the scheduler every frame, so no log.  Index is WVR_Eye.
+	void SetFoveationQuality(const float fovealFov[2], const WVR_PeripheralQuality periQuality[2]);
 	// If pose is nullptr, use internal pose.  Only benifted when late update is enabled.
 	void SetSubmitWithPose(bool enable, const WVR_PoseState_t * pose = nullptr);
 
@@ -153,6 +200,10 @@ public:
 	bool IsRenderFoveationSupport() const;
 	bool IsRenderFoveationEnabled() const;
 	void GetFoveationParams(EStereoscopicPass Eye, WVR_RenderFoveationParams_t& FoveatParams) const;
+	// The last mode set.  It is applied in render thread.
+	WVR_FoveationMode GetFoveationMode() const { return mCurrentFoveationMode; }
+	// The foveal fov and peripheral quality of the enable mode params.  Index is WVR_Eye.
+	void GetFoveationQuality(float fovealFov[2], WVR_PeripheralQuality periQuality[2]) const;
 	void GetSingleEyePixelSize(uint32 &w, uint32 &h) const;
 	uint32 GetSingleEyePixelWidth() const;
 	uint32 GetSingleEyePixelHeight() const;
@@ -248,6 +299,7 @@ private:
 	TRefCountPtr<FWaveVRFXRRenderBridge> mCustomPresent;
 	FWaveVRTextureManager mTextureManager;
 	FWaveVRHMD * mHMD;
+	FWaveVRFoveationScheduler mFoveationScheduler;
 
 private:
 	// WaveVR state
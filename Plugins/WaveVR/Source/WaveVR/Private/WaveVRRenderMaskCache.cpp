@@ -0,0 +1,277 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRRenderMaskCache.h"
+#include "WaveVRPrivatePCH.h"
+
+#include "Platforms/WaveVRAPIWrapper.h"
+#include "Platforms/WaveVRLogWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(RenderMaskCache, Display, All);
+
+#if PLATFORM_ANDROID
+#define PLATFORM_CHAR(str) TCHAR_TO_UTF8(str)
+#else
+#define PLATFORM_CHAR(str) str
+#endif
+
+// Keys are changed by the IPD, the near plane or the world scale.  Only a few are alive at once.
+static const int32 kMaxEntries = 4;
+// The runtime mesh should be small.
+static const uint32 kMaxStencilCount = 0xFF;
+
+#define RM_R 1.04f
+#define RM_P0 0.52f
+#define RM_P1 0.90666f
+#define RM_Z -1  // near plane value in right hand rule clipping space
+
+/**
+ *   15    11   0    1     12
+ *   +----------+----------+
+ *   |    _+    |    +_    |
+ *   |  -   -   |   -   -  |
+ * 10| + _   -  |  -   _ + |2
+ *   |-    -  - | -  -     |
+ *  9+----------*----------+3
+ *   |-   _ - - | - - _   -|
+ *  8| +     -  |  -     + |4
+ *   |  -_  -   |   -  _-  |
+ *   |    -+_   |   _+-    |
+ *   +----------+----------+
+ *   14    7    6    5     13
+ *
+**/
+static const float kDebugVertices[] {
+	// XYZ
+	// Circle start from Top
+	0,			RM_R,	RM_Z,  // 0
+	RM_P0,		RM_P1,	RM_Z,  // 1
+	RM_P1,		RM_P0,	RM_Z,  // 2
+	RM_R,		0,		RM_Z,  // 3
+	RM_P1,		-RM_P0,	RM_Z,  // 4
+	RM_P0,		-RM_P1,	RM_Z,  // 5
+	0,			-RM_R,	RM_Z,  // 6
+	-RM_P0,		-RM_P1,	RM_Z,  // 7
+	-RM_P1,		-RM_P0,	RM_Z,  // 8
+	-RM_R,		0,		RM_Z,  // 9
+	-RM_P1,		RM_P0,	RM_Z,  // 10
+	-RM_P0,		RM_P1,	RM_Z,  // 11
+
+	// Corner
+	 RM_R,   RM_R, RM_Z,  // 12
+	 RM_R,  -RM_R, RM_Z,  // 13
+	-RM_R,  -RM_R, RM_Z,  // 14
+	-RM_R,   RM_R, RM_Z,  // 15
+
+	0, 0, RM_Z  // 16 center
+};
+
+static const int32 kDebugIndices[] {
+	0, 1, 12,
+	1, 2, 12,
+	2, 3, 12,
+	3, 4, 13,
+	4, 5, 13,
+	5, 6, 13,
+	6, 7, 14,
+	7, 8, 14,
+	8, 9, 14,
+	9, 10, 15,
+	10, 11, 15,
+	11, 0, 15,
+};
+
+// The eye specified mesh has one more triangle from the center.  Index is the eye.
+static const int32 kDebugEyeIndices[2][3] {
+	{ 16, 5, 4 },
+	{ 16, 8, 7 },
+};
+
+#undef RM_R
+#undef RM_P0
+#undef RM_P1
+#undef RM_Z
+
+// Right hand rule
+static FMatrix MakeGLProjection(float Left, float Right, float Top, float Bottom, float ZNear, float ZFar = 1000) {
+	float SumRL = Right + Left;
+	float SumTB = Top + Bottom;
+	float SubRL = Right - Left;
+	float SubTB = Top - Bottom;
+
+	auto matrix = FMatrix(
+		FPlane(2 * ZNear / SubRL, 0.0f, 0.0f, 0.0f),
+		FPlane(0.0f, 2 * ZNear / SubTB, 0.0f, 0.0f),
+		FPlane(SumRL / SubRL, SumTB / SubTB, -(ZFar + ZNear) / (ZFar - ZNear), -1.0f),
+		FPlane(0.0f, 0.0f, -2 * ZFar * ZNear / (ZFar - ZNear), 0.0f)
+	);
+	auto tostr = matrix.ToString();
+	LOGD(RenderMaskCache, "Projection Matrix %s", PLATFORM_CHAR(*tostr));
+	return matrix;
+}
+
+FWaveVRRenderMaskCache& FWaveVRRenderMaskCache::Get()
+{
+	static FWaveVRRenderMaskCache Instance;
+	return Instance;
+}
+
+FWaveVRRenderMaskKey FWaveVRRenderMaskCache::GetStencilKey(const FWaveVRRenderMaskKey& key)
+{
+	FWaveVRRenderMaskKey stencilKey;
+	FMemory::Memcpy(stencilKey.Boundaries, key.Boundaries, sizeof(key.Boundaries));
+	stencilKey.IPD = key.IPD;
+	return stencilKey;
+}
+
+bool FWaveVRRenderMaskCache::FetchStencil(WVR_Eye eye, TArray<float>& outVertices, TArray<int32>& outIndices)
+{
+	uint32_t vertexCount = 0, triangleCount = 0;
+	WVR()->GetStencilMesh(eye, &vertexCount, &triangleCount, 0, NULL, 0, NULL);
+	if (vertexCount <= 0 || vertexCount > kMaxStencilCount || triangleCount <= 0 || triangleCount > kMaxStencilCount)
+		return false;
+	LOGD(RenderMaskCache, "FetchStencil() eye%d VCount = %d, TCount = %d", (int)eye, vertexCount, triangleCount);
+
+	// The buffers keep their allocation between the queries.
+	VertexBuffer.SetNumUninitialized(vertexCount * 3, false);
+	IndexBuffer.SetNumUninitialized(triangleCount * 3, false);
+	static_assert(sizeof(int32) == sizeof(int), "The indices are written by the runtime as int.");
+	WVR()->GetStencilMesh(eye, &vertexCount, &triangleCount, vertexCount * 3, VertexBuffer.GetData(), triangleCount * 3, (int*)IndexBuffer.GetData());
+
+	// The runtime may return less than queried.
+	outVertices.Reset(vertexCount * 3);
+	outVertices.Append(VertexBuffer.GetData(), FMath::Min<int32>(vertexCount * 3, VertexBuffer.Num()));
+	outIndices.Reset(triangleCount * 3);
+	outIndices.Append(IndexBuffer.GetData(), FMath::Min<int32>(triangleCount * 3, IndexBuffer.Num()));
+	return outVertices.Num() > 0;
+}
+
+FWaveVRRenderMaskMeshes* FWaveVRRenderMaskCache::Build(const FWaveVRRenderMaskKey& key, const FStencil& stencil)
+{
+	FWaveVRRenderMaskMeshes* meshes = new FWaveVRRenderMaskMeshes();
+
+	const float WorldUnitToMeter = key.WorldToMeters;
+	const float ZNear = key.NearPlane / WorldUnitToMeter;  // in meter
+
+	// Find the vertices not on the clipping space boundary.
+	const float ZDistance = ZNear + 0.01f;  // Near clipping plane plus 1cm.  Where the WaveVRRenderMaskComponent place at front of head.
+	meshes->Distance = ZDistance * WorldUnitToMeter;
+
+	LOGI(RenderMaskCache, "WorldUnitToMeter %f, ZNear %f, ZDistance %f", WorldUnitToMeter, ZNear, ZDistance);
+
+	// Transform from right hand rule to Unreal World
+	FMatrix AxisChangeMatrix = FMatrix::Identity;
+	AxisChangeMatrix.M[0][0] = 0, AxisChangeMatrix.M[0][1] = 1, AxisChangeMatrix.M[0][2] = 0;
+	AxisChangeMatrix.M[1][0] = 0, AxisChangeMatrix.M[1][1] = 0, AxisChangeMatrix.M[1][2] = 1;
+	AxisChangeMatrix.M[2][0] = -1, AxisChangeMatrix.M[2][1] = 0, AxisChangeMatrix.M[2][2] = 0;
+
+	const float scale = ZDistance / ZNear * WorldUnitToMeter;
+
+	for (int e = 0; e < 2; e++)
+	{
+		const TArray<float>& srcVertices = stencil.Vertices[e];
+		const TArray<int32>& srcIndices = stencil.Indices[e];
+		const int32 N = srcVertices.Num() / 3;
+		if (N <= 0)
+			continue;
+
+		// In WVR_GetClippingPlaneBoundary, the near value is assumed as 1.
+		const float* b = key.Boundaries[e];
+		float L = b[0] * ZNear, R = b[1] * ZNear, T = b[2] * ZNear, B = b[3] * ZNear;
+		LOGI(RenderMaskCache, "eye%d LRTB (%f, %f, %f, %f)", e, L, R, T, B);
+
+		// We need the projection used by HMD.  Invert it and multiply with vertices.
+		const FMatrix InvProj = MakeGLProjection(L, R, T, B, ZNear, 1000).Inverse();
+
+		FWaveVRRenderMaskSection& section = meshes->Sections[e];
+		section.Vertices.SetNumUninitialized(N);
+		section.Normals.Init(FVector(-1, 0, 0), N);
+		section.UVs.Init(FVector2D(0, 0), N);
+		section.Colors.Init(FLinearColor::Black, N);
+		section.Tangents.Init(FProcMeshTangent(0, 1, 0), N);
+		section.Triangles = srcIndices;
+
+		const float* src = srcVertices.GetData();
+		FVector* dst = section.Vertices.GetData();
+		for (int32 i = 0; i < N; i++, src += 3) {
+			// Set z to -1.0f which is the near plane value in GL right hand rule clipping space.
+			FVector4 v = InvProj.TransformFVector4(FVector4(src[0], src[1], -1.0f, 1));
+			v = v / v.W;
+
+			// v will be a vector in rhr world space.  convert to unreal world.  The mesh will put to ZDistance from camera.  no need the z.
+			dst[i] = AxisChangeMatrix.TransformVector(FVector(v.X, v.Y, 0) * scale);
+		}
+	}
+
+	return meshes;
+}
+
+FWaveVRRenderMaskMeshesPtr FWaveVRRenderMaskCache::GetMeshes(const FWaveVRRenderMaskKey& key)
+{
+	check(IsInGameThread());
+
+	int32 recent = RecentKeys.Find(key);
+	if (recent != INDEX_NONE) {
+		RecentKeys.RemoveAt(recent, 1, false);
+		RecentKeys.Add(key);
+		return Meshes.FindChecked(key);
+	}
+
+	// The stencil is shared by the keys of the same device and IPD.
+	const FWaveVRRenderMaskKey stencilKey = GetStencilKey(key);
+	TSharedPtr<const FStencil> stencil;
+	if (key.DebugMesh != 0) {
+		FStencil* debug = new FStencil();
+		for (int e = 0; e < 2; e++) {
+			debug->Vertices[e].Append(kDebugVertices, UE_ARRAY_COUNT(kDebugVertices) - (key.DebugMesh == 2 ? 0 : 3));
+			debug->Indices[e].Append(kDebugIndices, UE_ARRAY_COUNT(kDebugIndices));
+			if (key.DebugMesh == 2)
+				debug->Indices[e].Append(kDebugEyeIndices[e], 3);
+		}
+		stencil = MakeShareable(debug);
+	} else if (const TSharedPtr<const FStencil>* found = Stencils.Find(stencilKey)) {
+		stencil = *found;
+	} else {
+		FStencil* fetched = new FStencil();
+		if (!FetchStencil(WVR_Eye_Left, fetched->Vertices[0], fetched->Indices[0]) ||
+			!FetchStencil(WVR_Eye_Right, fetched->Vertices[1], fetched->Indices[1]))
+		{
+			delete fetched;
+			return nullptr;
+		}
+		stencil = MakeShareable(fetched);
+		Stencils.Add(stencilKey, stencil);
+	}
+
+	FWaveVRRenderMaskMeshesPtr meshes = MakeShareable(Build(key, *stencil));
+
+	if (RecentKeys.Num() >= kMaxEntries) {
+		const FWaveVRRenderMaskKey oldest = RecentKeys[0];
+		RecentKeys.RemoveAt(0, 1, false);
+		Meshes.Remove(oldest);
+		// Drop the stencil if no other entry is of it.
+		const FWaveVRRenderMaskKey oldestStencil = GetStencilKey(oldest);
+		if (!RecentKeys.ContainsByPredicate([&oldestStencil](const FWaveVRRenderMaskKey& k) { return GetStencilKey(k) == oldestStencil; }))
+			Stencils.Remove(oldestStencil);
+	}
+	RecentKeys.Add(key);
+	Meshes.Add(key, meshes);
+
+	LOGD(RenderMaskCache, "GetMeshes() built, IPD %f, %d in cache", key.IPD, RecentKeys.Num());
+	return meshes;
+}
+
+void FWaveVRRenderMaskCache::Empty()
+{
+	check(IsInGameThread());
+	Stencils.Empty();
+	Meshes.Empty();
+	RecentKeys.Empty();
+}
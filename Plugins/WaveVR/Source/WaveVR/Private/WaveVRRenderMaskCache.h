@@ -0,0 +1,88 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "wvr_render.h"
+
+// What decides the render mask mesh.
+struct FWaveVRRenderMaskKey
+{
+	float Boundaries[2][4];  // Left, right, top, bottom of each eye at distance 1.  Decided by the device.
+	float IPD;  // In meters
+	float NearPlane;  // In world units
+	float WorldToMeters;
+	int32 DebugMesh;  // 0 is the runtime mesh, 1 the debug mesh, and 2 the eye specified debug mesh.
+
+	FWaveVRRenderMaskKey() { FMemory::Memzero(this, sizeof(*this)); }
+	bool operator==(const FWaveVRRenderMaskKey& other) const { return FMemory::Memcmp(this, &other, sizeof(*this)) == 0; }
+	friend uint32 GetTypeHash(const FWaveVRRenderMaskKey& key) { return FCrc::MemCrc32(&key, sizeof(key)); }
+};
+
+// The streams of a procedural mesh section, in the component space.
+struct FWaveVRRenderMaskSection
+{
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UVs;
+	TArray<FLinearColor> Colors;
+	TArray<FProcMeshTangent> Tangents;
+};
+
+struct FWaveVRRenderMaskMeshes
+{
+	FWaveVRRenderMaskSection Sections[2];  // Index is the eye
+	float Distance;  // The component is put at this distance in front of the camera, in world units.
+};
+
+typedef TSharedPtr<const FWaveVRRenderMaskMeshes> FWaveVRRenderMaskMeshesPtr;
+
+/**
+ * The render mask meshes, built once per key and kept across the components and the levels.
+ *
+ * The stencil meshes of both eyes are fetched from the runtime once per device and IPD, into
+ * reused buffers.  Each section is built into arrays sized once, so a component passes them to
+ * the procedural mesh without building anything.  Accessed in game thread.
+ */
+class FWaveVRRenderMaskCache
+{
+public:
+	static FWaveVRRenderMaskCache& Get();
+
+	// nullptr if the runtime has no valid stencil mesh.
+	FWaveVRRenderMaskMeshesPtr GetMeshes(const FWaveVRRenderMaskKey& key);
+	void Empty();
+
+private:
+	FWaveVRRenderMaskCache() {}
+
+	struct FStencil
+	{
+		TArray<float> Vertices[2];  // XYZ
+		TArray<int32> Indices[2];
+	};
+
+	bool FetchStencil(WVR_Eye eye, TArray<float>& outVertices, TArray<int32>& outIndices);
+	static FWaveVRRenderMaskMeshes* Build(const FWaveVRRenderMaskKey& key, const FStencil& stencil);
+
+	// The runtime stencil is of the device and the IPD.
+	static FWaveVRRenderMaskKey GetStencilKey(const FWaveVRRenderMaskKey& key);
+
+	TMap<FWaveVRRenderMaskKey, TSharedPtr<const FStencil>> Stencils;
+	TMap<FWaveVRRenderMaskKey, FWaveVRRenderMaskMeshesPtr> Meshes;
+	TArray<FWaveVRRenderMaskKey> RecentKeys;  // The last is the most recent.
+
+	// Reused by the runtime queries.
+	TArray<float> VertexBuffer;
+	TArray<int32> IndexBuffer;
+};
@@ -0,0 +1,151 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRResourceStringCache.h"
+#include "WaveVRPrivatePCH.h"
+#include "Platforms/WaveVRJavaBridge.h"
+#include "Misc/ScopeRWLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRResString, Log, All);
+
+FWaveVRResourceStringCache& FWaveVRResourceStringCache::Get()
+{
+	static FWaveVRResourceStringCache Instance;
+	return Instance;
+}
+
+int32 FWaveVRResourceStringCache::FindLocale(const FString& lang, const FString& country) const
+{
+	for (int32 i = 0; i < Locales.Num(); i++) {
+		if (Locales[i].Key.Equals(lang, ESearchCase::CaseSensitive) && Locales[i].Value.Equals(country, ESearchCase::CaseSensitive))
+			return i;
+	}
+	return INDEX_NONE;
+}
+
+bool FWaveVRResourceStringCache::Find(const FString& name, const FString& lang, const FString& country, FString& out) const
+{
+	FRWScopeLock lock(Lock, SLT_ReadOnly);
+	const int32 locale = FindLocale(lang, country);
+	if (locale == INDEX_NONE)
+		return false;
+	const FSpan* span = Spans.Find(FKey(name, locale));
+	if (span == nullptr)
+		return false;
+	out = FString(span->Length, Pool.GetData() + span->Offset);
+	return true;
+}
+
+bool FWaveVRResourceStringCache::Prefetch(const TArray<FString>& names, const FString& lang, const FString& country)
+{
+	TArray<FString> missed;
+	int32 generation;
+	{
+		FRWScopeLock lock(Lock, SLT_ReadOnly);
+		generation = Generation;
+		const int32 locale = FindLocale(lang, country);
+		for (const FString& name : names) {
+			if (locale == INDEX_NONE || !Spans.Contains(FKey(name, locale)))
+				missed.AddUnique(name);
+		}
+	}
+	if (missed.Num() == 0)
+		return true;
+
+	TArray<FString> strings;
+	if (!FWaveVRJavaBridge::GetInstance()->GetStringsByName(missed, lang, country, strings) || strings.Num() != missed.Num()) {
+		LOGW(WVRResString, "Prefetch %d strings failed.", missed.Num());
+		return false;
+	}
+
+	FRWScopeLock lock(Lock, SLT_Write);
+	// The locale changed during the Java call.  These strings are of the old locale.
+	if (generation != Generation)
+		return true;
+
+	int32 locale = FindLocale(lang, country);
+	if (locale == INDEX_NONE)
+		locale = Locales.Add(TPair<FString, FString>(lang, country));
+	for (int32 i = 0; i < missed.Num(); i++) {
+		FKey key(missed[i], locale);
+		if (Spans.Contains(key))
+			continue;
+		FSpan span = { Pool.Num(), strings[i].Len() };
+		Pool.Append(*strings[i], span.Length);
+		Spans.Add(key, span);
+	}
+	LOGD(WVRResString, "Prefetch %d strings, %d in cache, pool %d", missed.Num(), Spans.Num(), Pool.Num());
+	return true;
+}
+
+bool FWaveVRResourceStringCache::GetString(const FString& name, const FString& lang, const FString& country, FString& out)
+{
+	if (Find(name, lang, country, out))
+		return true;
+
+	TArray<FString> names;
+	names.Add(name);
+	return Prefetch(names, lang, country) && Find(name, lang, country, out);
+}
+
+bool FWaveVRResourceStringCache::FetchSystemLocale()
+{
+	int32 generation;
+	{
+		FRWScopeLock lock(Lock, SLT_ReadOnly);
+		if (bHasSystemLocale)
+			return true;
+		generation = Generation;
+	}
+
+	FString language, country;
+	FWaveVRJavaBridge* bridge = FWaveVRJavaBridge::GetInstance();
+	if (!bridge->GetSystemLanguage(language) || !bridge->GetSystemCountry(country))
+		return false;
+
+	FRWScopeLock lock(Lock, SLT_Write);
+	if (generation == Generation) {
+		SystemLanguage = language;
+		SystemCountry = country;
+		bHasSystemLocale = true;
+	}
+	return true;
+}
+
+bool FWaveVRResourceStringCache::GetSystemLanguage(FString& out)
+{
+	if (!FetchSystemLocale())
+		return false;
+	FRWScopeLock lock(Lock, SLT_ReadOnly);
+	out = SystemLanguage;
+	return true;
+}
+
+bool FWaveVRResourceStringCache::GetSystemCountry(FString& out)
+{
+	if (!FetchSystemLocale())
+		return false;
+	FRWScopeLock lock(Lock, SLT_ReadOnly);
+	out = SystemCountry;
+	return true;
+}
+
+void FWaveVRResourceStringCache::Invalidate()
+{
+	FRWScopeLock lock(Lock, SLT_Write);
+	LOGI(WVRResString, "Invalidate %d strings", Spans.Num());
+	Locales.Empty();
+	Spans.Empty();
+	Pool.Empty();
+	SystemLanguage.Empty();
+	SystemCountry.Empty();
+	bHasSystemLocale = false;
+	FPlatformAtomics::InterlockedIncrement(&Generation);
+}
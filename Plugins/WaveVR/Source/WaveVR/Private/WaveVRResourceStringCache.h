@@ -0,0 +1,78 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * The resource strings of the Java ResourceWrapper, cached by name and locale.
+ *
+ * The strings only change with the system locale, so a lookup is served from a table without
+ * JNI, from any thread.  A miss fetches the string from Java.  Prefetch() fetches a set of names
+ * in one Java call, for example all labels of a panel before it is shown.  The whole cache is
+ * dropped when Java reports a locale change.
+ *
+ * The strings are packed in one character pool.  An empty lang and country is the system locale.
+ */
+class FWaveVRResourceStringCache
+{
+public:
+	static FWaveVRResourceStringCache& Get();
+
+	// Return false if the string is not cached.
+	bool Find(const FString& name, const FString& lang, const FString& country, FString& out) const;
+
+	// Fetch the names not cached yet in one Java call.  Return false if Java is not available.
+	bool Prefetch(const TArray<FString>& names, const FString& lang, const FString& country);
+
+	// Find, or fetch the string if missed.
+	bool GetString(const FString& name, const FString& lang, const FString& country, FString& out);
+
+	bool GetSystemLanguage(FString& out);
+	bool GetSystemCountry(FString& out);
+
+	// Drop all strings.  Called when the system locale changed.
+	void Invalidate();
+
+	uint32 GetGeneration() const { return (uint32)FPlatformAtomics::AtomicRead(&Generation); }
+
+private:
+	FWaveVRResourceStringCache() : Generation(0), bHasSystemLocale(false) {}
+
+	bool FetchSystemLocale();
+	int32 FindLocale(const FString& lang, const FString& country) const;
+
+	struct FKey
+	{
+		FString Name;  // Resource names are case sensitive.
+		int32 Locale;
+
+		FKey(const FString& name, int32 locale) : Name(name), Locale(locale) {}
+		bool operator==(const FKey& other) const { return Locale == other.Locale && Name.Equals(other.Name, ESearchCase::CaseSensitive); }
+		friend uint32 GetTypeHash(const FKey& key) { return HashCombine(FCrc::StrCrc32(*key.Name), (uint32)key.Locale); }
+	};
+
+	struct FSpan
+	{
+		int32 Offset;
+		int32 Length;
+	};
+
+	mutable FRWLock Lock;
+	TArray<TPair<FString, FString>> Locales;  // Index is FKey::Locale
+	TMap<FKey, FSpan> Spans;
+	TArray<TCHAR> Pool;
+	FString SystemLanguage;
+	FString SystemCountry;
+	int32 Generation;
+	bool bHasSystemLocale;
+};
@@ -10,6 +10,7 @@
 
 #include "WaveVRResourceWrapper.h"
 #include "WaveVRPrivatePCH.h"
+#include "WaveVRResourceStringCache.h"
 
 DEFINE_LOG_CATEGORY(LogResourceWrapper);
 
@@ -30,6 +31,16 @@ ResourceWrapperImpl* ResourceWrapperImpl::getInstance() {
 
 FString ResourceWrapperImpl::getString(FString stringName) {
 	LOG_FUNC();
+	FString ret;
+
+	// The system locale is cached with an empty lang and country.
+	const FString lang = useSystemLanguageFlag ? FString() : mPreferredLanguage;
+	const FString country = useSystemLanguageFlag ? FString() : mCountry;
+	if (FWaveVRResourceStringCache::Get().GetString(stringName, lang, country, ret)) {
+		TLOGD(LogResourceWrapper, "Get string %s from cache is %s", PLATFORM_CHAR(*stringName), PLATFORM_CHAR(*ret));
+		return ret;
+	}
+
 	std::string inputStr(TCHAR_TO_UTF8(*stringName));
 	std::string nativeStr;
 
@@ -39,13 +50,13 @@ FString ResourceWrapperImpl::getString(FString stringName) {
 	}
 	else
 	{
-		std::string lang(TCHAR_TO_UTF8(*mPreferredLanguage));
-		std::string country(TCHAR_TO_UTF8(*mCountry));
+		std::string inLang(TCHAR_TO_UTF8(*mPreferredLanguage));
+		std::string inCountry(TCHAR_TO_UTF8(*mCountry));
 
-		nativeStr = FWaveVRAPIWrapper::GetInstance()->GetStringByLanguage(inputStr, lang, country);
+		nativeStr = FWaveVRAPIWrapper::GetInstance()->GetStringByLanguage(inputStr, inLang, inCountry);
 	}
 
-	FString ret(UTF8_TO_TCHAR(nativeStr.c_str()));
+	ret = UTF8_TO_TCHAR(nativeStr.c_str());
 	LOGI(LogResourceWrapper, "Get string %s from native is %s", PLATFORM_CHAR(*stringName), PLATFORM_CHAR(*ret));
 
 	return ret;
@@ -53,27 +64,47 @@ FString ResourceWrapperImpl::getString(FString stringName) {
 
 FString ResourceWrapperImpl::getStringByLanguage(FString stringName, FString lang, FString country) {
 	LOG_FUNC();
+	FString ret;
+	if (FWaveVRResourceStringCache::Get().GetString(stringName, lang, country, ret)) {
+		TLOGD(LogResourceWrapper, "Get string %s lang %s country %s from cache is %s", PLATFORM_CHAR(*stringName), PLATFORM_CHAR(*lang), PLATFORM_CHAR(*country), PLATFORM_CHAR(*ret));
+		return ret;
+	}
+
 	std::string inputStr(TCHAR_TO_UTF8(*stringName));
 	std::string inLang(TCHAR_TO_UTF8(*lang));
 	std::string inCountry(TCHAR_TO_UTF8(*country));
 	std::string nativeStr;
 
 	nativeStr = FWaveVRAPIWrapper::GetInstance()->GetStringByLanguage(inputStr, inLang, inCountry);
-	FString ret(UTF8_TO_TCHAR(nativeStr.c_str()));
+	ret = UTF8_TO_TCHAR(nativeStr.c_str());
 	LOGI(LogResourceWrapper, "Get string %s lang %s country %s from native is %s", PLATFORM_CHAR(*stringName), PLATFORM_CHAR(*lang), PLATFORM_CHAR(*country), nativeStr.c_str());
 	return ret;
 }
 
+bool ResourceWrapperImpl::prefetchStrings(const TArray<FString>& stringNames) {
+	const FString lang = useSystemLanguageFlag ? FString() : mPreferredLanguage;
+	const FString country = useSystemLanguageFlag ? FString() : mCountry;
+	return FWaveVRResourceStringCache::Get().Prefetch(stringNames, lang, country);
+}
+
 FString ResourceWrapperImpl::getSystemLanguage() {
 	LOG_FUNC();
-	FString retStr(UTF8_TO_TCHAR(FWaveVRAPIWrapper::GetInstance()->GetSystemLanguage().c_str()));
+	FString retStr;
+	if (FWaveVRResourceStringCache::Get().GetSystemLanguage(retStr))
+		return retStr;
+
+	retStr = UTF8_TO_TCHAR(FWaveVRAPIWrapper::GetInstance()->GetSystemLanguage().c_str());
 	LOGI(LogResourceWrapper, "SystemLanguage is %s", PLATFORM_CHAR(*retStr));
 	return retStr;
 }
 
 FString ResourceWrapperImpl::getSystemCountry() {
 	LOG_FUNC();
-	FString retStr(UTF8_TO_TCHAR(FWaveVRAPIWrapper::GetInstance()->GetSystemCountry().c_str()));
+	FString retStr;
+	if (FWaveVRResourceStringCache::Get().GetSystemCountry(retStr))
+		return retStr;
+
+	retStr = UTF8_TO_TCHAR(FWaveVRAPIWrapper::GetInstance()->GetSystemCountry().c_str());
 	//LOGI(LogResourceWrapper, "SystemCountry is %s", PLATFORM_CHAR(*retStr));
 	return retStr;
 }
@@ -101,6 +132,10 @@ FString UWaveVRResourceWrapper::WaveVR_GetStringByLanguage(FString stringName, F
 	return ResourceWrapperImpl::getInstance()->getStringByLanguage(stringName, lang, country);
 }
 
+bool UWaveVRResourceWrapper::WaveVR_PrefetchStrings(const TArray<FString>& stringNames) {
+	return ResourceWrapperImpl::getInstance()->prefetchStrings(stringNames);
+}
+
 FString UWaveVRResourceWrapper::WaveVR_GetSystemLanguage() {
 	return ResourceWrapperImpl::getInstance()->getSystemLanguage();
 }
@@ -19,22 +19,45 @@
 
 DEFINE_LOG_CATEGORY_STATIC(WaveSplash, Display, All);
 
+static const int32 kProgressScale = 10000;
+static const FLinearColor kProgressTrackColor(0.2f, 0.2f, 0.2f, 1.0f);
+static const FLinearColor kProgressBarColor(1.0f, 1.0f, 1.0f, 1.0f);
+
 FWaveVRSplash::FWaveVRSplash(FWaveVRRender* InRender)
-	: bAutoShow(false)
+	: FTickableObjectRenderThread(false, true)
+	, bAutoShow(false)
 	, SplashTexture(nullptr)
+	, SplashBackGroundColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.0f))
+	, SplashScaleFactor(1.0f)
+	, SplashPositionShift(FVector2D::ZeroVector)
+	, AnimationFps(0)
+	, bInitialized(false)
+	, bIsShown(false)
 	, RendererModule(nullptr)
 	, mRender(InRender)
 	, BackGroundColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.0f))
 	, ScaleFactor(1.0f)
 	, PositionShift(FVector2D::ZeroVector)
-	, bInitialized(false)
-	, bIsShown(false)
-	, bSplashScreenRendered(false)
+	, FrameInterval(0)
+	, CurrentFrame(0)
+	, NextFrameTime(0)
+	, DrawnProgress(-1)
+	, bDirty(true)
+	, bShownRT(false)
+	, bTicking(false)
+	, ShowTime(0)
+	, MaxTimeToFirstFrame(0)
+	, CurrentWrapper(0)
+	, SplashOverlayId(-1)
+	, Progress(-1)
+	, TimeToFirstFrameUs(-1)
 {
 	LOG_FUNC();
 	static const FName RendererModuleName("Renderer");
 	RendererModule = FModuleManager::GetModulePtr<IRendererModule>(RendererModuleName);
 	check(RendererModule);
+	for (int32 i = 0; i < WrapperCount; i++)
+		SplashWrapperId[i] = 0;
 }
 
 FWaveVRSplash::~FWaveVRSplash()
@@ -46,10 +69,21 @@ FWaveVRSplash::~FWaveVRSplash()
 		FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
 		FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
 	}
-	DisApplyTexture();
+
+	FWaveVRSplash * pWaveVRSplash = this;
+	ENQUEUE_RENDER_COMMAND(ReleaseSplash)(
+		[pWaveVRSplash](FRHICommandListImmediate& RHICmdList)
+		{
+			pWaveVRSplash->Hide_RenderThread();
+			pWaveVRSplash->Frames.Empty();
+			FWaveVRAPIWrapper::GetInstance()->DelOverlay(pWaveVRSplash->SplashOverlayId);
+			pWaveVRSplash->SplashOverlayId = -1;
+		});
+	// Only when destroyed.  The commands above use this splash.
+	FlushRenderingCommands();
+
+	ReleaseTextures();
 	RendererModule = nullptr;
-	FWaveVRAPIWrapper::GetInstance()->DelOverlay(SplashOverlayId);
-	SplashOverlayId = -1;
 }
 
 void FWaveVRSplash::Init()
@@ -91,42 +125,24 @@ void FWaveVRSplash::Show()
 	LOG_FUNC();
 	check(IsInGameThread());
 
-	ApplyTexture();
-
 	if (!mRender->IsInitialized()) {
 		return;
 	}
 
-	if (SplashOverlayId < 0 || !FWaveVRAPIWrapper::GetInstance()->IsOverlayValid(SplashOverlayId)) {
-		FWaveVRAPIWrapper::GetInstance()->GenOverlay(&SplashOverlayId);
-		LOGD(WaveSplash, "FWaveVRAPIWrapper::GetInstance()->GenOverlay SplashOverlayId is (%u) ", SplashOverlayId);
-	}
-
 	if (bIsShown)
 	{
 		return;
 	}
+	bIsShown = true;
 
-	if(bSplashScreenRendered) {
-		uint32_t textureWidth = SplashWrapperRHIRef->GetSizeX();
-		uint32_t textureHeight = SplashWrapperRHIRef->GetSizeY();
-		const WVR_OverlayPosition position = {0.0f, 0.0f, -2.0f}; //Consider SPLASH_SCALE_FOR_POSITION if you change position.z
-		const WVR_OverlayTexture_t texture = { (uint32_t) SplashWrapperId, textureWidth, textureHeight };
-		LOGI(WaveSplash, "SplashTextureId(%u) textureWidth(%d) textureHeight(%d) SplashOverlayId(%u)", SplashWrapperId, textureWidth, textureHeight, SplashOverlayId);
-		FWaveVRAPIWrapper::GetInstance()->SetOverlayTextureId(SplashOverlayId, &texture);
-		FWaveVRAPIWrapper::GetInstance()->SetOverlayFixedPosition(SplashOverlayId, &position);
-		FWaveVRAPIWrapper::GetInstance()->ShowOverlay(SplashOverlayId);
-	}
-
+	// The overlay is created, drawn and submitted later in render thread.  Not to wait for it here.
+	const double showTime = FPlatformTime::Seconds();
 	FWaveVRSplash * pWaveVRSplash = this;
-	ENQUEUE_RENDER_COMMAND(SubmitSplash)(
-		[pWaveVRSplash](FRHICommandListImmediate& RHICmdList)
-			{
-		pWaveVRSplash->SubmitFrame_RenderThread();
+	ENQUEUE_RENDER_COMMAND(ShowSplash)(
+		[pWaveVRSplash, showTime](FRHICommandListImmediate& RHICmdList)
+		{
+			pWaveVRSplash->Show_RenderThread(showTime);
 		});
-	FlushRenderingCommands();
-
-	bIsShown = true;
 }
 
 void FWaveVRSplash::Hide()
@@ -138,133 +154,286 @@ void FWaveVRSplash::Hide()
 	{
 		return;
 	}
+	bIsShown = false;
+
+	FWaveVRSplash * pWaveVRSplash = this;
+	ENQUEUE_RENDER_COMMAND(HideSplash)(
+		[pWaveVRSplash](FRHICommandListImmediate& RHICmdList)
+		{
+			pWaveVRSplash->Hide_RenderThread();
+		});
+}
 
-	DisApplyTexture();
+float FWaveVRSplash::GetTimeToFirstFrame() const
+{
+	const int32 us = FPlatformAtomics::AtomicRead(&TimeToFirstFrameUs);
+	return us < 0 ? -1.0f : us / 1000000.0f;
+}
+
+void FWaveVRSplash::SetProgress(float InProgress)
+{
+	const int32 value = InProgress < 0 ? -1 : FMath::RoundToInt(FMath::Clamp(InProgress, 0.0f, 1.0f) * kProgressScale);
+	FPlatformAtomics::InterlockedExchange(&Progress, value);
+}
+
+void FWaveVRSplash::Show_RenderThread(double InShowTime)
+{
+	LOG_FUNC();
+	check(IsInRenderingThread());
+	if (!SplashWrapperRHIRef[CurrentWrapper].IsValid()) {
+		LOGD(WaveSplash, "Show_RenderThread : SplashWrapperRHIRef is not Initialized");
+		return;
+	}
+
+	ShowTime = InShowTime;
+	if (bDirty || DrawnProgress != FPlatformAtomics::AtomicRead(&Progress))
+		RenderStereo_RenderThread(CurrentWrapper);
+
+	if (SplashOverlayId < 0 || !FWaveVRAPIWrapper::GetInstance()->IsOverlayValid(SplashOverlayId)) {
+		FWaveVRAPIWrapper::GetInstance()->GenOverlay(&SplashOverlayId);
+		LOGD(WaveSplash, "FWaveVRAPIWrapper::GetInstance()->GenOverlay SplashOverlayId is (%u) ", SplashOverlayId);
+	}
+
+	uint32_t textureWidth = SplashWrapperRHIRef[CurrentWrapper]->GetSizeX();
+	uint32_t textureHeight = SplashWrapperRHIRef[CurrentWrapper]->GetSizeY();
+	const WVR_OverlayPosition position = {0.0f, 0.0f, -2.0f}; //Consider SPLASH_SCALE_FOR_POSITION if you change position.z
+	const WVR_OverlayTexture_t texture = { (uint32_t) SplashWrapperId[CurrentWrapper], textureWidth, textureHeight };
+	LOGI(WaveSplash, "SplashTextureId(%u) textureWidth(%d) textureHeight(%d) SplashOverlayId(%u)", SplashWrapperId[CurrentWrapper], textureWidth, textureHeight, SplashOverlayId);
+	FWaveVRAPIWrapper::GetInstance()->SetOverlayTextureId(SplashOverlayId, &texture);
+	FWaveVRAPIWrapper::GetInstance()->SetOverlayFixedPosition(SplashOverlayId, &position);
+	FWaveVRAPIWrapper::GetInstance()->ShowOverlay(SplashOverlayId);
+
+	SubmitFrame_RenderThread();
+	bShownRT = true;
+	NextFrameTime = FPlatformTime::Seconds() + FrameInterval;
+
+	const double timeToFirstFrame = FPlatformTime::Seconds() - ShowTime;
+	MaxTimeToFirstFrame = FMath::Max(MaxTimeToFirstFrame, (float)timeToFirstFrame);
+	FPlatformAtomics::InterlockedExchange(&TimeToFirstFrameUs, (int32)(timeToFirstFrame * 1000000));
+	LOGI(WaveSplash, "Time to first splash frame %.2f ms, max %.2f ms", timeToFirstFrame * 1000, MaxTimeToFirstFrame * 1000);
+
+	// Tick the animation and progress, even if the game thread is blocked.
+	if (!bTicking) {
+		Register(true);
+		bTicking = true;
+	}
+}
 
+void FWaveVRSplash::Hide_RenderThread()
+{
+	LOG_FUNC();
+	check(IsInRenderingThread());
+	if (bTicking) {
+		Unregister();
+		bTicking = false;
+	}
+	if (!bShownRT)
+		return;
 	FWaveVRAPIWrapper::GetInstance()->HideOverlay(SplashOverlayId);
-	bIsShown = false;
+	bShownRT = false;
 }
 
-void FWaveVRSplash::RenderStereo_RenderThread()
+void FWaveVRSplash::Tick(float DeltaTime)
+{
+	if (!bShownRT)
+		return;
+
+	const double now = FPlatformTime::Seconds();
+	bool changed = bDirty || DrawnProgress != FPlatformAtomics::AtomicRead(&Progress);
+	if (Frames.Num() > 1 && now >= NextFrameTime) {
+		CurrentFrame = (CurrentFrame + 1) % Frames.Num();
+		NextFrameTime = now + FrameInterval;
+		changed = true;
+	}
+	if (!changed)
+		return;
+
+	// Draw into the other wrapper.  The compositor may be still reading the current one.
+	const int32 next = (CurrentWrapper + 1) % WrapperCount;
+	if (!SplashWrapperRHIRef[next].IsValid())
+		return;
+	RenderStereo_RenderThread(next);
+	CurrentWrapper = next;
+
+	const WVR_OverlayTexture_t texture = { (uint32_t) SplashWrapperId[next], SplashWrapperRHIRef[next]->GetSizeX(), SplashWrapperRHIRef[next]->GetSizeY() };
+	FWaveVRAPIWrapper::GetInstance()->SetOverlayTextureId(SplashOverlayId, &texture);
+}
+
+void FWaveVRSplash::RenderStereo_RenderThread(int32 WrapperIndex)
 {
 	LOG_FUNC();
 	check(IsInRenderingThread());
-	if (!SplashWrapperRHIRef.IsValid()) {
+	FTexture2DRHIRef& wrapper = SplashWrapperRHIRef[WrapperIndex];
+	if (!wrapper.IsValid()) {
 		LOGD(WaveSplash, "RenderStereo_RenderThread : SplashWrapperRHIRef is not Initialized");
 		return;
 	}
 
-	if (!bSplashScreenRendered)
-	{
-		FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+
+	const uint32 ViewportWidth = wrapper->GetSizeX();
+	const uint32 ViewportHeight = wrapper->GetSizeY();
+	FIntRect DstRect = FIntRect(0, 0, ViewportWidth, ViewportHeight);
+	RHICmdList.SetViewport(DstRect.Min.X, DstRect.Min.Y, 0, DstRect.Max.X, DstRect.Max.Y, 1.0f);
 
-		const uint32 ViewportWidth = SplashWrapperRHIRef->GetSizeX();
-		const uint32 ViewportHeight = SplashWrapperRHIRef->GetSizeY();
-		FIntRect DstRect = FIntRect(0, 0, ViewportWidth, ViewportHeight);
-		RHICmdList.SetViewport(DstRect.Min.X, DstRect.Min.Y, 0, DstRect.Max.X, DstRect.Max.Y, 1.0f);
+	float RenderOffsetX = PositionShift.X + (1.0f - ScaleFactor) * 0.5 * ViewportWidth;
+	float RenderOffsetY = PositionShift.Y + (1.0f - ScaleFactor) * 0.5 * ViewportHeight;
 
-		//SetRenderTarget(RHICmdList, SplashWrapperRHIRef, FTextureRHIRef());
-		FRHIRenderPassInfo RPInfo(SplashWrapperRHIRef, ERenderTargetActions::DontLoad_Store);
-		RHICmdList.BeginRenderPass(RPInfo, TEXT("BlitSplashTexture"));
+	float RenderTargetSizeX = ViewportWidth * ScaleFactor;
+	float RenderTargetSizeY = ViewportHeight * ScaleFactor;
+
+	FTextureResource* frame = Frames.IsValidIndex(CurrentFrame) ? Frames[CurrentFrame] : nullptr;
+
+	//SetRenderTarget(RHICmdList, SplashWrapperRHIRef, FTextureRHIRef());
+	FRHIRenderPassInfo RPInfo(wrapper, ERenderTargetActions::DontLoad_Store);
+	RHICmdList.BeginRenderPass(RPInfo, TEXT("BlitSplashTexture"));
+	{
+		DrawClearQuad(RHICmdList, BackGroundColor);
+
+		if (frame != nullptr && frame->TextureRHI.IsValid())
 		{
-			DrawClearQuad(RHICmdList, BackGroundColor);
+			auto ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+			TShaderMapRef<FScreenVS> VertexShader(ShaderMap);
+			TShaderMapRef<FScreenPS> PixelShader(ShaderMap);
+			FGraphicsPipelineStateInitializer GraphicsPSOInit;
+			RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+
+			GraphicsPSOInit.BlendState = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+			GraphicsPSOInit.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None, true, false>::GetRHI();
+			GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+			GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GFilterVertexDeclaration.VertexDeclarationRHI;
+			GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+			GraphicsPSOInit.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
+			GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+			SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+			//Apply Splash texture texels
+			PixelShader->SetParameters(RHICmdList, TStaticSamplerState<SF_Trilinear>::GetRHI(), frame->TextureRHI);
+
+			RendererModule->DrawRectangle(
+				RHICmdList,
+				RenderOffsetX, RenderOffsetY,         //top left corner of the quad
+				RenderTargetSizeX, RenderTargetSizeY,
+				0.0, 0.0,                              //U, V
+				1.0, 1.0,                              //USize, VSize,
+				FIntPoint(ViewportWidth, ViewportHeight),
+				FIntPoint(1, 1),
+				VertexShader,
+				EDRF_Default);
+		}
 
-			if (SplashTexture != nullptr && SplashTexture->IsValidLowLevel())
+		// The progress bar is under the texture, in the same width.
+		const int32 progress = FPlatformAtomics::AtomicRead(&Progress);
+		if (progress >= 0)
+		{
+			const int32 barHeight = FMath::Max<int32>(ViewportHeight / 100, 2);
+			const int32 x0 = FMath::Clamp<int32>(RenderOffsetX, 0, ViewportWidth - 1);
+			const int32 x1 = FMath::Clamp<int32>(RenderOffsetX + RenderTargetSizeX, x0 + 1, ViewportWidth);
+			const int32 y0 = FMath::Clamp<int32>(RenderOffsetY + RenderTargetSizeY + barHeight, 0, ViewportHeight - barHeight);
+			const int32 filled = x0 + (x1 - x0) * progress / kProgressScale;
+
+			RHICmdList.SetViewport(x0, y0, 0, x1, y0 + barHeight, 1.0f);
+			DrawClearQuad(RHICmdList, kProgressTrackColor);
+			if (filled > x0)
 			{
-				auto ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
-				TShaderMapRef<FScreenVS> VertexShader(ShaderMap);
-				TShaderMapRef<FScreenPS> PixelShader(ShaderMap);
-				FGraphicsPipelineStateInitializer GraphicsPSOInit;
-				RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
-
-				GraphicsPSOInit.BlendState = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
-				GraphicsPSOInit.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None, true, false>::GetRHI();
-				GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
-				GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GFilterVertexDeclaration.VertexDeclarationRHI;
-				GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
-				GraphicsPSOInit.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
-				GraphicsPSOInit.PrimitiveType = PT_TriangleList;
-				SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
-
-				//Apply Splash texture texels
-				PixelShader->SetParameters(RHICmdList, TStaticSamplerState<SF_Trilinear>::GetRHI(), SplashTexture->Resource->TextureRHI);
-
-				float RenderOffsetX = PositionShift.X + (1.0f - ScaleFactor) * 0.5 * ViewportWidth;
-				float RenderOffsetY = PositionShift.Y + (1.0f - ScaleFactor) * 0.5 * ViewportHeight;
-
-				float RenderTargetSizeX = ViewportWidth * ScaleFactor;
-				float RenderTargetSizeY = ViewportHeight * ScaleFactor;
-
-				RendererModule->DrawRectangle(
-					RHICmdList,
-					RenderOffsetX, RenderOffsetY,         //top left corner of the quad
-					RenderTargetSizeX, RenderTargetSizeY,
-					0.0, 0.0,                              //U, V
-					1.0, 1.0,                              //USize, VSize,
-					FIntPoint(ViewportWidth, ViewportHeight),
-					FIntPoint(1, 1),
-					VertexShader,
-					EDRF_Default);
-				}
-			bSplashScreenRendered = true;
+				RHICmdList.SetViewport(x0, y0, 0, filled, y0 + barHeight, 1.0f);
+				DrawClearQuad(RHICmdList, kProgressBarColor);
+			}
+		}
+		DrawnProgress = progress;
+	}
+	RHICmdList.EndRenderPass();
+	bDirty = false;
+}
+
+void FWaveVRSplash::KeepResident(UTexture2D* Texture)
+{
+	if (Texture == nullptr || !Texture->IsValidLowLevel() || RootedTextures.Contains(Texture))
+		return;
+	// Not to be garbage collected or streamed out, so it can be shown without a load.
+	Texture->AddToRoot();
+	Texture->bForceMiplevelsToBeResident = true;
+	RootedTextures.Add(Texture);
+}
+
+void FWaveVRSplash::ReleaseTextures()
+{
+	LOG_FUNC();
+	for (UTexture2D* Texture : RootedTextures)
+	{
+		if (Texture != nullptr && Texture->IsValidLowLevel())
+		{
+			Texture->bForceMiplevelsToBeResident = false;
+			Texture->RemoveFromRoot();
 		}
-		RHICmdList.EndRenderPass();
 	}
+	RootedTextures.Empty();
 }
 
-bool FWaveVRSplash::ApplyTexture()
+void FWaveVRSplash::UpdateFrames_GameThread()
 {
 	LOG_FUNC();
+	check(IsInGameThread());
 
 	//TODO: Need make Texture UAsset to be cooked first if we use path to load UTexture2D.
 	//SplashTexturePath = "/Game/Test.Test";
 	//FSoftObjectPath Softload(SplashTexturePath);
 	//SplashTexture = Cast<UTexture2D>(Softload.TryLoad());
 
-	bool ret = false;
-	if (SplashTexture != nullptr && SplashTexture->IsValidLowLevel()) {
-		LOGD(WaveSplash, "Splash Texture is valid!");
-		SplashTexture->AddToRoot();
-		SplashTexture->UpdateResource();
-
-		FWaveVRSplash * pWaveVRSplash = this;
-		ENQUEUE_RENDER_COMMAND(ApplySplashTexture) (
-			[pWaveVRSplash](FRHICommandListImmediate& RHICmdList)
-			{
-				pWaveVRSplash->bSplashScreenRendered = false;
-				pWaveVRSplash->RenderStereo_RenderThread();
-			});
-		FlushRenderingCommands();
-		ret = true;
-	} else {
-		LOGD(WaveSplash, "Splash Texture is invalid!");
-	}
-	return ret;
-}
-
-
-void FWaveVRSplash::DisApplyTexture()
-{
-	LOG_FUNC();
-	if (SplashTexture != nullptr && SplashTexture->IsValidLowLevel())
+	// Only the textures in use are kept.
+	ReleaseTextures();
+	TArray<FTextureResource*> resources;
+	const TArray<UTexture2D*> textures = AnimationFrames.Num() > 0 ? AnimationFrames : TArray<UTexture2D*>({ SplashTexture });
+	for (UTexture2D* Texture : textures)
 	{
-		SplashTexture->RemoveFromRoot();
-		SplashTexture = nullptr;
+		if (Texture == nullptr || !Texture->IsValidLowLevel() || Texture->Resource == nullptr)
+			continue;
+		KeepResident(Texture);
+		resources.Add(Texture->Resource);
 	}
+	LOGD(WaveSplash, "Splash has %d valid frame(s).", resources.Num());
+
+	const FLinearColor background = SplashBackGroundColor;
+	const float scale = SplashScaleFactor;
+	const FVector2D shift = SplashPositionShift;
+	const double interval = AnimationFps > 0 ? 1.0 / AnimationFps : 0;
+	FWaveVRSplash * pWaveVRSplash = this;
+	ENQUEUE_RENDER_COMMAND(UpdateSplashFrames)(
+		[pWaveVRSplash, resources, background, scale, shift, interval](FRHICommandListImmediate& RHICmdList)
+		{
+			pWaveVRSplash->Frames = resources;
+			pWaveVRSplash->BackGroundColor = background;
+			pWaveVRSplash->ScaleFactor = scale;
+			pWaveVRSplash->PositionShift = shift;
+			pWaveVRSplash->FrameInterval = interval;
+			pWaveVRSplash->CurrentFrame = 0;
+			pWaveVRSplash->bDirty = true;
+			// Preload the overlay texture, so the next Show() needs no draw.  If shown, the tick will draw.
+			if (!pWaveVRSplash->bShownRT)
+				pWaveVRSplash->RenderStereo_RenderThread(pWaveVRSplash->CurrentWrapper);
+		});
 }
 
 void FWaveVRSplash::SetSplashParam(UTexture2D* InSplashTexture, FLinearColor InBackGroundColor, float InScaleFactor, FVector2D Shift,bool EnableAutoLoading) {
 	LOG_FUNC();
-	BackGroundColor = InBackGroundColor;
-	ScaleFactor = InScaleFactor / SPLASH_SCALE_FOR_FILLSCREEN;
-	PositionShift = Shift * SPLASH_SCALE_FOR_POSITION;
+	SplashBackGroundColor = InBackGroundColor;
+	SplashScaleFactor = InScaleFactor / SPLASH_SCALE_FOR_FILLSCREEN;
+	SplashPositionShift = Shift * SPLASH_SCALE_FOR_POSITION;
 	bAutoShow = EnableAutoLoading;
 	SplashTexture = InSplashTexture;
+	UpdateFrames_GameThread();
+}
+
+void FWaveVRSplash::SetSplashAnimation(const TArray<UTexture2D*>& InFrames, float FramesPerSecond) {
+	LOG_FUNC();
+	AnimationFrames = InFrames;
+	AnimationFps = FMath::Max(FramesPerSecond, 0.0f);
+	UpdateFrames_GameThread();
 }
 
 bool FWaveVRSplash::AllocateSplashWrapper_RenderThread() {
 
-	bool ret = false;
+	bool ret = true;
 
 	auto OpenGLDynamicRHI = static_cast<FOpenGLDynamicRHI*>(GDynamicRHI);
 	check(OpenGLDynamicRHI);
@@ -275,16 +444,20 @@ bool FWaveVRSplash::AllocateSplashWrapper_RenderThread() {
 	uint32 InNumMips = 1;
 	uint32 InNumSamples = 1;
 	uint32 InFlags = 0;
-	FRHIResourceCreateInfo CreateInfo;
-	SplashWrapperRHIRef = OpenGLDynamicRHI->RHICreateTexture2D(InSizeX, InSizeY, (uint8)InFormat, InNumMips, InNumSamples, InFlags, CreateInfo);
-
-	if (SplashWrapperRHIRef.IsValid()) {
-		SplashWrapperId = static_cast<uint32_t>(*(GLuint*)SplashWrapperRHIRef->GetNativeResource());
-		LOGI(WaveSplash, "SplashWrapperId (%u) ", SplashWrapperId);
-		ret = true;
-	} else {
-		LOGD(WaveSplash, "SplashWrapperRHIRef is not valid!");
+	// Two wrappers, to draw the next animation frame while the other is shown.
+	for (int32 i = 0; i < WrapperCount; i++) {
+		FRHIResourceCreateInfo CreateInfo;
+		SplashWrapperRHIRef[i] = OpenGLDynamicRHI->RHICreateTexture2D(InSizeX, InSizeY, (uint8)InFormat, InNumMips, InNumSamples, InFlags, CreateInfo);
+
+		if (SplashWrapperRHIRef[i].IsValid()) {
+			SplashWrapperId[i] = static_cast<uint32_t>(*(GLuint*)SplashWrapperRHIRef[i]->GetNativeResource());
+			LOGI(WaveSplash, "SplashWrapperId[%d] (%u) ", i, SplashWrapperId[i]);
+		} else {
+			LOGD(WaveSplash, "SplashWrapperRHIRef[%d] is not valid!", i);
+			ret = false;
+		}
 	}
+	bDirty = true;
 	return ret;
 }
 
@@ -11,11 +11,22 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "TickableObjectRenderThread.h"
 
 class FWaveVRHMD;
 class FWaveVRRender;
+class FTextureResource;
 
-class FWaveVRSplash : public TSharedFromThis<FWaveVRSplash>
+/**
+ * The splash is an overlay, which is drawn and submitted in render thread only.  The game thread
+ * never waits for the render thread, so a map loading is not delayed by its own splash.
+ *
+ * The splash textures are kept in root and fully resident from SetSplashParam().  The overlay
+ * texture is drawn before it is shown.  When the game thread is blocked by a map loading, the
+ * render thread is still ticked by the engine heartbeat, so the animation frames and the progress
+ * keep updating.
+ */
+class FWaveVRSplash : public TSharedFromThis<FWaveVRSplash>, public FTickableObjectRenderThread
 {
   public:
 
@@ -26,32 +37,74 @@ class FWaveVRSplash : public TSharedFromThis<FWaveVRSplash>
 	void Show();
 	void Hide();
 	void SetSplashParam(UTexture2D* InSplashTexture, FLinearColor InBackGroundColor, float InScaleFactor, FVector2D Shift, bool EnableAutoLoading);
+	// Frames replace the splash texture, and loop in FramesPerSecond.  Empty frames to stop the animation.
+	void SetSplashAnimation(const TArray<UTexture2D*>& InFrames, float FramesPerSecond);
+	// Draw a progress bar under the splash texture.  Negative to hide the bar.  Can be called in any thread.
+	void SetProgress(float InProgress);
 	bool IsShown() const { return bIsShown; }
 
+	// Seconds from Show() to the first splash frame submitted.  Negative if not shown yet.
+	float GetTimeToFirstFrame() const;
+
+  public:
+	// FTickableObjectRenderThread
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return true; }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(FWaveVRSplash, STATGROUP_Tickables); }
+
   private:
 	void OnPreLoadMap(const FString&);
 	void OnPostLoadMap(UWorld*);
 
-	bool ApplyTexture();
-	void DisApplyTexture();
-	void RenderStereo_RenderThread();
+	void KeepResident(UTexture2D* Texture);
+	void ReleaseTextures();
+	void UpdateFrames_GameThread();
+
+	// Render thread
+	void RenderStereo_RenderThread(int32 WrapperIndex);
 	bool AllocateSplashWrapper_RenderThread();
+	void Show_RenderThread(double ShowTime);
+	void Hide_RenderThread();
 	void SubmitFrame_RenderThread();
 
   private:
+	enum { WrapperCount = 2 };
+
+	// Game thread
 	bool bAutoShow;
 	UTexture2D* SplashTexture;
+	// Copied to the render thread members by UpdateFrames_GameThread().
+	FLinearColor SplashBackGroundColor;
+	float SplashScaleFactor;
+	FVector2D SplashPositionShift;
+	TArray<UTexture2D*> AnimationFrames;
+	float AnimationFps;
+	TArray<UTexture2D*> RootedTextures;
+	bool bInitialized;
+	bool bIsShown;
+
+	// Render thread
 	IRendererModule* RendererModule;
 	FWaveVRRender* mRender;
 	FLinearColor BackGroundColor;
 	float ScaleFactor;
 	FVector2D PositionShift;
-
-
-	bool bInitialized;
-	bool bIsShown;
-	bool bSplashScreenRendered;
-	FTexture2DRHIRef SplashWrapperRHIRef;
-	int32_t SplashWrapperId;
+	TArray<FTextureResource*> Frames;
+	double FrameInterval;
+	int32 CurrentFrame;
+	double NextFrameTime;
+	int32 DrawnProgress;
+	bool bDirty;
+	bool bShownRT;
+	bool bTicking;
+	double ShowTime;
+	float MaxTimeToFirstFrame;
+	FTexture2DRHIRef SplashWrapperRHIRef[WrapperCount];
+	int32_t SplashWrapperId[WrapperCount];
+	int32 CurrentWrapper;
 	int32_t SplashOverlayId;
+
+	// Any thread
+	volatile int32 Progress;  // In 1/10000.  Negative to hide.
+	volatile int32 TimeToFirstFrameUs;
 };
@@ -10,10 +10,6 @@
 
 #pragma once
 
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ProceduralMeshComponent.h"
@@ -22,6 +18,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAssimp, Log, All);
 
+struct FAdaptiveControllerModel;
+
 UCLASS()
 class WAVEVR_API AAdaptiveController : public AActor
 {
@@ -44,9 +42,6 @@ public:
 	virtual void PostLoad() override;
 
 private:
-  //  UFUNCTION(BlueprintCallable, Category = "WaveVR|Assimp")
-	bool OpenMesh(FString path, int32& SectionCount, FString& ErrorCode);
-
   //  UFUNCTION(BlueprintCallable, Category = "WaveVR|Assimp")
 	bool GetSection(int32 index, TArray<FVector>& Vertices, TArray<int32>& Faces, TArray<FVector>& Normals, TArray<FVector2D>& UV, TArray<FProcMeshTangent>& Tangents);
 
@@ -54,52 +49,18 @@ private:
 	void Clear();
 
 private:
-
-	void ClearProcessedMeshData();
-	void CopyProcessedRawDataToMultiMesh();
-	void CopyProcessedRawDataToOneMesh();
-
-	void processMesh(aiMesh* mesh, const aiScene* scene);
-	void processNode(aiNode* node, const aiScene* scene, aiMatrix4x4 AccuTransform);
+	void CreateMeshComponents();
 	void CreateProceduralMeshComponent();
-	void MeshInfo(aiMesh* aimesh);
-	void NodeInfo(aiNode* node);
 
-	//Current Processed Mesh Data
-	TArray<FString> _meshNames;
-	TArray<TArray<FVector>> _vertices;
-	TArray<TArray<int32>> _indices;
-	TArray<TArray<FVector>> _normals;
-	TArray<TArray<FVector2D>> _uvs;
-	TArray<TArray<FProcMeshTangent>> _tangents;
-	TArray<TArray<FLinearColor>> _vertexColors;
-	int32 _meshCurrentlyProcessed;
-	TArray<FMatrix> _TransformsOfMeshes;
+	// Loaded by FAdaptiveControllerMeshCache, and shared by all controllers of the same model.  Read only.
+	TSharedPtr<const FAdaptiveControllerModel, ESPMode::ThreadSafe> Model;
 
 	//Mutiple mesh Model
 	UPROPERTY(VisibleAnywhere)
 	TArray<UProceduralMeshComponent*> Multi_meshes;
-	TArray<FString> Multi_meshNames;
-	TArray<TArray<FVector>> Multi_vertices;
-	TArray<TArray<int32>> Multi_indices;
-	TArray<TArray<FVector>> Multi_normals;
-	TArray<TArray<FVector2D>> Multi_uvs;
-	TArray<TArray<FProcMeshTangent>> Multi_tangents;
-	TArray<TArray<FLinearColor>> Multi_vertexColors;
-	int32 Multi_meshCurrentlyProcessed;
-	TArray<FMatrix> Multi_TransformsOfMeshes;
 
 	//One mesh Model
 	TArray<UProceduralMeshComponent*> One_meshes;
-	TArray<FString> One_meshNames;
-	TArray<TArray<FVector>> One_vertices;
-	TArray<TArray<int32>> One_indices;
-	TArray<TArray<FVector>> One_normals;
-	TArray<TArray<FVector2D>> One_uvs;
-	TArray<TArray<FProcMeshTangent>> One_tangents;
-	TArray<TArray<FLinearColor>> One_vertexColors;
-	int32 One_meshCurrentlyProcessed;
-	TArray<FMatrix> One_TransformsOfMeshes;
 	TArray<int32> KeepIndex;
 
 	USceneComponent* SceneComponent;
@@ -213,6 +213,66 @@ enum class ERenderMaskMode : uint8
 	DEFAULT	= 2		/* Render mask follow the global setting to enable or disable */
 };
 
+/**
+ * Rolling percentiles of a frame timing metric, in milliseconds.
+ */
+USTRUCT(BlueprintType)
+struct FWaveVRTimingPercentiles
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	float P50 = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	float P90 = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	float P99 = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	float Average = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	float Max = 0;
+};
+
+/**
+ * Frame timing of the recent submitted frames.
+ */
+USTRUCT(BlueprintType)
+struct FWaveVRFrameTimingStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	// OnStartGameFrame to OnEndGameFrame
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	FWaveVRTimingPercentiles GameThread;
+
+	// OnEndGameFrame to the render thread begins rendering the frame
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	FWaveVRTimingPercentiles GameToRender;
+
+	// Begin rendering to PreRenderEye is done
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	FWaveVRTimingPercentiles PreRender;
+
+	// Begin rendering to submit
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	FWaveVRTimingPercentiles RenderThread;
+
+	// The pose was sampled, or late updated, to submit
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	FWaveVRTimingPercentiles PoseToSubmit;
+
+	// OnStartGameFrame to submit
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	FWaveVRTimingPercentiles Total;
+
+	UPROPERTY(BlueprintReadOnly, Category = "WaveVR|Timing")
+	int32 Frames = 0;
+};
+
 UCLASS()
 class WAVEVR_API UWaveVRBlueprintFunctionLibrary : public UBlueprintFunctionLibrary
 {
@@ -223,6 +283,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|PoseManager")
 	static bool GetDevicePose(FVector& OutPosition, FRotator& OutOrientation, EWVR_DeviceType Type = EWVR_DeviceType::DeviceType_HMD);
 
+	// To get the position and rotation of the device at the specified milliseconds ago.  Only the last 500ms are kept.
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|PoseManager")
+	static bool GetDevicePoseAgo(FVector& OutPosition, FRotator& OutOrientation, EWVR_DeviceType Type = EWVR_DeviceType::DeviceType_Controller_Right, float MilliSecondsAgo = 0);
+
+	// To predict the position and rotation of the device after the specified milliseconds by its latest velocity.
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|PoseManager")
+	static bool PredictDevicePose(FVector& OutPosition, FRotator& OutOrientation, EWVR_DeviceType Type = EWVR_DeviceType::DeviceType_Controller_Right, float MilliSeconds = 0);
+
 	// To enable or disable position and rotation prediction of the device. HMD always apply rotation prediction and cannot be disabled. HMD position prediction and controller pose prediction are disabled by default.
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|PoseManager")
 	static void SetPosePredictEnabled(EWVR_DeviceType Type, bool enabled_position_predict, bool enabled_rotation_predict);
@@ -324,6 +392,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|AdaptiveQuality")
 	static bool EnableAdaptiveQuality(bool enable, bool SendQualityEvent, bool AutoFoveation);
 
+	// To adjust the pixel density by the GPU and render thread frame time. MinDensity and MaxDensity limit the density, larger than 1 is supersampling. The eye textures are reallocated in MaxDensity if it is changed. Headroom is the part of the frame time kept free, 0.1 means 10%. Same as the wvr.DynamicResolution console variables.
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|DynamicResolution")
+	static void SetDynamicResolution(bool Enable, float MinDensity = 0.5f, float MaxDensity = 1.0f, float Headroom = 0.1f);
+
+	// To get the current pixel density, which may be decided by the dynamic resolution.
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|DynamicResolution")
+	static float GetPixelDensity();
+
 	UFUNCTION(
 		BlueprintCallable,
 		Category = "WaveVR|PoseManager",
@@ -424,6 +500,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|SplashScreen")
 	static void HideSplashScreen();
 
+	// Loop the Frames in FramesPerSecond instead of the splash texture.  The animation keeps playing while a map is loading.  Empty Frames to show the splash texture again.
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|SplashScreen")
+	static void SetSplashAnimation(const TArray<UTexture2D*>& Frames, float FramesPerSecond);
+
+	// Draw a progress bar under the splash texture.  Progress is from 0 to 1.  Negative to hide the bar.
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|SplashScreen")
+	static void SetSplashProgress(float Progress);
+
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|DirectPreview", meta = (
 		ToolTip = "Check if Direct Preview is running"))
 	static bool IsDirectPreview();
@@ -479,4 +563,11 @@ public:
 	**/
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|PoseManager")
 	static bool IsLateUpdateEnabled();
+
+	/**
+	 * To get the rolling percentiles of the frame timing in the last 90
+	 * submitted frames.  Return false if no frame was submitted.
+	**/
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|Timing")
+	static bool GetFrameTimingStats(FWaveVRFrameTimingStats& OutStats);
 };
@@ -12,6 +12,7 @@
 
 #include "EngineMinimal.h"
 #include "Components/ActorComponent.h"
+#include "RenderCommandFence.h"
 #include "WaveVRCameraTexture.generated.h"
 
 UENUM(BlueprintType)
@@ -43,12 +44,12 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-	//void updateTexture(void* data);
-
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|CameraTexture", meta = (
 		ToolTip = "To update Texture2D by native camera raw data."))
 	void updateCamera(float delta);
@@ -88,32 +89,27 @@ public:
 private:
 	bool bActive = false;
 	bool bUpdated = false;
+	// Created once, and updated in place.
+	UPROPERTY()
 	UTexture2D* CameraTexture;
 	uint32_t mWidth;
 	uint32_t mHeight;
 	uint32_t mSize;
 	EWVR_CameraImageType mImgType;
 	EWVR_CameraImageFormat mImgFormat;
-	TArray<FColor> rawData;
-	FUpdateTextureRegion2D *echoUpdateTextureRegion;
-	//void updateTexture(uint8_t* data);
-	void updateTextureG(uint8_t* data);
+	FUpdateTextureRegion2D mUpdateRegion;
+	void updateTexture(const uint8* data);
+	void waitStaging();
 	void reset();
-	int YUVtoRGB(int y, int u, int v);
 	const float frameRate = 30.f;
 	float timer = 0;
-	uint8_t* nativeRawData;
+	TArray<uint8> mFrameBuffer;  // Raw image from native camera
 	EPixelFormat mPixelFormat;
-};
 
-// Region Data struct
-struct FUpdateTextureRegionsData
-{
-	FTexture2DResource* Texture2DResource;
-	int32 MipIndex;
-	uint32 NumRegions;
-	FUpdateTextureRegion2D* Regions;
-	uint32 SrcPitch;
-	uint32 SrcBpp;
-	uint8* SrcData;
+	// Converted RGBA.  While RT uploads one, GT converts the next frame into the other.
+	static const int32 StagingCount = 2;
+	TArray<uint8> mStaging[StagingCount];
+	FRenderCommandFence mStagingFence[StagingCount];
+	int32 mStagingIndex;
+	uint32 mSkippedFrames;  // The staging was still being uploaded
 };
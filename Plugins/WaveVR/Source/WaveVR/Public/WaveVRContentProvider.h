@@ -29,11 +29,5 @@ public:
 	static void OnRoleChange();
 
 private:
-#if PLATFORM_ANDROID
-	static bool AndroidJavaENVCheck();
-	static void AndroidJavaENVFinish();
-	static bool mJavaAttached;
-#endif
-
 	static UWaveVRContentProvider* mInstance;
 };
@@ -264,6 +264,10 @@ public:
 		meta = (ToolTip = "To check if a button on a device is touched."))
 	static bool IsControllerButtonTouched(EWVR_DeviceType device, EWVR_TouchId button_id);
 
+	// All buttons of a device in one mask, each bit is a EWVR_InputId.
+	static uint32 GetButtonPressMask(EWVR_DeviceType device);
+	static uint32 GetButtonTouchMask(EWVR_DeviceType device);
+
 	UPROPERTY(BlueprintAssignable, Category = "WaveVR|Button")
 	FTouchpadPressBp OnTouchpadPressBp_Right;
 	UPROPERTY(BlueprintAssignable, Category = "WaveVR|Button")
@@ -290,13 +294,17 @@ private:
 	static bool isBtnTouch_right(EWVR_TouchId button);
 	static bool isBtnTouch_left(EWVR_TouchId button);
 
-	static bool btnPress_HMD[EventCommonButtonCount];
-	static bool btnPress_right[EventCommonButtonCount];
-	static bool btnPress_left[EventCommonButtonCount];
+	static void SetButtonBit(uint32& mask, uint8 button, bool down);
+	static void QueryButtonStates(EWVR_DeviceType device, uint32& press, uint32& touch);
+
+	// Bit is the button id, so EventCommonButtonCount should not exceed 32.
+	static uint32 btnPress_HMD;
+	static uint32 btnPress_right;
+	static uint32 btnPress_left;
 
-	static bool btnTouch_HMD[EventCommonButtonCount];
-	static bool btnTouch_right[EventCommonButtonCount];
-	static bool btnTouch_left[EventCommonButtonCount];
+	static uint32 btnTouch_HMD;
+	static uint32 btnTouch_right;
+	static uint32 btnTouch_left;
 #pragma endregion Button Event
 #pragma region
 public:
@@ -0,0 +1,46 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WaveVRBlueprintFunctionLibrary.h"
+
+/**
+ * Input state of one device in one frame.
+ *
+ * Each bit of the masks is a WVR_InputId, so the edges of a frame are the XOR of two snapshots.
+ * The axes are indexed as TouchButton.
+ */
+struct WAVEVR_API FWaveVRInputSnapshot
+{
+	uint32 Pressed;
+	uint32 Touched;
+	FVector2D Axis[TouchButtonCount];
+
+	FWaveVRInputSnapshot() { Reset(); }
+
+	void Reset();
+
+	inline bool IsPressed(EWVR_InputId id) const { return (Pressed & GetBit((uint8)id)) != 0; }
+	inline bool IsTouched(EWVR_TouchId id) const { return (Touched & GetBit((uint8)id)) != 0; }
+
+	/**
+	 * Read the inputs of a device by a single runtime call.  inputTypes is a mask of WVR_InputType.
+	 * The types which are not requested are left unchanged.  Return false, and keep the snapshot,
+	 * if the device is not connected or the runtime is not available, e.g. PIE without DirectPreview.
+	 */
+	bool Query(EWVR_DeviceType device, uint32 inputTypes);
+
+	static inline uint32 GetBit(uint8 id) { return id < 32 ? 1u << id : 0; }
+
+	// Index in TouchButton, or INDEX_NONE.
+	static int32 GetTouchIndex(uint8 id);
+};
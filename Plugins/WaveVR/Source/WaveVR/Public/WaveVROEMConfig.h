@@ -34,6 +34,59 @@ struct FOBatterySetting
 	int show;
 };
 
+// One value of the controller property, converted when the config is loaded.
+struct FWaveVROEMConfigValue
+{
+	FString String;
+	float Number;
+	FVector Vector;
+	FVector4 Vector4;
+	bool bIsNull;
+	bool bHasNumber;
+	bool bHasVector;
+	bool bHasVector4;
+
+	FWaveVROEMConfigValue()
+		: Number(0), Vector(FVector::ZeroVector), Vector4(0, 0, 0, 0)
+		, bIsNull(false), bHasNumber(false), bHasVector(false), bHasVector4(false) {}
+};
+
+/**
+ * An immutable snapshot of the OEM config.  The controller property is flattened into a map of
+ * interned (category, key), so a lookup is a hash of two names.  The single beam and battery
+ * settings are also resolved here.
+ */
+struct FWaveVROEMConfigStore
+{
+	struct FKey
+	{
+		FName Category;
+		FName Key;
+
+		FKey(FName category, FName key) : Category(category), Key(key) {}
+		bool operator==(const FKey& other) const { return Category == other.Category && Key == other.Key; }
+		friend uint32 GetTypeHash(const FKey& key) { return HashCombine(GetTypeHash(key.Category), GetTypeHash(key.Key)); }
+	};
+
+	TMap<FKey, FWaveVROEMConfigValue> Values;
+	uint32 Generation;
+	bool bLoaded;  // The controller property was parsed.
+	bool bEnableSingleBeam;
+	bool bBatteryInfo;
+
+	FWaveVROEMConfigStore() : Generation(0), bLoaded(false), bEnableSingleBeam(true), bBatteryInfo(false) {}
+
+	const FWaveVROEMConfigValue* Find(FName category, FName key) const { return Values.Find(FKey(category, key)); }
+	const FWaveVROEMConfigValue* Find(const FString& category, const FString& key) const;
+};
+
+typedef TSharedPtr<const FWaveVROEMConfigStore, ESPMode::ThreadSafe> FWaveVROEMConfigStorePtr;
+
+/**
+ * The OEM config is read from Java and parsed once into a store.  Reload() builds a new store
+ * and swaps it, so a reader always sees a whole config.  It is called when the config changed.
+ * The getters are thread safe.
+ */
 class WaveVROEMConfigImpl {
 public:
 	WaveVROEMConfigImpl();
@@ -46,13 +99,22 @@ public:
 	bool IsBatteryInfo();
 	static WaveVROEMConfigImpl* getInstance();
 
+	// Keep the returned store for a group of lookups.
+	FWaveVROEMConfigStorePtr GetStore();
+	// Increased when each reload starts.  The store keeps the generation it was loaded as, and a
+	// consumer compares the two to know its cached values are old.
+	uint32 GetGeneration() const { return (uint32)FPlatformAtomics::AtomicRead(&Generation); }
+	void Reload();
+
 private:
 	static WaveVROEMConfigImpl* mInstance;
 
-	FString jsonString;
-	bool jsonUpdate;
-	TSharedPtr<FJsonObject> JsonParsed;
-	void updateJsonStr();
+	static FWaveVROEMConfigStore* Load();
+
+	FCriticalSection StoreLock;
+	FWaveVROEMConfigStorePtr Store;
+	int32 Generation;
+	double LastLoadTime;
 };
 
 /**
@@ -44,30 +44,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Default)
 	bool UseEyeSpecifiedMesh;
 
-public:
-	class RenderMaskData {
-	public:
-		int vertexFloatCount;
-		int indexIntCount;
-
-		float * vertices;
-		int * indices;
-	};
-
 public:
 	UFUNCTION()
 	void OnIpdBroadcast();
 
 private:
-	RenderMaskData GetRenderMaskData(int e);
-
-private:
-	float* vertexDataL;
-	int* indexDataL;
-	float* vertexDataR;
-	int* indexDataR;
-	uint32_t vertexCountL = 0, triangleCountL = 0;
-	uint32_t vertexCountR = 0, triangleCountR = 0;
+	// The meshes of the current eye geometry, shared with the other components by the cache.
+	TSharedPtr<const struct FWaveVRRenderMaskMeshes> Meshes;
 	bool GetStencilMesh();
 	void CreateMesh();
 };
@@ -25,6 +25,9 @@ public:
 
 	FString getStringByLanguage(FString stringName, FString lang, FString country);
 
+	// Cache the strings of the current language in one call.
+	bool prefetchStrings(const TArray<FString>& stringNames);
+
 	FString getSystemLanguage();
 
 	FString getSystemCountry();
@@ -58,6 +61,10 @@ class WAVEVR_API UWaveVRResourceWrapper : public UObject
 		ToolTip = "Return value by key and language you preferred."))
 	static FString WaveVR_GetStringByLanguage(FString stringName, FString lang, FString country);
 
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|Resource", meta = (
+		ToolTip = "Cache the values of the keys in one call, for example before a panel is shown. Return false if failed."))
+	static bool WaveVR_PrefetchStrings(const TArray<FString>& stringNames);
+
 	UFUNCTION(BlueprintCallable, Category = "WaveVR|Resource", meta = (
 		ToolTip = "Return language code what your device is."))
 	static FString WaveVR_GetSystemLanguage();
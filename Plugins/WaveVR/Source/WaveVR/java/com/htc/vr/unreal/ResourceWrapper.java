@@ -10,8 +10,12 @@
 
 package com.htc.vr.unreal;
 
+import android.content.BroadcastReceiver;
 import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
 import android.content.res.Configuration;
+import android.content.res.Resources;
 import android.os.Build;
 import android.util.Log;
 
@@ -28,6 +32,15 @@ public class ResourceWrapper {
 	private static String mPackageName;
 
 	public native void initNative();
+	public native void localeChangedNative();
+
+	private final BroadcastReceiver mLocaleReceiver = new BroadcastReceiver() {
+		@Override
+		public void onReceive(Context context, Intent intent) {
+			Log.i(TAG, "locale changed");
+			localeChangedNative();
+		}
+	};
 
 	public void setPackageName(String pn) {
 		mPackageName = pn;
@@ -49,6 +62,7 @@ public class ResourceWrapper {
 
 	public void setContext(Context ctx) {
 		mContext = ctx;
+		mContext.registerReceiver(mLocaleReceiver, new IntentFilter(Intent.ACTION_LOCALE_CHANGED));
 	}
 
 	public String  getPreferredStringByName(String aString, String lang, String country) {
@@ -65,6 +79,24 @@ public class ResourceWrapper {
 		return mContext.createConfigurationContext(configuration).getResources().getString(resId);
 	}
 
+	// Empty lang and country for the system locale.  A name not found is an empty string.
+	public String[] getStringsByName(String[] names, String lang, String country) {
+		Resources resources = mContext.getResources();
+		if (!lang.isEmpty()) {
+			Configuration configuration = new Configuration(resources.getConfiguration());
+			configuration.setLocale(new Locale(lang, country));
+			resources = mContext.createConfigurationContext(configuration).getResources();
+		}
+
+		String[] strings = new String[names.length];
+		for (int i = 0; i < names.length; i++) {
+			int resId = resources.getIdentifier(names[i], "string", mPackageName);
+			strings[i] = resId == 0 ? "" : resources.getString(resId);
+		}
+		Log.i(TAG, "getStringsByName count = " + names.length + " language = " + lang + " country = " + country);
+		return strings;
+	}
+
 	public String getStringByName(String aString) {
 		Log.i(TAG, "getStringByName string = " + aString);
 
@@ -34,7 +34,6 @@ FWaveVRGestureInputDevice::FWaveVRGestureInputDevice(const TSharedRef<FGenericAp
 	BONE_OFFSET_L(FVector(0, 0, 0)),
 	BONE_OFFSET_R(FVector(0, 0, 0))
 {
-	Skeleton = new WaveVRGestureSkeleton();
 	bGestureInputDeviceInitialized = true;
 	gestureThread = FWaveVRGestureThread::JoyInit();
 	UE_LOG(LogWaveVRGestureInputDevice, Log, TEXT("FWaveVRGestureInputDevice()"));
@@ -103,14 +102,13 @@ void FWaveVRGestureInputDevice::Tick(float DeltaTime)
 		bHandTrackingDataUpdated = FWaveVRAPIWrapper::GetInstance()->GetHandTrackingData(&handSkeletonData, &handPoseData) == WVR_Result::WVR_Success ? true : false;
 		if (bHandTrackingDataUpdated)	// Get the tracking data from the shmem.
 		{
-			if (handSkeletonData.left.wrist.isValidPose)
-				UpdateLeftHandTrackingData();
+			const float worldToMeters = HMD->GetWorldToMetersScale();
 
-			if (handSkeletonData.right.wrist.isValidPose)
-				UpdateRightHandTrackingData();
+			Skeleton.UpdateHand(EWaveVRGestureHandType::LEFT, handSkeletonData.left, worldToMeters, BONE_OFFSET_L);
+			Skeleton.UpdateHand(EWaveVRGestureHandType::RIGHT, handSkeletonData.right, worldToMeters, BONE_OFFSET_R);
 
-			UpdateLeftHandPoseData();
-			UpdateRightHandPoseData();
+			UpdateLeftHandPoseData(worldToMeters);
+			UpdateRightHandPoseData(worldToMeters);
 		}
 	}
 	else
@@ -237,9 +235,24 @@ bool FWaveVRGestureInputDevice::GetBonePositionAndRotation(int32 DevId, EWaveVRG
 		)
 		return false;
 
-	OutPosition = Skeleton->Bones[(int32)BoneId]->GetPosition();
-	OutRotation = Skeleton->Bones[(int32)BoneId]->GetRotation();
-	return Skeleton->Bones[(int32)BoneId]->IsValidPose();
+	OutPosition = Skeleton.Positions[(int32)BoneId];
+	OutRotation = Skeleton.Rotations[(int32)BoneId];
+	return Skeleton.Valid[(int32)BoneId];
+}
+
+bool FWaveVRGestureInputDevice::GetHandBonePoses(EWaveVRGestureHandType hand, TArray<FVector>& OutPositions, TArray<FRotator>& OutRotations)
+{
+	if (!bHandTrackingDataUpdated)
+		return false;
+
+	// All bones of a hand have the same validity.
+	const TArrayView<const FVector> positions = Skeleton.GetPositions(hand);
+	const TArrayView<const FRotator> rotations = Skeleton.GetRotations(hand);
+	OutPositions.Reset(positions.Num());
+	OutPositions.Append(positions.GetData(), positions.Num());
+	OutRotations.Reset(rotations.Num());
+	OutRotations.Append(rotations.GetData(), rotations.Num());
+	return Skeleton.Valid[FWaveVRHandSkeleton::GetFirstBone(hand)];
 }
 
 EWaveVRHandTrackingStatus FWaveVRGestureInputDevice::GetHandTrackingStatus()
@@ -284,11 +297,8 @@ FVector FWaveVRGestureInputDevice::GetHandPinchDirection(EWaveVRGestureHandType
 #pragma endregion GestureBPLibrary related functions.
 
 #pragma region
-void FWaveVRGestureInputDevice::UpdateLeftHandPoseData()
+void FWaveVRGestureInputDevice::UpdateLeftHandPoseData(float worldToMeters)
 {
-	FWaveVRHMD* HMD = GetWaveVRHMD();
-	if (HMD == nullptr) return;
-
 	if (handPoseData.left.pinch.base.type == WVR_HandPoseType::WVR_HandPoseType_Invalid)
 	{
 		pinchStrengthLeft = 0;
@@ -299,17 +309,14 @@ void FWaveVRGestureInputDevice::UpdateLeftHandPoseData()
 	if (handPoseData.left.pinch.base.type == WVR_HandPoseType::WVR_HandPoseType_Pinch)
 	{
 		pinchStrengthLeft = handPoseData.left.pinch.strength;
-		pinchOriginLeft = CoordinateUtil::GetVector3(handPoseData.left.pinch.origin, HMD->GetWorldToMetersScale());
-		pinchDirectionLeft = CoordinateUtil::GetVector3(handPoseData.left.pinch.direction, HMD->GetWorldToMetersScale());
+		pinchOriginLeft = CoordinateUtil::GetVector3(handPoseData.left.pinch.origin, worldToMeters);
+		pinchDirectionLeft = CoordinateUtil::GetVector3(handPoseData.left.pinch.direction, worldToMeters);
 		UE_LOG(LogWaveVRGestureInputDevice, Log, TEXT("UpdateLeftHandPoseData() %f"), pinchStrengthLeft);
 	}
 }
 
-void FWaveVRGestureInputDevice::UpdateRightHandPoseData()
+void FWaveVRGestureInputDevice::UpdateRightHandPoseData(float worldToMeters)
 {
-	FWaveVRHMD* HMD = GetWaveVRHMD();
-	if (HMD == nullptr) return;
-
 	if (handPoseData.right.pinch.base.type == WVR_HandPoseType::WVR_HandPoseType_Invalid)
 	{
 		pinchStrengthRight = 0;
@@ -320,386 +327,12 @@ void FWaveVRGestureInputDevice::UpdateRightHandPoseData()
 	if (handPoseData.right.pinch.base.type == WVR_HandPoseType::WVR_HandPoseType_Pinch)
 	{
 		pinchStrengthRight = handPoseData.right.pinch.strength;
-		pinchOriginRight = CoordinateUtil::GetVector3(handPoseData.right.pinch.origin, HMD->GetWorldToMetersScale());
-		pinchDirectionRight = CoordinateUtil::GetVector3(handPoseData.right.pinch.direction, HMD->GetWorldToMetersScale());
+		pinchOriginRight = CoordinateUtil::GetVector3(handPoseData.right.pinch.origin, worldToMeters);
+		pinchDirectionRight = CoordinateUtil::GetVector3(handPoseData.right.pinch.direction, worldToMeters);
 	}
 }
 #pragma endregion Hand Pose
 
-#pragma region
-void FWaveVRGestureInputDevice::UpdateLeftHandTrackingData()
-{
-	if (Skeleton == nullptr) return;
-
-	FWaveVRHMD* HMD = GetWaveVRHMD();
-	if (HMD == nullptr) return;
-
-	for (int i = (int32)EWaveVRGestureBoneType::BONE_UPPERARM_L; i < (int32)EWaveVRGestureBoneType::BONE_UPPERARM_R; i++)
-	{
-		Skeleton->Bones[i]->SetPoseValid(handSkeletonData.left.wrist.isValidPose);
-		Skeleton->Bones[i]->SetConfidence(handSkeletonData.left.confidence);
-	}
-
-	// Left arm wrist - BONE_HAND_WRIST_L.
-	FVector BONE_HAND_WRIST_L_Pos = FVector::ZeroVector;
-	FQuat BONE_HAND_WRIST_L_Quat = FQuat::Identity;
-	CoordinateUtil::MatrixToPose(handSkeletonData.left.wrist.poseMatrix, BONE_HAND_WRIST_L_Quat, BONE_HAND_WRIST_L_Pos, HMD->GetWorldToMetersScale());
-
-	BONE_HAND_WRIST_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_HAND_WRIST_L_Rot = BONE_HAND_WRIST_L_Quat.Rotator();
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_HAND_WRIST_L]->SetPosition(BONE_HAND_WRIST_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_HAND_WRIST_L]->SetRotation(BONE_HAND_WRIST_L_Rot);
-
-	// Left arm thumb joint1 bone - BONE_THUMB_JOINT1_L.
-	FVector BONE_THUMB_JOINT1_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.thumb.joint1, HMD->GetWorldToMetersScale());
-	BONE_THUMB_JOINT1_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_THUMB_JOINT1_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_L_Pos, BONE_THUMB_JOINT1_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT1_L]->SetPosition(BONE_THUMB_JOINT1_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT1_L]->SetRotation(BONE_THUMB_JOINT1_L_Rot);
-
-	// Left arm thumb joint2 bone - BONE_THUMB_JOINT2_L.
-	FVector BONE_THUMB_JOINT2_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.thumb.joint2, HMD->GetWorldToMetersScale());
-	BONE_THUMB_JOINT2_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_THUMB_JOINT2_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_L_Pos, BONE_THUMB_JOINT2_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT2_L]->SetPosition(BONE_THUMB_JOINT2_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT2_L]->SetRotation(BONE_THUMB_JOINT2_L_Rot);
-
-	// Left arm thumb joint3 bone - BONE_THUMB_JOINT3_L.
-	FVector BONE_THUMB_JOINT3_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.thumb.joint3, HMD->GetWorldToMetersScale());
-	BONE_THUMB_JOINT3_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_THUMB_JOINT3_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_THUMB_JOINT2_L_Pos, BONE_THUMB_JOINT3_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT3_L]->SetPosition(BONE_THUMB_JOINT3_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT3_L]->SetRotation(BONE_THUMB_JOINT3_L_Rot);
-
-	// Left arm thumb tip bone - BONE_THUMB_TIP_L.
-	FVector BONE_THUMB_TIP_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.thumb.tip, HMD->GetWorldToMetersScale());
-	BONE_THUMB_TIP_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_THUMB_TIP_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_THUMB_JOINT3_L_Pos, BONE_THUMB_TIP_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_TIP_L]->SetPosition(BONE_THUMB_TIP_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_TIP_L]->SetRotation(BONE_THUMB_TIP_L_Rot);
-
-	// Left arm index joint1 bone - BONE_INDEX_JOINT1_L.
-	FVector BONE_INDEX_JOINT1_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.index.joint1, HMD->GetWorldToMetersScale());
-	BONE_INDEX_JOINT1_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_INDEX_JOINT1_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_L_Pos, BONE_INDEX_JOINT1_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT1_L]->SetPosition(BONE_INDEX_JOINT1_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT1_L]->SetRotation(BONE_INDEX_JOINT1_L_Rot);
-
-	// Left arm index joint2 bone - BONE_INDEX_JOINT2_L.
-	FVector BONE_INDEX_JOINT2_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.index.joint2, HMD->GetWorldToMetersScale());
-	BONE_INDEX_JOINT2_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_INDEX_JOINT2_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_INDEX_JOINT1_L_Pos, BONE_INDEX_JOINT2_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT2_L]->SetPosition(BONE_INDEX_JOINT2_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT2_L]->SetRotation(BONE_INDEX_JOINT2_L_Rot);
-
-	// Left arm index joint3 bone - BONE_INDEX_JOINT3_L.
-	FVector BONE_INDEX_JOINT3_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.index.joint3, HMD->GetWorldToMetersScale());
-	BONE_INDEX_JOINT3_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_INDEX_JOINT3_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_INDEX_JOINT2_L_Pos, BONE_INDEX_JOINT3_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT3_L]->SetPosition(BONE_INDEX_JOINT3_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT3_L]->SetRotation(BONE_INDEX_JOINT3_L_Rot);
-
-	// Left arm index tip bone - BONE_INDEX_TIP_L.
-	FVector BONE_INDEX_TIP_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.index.tip, HMD->GetWorldToMetersScale());
-	BONE_INDEX_TIP_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_INDEX_TIP_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_INDEX_JOINT3_L_Pos, BONE_INDEX_TIP_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_TIP_L]->SetPosition(BONE_INDEX_TIP_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_TIP_L]->SetRotation(BONE_INDEX_TIP_L_Rot);
-
-	// Left arm middle joint1 bone - BONE_MIDDLE_JOINT1_L.
-	FVector BONE_MIDDLE_JOINT1_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.middle.joint1, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_JOINT1_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_MIDDLE_JOINT1_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_L_Pos, BONE_MIDDLE_JOINT1_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT1_L]->SetPosition(BONE_MIDDLE_JOINT1_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT1_L]->SetRotation(BONE_MIDDLE_JOINT1_L_Rot);
-
-	// Left arm middle joint2 bone - BONE_MIDDLE_JOINT2_L.
-	FVector BONE_MIDDLE_JOINT2_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.middle.joint2, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_JOINT2_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_MIDDLE_JOINT2_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_MIDDLE_JOINT1_L_Pos, BONE_MIDDLE_JOINT2_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT2_L]->SetPosition(BONE_MIDDLE_JOINT2_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT2_L]->SetRotation(BONE_MIDDLE_JOINT2_L_Rot);
-
-	// Left arm middle joint3 bone - BONE_MIDDLE_JOINT3_L.
-	FVector BONE_MIDDLE_JOINT3_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.middle.joint3, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_JOINT3_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_MIDDLE_JOINT3_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_MIDDLE_JOINT2_L_Pos, BONE_MIDDLE_JOINT3_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT3_L]->SetPosition(BONE_MIDDLE_JOINT3_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT3_L]->SetRotation(BONE_MIDDLE_JOINT3_L_Rot);
-
-	// Left arm middle tip bone - BONE_MIDDLE_TIP_L.
-	FVector BONE_MIDDLE_TIP_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.middle.tip, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_TIP_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_MIDDLE_TIP_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_MIDDLE_JOINT3_L_Pos, BONE_MIDDLE_TIP_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_TIP_L]->SetPosition(BONE_MIDDLE_TIP_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_TIP_L]->SetRotation(BONE_MIDDLE_TIP_L_Rot);
-
-	// Left arm ring joint1 bone - BONE_RING_JOINT1_L.
-	FVector BONE_RING_JOINT1_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.ring.joint1, HMD->GetWorldToMetersScale());
-	BONE_RING_JOINT1_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_RING_JOINT1_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_L_Pos, BONE_RING_JOINT1_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT1_L]->SetPosition(BONE_RING_JOINT1_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT1_L]->SetRotation(BONE_RING_JOINT1_L_Rot);
-
-	// Left arm ring joint2 bone - BONE_RING_JOINT2_L.
-	FVector BONE_RING_JOINT2_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.ring.joint2, HMD->GetWorldToMetersScale());
-	BONE_RING_JOINT2_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_RING_JOINT2_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_RING_JOINT1_L_Pos, BONE_RING_JOINT2_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT2_L]->SetPosition(BONE_RING_JOINT2_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT2_L]->SetRotation(BONE_RING_JOINT2_L_Rot);
-
-	// Left arm ring joint3 bone - BONE_RING_JOINT3_L.
-	FVector BONE_RING_JOINT3_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.ring.joint3, HMD->GetWorldToMetersScale());
-	BONE_RING_JOINT3_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_RING_JOINT3_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_RING_JOINT2_L_Pos, BONE_RING_JOINT3_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT3_L]->SetPosition(BONE_RING_JOINT3_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT3_L]->SetRotation(BONE_RING_JOINT3_L_Rot);
-
-	// Left arm ring tip bone - BONE_RING_TIP_L.
-	FVector BONE_RING_TIP_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.ring.tip, HMD->GetWorldToMetersScale());
-	BONE_RING_TIP_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_RING_TIP_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_RING_JOINT3_L_Pos, BONE_RING_TIP_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_TIP_L]->SetPosition(BONE_RING_TIP_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_TIP_L]->SetRotation(BONE_RING_TIP_L_Rot);
-
-	// Left arm pinky joint1 bone - BONE_PINKY_JOINT1_L.
-	FVector BONE_PINKY_JOINT1_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.pinky.joint1, HMD->GetWorldToMetersScale());
-	BONE_PINKY_JOINT1_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_PINKY_JOINT1_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_L_Pos, BONE_PINKY_JOINT1_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT1_L]->SetPosition(BONE_PINKY_JOINT1_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT1_L]->SetRotation(BONE_PINKY_JOINT1_L_Rot);
-
-	// Left arm pinky joint2 bone - BONE_PINKY_JOINT2_L.
-	FVector BONE_PINKY_JOINT2_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.pinky.joint2, HMD->GetWorldToMetersScale());
-	BONE_PINKY_JOINT2_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_PINKY_JOINT2_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_PINKY_JOINT1_L_Pos, BONE_PINKY_JOINT2_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT2_L]->SetPosition(BONE_PINKY_JOINT2_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT2_L]->SetRotation(BONE_PINKY_JOINT2_L_Rot);
-
-	// Left arm pinky joint3 bone - BONE_PINKY_JOINT3_L.
-	FVector BONE_PINKY_JOINT3_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.pinky.joint3, HMD->GetWorldToMetersScale());
-	BONE_PINKY_JOINT3_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_PINKY_JOINT3_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_PINKY_JOINT2_L_Pos, BONE_PINKY_JOINT3_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT3_L]->SetPosition(BONE_PINKY_JOINT3_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT3_L]->SetRotation(BONE_PINKY_JOINT3_L_Rot);
-
-	// Left arm pinky tip bone - BONE_PINKY_TIP_L.
-	FVector BONE_PINKY_TIP_L_Pos = CoordinateUtil::GetVector3(handSkeletonData.left.pinky.tip, HMD->GetWorldToMetersScale());
-	BONE_PINKY_TIP_L_Pos += BONE_OFFSET_L;
-	FRotator BONE_PINKY_TIP_L_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_PINKY_JOINT3_L_Pos, BONE_PINKY_TIP_L_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_TIP_L]->SetPosition(BONE_PINKY_TIP_L_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_TIP_L]->SetRotation(BONE_PINKY_TIP_L_Rot);
-
-}
-
-void FWaveVRGestureInputDevice::UpdateRightHandTrackingData()
-{
-	if (Skeleton == nullptr) return;
-
-	FWaveVRHMD* HMD = GetWaveVRHMD();
-	if (HMD == nullptr) return;
-
-	for (int i = (int32)EWaveVRGestureBoneType::BONE_UPPERARM_R; i < (int32)EWaveVRGestureBoneType::BONES_COUNT; i++)
-	{
-		Skeleton->Bones[i]->SetPoseValid(handSkeletonData.right.wrist.isValidPose);
-		Skeleton->Bones[i]->SetConfidence(handSkeletonData.right.confidence);
-	}
-
-	// Right arm wrist - BONE_HAND_WRIST_R.
-	FVector BONE_HAND_WRIST_R_Pos = FVector::ZeroVector;
-	FQuat BONE_HAND_WRIST_R_Quat = FQuat::Identity;
-	CoordinateUtil::MatrixToPose(handSkeletonData.right.wrist.poseMatrix, BONE_HAND_WRIST_R_Quat, BONE_HAND_WRIST_R_Pos, HMD->GetWorldToMetersScale());
-
-	BONE_HAND_WRIST_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_HAND_WRIST_R_Rot = BONE_HAND_WRIST_R_Quat.Rotator();
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_HAND_WRIST_R]->SetPosition(BONE_HAND_WRIST_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_HAND_WRIST_R]->SetRotation(BONE_HAND_WRIST_R_Rot);
-
-	// Right arm thumb joint1 bone - BONE_THUMB_JOINT1_R.
-	FVector BONE_THUMB_JOINT1_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.thumb.joint1, HMD->GetWorldToMetersScale());
-	BONE_THUMB_JOINT1_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_THUMB_JOINT1_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_R_Pos, BONE_THUMB_JOINT1_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT1_R]->SetPosition(BONE_THUMB_JOINT1_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT1_R]->SetRotation(BONE_THUMB_JOINT1_R_Rot);
-
-	// Right arm thumb joint2 bone - BONE_THUMB_JOINT2_R.
-	FVector BONE_THUMB_JOINT2_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.thumb.joint2, HMD->GetWorldToMetersScale());
-	BONE_THUMB_JOINT2_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_THUMB_JOINT2_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_R_Pos, BONE_THUMB_JOINT2_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT2_R]->SetPosition(BONE_THUMB_JOINT2_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT2_R]->SetRotation(BONE_THUMB_JOINT2_R_Rot);
-
-	// Right arm thumb joint2 bone - BONE_THUMB_JOINT3_R.
-	FVector BONE_THUMB_JOINT3_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.thumb.joint3, HMD->GetWorldToMetersScale());
-	BONE_THUMB_JOINT3_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_THUMB_JOINT3_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_THUMB_JOINT2_R_Pos, BONE_THUMB_JOINT3_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT3_R]->SetPosition(BONE_THUMB_JOINT3_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT3_R]->SetRotation(BONE_THUMB_JOINT3_R_Rot);
-
-	// Right arm thumb tip bone - BONE_THUMB_TIP_R.
-	FVector BONE_THUMB_TIP_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.thumb.tip, HMD->GetWorldToMetersScale());
-	BONE_THUMB_TIP_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_THUMB_TIP_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_THUMB_JOINT3_R_Pos, BONE_THUMB_TIP_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_TIP_R]->SetPosition(BONE_THUMB_TIP_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_THUMB_TIP_R]->SetRotation(BONE_THUMB_TIP_R_Rot);
-
-	// Right arm index joint1 bone - BONE_INDEX_JOINT1_R.
-	FVector BONE_INDEX_JOINT1_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.index.joint1, HMD->GetWorldToMetersScale());
-	BONE_INDEX_JOINT1_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_INDEX_JOINT1_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_R_Pos, BONE_INDEX_JOINT1_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT1_R]->SetPosition(BONE_INDEX_JOINT1_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT1_R]->SetRotation(BONE_INDEX_JOINT1_R_Rot);
-
-	// Right arm index joint2 bone - BONE_INDEX_JOINT2_R.
-	FVector BONE_INDEX_JOINT2_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.index.joint2, HMD->GetWorldToMetersScale());
-	BONE_INDEX_JOINT2_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_INDEX_JOINT2_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_INDEX_JOINT1_R_Pos, BONE_INDEX_JOINT2_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT2_R]->SetPosition(BONE_INDEX_JOINT2_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT2_R]->SetRotation(BONE_INDEX_JOINT2_R_Rot);
-
-	// Right arm index joint3 bone - BONE_INDEX_JOINT3_R.
-	FVector BONE_INDEX_JOINT3_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.index.joint3, HMD->GetWorldToMetersScale());
-	BONE_INDEX_JOINT3_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_INDEX_JOINT3_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_INDEX_JOINT2_R_Pos, BONE_INDEX_JOINT3_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT3_R]->SetPosition(BONE_INDEX_JOINT3_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_JOINT3_R]->SetRotation(BONE_INDEX_JOINT3_R_Rot);
-
-	// Right arm index tip bone - BONE_INDEX_TIP_R.
-	FVector BONE_INDEX_TIP_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.index.tip, HMD->GetWorldToMetersScale());
-	BONE_INDEX_TIP_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_INDEX_TIP_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_INDEX_JOINT3_R_Pos, BONE_INDEX_TIP_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_TIP_R]->SetPosition(BONE_INDEX_TIP_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_INDEX_TIP_R]->SetRotation(BONE_INDEX_TIP_R_Rot);
-
-	// Right arm middle joint1 bone - BONE_MIDDLE_JOINT1_R.
-	FVector BONE_MIDDLE_JOINT1_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.middle.joint1, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_JOINT1_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_MIDDLE_JOINT1_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_R_Pos, BONE_MIDDLE_JOINT1_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT1_R]->SetPosition(BONE_MIDDLE_JOINT1_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT1_R]->SetRotation(BONE_MIDDLE_JOINT1_R_Rot);
-
-	// Right arm middle joint2 bone - BONE_MIDDLE_JOINT2_R.
-	FVector BONE_MIDDLE_JOINT2_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.middle.joint2, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_JOINT2_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_MIDDLE_JOINT2_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_MIDDLE_JOINT1_R_Pos, BONE_MIDDLE_JOINT2_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT2_R]->SetPosition(BONE_MIDDLE_JOINT2_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT2_R]->SetRotation(BONE_MIDDLE_JOINT2_R_Rot);
-
-	// Right arm middle joint3 bone - BONE_MIDDLE_JOINT3_R.
-	FVector BONE_MIDDLE_JOINT3_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.middle.joint3, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_JOINT3_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_MIDDLE_JOINT3_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_MIDDLE_JOINT2_R_Pos, BONE_MIDDLE_JOINT3_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT3_R]->SetPosition(BONE_MIDDLE_JOINT3_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_JOINT3_R]->SetRotation(BONE_MIDDLE_JOINT3_R_Rot);
-
-	// Right arm middle tip bone - BONE_MIDDLE_TIP_R.
-	FVector BONE_MIDDLE_TIP_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.middle.tip, HMD->GetWorldToMetersScale());
-	BONE_MIDDLE_TIP_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_MIDDLE_TIP_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_MIDDLE_JOINT3_R_Pos, BONE_MIDDLE_TIP_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_TIP_R]->SetPosition(BONE_MIDDLE_TIP_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_MIDDLE_TIP_R]->SetRotation(BONE_MIDDLE_TIP_R_Rot);
-
-	// Right arm ring joint1 bone - BONE_RING_JOINT1_R.
-	FVector BONE_RING_JOINT1_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.ring.joint1, HMD->GetWorldToMetersScale());
-	BONE_RING_JOINT1_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_RING_JOINT1_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_R_Pos, BONE_RING_JOINT1_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT1_R]->SetPosition(BONE_RING_JOINT1_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT1_R]->SetRotation(BONE_RING_JOINT1_R_Rot);
-
-	// Right arm ring joint2 bone - BONE_RING_JOINT2_R.
-	FVector BONE_RING_JOINT2_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.ring.joint2, HMD->GetWorldToMetersScale());
-	BONE_RING_JOINT2_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_RING_JOINT2_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_RING_JOINT1_R_Pos, BONE_RING_JOINT2_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT2_R]->SetPosition(BONE_RING_JOINT2_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT2_R]->SetRotation(BONE_RING_JOINT2_R_Rot);
-
-	// Right arm ring joint3 bone - BONE_RING_JOINT3_R.
-	FVector BONE_RING_JOINT3_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.ring.joint3, HMD->GetWorldToMetersScale());
-	BONE_RING_JOINT3_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_RING_JOINT3_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_RING_JOINT2_R_Pos, BONE_RING_JOINT3_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT3_R]->SetPosition(BONE_RING_JOINT3_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_JOINT3_R]->SetRotation(BONE_RING_JOINT3_R_Rot);
-
-	// Right arm ring tip bone - BONE_RING_TIP_R.
-	FVector BONE_RING_TIP_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.ring.tip, HMD->GetWorldToMetersScale());
-	BONE_RING_TIP_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_RING_TIP_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_RING_JOINT3_R_Pos, BONE_RING_TIP_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_TIP_R]->SetPosition(BONE_RING_TIP_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_RING_TIP_R]->SetRotation(BONE_RING_TIP_R_Rot);
-
-	// Right arm pinky joint1 bone - BONE_PINKY_JOINT1_R.
-	FVector BONE_PINKY_JOINT1_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.pinky.joint1, HMD->GetWorldToMetersScale());
-	BONE_PINKY_JOINT1_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_PINKY_JOINT1_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_HAND_WRIST_R_Pos, BONE_PINKY_JOINT1_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT1_R]->SetPosition(BONE_PINKY_JOINT1_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT1_R]->SetRotation(BONE_PINKY_JOINT1_R_Rot);
-
-	// Right arm pinky joint2 bone - BONE_PINKY_JOINT2_R.
-	FVector BONE_PINKY_JOINT2_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.pinky.joint2, HMD->GetWorldToMetersScale());
-	BONE_PINKY_JOINT2_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_PINKY_JOINT2_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_PINKY_JOINT1_R_Pos, BONE_PINKY_JOINT2_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT2_R]->SetPosition(BONE_PINKY_JOINT2_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT2_R]->SetRotation(BONE_PINKY_JOINT2_R_Rot);
-
-	// Right arm pinky joint3 bone - BONE_PINKY_JOINT3_R.
-	FVector BONE_PINKY_JOINT3_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.pinky.joint3, HMD->GetWorldToMetersScale());
-	BONE_PINKY_JOINT3_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_PINKY_JOINT3_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_PINKY_JOINT2_R_Pos, BONE_PINKY_JOINT3_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT3_R]->SetPosition(BONE_PINKY_JOINT3_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_JOINT3_R]->SetRotation(BONE_PINKY_JOINT3_R_Rot);
-
-	// Right arm pinky tip bone - BONE_PINKY_TIP_R.
-	FVector BONE_PINKY_TIP_R_Pos = CoordinateUtil::GetVector3(handSkeletonData.right.pinky.tip, HMD->GetWorldToMetersScale());
-	BONE_PINKY_TIP_R_Pos += BONE_OFFSET_R;
-	FRotator BONE_PINKY_TIP_R_Rot = UKismetMathLibrary::FindLookAtRotation(BONE_PINKY_JOINT3_R_Pos, BONE_PINKY_TIP_R_Pos);
-
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_TIP_R]->SetPosition(BONE_PINKY_TIP_R_Pos);
-	Skeleton->Bones[(int32)EWaveVRGestureBoneType::BONE_PINKY_TIP_R]->SetRotation(BONE_PINKY_TIP_R_Rot);
-
-}
-#pragma endregion Hand Skeleton
-
 #pragma region
 void FWaveVRGestureInputDevice::UpdateLeftHandGestureData()
 {
@@ -13,139 +13,12 @@
 #include "WaveVRGestureEnums.h"
 #include "WaveVRGestureUtils.h"
 #include "FWaveVRGestureThread.h"
+#include "WaveVRHandSkeleton.h"
 
 #include "GenericPlatform/IInputInterface.h"
-#include "Runtime/Engine/Classes/Kismet/KismetMathLibrary.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogWaveVRGestureInputDevice, Log, All);
 
-struct WaveVRGestureBoneData
-{
-	FVector Position;
-	FRotator Rotation;
-	bool Valid;
-	float Confidence;
-
-	WaveVRGestureBoneData()
-		: Position(FVector::ZeroVector)
-		, Rotation(FRotator::ZeroRotator)
-		, Valid(false)
-		, Confidence(false)
-	{
-	}
-};
-
-class WaveVRGestureBone
-{
-public:
-	FString Name;
-	WaveVRGestureBoneData BoneData;
-
-	FVector GetPosition() { return BoneData.Position; }
-	void SetPosition(const FVector& InPosition) { BoneData.Position = InPosition; }
-	FRotator GetRotation() { return BoneData.Rotation; }
-	void SetRotation(const FRotator& InRotation) { BoneData.Rotation = InRotation; }
-	bool IsValidPose() { return BoneData.Valid; }
-	void SetPoseValid(const bool& InValid) { BoneData.Valid = InValid; }
-	float GetConfidence() { return BoneData.Confidence; }
-	void SetConfidence(const float& InConfidence) { BoneData.Confidence = InConfidence; }
-
-	WaveVRGestureBone(const FString BoneName) {
-		Name = BoneName;
-	}
-};
-
-class WaveVRGestureFinger
-{
-public:
-	FString Name;
-	WaveVRGestureBone* Joint1;
-	WaveVRGestureBone* Joint2;
-	WaveVRGestureBone* Joint3;
-	WaveVRGestureBone* Tip;
-
-	WaveVRGestureFinger(const FString FingerName) {
-		Name = FingerName;
-		FString BoneName;
-		BoneName = FingerName + FString("_Joint1");
-		Joint1 = new WaveVRGestureBone(BoneName);
-		BoneName = FingerName + FString("_Joint2");
-		Joint2 = new WaveVRGestureBone(BoneName);
-		BoneName = FingerName + FString("_Joint3");
-		Joint3 = new WaveVRGestureBone(BoneName);
-		BoneName = FingerName + FString("_Tip");
-		Tip = new WaveVRGestureBone(BoneName);
-	}
-};
-
-class WaveVRGestureHand
-{
-public:
-	FString Name;
-	WaveVRGestureBone* Wrist;
-	WaveVRGestureBone* Palm;
-	WaveVRGestureFinger* Thumb;
-	WaveVRGestureFinger* Index;
-	WaveVRGestureFinger* Middle;
-	WaveVRGestureFinger* Ring;
-	WaveVRGestureFinger* Pinky;
-
-	WaveVRGestureHand(const FString HandName) {
-		Name = HandName;
-		FString BoneName;
-		BoneName = HandName + FString("_Wrist");
-		Wrist = new WaveVRGestureBone(BoneName);
-		BoneName = HandName + FString("_Palm");
-		Palm = new WaveVRGestureBone(BoneName);
-		FString FingerName;
-		FingerName = HandName + FString("_Thumb");
-		Thumb = new WaveVRGestureFinger(FingerName);
-		FingerName = HandName + FString("_Index");
-		Index = new WaveVRGestureFinger(FingerName);
-		FingerName = HandName + FString("_Middle");
-		Middle = new WaveVRGestureFinger(FingerName);
-		FingerName = HandName + FString("_Ring");
-		Ring = new WaveVRGestureFinger(FingerName);
-		FingerName = HandName + FString("_Pinky");
-		Pinky = new WaveVRGestureFinger(FingerName);
-	}
-};
-
-class WaveVRGestureArm
-{
-public:
-	FString Name;
-	WaveVRGestureHand* Hand;
-	WaveVRGestureBone* ForeArm;
-	WaveVRGestureBone* UpperArm;
-
-	WaveVRGestureArm(const FString ArmName) {
-		Name = ArmName;
-		FString HandName = ArmName + FString("_Hand");
-		Hand = new WaveVRGestureHand(HandName);
-		FString BoneName;
-		BoneName = ArmName + FString("_ForeArm");
-		ForeArm = new WaveVRGestureBone(BoneName);
-		BoneName = ArmName + FString("_UpperArm");
-		UpperArm = new WaveVRGestureBone(BoneName);
-	}
-};
-
-class WaveVRGestureSkeleton
-{
-public:
-	TArray<WaveVRGestureBone*> Bones;
-
-	WaveVRGestureSkeleton() {
-		for (int i = 0; i < (int32)EWaveVRGestureBoneType::BONES_COUNT; i++)
-		{
-			const FString BoneName = FWaveVRGestureUtils::EnumToString(TEXT("EWaveVRGestureBoneType"), (EWaveVRGestureBoneType)i);
-			WaveVRGestureBone* Bone = new WaveVRGestureBone(BoneName);
-			Bones.Add(Bone);
-		}
-	}
-};
-
 class FWaveVRGestureInputDevice : public IInputDevice
 {
 	FWaveVRHMD* GetWaveVRHMD() const {
@@ -192,6 +65,9 @@ public:
 	void StopHandTracking();
 	bool IsHandTrackingAvailable();
 	bool GetBonePositionAndRotation(int32 DevId, EWaveVRGestureBoneType BoneId, FVector& OutPosition, FRotator& OutRotation);
+	bool GetHandBonePoses(EWaveVRGestureHandType hand, TArray<FVector>& OutPositions, TArray<FRotator>& OutRotations);
+	// Only valid if the hand tracking data is updated in this frame.
+	const FWaveVRHandSkeleton* GetSkeleton() const { return bHandTrackingDataUpdated ? &Skeleton : nullptr; }
 	EWaveVRHandTrackingStatus GetHandTrackingStatus();
 	float GetHandConfidence(EWaveVRGestureHandType hand);
 	float GetHandPinchStrength(EWaveVRGestureHandType hand);
@@ -200,7 +76,7 @@ public:
 
 private:
 	int32 DeviceIndex;
-	class WaveVRGestureSkeleton* Skeleton;
+	FWaveVRHandSkeleton Skeleton;
 
 	bool bGestureInputDeviceInitialized;
 
@@ -213,11 +89,9 @@ private:
 
 	WVR_HandSkeletonData handSkeletonData;
 	bool bHandTrackingDataUpdated;
-	void UpdateLeftHandTrackingData();
-	void UpdateRightHandTrackingData();
 	WVR_HandPoseData handPoseData;
-	void UpdateLeftHandPoseData();
-	void UpdateRightHandPoseData();
+	void UpdateLeftHandPoseData(float worldToMeters);
+	void UpdateRightHandPoseData(float worldToMeters);
 
 	float pinchStrengthLeft, pinchStrengthRight;
 	FVector pinchOriginLeft, pinchOriginRight;
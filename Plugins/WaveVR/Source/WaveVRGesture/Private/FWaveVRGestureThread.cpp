@@ -17,10 +17,9 @@ FWaveVRGestureThread* FWaveVRGestureThread::Runnable = NULL;
 //***********************************************************
 
 FWaveVRGestureThread::FWaveVRGestureThread()
-	: shutDownThread(false)
-	, getSupportedFeature(false)
-	, handGestureStatus(EWaveVRHandGestureStatus::UNSUPPORT)
-	, handTrackingStatus(EWaveVRHandTrackingStatus::UNSUPPORT)
+	: wakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, handGestureStatus((int32)EWaveVRHandGestureStatus::UNSUPPORT)
+	, handTrackingStatus((int32)EWaveVRHandTrackingStatus::UNSUPPORT)
 {
 	Thread = FRunnableThread::Create(this, TEXT("FWaveVRGestureThread"));
 }
@@ -29,6 +28,8 @@ FWaveVRGestureThread::~FWaveVRGestureThread()
 {
 	delete Thread;
 	Thread = NULL;
+	FPlatformProcess::ReturnSynchEventToPool(wakeEvent);
+	wakeEvent = nullptr;
 }
 
 //Init
@@ -43,82 +44,102 @@ uint32 FWaveVRGestureThread::Run()
 	//Initial wait before starting
 	FPlatformProcess::Sleep(0.03);
 
-	while (!shutDownThread)
-	{
-		if (!getSupportedFeature)
-		{
-			uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
-			if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_HandGesture) != 0)
-				handGestureStatus = EWaveVRHandGestureStatus::NOT_START;
-			if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_HandTracking) != 0)
-				handTrackingStatus = EWaveVRHandTrackingStatus::NOT_START;
-
-			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() supportedFeatures %d, handGestureStatus %d, handTrackingStatus %d"), (int)supportedFeatures, (int)handGestureStatus, (int)handTrackingStatus);
-			getSupportedFeature = true;
-		}
+	uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
+	if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_HandGesture) != 0)
+		SetHandGestureStatus(EWaveVRHandGestureStatus::NOT_START);
+	if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_HandTracking) != 0)
+		SetHandTrackingStatus(EWaveVRHandTrackingStatus::NOT_START);
+	UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() supportedFeatures %d, handGestureStatus %d, handTrackingStatus %d"), (int)supportedFeatures, (int)GetHandGestureStatus(), (int)GetHandTrackingStatus());
 
-		bool has_action = qActions.Dequeue(action);
-		if (has_action)
+	while (StopTaskCounter.GetValue() == 0)
+	{
+		FRequest request;
+		while (StopTaskCounter.GetValue() == 0 && qActions.Dequeue(request))
 		{
-			m_mutex.Lock();
-			switch (action)
+			bool result = DoAction(request.action);
+			float latency = (float)((FPlatformTime::Seconds() - request.queuedTime) * 1000.0);
 			{
-			case Actions::StartGesture:
-				if (handGestureStatus == EWaveVRHandGestureStatus::NOT_START ||
-					handGestureStatus == EWaveVRHandGestureStatus::START_FAILURE)
-				{
-					handGestureStatus = EWaveVRHandGestureStatus::STARTING;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand gesture."));
-					WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartHandGesture();
-					handGestureStatus = result == WVR_Result::WVR_Success ? EWaveVRHandGestureStatus::AVAILABLE : EWaveVRHandGestureStatus::START_FAILURE;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand gesture result: %d"), (uint8)result);
-				}
-				break;
-			case Actions::StopGesture:
-				if (handGestureStatus == EWaveVRHandGestureStatus::AVAILABLE)
-				{
-					handGestureStatus = EWaveVRHandGestureStatus::STOPING;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Stop hand gesture."));
-					FWaveVRAPIWrapper::GetInstance()->StopHandGesture();
-					handGestureStatus = EWaveVRHandGestureStatus::NOT_START;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Hand gesture stopped."));
-				}
-				break;
-			case Actions::StartTracking:
-				if (handTrackingStatus == EWaveVRHandTrackingStatus::NOT_START ||
-					handTrackingStatus == EWaveVRHandTrackingStatus::START_FAILURE)
-				{
-					handTrackingStatus = EWaveVRHandTrackingStatus::STARTING;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand tracking."));
-					WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartHandTracking();
-					handTrackingStatus = result == WVR_Result::WVR_Success ? EWaveVRHandTrackingStatus::AVAILABLE : EWaveVRHandTrackingStatus::START_FAILURE;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand tracking result: %d"), (uint8)result);
-				}
-				break;
-			case Actions::StopTracking:
-				if (handTrackingStatus == EWaveVRHandTrackingStatus::AVAILABLE)
-				{
-					handTrackingStatus = EWaveVRHandTrackingStatus::STOPING;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Stop hand tracking."));
-					FWaveVRAPIWrapper::GetInstance()->StopHandTracking();
-					handTrackingStatus = EWaveVRHandTrackingStatus::NOT_START;
-					UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Hand tracking stopped."));
-				}
-				break;
-			default:
-				break;
+				FScopeLock lock(&m_mutex);
+				FActionStats& stats = actionStats[request.action];
+				stats.count++;
+				stats.last = latency;
+				stats.max = FMath::Max(stats.max, latency);
+				stats.total += latency;
 			}
-			m_mutex.Unlock();
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() action %d result %d, %.2f ms"), (int)request.action, (int)result, latency);
+			request.promise->SetValue(result);
 		}
-		FPlatformProcess::Sleep(0.1);
+
+		// Sleep until an action is queued or Stop().
+		if (StopTaskCounter.GetValue() == 0)
+			wakeEvent->Wait();
 	}
 
+	// Not done.  Let the waiters go.
+	FRequest request;
+	while (qActions.Dequeue(request))
+		request.promise->SetValue(false);
+
 	return 0;
 }
 
+bool FWaveVRGestureThread::DoAction(Actions InAction)
+{
+	switch (InAction)
+	{
+	case Actions::StartGesture:
+		if (GetHandGestureStatus() == EWaveVRHandGestureStatus::NOT_START ||
+			GetHandGestureStatus() == EWaveVRHandGestureStatus::START_FAILURE)
+		{
+			SetHandGestureStatus(EWaveVRHandGestureStatus::STARTING);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand gesture."));
+			WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartHandGesture();
+			SetHandGestureStatus(result == WVR_Result::WVR_Success ? EWaveVRHandGestureStatus::AVAILABLE : EWaveVRHandGestureStatus::START_FAILURE);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand gesture result: %d"), (uint8)result);
+		}
+		return GetHandGestureStatus() == EWaveVRHandGestureStatus::AVAILABLE;
+	case Actions::StopGesture:
+		if (GetHandGestureStatus() == EWaveVRHandGestureStatus::AVAILABLE)
+		{
+			SetHandGestureStatus(EWaveVRHandGestureStatus::STOPING);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Stop hand gesture."));
+			FWaveVRAPIWrapper::GetInstance()->StopHandGesture();
+			SetHandGestureStatus(EWaveVRHandGestureStatus::NOT_START);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Hand gesture stopped."));
+		}
+		return GetHandGestureStatus() != EWaveVRHandGestureStatus::AVAILABLE;
+	case Actions::StartTracking:
+		if (GetHandTrackingStatus() == EWaveVRHandTrackingStatus::NOT_START ||
+			GetHandTrackingStatus() == EWaveVRHandTrackingStatus::START_FAILURE)
+		{
+			SetHandTrackingStatus(EWaveVRHandTrackingStatus::STARTING);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand tracking."));
+			WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartHandTracking();
+			SetHandTrackingStatus(result == WVR_Result::WVR_Success ? EWaveVRHandTrackingStatus::AVAILABLE : EWaveVRHandTrackingStatus::START_FAILURE);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Start hand tracking result: %d"), (uint8)result);
+		}
+		return GetHandTrackingStatus() == EWaveVRHandTrackingStatus::AVAILABLE;
+	case Actions::StopTracking:
+		if (GetHandTrackingStatus() == EWaveVRHandTrackingStatus::AVAILABLE)
+		{
+			SetHandTrackingStatus(EWaveVRHandTrackingStatus::STOPING);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Stop hand tracking."));
+			FWaveVRAPIWrapper::GetInstance()->StopHandTracking();
+			SetHandTrackingStatus(EWaveVRHandTrackingStatus::NOT_START);
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("Run() Hand tracking stopped."));
+		}
+		return GetHandTrackingStatus() != EWaveVRHandTrackingStatus::AVAILABLE;
+	default:
+		break;
+	}
+	return false;
+}
+
 //stop
 void FWaveVRGestureThread::Stop()
 {
+	StopTaskCounter.Increment();
+	wakeEvent->Trigger();
 }
 
 FWaveVRGestureThread* FWaveVRGestureThread::JoyInit()
@@ -135,9 +156,9 @@ FWaveVRGestureThread* FWaveVRGestureThread::JoyInit()
 
 void FWaveVRGestureThread::EnsureCompletion()
 {
-	shutDownThread = true;
 	Stop();
 	Thread->WaitForCompletion();
+	LogActionStats();
 }
 
 void FWaveVRGestureThread::Shutdown()
@@ -150,34 +171,64 @@ void FWaveVRGestureThread::Shutdown()
 	}
 }
 
-void FWaveVRGestureThread::StartHandGesture()
+TFuture<bool> FWaveVRGestureThread::Enqueue(Actions InAction)
+{
+	FRequest request;
+	request.action = InAction;
+	request.queuedTime = FPlatformTime::Seconds();
+	request.promise = MakeShared<TPromise<bool>, ESPMode::ThreadSafe>();
+	TFuture<bool> future = request.promise->GetFuture();
+
+	qActions.Enqueue(MoveTemp(request));
+	wakeEvent->Trigger();
+	return future;
+}
+
+FWaveVRGestureThread::FActionStats FWaveVRGestureThread::GetActionStats(Actions InAction)
+{
+	FScopeLock lock(&m_mutex);
+	return actionStats[InAction];
+}
+
+void FWaveVRGestureThread::LogActionStats()
+{
+	FScopeLock lock(&m_mutex);
+	for (int32 i = Actions::StartGesture; i < Actions::ActionCount; i++)
+	{
+		const FActionStats& stats = actionStats[i];
+		if (stats.count > 0)
+			UE_LOG(LogWaveVRGestureThread, Log, TEXT("action %d: count %u, avg %.2f ms, max %.2f ms"), i, stats.count, stats.GetAverage(), stats.max);
+	}
+}
+
+TFuture<bool> FWaveVRGestureThread::StartHandGesture()
 {
-	qActions.Enqueue(Actions::StartGesture);
+	return Enqueue(Actions::StartGesture);
 }
 
-void FWaveVRGestureThread::StopHandGesture()
+TFuture<bool> FWaveVRGestureThread::StopHandGesture()
 {
-	qActions.Enqueue(Actions::StopGesture);
+	return Enqueue(Actions::StopGesture);
 }
 
-void FWaveVRGestureThread::RestartHandGesture()
+TFuture<bool> FWaveVRGestureThread::RestartHandGesture()
 {
-	qActions.Enqueue(Actions::StopGesture);
-	qActions.Enqueue(Actions::StartGesture);
+	Enqueue(Actions::StopGesture);
+	return Enqueue(Actions::StartGesture);
 }
 
-void FWaveVRGestureThread::StartHandTracking()
+TFuture<bool> FWaveVRGestureThread::StartHandTracking()
 {
-	qActions.Enqueue(Actions::StartTracking);
+	return Enqueue(Actions::StartTracking);
 }
 
-void FWaveVRGestureThread::StopHandTracking()
+TFuture<bool> FWaveVRGestureThread::StopHandTracking()
 {
-	qActions.Enqueue(Actions::StopTracking);
+	return Enqueue(Actions::StopTracking);
 }
 
-void FWaveVRGestureThread::RestartHandTracking()
+TFuture<bool> FWaveVRGestureThread::RestartHandTracking()
 {
-	qActions.Enqueue(Actions::StopTracking);
-	qActions.Enqueue(Actions::StartTracking);
+	Enqueue(Actions::StopTracking);
+	return Enqueue(Actions::StartTracking);
 }
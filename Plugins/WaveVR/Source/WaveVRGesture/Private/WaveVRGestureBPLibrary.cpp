@@ -98,6 +98,14 @@ bool UWaveVRGestureBPLibrary::GetBonePositionAndRotation(EWaveVRGestureBoneType
 	return false;
 }
 
+bool UWaveVRGestureBPLibrary::GetHandBonePoses(EWaveVRGestureHandType hand, TArray<FVector>& OutPositions, TArray<FRotator>& OutRotations)
+{
+	TSharedPtr< class FWaveVRGestureInputDevice > gestureInputDevice = GetGestureDevice();
+	if (gestureInputDevice.IsValid() && gestureInputDevice->IsGestureInputDeviceInitialized())
+		return gestureInputDevice->GetHandBonePoses(hand, OutPositions, OutRotations);
+	return false;
+}
+
 EWaveVRHandTrackingStatus UWaveVRGestureBPLibrary::GetHandTrackingStatus()
 {
 	TSharedPtr< class FWaveVRGestureInputDevice > gestureInputDevice = GetGestureDevice();
@@ -0,0 +1,84 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRHandSkeleton.h"
+#include "WaveVRUtils.h"
+
+using namespace wvr::utils;
+
+static_assert(sizeof(WVR_Vector3f_t) == sizeof(float) * 3, "The joints are read as a float array.");
+static_assert(sizeof(WVR_FingerState_t) == sizeof(WVR_Vector3f_t) * 4, "The joints of a finger should be continuous.");
+static_assert(STRUCT_OFFSET(WVR_HandSkeletonState_t, pinky) - STRUCT_OFFSET(WVR_HandSkeletonState_t, thumb) == sizeof(WVR_FingerState_t) * 4, "The fingers should be continuous.");
+static_assert((int32)EWaveVRGestureBoneType::BONE_PINKY_TIP_L - (int32)EWaveVRGestureBoneType::BONE_THUMB_JOINT1_L + 1 == FWaveVRHandSkeleton::JointCount, "The joints should be continuous in the bone enum.");
+
+#define HAND_BONE(name) ((int32)EWaveVRGestureBoneType::name##_L - (int32)EWaveVRGestureBoneType::BONE_UPPERARM_L)
+
+static const int32 kWrist = HAND_BONE(BONE_HAND_WRIST);
+static const int32 kFirstJoint = HAND_BONE(BONE_THUMB_JOINT1);
+
+// The look at rotation of a joint is from this bone.  The thumb joint2 is from the wrist, as before.
+static const int32 kLookAtFrom[FWaveVRHandSkeleton::JointCount] = {
+	HAND_BONE(BONE_HAND_WRIST),      HAND_BONE(BONE_HAND_WRIST),      HAND_BONE(BONE_THUMB_JOINT2),  HAND_BONE(BONE_THUMB_JOINT3),
+	HAND_BONE(BONE_HAND_WRIST),      HAND_BONE(BONE_INDEX_JOINT1),    HAND_BONE(BONE_INDEX_JOINT2),  HAND_BONE(BONE_INDEX_JOINT3),
+	HAND_BONE(BONE_HAND_WRIST),      HAND_BONE(BONE_MIDDLE_JOINT1),   HAND_BONE(BONE_MIDDLE_JOINT2), HAND_BONE(BONE_MIDDLE_JOINT3),
+	HAND_BONE(BONE_HAND_WRIST),      HAND_BONE(BONE_RING_JOINT1),     HAND_BONE(BONE_RING_JOINT2),   HAND_BONE(BONE_RING_JOINT3),
+	HAND_BONE(BONE_HAND_WRIST),      HAND_BONE(BONE_PINKY_JOINT1),    HAND_BONE(BONE_PINKY_JOINT2),  HAND_BONE(BONE_PINKY_JOINT3),
+};
+
+#undef HAND_BONE
+
+void FWaveVRHandSkeleton::Reset()
+{
+	for (int32 i = 0; i < BoneCount; i++) {
+		Positions[i] = FVector::ZeroVector;
+		Rotations[i] = FRotator::ZeroRotator;
+		Valid[i] = false;
+	}
+	Confidence[0] = Confidence[1] = 0;
+}
+
+void FWaveVRHandSkeleton::ConvertJoints(const WVR_Vector3f_t* src, int32 num, float worldToMeters, const FVector& offset, FVector* dst)
+{
+	const float* in = src->v;
+	for (int32 i = 0; i < num; i++, in += 3) {
+		dst[i].X = -in[2] * worldToMeters + offset.X;
+		dst[i].Y = in[0] * worldToMeters + offset.Y;
+		dst[i].Z = in[1] * worldToMeters + offset.Z;
+	}
+}
+
+void FWaveVRHandSkeleton::UpdateHand(EWaveVRGestureHandType hand, const WVR_HandSkeletonState_t& state, float worldToMeters, const FVector& offset)
+{
+	const int32 base = GetFirstBone(hand);
+	const bool valid = state.wrist.isValidPose;
+
+	for (int32 i = 0; i < HandBoneCount; i++)
+		Valid[base + i] = valid;
+	Confidence[(int32)hand] = state.confidence;
+
+	// Keep the last poses if not valid.
+	if (!valid)
+		return;
+
+	FVector* positions = Positions + base;
+	FRotator* rotations = Rotations + base;
+
+	FQuat wristQuat = FQuat::Identity;
+	FVector wristPos = FVector::ZeroVector;
+	CoordinateUtil::MatrixToPose(state.wrist.poseMatrix, wristQuat, wristPos, worldToMeters);
+	positions[kWrist] = wristPos + offset;
+	rotations[kWrist] = wristQuat.Rotator();
+
+	ConvertJoints(&state.thumb.joint1, JointCount, worldToMeters, offset, positions + kFirstJoint);
+
+	// Same as FindLookAtRotation, which is the rotation of the direction.
+	for (int32 j = 0; j < JointCount; j++)
+		rotations[kFirstJoint + j] = (positions[kFirstJoint + j] - positions[kLookAtFrom[j]]).Rotation();
+}
@@ -0,0 +1,59 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WaveVRGestureEnums.h"
+#include "wvr_hand.h"
+
+/**
+ * Bone poses of both hands in structure of arrays, indexed by EWaveVRGestureBoneType.
+ *
+ * The 20 finger joints of WVR_HandSkeletonState_t are continuous, and in the same order as the
+ * bone enum from THUMB_JOINT1 to PINKY_TIP.  So one hand is converted by a single pass over the
+ * joints, then the look at rotations by a parent table.  Only the wrist has its own rotation.
+ * The upper arm, fore arm and palm are not tracked, and stay at zero.
+ */
+struct FWaveVRHandSkeleton
+{
+	enum
+	{
+		BoneCount = (int32)EWaveVRGestureBoneType::BONES_COUNT,
+		// From the upper arm to the pinky tip.
+		HandBoneCount = (int32)EWaveVRGestureBoneType::BONE_UPPERARM_R - (int32)EWaveVRGestureBoneType::BONE_UPPERARM_L,
+		JointCount = 20,
+	};
+
+	FVector Positions[BoneCount];
+	FRotator Rotations[BoneCount];
+	bool Valid[BoneCount];
+	float Confidence[2];  // Index is EWaveVRGestureHandType
+
+	FWaveVRHandSkeleton() { Reset(); }
+
+	void Reset();
+
+	// worldToMeters is fetched once per frame by the caller.  An invalid wrist invalidates the whole hand.
+	void UpdateHand(EWaveVRGestureHandType hand, const WVR_HandSkeletonState_t& state, float worldToMeters, const FVector& offset);
+
+	// Views of one hand, from the upper arm to the pinky tip.
+	TArrayView<const FVector> GetPositions(EWaveVRGestureHandType hand) const { return TArrayView<const FVector>(Positions + GetFirstBone(hand), HandBoneCount); }
+	TArrayView<const FRotator> GetRotations(EWaveVRGestureHandType hand) const { return TArrayView<const FRotator>(Rotations + GetFirstBone(hand), HandBoneCount); }
+	TArrayView<const bool> GetValids(EWaveVRGestureHandType hand) const { return TArrayView<const bool>(Valid + GetFirstBone(hand), HandBoneCount); }
+
+	static inline int32 GetFirstBone(EWaveVRGestureHandType hand) {
+		return (int32)(hand == EWaveVRGestureHandType::LEFT ? EWaveVRGestureBoneType::BONE_UPPERARM_L : EWaveVRGestureBoneType::BONE_UPPERARM_R);
+	}
+
+	// WVR to Unreal coordinate, scale and offset.  No branch in the loop, so the compiler can vectorize it.
+	// It has no HMD or runtime call, but like the module it is only built for Android and Win64.
+	static void ConvertJoints(const WVR_Vector3f_t* src, int32 num, float worldToMeters, const FVector& offset, FVector* dst);
+};
@@ -12,11 +12,21 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
+#include "HAL/Event.h"
+#include "Async/Future.h"
+#include "Containers/Queue.h"
 #include "WaveVRHMD.h"
 #include "WaveVRGestureEnums.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogWaveVRGestureThread, Log, All);
 
+/**
+ * Start and stop the hand gesture and hand tracking in a worker, because the runtime calls may block.
+ *
+ * The worker sleeps on an event, and wakes up only when an action is queued or at shutdown.  The
+ * status is written by the worker with atomic exchanges, and can be read from any thread.  Each
+ * action gives a future, which is true if the feature is in the requested status after the action.
+ */
 class WAVEVRGESTURE_API FWaveVRGestureThread : public FRunnable
 {
 	/** Singleton instance, can access the thread any time via static accessor, if it is active! */
@@ -28,13 +38,27 @@ class WAVEVRGESTURE_API FWaveVRGestureThread : public FRunnable
 	/** Stop this thread? Uses Thread Safe Counter */
 	FThreadSafeCounter StopTaskCounter;
 
+public:
 	enum Actions
 	{
 		None,
 		StartGesture,
 		StopGesture,
 		StartTracking,
-		StopTracking
+		StopTracking,
+		ActionCount
+	};
+
+	// Latency from queued to done, in ms.
+	struct FActionStats
+	{
+		uint32 count;
+		float last;
+		float max;
+		float total;
+
+		FActionStats() : count(0), last(0), max(0), total(0) {}
+		float GetAverage() const { return count > 0 ? total / count : 0; }
 	};
 
 public:
@@ -66,28 +90,42 @@ public:
 
 
 	// ~~~ WaveVR related components ~~~
-	void StartHandGesture();
-	void StopHandGesture();
-	void RestartHandGesture();
-	bool IsHandGestureAvailable() { return handGestureStatus == EWaveVRHandGestureStatus::AVAILABLE ? true : false; }
-	EWaveVRHandGestureStatus GetHandGestureStatus() { return handGestureStatus; }
-
-	void StartHandTracking();
-	void StopHandTracking();
-	void RestartHandTracking();
-	bool IsHandTrackingAvailable() { return handTrackingStatus == EWaveVRHandTrackingStatus::AVAILABLE ? true : false; }
-	EWaveVRHandTrackingStatus GetHandTrackingStatus() { return handTrackingStatus; }
+	TFuture<bool> StartHandGesture();
+	TFuture<bool> StopHandGesture();
+	TFuture<bool> RestartHandGesture();
+	bool IsHandGestureAvailable() { return GetHandGestureStatus() == EWaveVRHandGestureStatus::AVAILABLE; }
+	EWaveVRHandGestureStatus GetHandGestureStatus() { return (EWaveVRHandGestureStatus)FPlatformAtomics::AtomicRead(&handGestureStatus); }
+
+	TFuture<bool> StartHandTracking();
+	TFuture<bool> StopHandTracking();
+	TFuture<bool> RestartHandTracking();
+	bool IsHandTrackingAvailable() { return GetHandTrackingStatus() == EWaveVRHandTrackingStatus::AVAILABLE; }
+	EWaveVRHandTrackingStatus GetHandTrackingStatus() { return (EWaveVRHandTrackingStatus)FPlatformAtomics::AtomicRead(&handTrackingStatus); }
+
+	FActionStats GetActionStats(Actions InAction);
+	void LogActionStats();
 
 private:
-	FCriticalSection m_mutex;
+	struct FRequest
+	{
+		Actions action;
+		double queuedTime;
+		TSharedPtr<TPromise<bool>, ESPMode::ThreadSafe> promise;
+	};
+
+	TFuture<bool> Enqueue(Actions InAction);
+	bool DoAction(Actions InAction);
+	// Only the worker changes the status.  Return the old status.
+	EWaveVRHandGestureStatus SetHandGestureStatus(EWaveVRHandGestureStatus status) { return (EWaveVRHandGestureStatus)FPlatformAtomics::InterlockedExchange(&handGestureStatus, (int32)status); }
+	EWaveVRHandTrackingStatus SetHandTrackingStatus(EWaveVRHandTrackingStatus status) { return (EWaveVRHandTrackingStatus)FPlatformAtomics::InterlockedExchange(&handTrackingStatus, (int32)status); }
 
+	FCriticalSection m_mutex;  // For the stats
+	FEvent* wakeEvent;
 
 	// ~~~ WaveVR related components ~~~
-	bool shutDownThread;
-	bool getSupportedFeature;
-	volatile EWaveVRHandGestureStatus handGestureStatus;
-	volatile EWaveVRHandTrackingStatus handTrackingStatus;
+	volatile int32 handGestureStatus;  // EWaveVRHandGestureStatus
+	volatile int32 handTrackingStatus;  // EWaveVRHandTrackingStatus
 
-	Actions action = Actions::None;
-	TQueue<Actions> qActions;
+	TQueue<FRequest, EQueueMode::Mpsc> qActions;
+	FActionStats actionStats[ActionCount];
 };
@@ -77,6 +77,12 @@ public:
 		meta = (ToolTip = "If the Hand Tracking component is available, this API is used for getting the bone poses."))
 	static bool GetBonePositionAndRotation(EWaveVRGestureBoneType BoneId, FVector& OutPosition, FRotator& OutRotation);
 
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "WaveVR|Gesture",
+		meta = (ToolTip = "Get all bone poses of a hand at once, from the upper arm to the pinky tip, in the order of EWaveVRGestureBoneType. Return false if the hand is not valid."))
+	static bool GetHandBonePoses(EWaveVRGestureHandType hand, TArray<FVector>& OutPositions, TArray<FRotator>& OutRotations);
+
 	UFUNCTION(
 		BlueprintCallable,
 		Category = "WaveVR|Gesture",
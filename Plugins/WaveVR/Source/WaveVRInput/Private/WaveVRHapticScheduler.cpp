@@ -0,0 +1,266 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRHapticScheduler.h"
+#include "WaveVRPrivatePCH.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(WVRHaptics, Log, All);
+
+static const float kMinAmplitude = 0.05f;  // Lower is off
+static const float kMaxPulsesPerSecond = 20.0f;  // Of frequency 1
+static const double kSegmentSeconds = 0.05;  // Buffer resample
+static const double kPulseSeconds = 0.1;  // Length of a pulse of a curve effect
+static const double kMaxPulseSeconds = 0.25;  // A pulse can not be canceled, so keep it short.
+static const double kRenewSeconds = 0.015;  // Send the next pulse before the previous one ends.
+static const double kLogInterval = 5.0;
+
+FWaveVRHapticScheduler::FController::FController()
+	: sentIntensity((WVR_Intensity)0)
+	, sentPulses(0)
+	, sentTime(0)
+	, sentUntil(0)
+{
+	ClearTarget();
+}
+
+void FWaveVRHapticScheduler::FController::ClearTarget()
+{
+	intensity = (WVR_Intensity)0;
+	frequency = 0;
+	buffer = nullptr;
+	segments.Reset();
+	bufferStartTime = 0;
+	bufferDuration = 0;
+}
+
+FWaveVRHapticScheduler::FWaveVRHapticScheduler()
+	: Thread(nullptr)
+	, wakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, SentCount(0)
+	, SkippedCount(0)
+	, LastLogTime(0)
+{
+}
+
+FWaveVRHapticScheduler::~FWaveVRHapticScheduler()
+{
+	Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(wakeEvent);
+	wakeEvent = nullptr;
+}
+
+void FWaveVRHapticScheduler::Startup()
+{
+	if (Thread != nullptr)
+		return;
+	LOGD(WVRHaptics, "Startup()");
+	StopTaskCounter.Reset();
+	Thread = FRunnableThread::Create(this, TEXT("FWaveVRHapticScheduler"), 0, TPri_AboveNormal);
+}
+
+void FWaveVRHapticScheduler::Shutdown()
+{
+	if (Thread == nullptr)
+		return;
+	LOGD(WVRHaptics, "Shutdown()");
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+}
+
+void FWaveVRHapticScheduler::Stop()
+{
+	StopTaskCounter.Increment();
+	wakeEvent->Trigger();
+}
+
+WVR_Intensity FWaveVRHapticScheduler::ToIntensity(float amplitude)
+{
+	amplitude = FMath::Clamp(amplitude, 0.0f, 1.0f);
+	if (amplitude < kMinAmplitude)
+		return (WVR_Intensity)0;
+	// [Weak, Severe]
+	return (WVR_Intensity)(WVR_Intensity_Weak + FMath::Min(FMath::FloorToInt(amplitude * 5), 4));
+}
+
+uint32 FWaveVRHapticScheduler::ToPulses(float frequency, double duration)
+{
+	// Frequency 0 is one continuous vibration.
+	if (frequency <= 0)
+		return 1;
+	return (uint32)FMath::Max(1, FMath::RoundToInt(duration * FMath::Min(frequency, 1.0f) * kMaxPulsesPerSecond));
+}
+
+void FWaveVRHapticScheduler::Resample(const FHapticFeedbackBuffer& buffer, int32 channel, TArray<FSegment>& outSegments)
+{
+	outSegments.Reset();
+	if (buffer.RawData == nullptr || buffer.BufferLength <= 0 || buffer.SamplingRate <= 0)
+		return;
+
+	// The raw data are 8 bits amplitudes, interleaved if stereo.
+	const int32 stride = buffer.bUseStereo ? 2 : 1;
+	const int32 offset = buffer.bUseStereo ? FMath::Clamp(channel, 0, 1) : 0;
+	const int32 numSamples = buffer.BufferLength / stride;
+	const int32 perSegment = FMath::Max(1, FMath::RoundToInt(buffer.SamplingRate * kSegmentSeconds));
+
+	for (int32 s = 0; s < numSamples; s += perSegment) {
+		const int32 n = FMath::Min(perSegment, numSamples - s);
+		uint32 sum = 0;
+		for (int32 i = 0; i < n; i++)
+			sum += buffer.RawData[(s + i) * stride + offset];
+		const float amplitude = sum / (255.0f * n) * buffer.ScaleFactor;
+		const WVR_Intensity intensity = ToIntensity(amplitude);
+		const double duration = (double)n / buffer.SamplingRate;
+
+		// Merge the same intensity.
+		if (outSegments.Num() > 0 && outSegments.Last().intensity == intensity) {
+			outSegments.Last().duration += duration;
+			continue;
+		}
+		FSegment segment;
+		segment.start = (double)s / buffer.SamplingRate;
+		segment.duration = duration;
+		segment.intensity = intensity;
+		segment.pulses = 1;
+		outSegments.Add(segment);
+	}
+}
+
+void FWaveVRHapticScheduler::SetValues(WVR_DeviceType device, const FHapticFeedbackValues& values)
+{
+	const double now = FPlatformTime::Seconds();
+	FHapticFeedbackBuffer* buffer = values.HapticBuffer;
+	bool bChanged = false;
+	{
+		FScopeLock lock(&Lock);
+		FController& c = Controllers[ToIndex(device)];
+
+		if (buffer != nullptr && buffer->RawData != nullptr && buffer->SamplingRate > 0) {
+			// A new effect starts from CurrentPtr 0, even if the buffer is reused.
+			if (buffer != c.buffer || buffer->CurrentPtr == 0) {
+				c.ClearTarget();
+				c.buffer = buffer;
+				Resample(*buffer, device == WVR_DeviceType_Controller_Left ? 0 : 1, c.segments);
+				c.bufferStartTime = now;
+				if (c.segments.Num() > 0)
+					c.bufferDuration = c.segments.Last().start + c.segments.Last().duration;
+				bChanged = true;
+			}
+
+			// The buffer is played by the time, so report the progress to the engine.
+			const double elapsed = now - c.bufferStartTime;
+			const int32 stride = buffer->bUseStereo ? 2 : 1;
+			const int32 played = FMath::Clamp((int32)(elapsed * buffer->SamplingRate) * stride, 1, FMath::Max(buffer->BufferLength, 1));
+			buffer->CurrentPtr = played;
+			buffer->SamplesSent = played / stride;
+			if (elapsed >= c.bufferDuration)
+				buffer->bFinishedPlaying = true;
+		} else {
+			const WVR_Intensity intensity = ToIntensity(values.Amplitude);
+			if (c.buffer != nullptr || intensity != c.intensity || values.Frequency != c.frequency) {
+				c.ClearTarget();
+				c.intensity = intensity;
+				c.frequency = values.Frequency;
+				bChanged = true;
+			}
+		}
+	}
+
+	if (bChanged)
+		wakeEvent->Trigger();
+}
+
+double FWaveVRHapticScheduler::Update(int32 index, double now)
+{
+	static const auto CVarMinInterval = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("wvr.Haptics.MinIntervalMs"));
+	const double minInterval = (CVarMinInterval != nullptr ? CVarMinInterval->GetValueOnAnyThread() : 50.0f) / 1000.0;
+
+	WVR_Intensity intensity = (WVR_Intensity)0;
+	uint32 pulses = 1;
+	double until = 0;  // End of the current segment
+	double duration = kPulseSeconds;
+	bool bPlayingBuffer = false;  // A segment of a buffer is current, even if it is silent.
+	FController& c = Controllers[index];
+	{
+		FScopeLock lock(&Lock);
+		if (c.segments.Num() > 0) {
+			const double t = now - c.bufferStartTime;
+			const FSegment* current = c.segments.FindByPredicate([t](const FSegment& s) { return t < s.start + s.duration; });
+			if (current == nullptr) {
+				c.segments.Reset();
+			} else {
+				bPlayingBuffer = true;
+				intensity = current->intensity;
+				pulses = current->pulses;
+				until = c.bufferStartTime + current->start + current->duration;
+				duration = FMath::Min(until - now, kMaxPulseSeconds);
+			}
+		} else {
+			intensity = c.intensity;
+			pulses = ToPulses(c.frequency, kPulseSeconds);
+			until = now + kPulseSeconds;
+		}
+	}
+
+	// Off.  The last pulse ends by itself.  A silent segment of a buffer wakes up at its end, as
+	// nothing else will.  Idle only if no buffer is playing.
+	if (intensity == 0) {
+		c.sentIntensity = intensity;
+		return bPlayingBuffer ? until : 0;
+	}
+
+	// Coalesce.  The same vibration is still playing.
+	if (intensity == c.sentIntensity && pulses == c.sentPulses && now < c.sentUntil - kRenewSeconds)
+		return FMath::Min(c.sentUntil - kRenewSeconds, until);
+
+	// Rate limit
+	if (now - c.sentTime < minInterval) {
+		SkippedCount++;
+		return c.sentTime + minInterval;
+	}
+
+	WVR()->TriggerVibration(ToDevice(index), WVR_InputId_Alias1_Touchpad, (uint32)(duration * 1000000), pulses, intensity);
+	c.sentIntensity = intensity;
+	c.sentPulses = pulses;
+	c.sentTime = now;
+	c.sentUntil = now + duration;
+	SentCount++;
+	return FMath::Min(c.sentUntil - kRenewSeconds, until);
+}
+
+uint32 FWaveVRHapticScheduler::Run()
+{
+	while (StopTaskCounter.GetValue() == 0) {
+		const double now = FPlatformTime::Seconds();
+		double next = 0;
+		for (int32 i = 0; i < ControllerCount; i++) {
+			const double t = Update(i, now);
+			if (t > 0)
+				next = next > 0 ? FMath::Min(next, t) : t;
+		}
+
+		if (SentCount > 0 && now - LastLogTime > kLogInterval) {
+			LOGD(WVRHaptics, "Sent %u pulses, skipped %u by the rate limit", SentCount, SkippedCount);
+			SentCount = SkippedCount = 0;
+			LastLogTime = now;
+		}
+
+		// Idle until the game thread sets a target.
+		if (next <= 0)
+			wakeEvent->Wait();
+		else
+			wakeEvent->Wait(FTimespan::FromSeconds(FMath::Max(next - FPlatformTime::Seconds(), 0.001)));
+	}
+	return 0;
+}
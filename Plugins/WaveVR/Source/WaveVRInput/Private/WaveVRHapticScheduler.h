@@ -0,0 +1,101 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/Event.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "GenericPlatform/IInputInterface.h"
+#include "wvr_device.h"
+
+/**
+ * Play the Unreal haptic effects by WVR TriggerVibration pulses.
+ *
+ * The engine calls SetHapticFeedbackValues in every tick while an effect plays.  A curve or a
+ * force feedback effect becomes the current amplitude and frequency of the controller.  A buffer
+ * effect is resampled once into segments of SegmentSeconds, and the same segments are merged.
+ * The amplitude is quantized to WVR_Intensity, so the small changes are not sent.
+ *
+ * A timer thread sends the pulses.  A pulse is only sent when the quantized vibration changes,
+ * or the previous pulse is about to end, and not more often than wvr.Haptics.MinIntervalMs per
+ * controller.  The game thread only updates the targets, and never calls the runtime.
+ */
+class FWaveVRHapticScheduler : public FRunnable
+{
+public:
+	enum { ControllerCount = 2 };  // Index 0 is the right controller, 1 the left.
+
+	struct FSegment
+	{
+		double start;  // Seconds since the buffer started
+		double duration;
+		WVR_Intensity intensity;  // 0 is off
+		uint32 pulses;  // Number of vibrations in the segment
+	};
+
+	FWaveVRHapticScheduler();
+	virtual ~FWaveVRHapticScheduler();
+
+	void Startup();
+	void Shutdown();
+
+	// Game thread.  device is a controller.  A zero amplitude stops the controller.
+	void SetValues(WVR_DeviceType device, const FHapticFeedbackValues& values);
+
+	// Pure conversions.  Amplitude and frequency are in [0, 1].
+	static WVR_Intensity ToIntensity(float amplitude);
+	static uint32 ToPulses(float frequency, double duration);
+	static void Resample(const FHapticFeedbackBuffer& buffer, int32 channel, TArray<FSegment>& outSegments);
+
+	// Begin FRunnable interface.
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+	struct FController
+	{
+		// Target, written in game thread
+		WVR_Intensity intensity;
+		float frequency;
+		const FHapticFeedbackBuffer* buffer;  // Only used to know a new buffer.  Never dereferenced in the timer thread.
+		TArray<FSegment> segments;
+		double bufferStartTime;
+		double bufferDuration;
+
+		// Sent, only used in timer thread
+		WVR_Intensity sentIntensity;
+		uint32 sentPulses;
+		double sentTime;
+		double sentUntil;
+
+		FController();
+		void ClearTarget();
+	};
+
+	static int32 ToIndex(WVR_DeviceType device) { return device == WVR_DeviceType_Controller_Left ? 1 : 0; }
+	static WVR_DeviceType ToDevice(int32 index) { return index == 1 ? WVR_DeviceType_Controller_Left : WVR_DeviceType_Controller_Right; }
+
+	// Timer thread.  Return the time of the next pulse needed, or 0 if idle.
+	double Update(int32 index, double now);
+
+	FCriticalSection Lock;  // Targets of the controllers
+	FController Controllers[ControllerCount];
+
+	FRunnableThread* Thread;
+	FThreadSafeCounter StopTaskCounter;
+	FEvent* wakeEvent;
+
+	uint32 SentCount;
+	uint32 SkippedCount;
+	double LastLogTime;
+};
@@ -224,15 +224,26 @@ FWaveVRInput::FWaveVRInput(WaveVRInputSimulator* simulator, const TSharedRef< FG
 	, MessageHandler(InMessageHandler)
 {
 	IModularFeatures::Get().RegisterModularFeature( GetModularFeatureName(), this );
+	HapticScheduler.Startup();
 
 	for (int i = 0; i < ControllerCount; i++)
 	{
-		for (int j = 0; j < InputButtonCount; j++)
-			PrevPressState[i][j] = false;
-		for (int j = 0; j < TouchButtonCount; j++)
-			PrevTouchState[i][j] = false;
+		PrevPressed[i] = 0;
+		PrevTouched[i] = 0;
 	}
 
+	PressButtonMask = 0;
+	TouchButtonMask = 0;
+	for (int i = 0; i < 32; i++)
+		PressButtonIndex[i] = INDEX_NONE;
+	for (int i = 0; i < InputButtonCount; i++)
+	{
+		PressButtonMask |= FWaveVRInputSnapshot::GetBit((uint8)InputButton[i]);
+		PressButtonIndex[(uint8)InputButton[i]] = i;
+	}
+	for (int i = 0; i < TouchButtonCount; i++)
+		TouchButtonMask |= FWaveVRInputSnapshot::GetBit((uint8)TouchButton[i]);
+
 	int32 right_hand = (int32)EControllerHand::Right;
 	int32 left_hand = (int32)EControllerHand::Left;
 
@@ -465,6 +476,7 @@ FWaveVRInput::FWaveVRInput(WaveVRInputSimulator* simulator, const TSharedRef< FG
 
 FWaveVRInput::~FWaveVRInput()
 {
+	HapticScheduler.Shutdown();
 	IModularFeatures::Get().UnregisterModularFeature( GetModularFeatureName(), this );
 }
 
@@ -480,7 +492,7 @@ void FWaveVRInput::fireButtonPressEvent(FName button_name, bool down)
 		button_name == WaveVRControllerKeyNames::Left_Trigger_Press.GetFName() ||
 		button_name == WaveVRControllerKeyNames::Right_Trigger_Press.GetFName())
 	{
-		LOGD(LogWaveVRInput, "fireButtonPressEvent() button %s is press %s.", TCHAR_TO_ANSI(*button_name.ToString()), (down ? "down" : "up"));
+		TLOGD(LogWaveVRInput, "fireButtonPressEvent() button %s is press %s.", TCHAR_TO_ANSI(*button_name.ToString()), (down ? "down" : "up"));
 	}
 	// ---- Touchpad ----
 	if (button_name == WaveVRControllerKeyNames::Left_Touchpad_Press.GetFName())
@@ -495,7 +507,7 @@ void FWaveVRInput::fireButtonPressEvent(FName button_name, bool down)
 
 void FWaveVRInput::fireAllButtonPressEvent(EControllerHand hand, EWVR_InputId id, bool down)
 {
-	LOGD(LogWaveVRInput, "fireAllButtonPressEvent() hand %d button %d is press %s.", (uint8)hand, (uint8)id, (down ? "down" : "up"));
+	TLOGD(LogWaveVRInput, "fireAllButtonPressEvent() hand %d button %d is press %s.", (uint8)hand, (uint8)id, (down ? "down" : "up"));
 	switch (hand)
 	{
 	case EControllerHand::Right:
@@ -509,149 +521,111 @@ void FWaveVRInput::fireAllButtonPressEvent(EControllerHand hand, EWVR_InputId id
 	}
 }
 
-void FWaveVRInput::UpdateButtonPressStates(EControllerHand hand)
+void FWaveVRInput::UpdateInputSnapshot(EControllerHand hand, FWaveVRInputSnapshot& snapshot)
 {
 	EWVR_DeviceType _device = GetLeftHandedDevice(hand);
 
-	int32 _hand = (int32)hand;
-	bool _curPressState[InputButtonCount] = { false };
-
-	// Get current buttons' states.
-	for (int i = 0; i < InputButtonCount; i++)
+	if (IsPlayInEditor() && !WaveVRDirectPreview::IsDirectPreview())
 	{
-		if (IsPlayInEditor() && !WaveVRDirectPreview::IsDirectPreview())
+		// The simulator has no touch and axis.
+		for (int i = 0; i < InputButtonCount; i++)
 		{
-			_curPressState[i] = pSimulator->IsButtonPressed(_device, InputButton[i]);
-		}
-		else
-		{
-			//_curPressState[i] = UWaveVRController::IsControllerButtonPressed(_device, InputButton[i]);
-			_curPressState[i] = UWaveVREventCommon::IsControllerButtonPressed(_device, InputButton[i]);
+			if (pSimulator->IsButtonPressed(_device, InputButton[i]))
+				snapshot.Pressed |= FWaveVRInputSnapshot::GetBit((uint8)InputButton[i]);
 		}
+		return;
 	}
 
-	// Compare with previous buttons' states.
-	for (int i = 0; i < InputButtonCount; i++)
+	// Buttons are from the events, which are cached by UWaveVREventCommon.
+	snapshot.Pressed = UWaveVREventCommon::GetButtonPressMask(_device);
+	snapshot.Touched = UWaveVREventCommon::GetButtonTouchMask(_device);
+
+	// All axes of the device are read by one call, and only while touched.
+	if (snapshot.Touched & TouchButtonMask)
+		snapshot.Query(_device, WVR_InputType_Analog);
+}
+
+void FWaveVRInput::UpdateButtonPressStates(EControllerHand hand, uint32 pressed)
+{
+	int32 _hand = (int32)hand;
+	uint32 _changed = (pressed ^ PrevPressed[_hand]) & PressButtonMask;
+	PrevPressed[_hand] = pressed;
+
+	// Only the changed bits.
+	while (_changed != 0)
 	{
-		FName button_name = ControllerPressButtons[_hand][i];
+		uint32 id = FMath::CountTrailingZeros(_changed);
+		_changed &= _changed - 1;
 
-		if (_curPressState[i] != PrevPressState[_hand][i])
-		{
-			if (_curPressState[i])
-			{
-				LOGD(LogWaveVRInput, "UpdateButtonPressStates() hand %d device %d button %s is pressed.", _hand, (int32)_device, TCHAR_TO_ANSI(*button_name.ToString()));
-				fireButtonPressEvent(button_name, true);
-				fireAllButtonPressEvent(hand, InputButton[i], true);
-				MessageHandler->OnControllerButtonPressed(button_name, 0, false);
-			}
-			else
-			{
-				LOGD(LogWaveVRInput, "UpdateButtonPressStates() hand %d device %d button %s is released.", _hand, (int32)_device, TCHAR_TO_ANSI(*button_name.ToString()));
-				fireButtonPressEvent(button_name, false);
-				fireAllButtonPressEvent(hand, InputButton[i], false);
-				MessageHandler->OnControllerButtonReleased(button_name, 0, false);
-			}
-		}
+		int32 i = PressButtonIndex[id];
+		bool down = (pressed & FWaveVRInputSnapshot::GetBit(id)) != 0;
+		FName button_name = ControllerPressButtons[_hand][i];
 
-		PrevPressState[_hand][i] = _curPressState[i];
+		TLOGD(LogWaveVRInput, "UpdateButtonPressStates() hand %d button %d is %s.", _hand, id, (down ? "pressed" : "released"));
+		fireButtonPressEvent(button_name, down);
+		fireAllButtonPressEvent(hand, InputButton[i], down);
+		if (down)
+			MessageHandler->OnControllerButtonPressed(button_name, 0, false);
+		else
+			MessageHandler->OnControllerButtonReleased(button_name, 0, false);
 	}
 }
 
-void FWaveVRInput::UpdateButtonTouchStates(EControllerHand hand)
+void FWaveVRInput::UpdateButtonTouchStates(EControllerHand hand, const FWaveVRInputSnapshot& snapshot)
 {
-	EWVR_DeviceType _device = GetLeftHandedDevice(hand);
-
 	int32 _hand = (int32)hand;
-	bool _curTouchState[TouchButtonCount] = { false };
+	uint32 _touched = snapshot.Touched & TouchButtonMask;
+	uint32 _changed = _touched ^ PrevTouched[_hand];
+	PrevTouched[_hand] = _touched;
 
 	for (int i = 0; i < TouchButtonCount; i++)
 	{
-		//_curTouchState[i] = UWaveVRController::IsControllerButtonTouched(_device, TouchButton[i]);
-		if (!IsPlayInEditor() || WaveVRDirectPreview::IsDirectPreview())
+		uint32 bit = FWaveVRInputSnapshot::GetBit((uint8)TouchButton[i]);
+		if (_touched & bit)
 		{
-			_curTouchState[i] = UWaveVREventCommon::IsControllerButtonTouched(_device, TouchButton[i]);
+			SendAxis(hand, TouchButton[i], snapshot.Axis[i]);
 		}
-
-		if (_curTouchState[i])
+		else if (_changed & bit)
 		{
-			FVector2D axis = UWaveVRController::GetControllerAxis(_device, TouchButton[i]);
-			//LOGD(LogWaveVRInput, "UpdateButtonTouchStates() hand %d device %d axis (%f, %f)", _hand, (int32)_device, axis.X, axis.Y);
-			float trigger_axis = 0;
-			switch (TouchButton[i])
-			{
-			case EWVR_TouchId::Touchpad:
-				if (hand == EControllerHand::Right)
-				{
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Touchpad_X.GetFName(), 0, axis.X);
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Touchpad_Y.GetFName(), 0, axis.Y);
-				}
-				if (hand == EControllerHand::Left)
-				{
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Touchpad_X.GetFName(), 0, axis.X);
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Touchpad_Y.GetFName(), 0, axis.Y);
-				}
-				break;
-			case EWVR_TouchId::Trigger:
-				trigger_axis = axis.X < 0 ? -(axis.X) : axis.X;
-				if (hand == EControllerHand::Right)
-				{
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Trigger_X.GetFName(), 0, trigger_axis);
-				}
-				if (hand == EControllerHand::Left)
-				{
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Trigger_X.GetFName(), 0, trigger_axis);
-				}
-				break;
-			case EWVR_TouchId::Thumbstick:
-				if (hand == EControllerHand::Right)
-				{
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Thumbstick_X.GetFName(), 0, axis.X);
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Thumbstick_Y.GetFName(), 0, axis.Y);
-				}
-				if (hand == EControllerHand::Left)
-				{
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Thumbstick_X.GetFName(), 0, axis.X);
-					MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Thumbstick_Y.GetFName(), 0, axis.Y);
-				}
-				break;
-			default:
-				break;
-			}
-		}
-		else
-		{
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Touchpad_X.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Touchpad_Y.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Touchpad_X.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Touchpad_Y.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Trigger_X.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Trigger_X.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Thumbstick_X.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Right_Thumbstick_Y.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Thumbstick_X.GetFName(), 0, 0);
-			MessageHandler->OnControllerAnalog(WaveVRControllerKeyNames::Left_Thumbstick_Y.GetFName(), 0, 0);
+			// Only the axes of this button of this hand are reset, once when untouched.
+			SendAxis(hand, TouchButton[i], FVector2D::ZeroVector);
 		}
 	}
 
 	for (int i = 0; i < TouchButtonCount; i++)
 	{
-		FName button_name = ControllerTouchButtons[_hand][i];
+		uint32 bit = FWaveVRInputSnapshot::GetBit((uint8)TouchButton[i]);
+		if ((_changed & bit) == 0)
+			continue;
 
-		if (_curTouchState[i] != PrevTouchState[_hand][i])
-		{
-			if (_curTouchState[i])
-			{
-				LOGD(LogWaveVRInput, "UpdateButtonTouchStates() hand %d device %d button %s is touched.", _hand, (int32)_device, TCHAR_TO_ANSI(*button_name.ToString()));
-				MessageHandler->OnControllerButtonPressed(button_name, 0, false);
-			}
-			else
-			{
-				LOGD(LogWaveVRInput, "UpdateButtonTouchStates() hand %d device %d button %s is untouched.", _hand, (int32)_device, TCHAR_TO_ANSI(*button_name.ToString()));
-				MessageHandler->OnControllerButtonReleased(button_name, 0, false);
-			}
-		}
+		bool touched = (_touched & bit) != 0;
+		FName button_name = ControllerTouchButtons[_hand][i];
+		TLOGD(LogWaveVRInput, "UpdateButtonTouchStates() hand %d button %d is %s.", _hand, (uint8)TouchButton[i], (touched ? "touched" : "untouched"));
+		if (touched)
+			MessageHandler->OnControllerButtonPressed(button_name, 0, false);
+		else
+			MessageHandler->OnControllerButtonReleased(button_name, 0, false);
+	}
+}
 
-		PrevTouchState[_hand][i] = _curTouchState[i];
+void FWaveVRInput::SendAxis(EControllerHand hand, EWVR_TouchId id, const FVector2D& axis)
+{
+	bool right = hand == EControllerHand::Right;
+	switch (id)
+	{
+	case EWVR_TouchId::Touchpad:
+		MessageHandler->OnControllerAnalog((right ? WaveVRControllerKeyNames::Right_Touchpad_X : WaveVRControllerKeyNames::Left_Touchpad_X).GetFName(), 0, axis.X);
+		MessageHandler->OnControllerAnalog((right ? WaveVRControllerKeyNames::Right_Touchpad_Y : WaveVRControllerKeyNames::Left_Touchpad_Y).GetFName(), 0, axis.Y);
+		break;
+	case EWVR_TouchId::Trigger:
+		MessageHandler->OnControllerAnalog((right ? WaveVRControllerKeyNames::Right_Trigger_X : WaveVRControllerKeyNames::Left_Trigger_X).GetFName(), 0, FMath::Abs(axis.X));
+		break;
+	case EWVR_TouchId::Thumbstick:
+		MessageHandler->OnControllerAnalog((right ? WaveVRControllerKeyNames::Right_Thumbstick_X : WaveVRControllerKeyNames::Left_Thumbstick_X).GetFName(), 0, axis.X);
+		MessageHandler->OnControllerAnalog((right ? WaveVRControllerKeyNames::Right_Thumbstick_Y : WaveVRControllerKeyNames::Left_Thumbstick_Y).GetFName(), 0, axis.Y);
+		break;
+	default:
+		break;
 	}
 }
 
@@ -666,10 +640,15 @@ void FWaveVRInput::SendControllerEvents()
 {
 	//LOGD(LogWaveVRInput, "SendControllerEvents()");
 
-	UpdateButtonPressStates(EControllerHand::Right);
-	UpdateButtonPressStates(EControllerHand::Left);
-	UpdateButtonTouchStates(EControllerHand::Right);
-	UpdateButtonTouchStates(EControllerHand::Left);
+	// One snapshot per hand per frame, then only the edges are dispatched.
+	const EControllerHand hands[ControllerCount] = { EControllerHand::Right, EControllerHand::Left };
+	for (int i = 0; i < ControllerCount; i++)
+	{
+		FWaveVRInputSnapshot snapshot;
+		UpdateInputSnapshot(hands[i], snapshot);
+		UpdateButtonPressStates(hands[i], snapshot.Pressed);
+		UpdateButtonTouchStates(hands[i], snapshot);
+	}
 }
 #pragma endregion IInputDevice overrides
 
@@ -744,6 +723,10 @@ ETrackingStatus FWaveVRInput::GetControllerTrackingStatus(const int32 Controller
 
 void FWaveVRInput::SetHapticFeedbackValues(int32 ControllerId, int32 Hand, const FHapticFeedbackValues& Values)
 {
+	if (Hand != (int32)EControllerHand::Left && Hand != (int32)EControllerHand::Right)
+		return;
+	EWVR_DeviceType _device = GetLeftHandedDevice((EControllerHand)Hand);
+	HapticScheduler.SetValues((WVR_DeviceType)_device, Values);
 }
 
 void FWaveVRInput::GetHapticFrequencyRange(float& MinFrequency, float& MaxFrequency) const
@@ -13,6 +13,8 @@
 #include "WaveVRHMD.h"
 #include "WaveVRController.h"
 #include "WaveVRInputSimulator.h"
+#include "WaveVRInputSnapshot.h"
+#include "WaveVRHapticScheduler.h"
 
 #include "GenericPlatform/IInputInterface.h"
 #include "XRMotionControllerBase.h"
@@ -100,9 +102,10 @@ public:
 
 	static const int ControllerCount = 2;
 	FGamepadKeyNames::Type ControllerPressButtons[ControllerCount][InputButtonCount];
-	bool PrevPressState[ControllerCount][InputButtonCount];
 	FGamepadKeyNames::Type ControllerTouchButtons[ControllerCount][TouchButtonCount];
-	bool PrevTouchState[ControllerCount][TouchButtonCount];
+	// States of the previous frame.  Each bit is a EWVR_InputId.
+	uint32 PrevPressed[ControllerCount];
+	uint32 PrevTouched[ControllerCount];
 
 	void EnableInputSimulator(UObject * WorldContextObject);
 
@@ -132,8 +135,15 @@ public:	// IInputDevice overrides
 	virtual void Tick(float DeltaTime) override;
 
 private:
-	void UpdateButtonPressStates(EControllerHand hand);
-	void UpdateButtonTouchStates(EControllerHand hand);
+	void UpdateInputSnapshot(EControllerHand hand, FWaveVRInputSnapshot& snapshot);
+	void UpdateButtonPressStates(EControllerHand hand, uint32 pressed);
+	void UpdateButtonTouchStates(EControllerHand hand, const FWaveVRInputSnapshot& snapshot);
+	void SendAxis(EControllerHand hand, EWVR_TouchId id, const FVector2D& axis);
+
+	// Bits of InputButton and TouchButton, and the index of a bit in them.
+	uint32 PressButtonMask;
+	uint32 TouchButtonMask;
+	int8 PressButtonIndex[32];
 
 	float fFPS;
 
@@ -153,6 +163,9 @@ public:	// IHapticDevice overrides
 	virtual void GetHapticFrequencyRange(float& MinFrequency, float& MaxFrequency) const override;
 	virtual float GetHapticAmplitudeScale() const override;
 
+private:
+	FWaveVRHapticScheduler HapticScheduler;
+
 public:	// Real & Simulation Pose
 	struct RigidTransform {
 		FVector pos;	// position